@@ -0,0 +1,184 @@
+#!/bin/bash
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+# Runs the publisher and partner of a game binary as two processes talking
+# over loopback, once for every combination of the swept values, and writes
+# wall time, peak RSS, gate counts and traffic of both parties to a CSV.
+#
+# Binaries can be taken out of the emp-games image with
+# extract-docker-binaries.sh. For example, to sweep input sizes and
+# concurrency of pcf2_attribution over a 100 Mbit/s link with 10ms latency:
+#
+#   run-loopback-benchmark.sh -b ./pcf2_attribution_calculator \
+#     -p "--input_base_path=inputs/{rows}_{touchpoints}/publisher.csv \
+#         --output_base_path=out/publisher --attribution_rules={rules}" \
+#     -q "--input_base_path=inputs/{rows}_{touchpoints}/partner.csv \
+#         --output_base_path=out/partner" \
+#     -s rows=1000,10000 -s touchpoints=1,4 \
+#     -s rules=last_click_1d,last_touch_1d -s concurrency=1,4 \
+#     -r 100mbit -l 10ms
+#
+# A swept value replaces every "{name}" in the party flags. Names that appear
+# in neither party's flags are passed to both parties as "--name=value".
+
+set -u
+
+usage() {
+    cat <<EOF
+Usage: $0 -b <binary> [options]
+  -b <binary>      game binary, e.g. pcf2_attribution_calculator
+  -p <flags>       flags for the publisher (party 1)
+  -q <flags>       flags for the partner (party 2)
+  -s <name=v1,v2>  values to sweep, may be repeated
+  -n <repeats>     runs per combination (default 1)
+  -r <rate>        shape loopback to this bandwidth, e.g. 100mbit (needs root)
+  -l <latency>     add this one-way latency to loopback, e.g. 10ms (needs root)
+  -o <dir>         where logs and results.csv go (default loopback-benchmark)
+  -P <port>        first port to use, one more per run (default 15200)
+EOF
+    exit 1
+}
+
+BINARY=""
+PUBLISHER_FLAGS=""
+PARTNER_FLAGS=""
+SWEEPS=()
+REPEATS=1
+RATE=""
+LATENCY=""
+OUTPUT_DIR="loopback-benchmark"
+PORT=15200
+
+while getopts "b:p:q:s:n:r:l:o:P:h" opt; do
+    case $opt in
+        b) BINARY=$OPTARG ;;
+        p) PUBLISHER_FLAGS=$OPTARG ;;
+        q) PARTNER_FLAGS=$OPTARG ;;
+        s) SWEEPS+=("$OPTARG") ;;
+        n) REPEATS=$OPTARG ;;
+        r) RATE=$OPTARG ;;
+        l) LATENCY=$OPTARG ;;
+        o) OUTPUT_DIR=$OPTARG ;;
+        P) PORT=$OPTARG ;;
+        *) usage ;;
+    esac
+done
+
+if [ -z "$BINARY" ]; then
+    usage
+fi
+if [ ! -x /usr/bin/time ]; then
+    echo "/usr/bin/time is needed to measure peak memory" >&2
+    exit 1
+fi
+
+mkdir -p "$OUTPUT_DIR"
+RESULTS="$OUTPUT_DIR/results.csv"
+
+# Shaping loopback affects both directions, so a round trip takes twice the
+# latency. It is removed again however the script exits.
+if [ -n "$RATE" ] || [ -n "$LATENCY" ]; then
+    NETEM=()
+    if [ -n "$LATENCY" ]; then
+        NETEM+=(delay "$LATENCY")
+    fi
+    if [ -n "$RATE" ]; then
+        NETEM+=(rate "$RATE")
+    fi
+    tc qdisc add dev lo root netem "${NETEM[@]}" || exit 1
+    trap 'tc qdisc del dev lo root netem' EXIT
+fi
+
+# Expands the sweeps into one line per combination, each a space separated
+# list of name=value
+combinations() {
+    local result=("")
+    local sweep name value prefix values
+    for sweep in "${SWEEPS[@]}"; do
+        name=${sweep%%=*}
+        IFS=',' read -r -a values <<< "${sweep#*=}"
+        local next=()
+        for prefix in "${result[@]}"; do
+            for value in "${values[@]}"; do
+                next+=("${prefix:+$prefix }$name=$value")
+            done
+        done
+        result=("${next[@]}")
+    done
+    printf '%s\n' "${result[@]}"
+}
+
+# Fills in "{name}" for every swept value, and appends the values that the
+# flags do not mention
+apply_combination() {
+    local flags=$1
+    local combination=$2
+    local other_flags=$3
+    local pair name value
+    for pair in $combination; do
+        name=${pair%%=*}
+        value=${pair#*=}
+        if [[ "$flags$other_flags" == *"{$name}"* ]]; then
+            flags=${flags//\{$name\}/$value}
+        else
+            flags="$flags --$name=$value"
+        fi
+    done
+    echo "$flags"
+}
+
+# Reads "<first> = <a>, <second> = <b>" lines, as the pcf2 games log them
+log_counter() {
+    local log=$1
+    local pattern=$2
+    local field=$3
+    grep -o "$pattern = [0-9]*, .* = [0-9]*" "$log" | tail -n 1 |
+        sed 's/[^0-9,]//g' | cut -d ',' -f "$field"
+}
+
+run_party() {
+    local party=$1
+    local flags=$2
+    local prefix=$3
+    # shellcheck disable=SC2086
+    /usr/bin/time -f "%e %M" -o "$prefix.time" \
+        "$BINARY" --party="$party" --server_ip=127.0.0.1 --port="$PORT" \
+        $flags > "$prefix.log" 2>&1
+}
+
+echo "combination,repeat,party,exit_code,wall_seconds,peak_rss_kb,non_free_gates,free_gates,sent_bytes,received_bytes" > "$RESULTS"
+
+RUN=0
+while read -r COMBINATION; do
+    for ((REPEAT = 0; REPEAT < REPEATS; REPEAT++)); do
+        PREFIX="$OUTPUT_DIR/run_$RUN"
+        PUBLISHER=$(apply_combination "$PUBLISHER_FLAGS" "$COMBINATION" "$PARTNER_FLAGS")
+        PARTNER=$(apply_combination "$PARTNER_FLAGS" "$COMBINATION" "$PUBLISHER_FLAGS")
+        echo "Run $RUN: ${COMBINATION:-default}, repeat $REPEAT"
+
+        run_party 1 "$PUBLISHER" "${PREFIX}_publisher" &
+        PUBLISHER_PID=$!
+        run_party 2 "$PARTNER" "${PREFIX}_partner"
+        PARTNER_EXIT=$?
+        wait $PUBLISHER_PID
+        PUBLISHER_EXIT=$?
+
+        for PARTY in publisher partner; do
+            if [ "$PARTY" = publisher ]; then
+                EXIT_CODE=$PUBLISHER_EXIT
+            else
+                EXIT_CODE=$PARTNER_EXIT
+            fi
+            LOG="${PREFIX}_$PARTY.log"
+            read -r WALL_SECONDS PEAK_RSS_KB < <(tail -n 1 "${PREFIX}_$PARTY.time")
+            echo "\"$COMBINATION\",$REPEAT,$PARTY,$EXIT_CODE,$WALL_SECONDS,$PEAK_RSS_KB,$(log_counter "$LOG" "Non-free gate count" 1),$(log_counter "$LOG" "Non-free gate count" 2),$(log_counter "$LOG" "Sent network traffic" 1),$(log_counter "$LOG" "Sent network traffic" 2)" >> "$RESULTS"
+        done
+        RUN=$((RUN + 1))
+        PORT=$((PORT + 1))
+    done
+done < <(combinations)
+
+echo "Results are in $RESULTS"
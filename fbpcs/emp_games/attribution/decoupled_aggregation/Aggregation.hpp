@@ -121,17 +121,15 @@ populateMeasurementConversionMetadata(
   return measurementCvmArrays;
 }
 
-// we will receive a list of aggregation formats on publisher side, sharing the
-// formats with partner.
-template <int MY_ROLE>
-const std::vector<AggregationFormat> shareAggregationFormats(
-    const std::vector<AggregationFormat>& aggregationFormats) {
-  int64_t numAggregationFormats =
-      emp::Integer{
-          INT_SIZE, static_cast<int64_t>(aggregationFormats.size()), PUBLISHER}
-          .reveal<int64_t>();
-  XLOGF(DBG, "Shared number of aggregation formats: {}", numAggregationFormats);
-
+// we will receive a list of aggregation formats and the valid ad ids on
+// publisher side, sharing both with partner. Ad ids will be used as keys for
+// aggregation in Measurement aggregator.
+template <int MY_ROLE, class IOChannel>
+const std::pair<std::vector<AggregationFormat>, std::vector<int64_t>>
+shareAggregationMetadata(
+    IOChannel& io,
+    const std::vector<AggregationFormat>& aggregationFormats,
+    const std::vector<int64_t>& adIds) {
   std::vector<int64_t> aggregationIds;
   if constexpr (MY_ROLE == PUBLISHER) {
     for (std::vector<AggregationFormat>::size_type i = 0;
@@ -146,50 +144,32 @@ const std::vector<AggregationFormat> shareAggregationFormats(
   }
 
   const auto action = MY_ROLE == PUBLISHER ? "sending" : "receiving";
-  XLOGF(DBG, "{} aggregation formats", action);
-  auto sharedAggregationFormatIds =
-      private_measurement::secret_sharing::privatelyShareIntsFromAlice<MY_ROLE>(
-          aggregationIds, numAggregationFormats);
-  std::vector<AggregationFormat> out;
+  XLOGF(DBG, "{} aggregation formats and ad ids", action);
+  // Format ids and ad ids go over in the clear in one message, rather than one
+  // round trip per id
+  const auto sharedLists =
+      private_measurement::secret_sharing::publiclyShareIntListsFromAlice<
+          MY_ROLE>(io, {aggregationIds, adIds}, 2);
+  const auto& sharedAggregationFormatIds = sharedLists.at(0);
+  const auto& sharedAdIds = sharedLists.at(1);
+  XLOGF(
+      DBG,
+      "Shared number of aggregation formats: {}",
+      sharedAggregationFormatIds.size());
+
+  std::vector<AggregationFormat> formats;
   for (auto sharedId : sharedAggregationFormatIds) {
-    auto aggregationFormat =
-        getAggregationFormatFromIdOrThrow(sharedId.template reveal<int64_t>());
+    auto aggregationFormat = getAggregationFormatFromIdOrThrow(sharedId);
     XLOGF(DBG, "Found aggregation format: {}", aggregationFormat.name);
-    out.push_back(aggregationFormat);
-  }
-
-  return out;
-}
-
-// ad Ids will be used as keys for aggregation in Measurement aggregator.
-// sharing the Ids with partner.
-template <int MY_ROLE>
-const std::vector<int64_t> shareValidAdIds(const std::vector<int64_t>& adIds) {
-  // Compute and then send over the integer ad ids.
-  int64_t numValidAdIds = 0;
-  if (MY_ROLE == aggregation::private_aggregation::PUBLISHER) {
-    XLOG(DBG, "Computing valid ad ids for sending to partner");
-    std::unordered_set<int64_t> adIdSet;
-    numValidAdIds = adIds.size();
+    formats.push_back(aggregationFormat);
   }
 
-  const emp::Integer empNumValidAdIds{INT_SIZE, numValidAdIds, PUBLISHER};
-  numValidAdIds = empNumValidAdIds.reveal<int64_t>();
-  XLOGF(INFO, "Number of Ad Ids: {}", numValidAdIds);
-
-  // Send over and then reveal the ad ids
-  const auto empAdIds =
-      private_measurement::secret_sharing::privatelyShareIntsFromAlice<MY_ROLE>(
-          adIds, numValidAdIds, INT_SIZE);
-  const auto revealedAdIds =
-      private_measurement::secret_sharing::map<emp::Integer, int64_t>(
-          empAdIds, [](auto adId) { return adId.template reveal<int64_t>(); });
-
+  XLOGF(INFO, "Number of Ad Ids: {}", sharedAdIds.size());
   XLOGF(
       INFO,
       "Ad Ids to Be Considered: {}",
-      private_measurement::vecToString(revealedAdIds));
-  return revealedAdIds;
+      private_measurement::vecToString(sharedAdIds));
+  return std::make_pair(formats, sharedAdIds);
 }
 
 // we will initially parse input metrics for all aggregators combined, in this
@@ -222,8 +202,9 @@ populateMetricsForAdObjectFormat(
       privateTpmArrays, privateCvmArrays);
 }
 
-template <int MY_ROLE>
+template <int MY_ROLE, class IOChannel>
 AggregationOutputMetrics computeAggregations(
+    IOChannel& io,
     const AggregationInputMetrics& inputData,
     fbpcf::Visibility outputVisibility) {
   auto ids = inputData.getIds();
@@ -231,11 +212,9 @@ AggregationOutputMetrics computeAggregations(
   XLOGF(INFO, "Have {} ids", numIds);
 
   // Send over all of the data needed for this computation
-  XLOG(INFO, "Sharing aggregation formats...");
-  const auto aggregationFormats =
-      shareAggregationFormats<MY_ROLE>(inputData.getAggregationFormats());
-
-  const auto& adIds = shareValidAdIds<MY_ROLE>(inputData.getOriginalAdIds());
+  XLOG(INFO, "Sharing aggregation formats and ad ids...");
+  const auto [aggregationFormats, adIds] = shareAggregationMetadata<MY_ROLE>(
+      io, inputData.getAggregationFormats(), inputData.getOriginalAdIds());
 
   MeasurementTpmArrays privateTpmArrays;
   MeasurementCvmArrays privateCvmArrays;
@@ -27,22 +27,33 @@ class AggregationGame : public fbpcf::EmpGame<
                             AggregationOutputMetrics> {
  public:
   AggregationGame(std::unique_ptr<IOChannel> ioChannel, fbpcf::Party party)
-      : fbpcf::EmpGame<
-            IOChannel,
-            AggregationInputMetrics,
-            AggregationOutputMetrics>(std::move(ioChannel), party) {}
+      : AggregationGame(ioChannel.get(), std::move(ioChannel), party) {}
 
   AggregationOutputMetrics play(
       const AggregationInputMetrics& inputData) override {
     XLOG(INFO, "Running private aggregation");
-    AggregationOutputMetrics outputMetrics =
-        computeAggregations<MY_ROLE>(inputData, OUTPUT_VISIBILITY);
+    AggregationOutputMetrics outputMetrics = computeAggregations<MY_ROLE>(
+        *ioChannel_, inputData, OUTPUT_VISIBILITY);
     XLOGF(
         INFO,
         "Done. Output: {}",
         folly::toPrettyJson(outputMetrics.toDynamic()));
     return outputMetrics;
   }
+
+ private:
+  AggregationGame(
+      IOChannel* ioChannelPtr,
+      std::unique_ptr<IOChannel> ioChannel,
+      fbpcf::Party party)
+      : fbpcf::EmpGame<
+            IOChannel,
+            AggregationInputMetrics,
+            AggregationOutputMetrics>(std::move(ioChannel), party),
+        ioChannel_{ioChannelPtr} {}
+
+  // Owned by EmpGame. Public metadata is sent over it in the clear.
+  IOChannel* ioChannel_;
 };
 
 } // namespace aggregation::private_aggregation
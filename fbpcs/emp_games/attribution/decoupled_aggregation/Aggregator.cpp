@@ -9,6 +9,7 @@
 #include <cstdint>
 #include <iterator>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include "folly/dynamic.h"
@@ -19,6 +20,7 @@
 
 #include "fbpcs/emp_games/attribution/decoupled_aggregation/Aggregator.h"
 #include "fbpcs/emp_games/attribution/decoupled_aggregation/Constants.h"
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/ObliviousSort.h"
 
 namespace aggregation::private_aggregation {
 
@@ -26,6 +28,16 @@ using PrivateConvMap = std::vector<std::pair<emp::Integer, PrivateConvMetrics>>;
 
 namespace {
 
+// AND gates for each (conversion, ad id) pair: an ad id comparison, and a mux
+// and an adder for each of the two metrics
+constexpr double kPerAdIdGates = INT_SIZE_16 + 1 + 4 * INT_SIZE_32;
+// AND gates for each compare-and-swap of a sort: a key comparison, and a mux
+// for the key and each of the two metrics
+constexpr double kCompareAndSwapGates = 4 * INT_SIZE_32;
+// AND gates for each record of the segmented sums: a key comparison, and a
+// mux and an adder for each of the two metrics
+constexpr double kSegmentedSumGates = 5 * INT_SIZE_32;
+
 struct MeasurementAggregation {
   // ad_id => metrics
   std::unordered_map<int64_t, ConvMetrics> metrics;
@@ -54,8 +66,9 @@ class MeasurementAggregator : public Aggregator {
  public:
   explicit MeasurementAggregator(
       const std::vector<int64_t>& validAdIds,
-      const fbpcf::Visibility& outputVisibility)
-      : Aggregator{outputVisibility} {
+      const fbpcf::Visibility& outputVisibility,
+      std::optional<AggregationStrategy> strategy)
+      : Aggregator{outputVisibility}, _strategy{strategy} {
     int numValidAdIds = validAdIds.size();
     validOriginalAdIds_ = validAdIds;
     for (uint16_t compressedAdId = 1; compressedAdId <= numValidAdIds;
@@ -90,9 +103,8 @@ class MeasurementAggregator : public Aggregator {
     CHECK_EQ(privateCvmArrays.size(), privateTpmArrays.size())
         << "Size of conversion metadata and touchpoint metadata should be equal.";
 
-    std::vector<std::vector<
-        MeasurementAggregation::PrivateMeasurementAggregationResult>>
-        touchpointConversionResults;
+    std::vector<MeasurementAggregation::PrivateMeasurementAggregationResult>
+        conversions;
     for (std::size_t i = 0; i < privateCvmArrays.size(); i++) {
       // Retrieve the touchpoint-conversion metadata pairs based on attribution
       // results. One assumption here is that one conversion will only be
@@ -103,34 +115,118 @@ class MeasurementAggregator : public Aggregator {
               privateCvmArrays.at(i),
               privateTpAttributionArrays.at(i),
               privateCvmAttributionsArrays.at(i));
-      touchpointConversionResults.push_back(touchpointConversionResultsPerId);
+      conversions.insert(
+          conversions.end(),
+          touchpointConversionResultsPerId.begin(),
+          touchpointConversionResultsPerId.end());
+    }
+
+    auto strategy = _strategy.value_or(getAggregationStrategy(
+        conversions.size(), _adIdToMetrics.size()));
+    if (strategy == AggregationStrategy::ObliviousSort) {
+      aggregateUsingObliviousSort(conversions);
+    } else {
+      aggregatePerAdId(conversions);
+    }
+  }
+
+  // Compares every conversion against every ad id.
+  void aggregatePerAdId(
+      const std::vector<
+          MeasurementAggregation::PrivateMeasurementAggregationResult>&
+          conversions) {
+    const emp::Integer zero{INT_SIZE_32, 0, emp::PUBLIC};
+    const emp::Integer one{INT_SIZE_32, 1, emp::PUBLIC};
+
+    for (const auto& touchpointConversionResult : conversions) {
+      const auto& touchpoint =
+          touchpointConversionResult.measurementTouchpointMetadata;
+      const auto& conversion =
+          touchpointConversionResult.measurementConversionMetadata;
+
+      for (auto& [adId, metrics] : _adIdToMetrics) {
+        const auto adIdMatches =
+            touchpointConversionResult.hasAttributedTouchpoint &
+            adId.equal(touchpoint.adId);
+
+        // emp::If(condition, true_case, false_case)
+        const auto convsDelta = emp::If(adIdMatches, one, zero);
+        const auto salesDelta =
+            emp::If(adIdMatches, conversion.conv_value, zero);
+
+        metrics.convs = metrics.convs + convsDelta;
+        metrics.sales = metrics.sales + salesDelta;
+      }
     }
+  }
 
-    for (auto& touchpointConversionResultsPerId : touchpointConversionResults) {
-      for (auto& touchpointConversionResult :
-           touchpointConversionResultsPerId) {
-        const auto& touchpoint =
-            touchpointConversionResult.measurementTouchpointMetadata;
-        const auto& conversion =
-            touchpointConversionResult.measurementConversionMetadata;
+  // Obliviously sorts the conversions together with one empty record per ad
+  // id, sums every ad id's run into its empty record, and sorts these records
+  // to the front.
+  void aggregateUsingObliviousSort(
+      const std::vector<
+          MeasurementAggregation::PrivateMeasurementAggregationResult>&
+          conversions) {
+    const emp::Integer zero{INT_SIZE_32, 0, emp::PUBLIC};
+    const emp::Integer one{INT_SIZE_32, 1, emp::PUBLIC};
+
+    std::size_t numAdIds = _adIdToMetrics.size();
+    std::size_t numRecords = 1;
+    while (numRecords < conversions.size() + numAdIds) {
+      numRecords <<= 1;
+    }
 
-        for (auto& [adId, metrics] : _adIdToMetrics) {
-          const emp::Integer zero{INT_SIZE_32, 0, emp::PUBLIC};
-          const emp::Integer one{INT_SIZE_32, 1, emp::PUBLIC};
+    // Sort keys hold the ad id above a flag marking the empty record of each
+    // ad id, which sorts after the conversions of the same ad id. Values are
+    // convs and sales.
+    std::vector<emp::Integer> keys;
+    std::vector<std::vector<emp::Integer>> values(2);
+    keys.reserve(numRecords);
+    for (auto& value : values) {
+      value.reserve(numRecords);
+    }
+    for (const auto& touchpointConversionResult : conversions) {
+      auto adId = touchpointConversionResult.measurementTouchpointMetadata.adId;
+      adId.resize(INT_SIZE_32, /* signed_extend */ false);
+      // Conversions without a touchpoint go to ad id 0, which is not valid.
+      keys.push_back(emp::If(
+          touchpointConversionResult.hasAttributedTouchpoint,
+          adId << 1,
+          zero));
+      values.at(0).push_back(one);
+      values.at(1).push_back(
+          touchpointConversionResult.measurementConversionMetadata.conv_value);
+    }
+    for (std::size_t i = 1; keys.size() < numRecords; ++i) {
+      // Padding records use an ad id past all valid ones.
+      auto adId = static_cast<int64_t>(std::min(i, numAdIds + 1));
+      keys.emplace_back(INT_SIZE_32, (adId << 1) | 1, emp::PUBLIC);
+      values.at(0).push_back(zero);
+      values.at(1).push_back(zero);
+    }
 
-          const auto adIdMatches =
-              touchpointConversionResult.hasAttributedTouchpoint &
-              adId.equal(touchpoint.adId);
+    oblivious_sort::sortByKey(keys, values);
 
-          // emp::If(condition, true_case, false_case)
-          const auto convsDelta = emp::If(adIdMatches, one, zero);
-          const auto salesDelta =
-              emp::If(adIdMatches, conversion.conv_value, zero);
+    std::vector<emp::Integer> adIds;
+    adIds.reserve(numRecords);
+    for (const auto& key : keys) {
+      adIds.push_back(key >> 1);
+    }
+    oblivious_sort::segmentedSums(adIds, values);
+
+    // The empty record of every ad id now holds its sums. Move these records
+    // to the front, ordered by ad id.
+    for (std::size_t i = 0; i < numRecords; ++i) {
+      auto isConversion = !keys.at(i)[0];
+      keys.at(i) = adIds.at(i);
+      keys.at(i)[INT_SIZE_32 - 2] = isConversion;
+    }
+    oblivious_sort::sortByKey(keys, values);
 
-          metrics.convs = metrics.convs + convsDelta;
-          metrics.sales = metrics.sales + salesDelta;
-        }
-      }
+    for (std::size_t i = 0; i < numAdIds; ++i) {
+      auto& metrics = _adIdToMetrics.at(i).second;
+      metrics.convs = metrics.convs + values.at(0).at(i);
+      metrics.sales = metrics.sales + values.at(1).at(i);
     }
   }
 
@@ -197,9 +293,30 @@ class MeasurementAggregator : public Aggregator {
 
  private:
   PrivateConvMap _adIdToMetrics;
+  std::optional<AggregationStrategy> _strategy;
 };
 } // namespace
 
+AggregationStrategy getAggregationStrategy(
+    std::size_t numConversions,
+    std::size_t numAdIds) {
+  std::size_t numRecords = 1;
+  double depth = 0;
+  while (numRecords < numConversions + numAdIds) {
+    numRecords <<= 1;
+    ++depth;
+  }
+
+  // A bitonic sort has depth * (depth + 1) / 2 layers of numRecords / 2
+  // compare-and-swaps, and runs twice.
+  double sortGates =
+      kCompareAndSwapGates * numRecords * depth * (depth + 1) / 2 +
+      kSegmentedSumGates * numRecords;
+  double perAdIdGates = kPerAdIdGates * numConversions * numAdIds;
+  return perAdIdGates <= sortGates ? AggregationStrategy::PerAdId
+                                   : AggregationStrategy::ObliviousSort;
+}
+
 static const std::array SUPPORTED_AGGREGATION_FORMATS{AggregationFormat{
     /* id */ 1,
     /* name */ "measurement",
@@ -207,7 +324,7 @@ static const std::array SUPPORTED_AGGREGATION_FORMATS{AggregationFormat{
     [](AggregationContext ctx,
        fbpcf::Visibility outputVisibility) -> std::unique_ptr<Aggregator> {
       return std::make_unique<MeasurementAggregator>(
-          ctx.validAdIds, outputVisibility);
+          ctx.validAdIds, outputVisibility, ctx.strategy);
     }}};
 
 AggregationFormat getAggregationFormatFromNameOrThrow(const std::string& name) {
@@ -10,6 +10,7 @@
 #include <fbpcf/mpc/EmpGame.h>
 #include <math.h>
 #include <memory>
+#include <optional>
 #include <vector>
 #include "fbpcs/emp_games/attribution/decoupled_aggregation/AttributionResult.h"
 #include "fbpcs/emp_games/attribution/decoupled_aggregation/Constants.h"
@@ -97,8 +98,25 @@ class Aggregator {
   std::vector<int64_t> validOriginalAdIds_;
 };
 
+// How the measurement aggregator adds every attributed conversion to the
+// metrics of its ad id.
+enum class AggregationStrategy {
+  // compare every conversion against every ad id
+  PerAdId,
+  // obliviously sort the conversions by ad id and sum every ad id's run
+  ObliviousSort
+};
+
+// Picks the strategy with fewer AND gates. Both parties know the number of
+// conversions and ad ids, so they pick the same one.
+AggregationStrategy getAggregationStrategy(
+    std::size_t numConversions,
+    std::size_t numAdIds);
+
 struct AggregationContext {
   const std::vector<int64_t>& validAdIds;
+  // overrides getAggregationStrategy, e.g. for benchmarks
+  std::optional<AggregationStrategy> strategy = std::nullopt;
 };
 
 class AggregationFormat {
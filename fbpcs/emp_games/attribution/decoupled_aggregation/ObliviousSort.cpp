@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/ObliviousSort.h"
+
+#include <cstddef>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include "folly/logging/xlog.h"
+
+namespace aggregation::private_aggregation::oblivious_sort {
+
+namespace {
+// Swaps low and high when swap is set, with one mux per bit. The other output
+// is free, since a ^ b ^ (swap ? b : a) == (swap ? a : b).
+void conditionalSwap(
+    const emp::Bit& swap,
+    emp::Integer& low,
+    emp::Integer& high) {
+  // emp::If(condition, true_case, false_case)
+  auto newLow = emp::If(swap, high, low);
+  high = high ^ low ^ newLow;
+  low = newLow;
+}
+} // namespace
+
+void sortByKey(
+    std::vector<emp::Integer>& keys,
+    std::vector<std::vector<emp::Integer>>& values) {
+  std::size_t size = keys.size();
+  CHECK_EQ(size & (size - 1), 0)
+      << "Number of records to sort must be a power of two.";
+  for (const auto& value : values) {
+    CHECK_EQ(value.size(), size)
+        << "Every value must have one entry per record.";
+  }
+
+  for (std::size_t blockSize = 2; blockSize <= size; blockSize <<= 1) {
+    for (std::size_t distance = blockSize >> 1; distance > 0; distance >>= 1) {
+      for (std::size_t i = 0; i < size; ++i) {
+        std::size_t j = i ^ distance;
+        if (j <= i) {
+          continue;
+        }
+        // Blocks alternate between ascending and descending order, so that
+        // every two neighbouring blocks form a bitonic sequence.
+        bool ascending = (i & blockSize) == 0;
+        std::size_t low = ascending ? i : j;
+        std::size_t high = ascending ? j : i;
+
+        auto swap = keys.at(high) < keys.at(low);
+        conditionalSwap(swap, keys.at(low), keys.at(high));
+        for (auto& value : values) {
+          conditionalSwap(swap, value.at(low), value.at(high));
+        }
+      }
+    }
+  }
+}
+
+void segmentedSums(
+    const std::vector<emp::Integer>& segments,
+    std::vector<std::vector<emp::Integer>>& values) {
+  for (std::size_t i = 1; i < segments.size(); ++i) {
+    // Records are grouped by segment, so the two records are in the same run
+    // exactly when they have the same segment key.
+    auto sameSegment = segments.at(i).equal(segments.at(i - 1));
+    for (auto& value : values) {
+      const emp::Integer zero{value.at(i).size(), 0, emp::PUBLIC};
+      value.at(i) = value.at(i) + emp::If(sameSegment, value.at(i - 1), zero);
+    }
+  }
+}
+
+} // namespace aggregation::private_aggregation::oblivious_sort
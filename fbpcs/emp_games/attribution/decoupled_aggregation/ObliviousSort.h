@@ -0,0 +1,34 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+namespace aggregation::private_aggregation::oblivious_sort {
+
+// Helpers to add up values by key in a number of gates that does not grow
+// with the product of records and keys. Records are given as a key and any
+// number of values, with values indexed by [value][record]. Keys are compared
+// as signed integers, so they must be non-negative.
+
+// Obliviously sorts records by key, in ascending order, with a bitonic sorting
+// network. The number of records must be a power of two.
+void sortByKey(
+    std::vector<emp::Integer>& keys,
+    std::vector<std::vector<emp::Integer>>& values);
+
+// Computes the running sums of the values within every run of consecutive
+// records that have the same segment key. Afterwards, the last record of every
+// run holds the sum of the run.
+void segmentedSums(
+    const std::vector<emp::Integer>& segments,
+    std::vector<std::vector<emp::Integer>>& values);
+
+} // namespace aggregation::private_aggregation::oblivious_sort
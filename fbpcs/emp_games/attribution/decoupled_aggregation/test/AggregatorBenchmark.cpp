@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include <gflags/gflags.h>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/Aggregator.h"
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/Constants.h"
+
+DEFINE_int64(num_conversions, 1000, "Number of conversions to aggregate");
+
+namespace aggregation::private_aggregation {
+
+// One attributed touchpoint and conversion per id, spread over all ad ids
+PrivateAggregation getPrivateAggregation(int64_t numAdIds) {
+  PrivateAggregation res;
+  for (int64_t i = 0; i < FLAGS_num_conversions; ++i) {
+    res.tpAttributionResults.push_back(
+        {PrivateAttributionResult{emp::Bit{true, emp::ALICE}}});
+    res.convAttributionResults.push_back(
+        {PrivateAttributionResult{emp::Bit{false, emp::BOB}}});
+    res.privateTpm.push_back({PrivateMeasurementTouchpointMetadata{
+        emp::Integer{INT_SIZE_16, i % numAdIds + 1, emp::ALICE}}});
+    res.privateCvm.push_back({PrivateMeasurementConversionMetadata{
+        emp::Integer{INT_SIZE_32, i % 100, emp::BOB}}});
+  }
+  return res;
+}
+
+// Inputs are shared inside the timed run, since they need an emp backend. Both
+// strategies share the same inputs, so the difference between them is the cost
+// of aggregation.
+void runAggregator(
+    AggregationStrategy strategy,
+    std::size_t iters,
+    std::size_t numAdIds) {
+  std::vector<int64_t> validAdIds;
+  for (std::size_t adId = 1; adId <= numAdIds; ++adId) {
+    validAdIds.push_back(adId);
+  }
+  for (std::size_t i = 0; i < iters; ++i) {
+    fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+        [strategy, numAdIds, &validAdIds](fbpcf::Party /* party */) {
+          auto privateAggregation = getPrivateAggregation(numAdIds);
+          auto aggregator =
+              getAggregationFormatFromNameOrThrow("measurement")
+                  .newAggregator(
+                      AggregationContext{validAdIds, strategy},
+                      fbpcf::Visibility::Public);
+          aggregator->aggregateAttributions(privateAggregation);
+          folly::doNotOptimizeAway(aggregator->reveal());
+        });
+  }
+}
+
+void perAdId(std::size_t iters, std::size_t numAdIds) {
+  runAggregator(AggregationStrategy::PerAdId, iters, numAdIds);
+}
+
+void obliviousSort(std::size_t iters, std::size_t numAdIds) {
+  runAggregator(AggregationStrategy::ObliviousSort, iters, numAdIds);
+}
+
+// A fixed number of conversions over a growing number of ad ids
+BENCHMARK_PARAM(perAdId, 10)
+BENCHMARK_RELATIVE_PARAM(obliviousSort, 10)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(perAdId, 100)
+BENCHMARK_RELATIVE_PARAM(obliviousSort, 100)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(perAdId, 1000)
+BENCHMARK_RELATIVE_PARAM(obliviousSort, 1000)
+BENCHMARK_DRAW_LINE();
+BENCHMARK_PARAM(perAdId, 10000)
+BENCHMARK_RELATIVE_PARAM(obliviousSort, 10000)
+
+} // namespace aggregation::private_aggregation
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
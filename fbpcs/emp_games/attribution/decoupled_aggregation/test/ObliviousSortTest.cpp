@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <tuple>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include <gtest/gtest.h>
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include "folly/dynamic.h"
+
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/Aggregator.h"
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/Constants.h"
+#include "fbpcs/emp_games/attribution/decoupled_aggregation/ObliviousSort.h"
+
+namespace aggregation::private_aggregation {
+
+namespace {
+std::vector<emp::Integer> toIntegers(const std::vector<int64_t>& values) {
+  std::vector<emp::Integer> res;
+  for (auto value : values) {
+    res.emplace_back(INT_SIZE_32, value, emp::ALICE);
+  }
+  return res;
+}
+
+std::vector<int64_t> reveal(const std::vector<emp::Integer>& values) {
+  std::vector<int64_t> res;
+  for (const auto& value : values) {
+    res.push_back(value.reveal<int64_t>(emp::PUBLIC));
+  }
+  return res;
+}
+
+// One touchpoint and one conversion per id, given as (is attributed, ad id,
+// conversion value)
+PrivateAggregation getPrivateAggregation(
+    const std::vector<std::tuple<bool, int64_t, int64_t>>& conversions) {
+  PrivateAggregation res;
+  for (const auto& [isAttributed, adId, convValue] : conversions) {
+    // Attribution results are XOR shared between touchpoints and conversions
+    res.tpAttributionResults.push_back(
+        {PrivateAttributionResult{emp::Bit{isAttributed, emp::ALICE}}});
+    res.convAttributionResults.push_back(
+        {PrivateAttributionResult{emp::Bit{false, emp::BOB}}});
+    res.privateTpm.push_back({PrivateMeasurementTouchpointMetadata{
+        emp::Integer{INT_SIZE_16, adId, emp::ALICE}}});
+    res.privateCvm.push_back({PrivateMeasurementConversionMetadata{
+        emp::Integer{INT_SIZE_32, convValue, emp::BOB}}});
+  }
+  return res;
+}
+} // namespace
+
+TEST(ObliviousSortTest, TestSortByKey) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        auto keys = toIntegers({5, 3, 7, 3, 0, 6, 1, 2});
+        std::vector<std::vector<emp::Integer>> values{
+            toIntegers({50, 30, 70, 31, 0, 60, 10, 20})};
+        oblivious_sort::sortByKey(keys, values);
+
+        EXPECT_EQ(reveal(keys), std::vector<int64_t>({0, 1, 2, 3, 3, 5, 6, 7}));
+        // Values move with their keys. Equal keys may be in any order.
+        auto sortedValues = reveal(values.at(0));
+        EXPECT_EQ(sortedValues.at(0), 0);
+        EXPECT_EQ(sortedValues.at(1), 10);
+        EXPECT_EQ(sortedValues.at(2), 20);
+        EXPECT_EQ(sortedValues.at(3) + sortedValues.at(4), 61);
+        EXPECT_EQ(sortedValues.at(5), 50);
+        EXPECT_EQ(sortedValues.at(6), 60);
+        EXPECT_EQ(sortedValues.at(7), 70);
+      });
+}
+
+TEST(ObliviousSortTest, TestSegmentedSums) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        auto segments = toIntegers({1, 1, 1, 2, 4, 4, 5});
+        std::vector<std::vector<emp::Integer>> values{
+            toIntegers({1, 2, 3, 4, 5, 6, 7}),
+            toIntegers({10, 20, 30, 40, 50, 60, 70})};
+        oblivious_sort::segmentedSums(segments, values);
+
+        EXPECT_EQ(
+            reveal(values.at(0)),
+            std::vector<int64_t>({1, 3, 6, 4, 5, 11, 7}));
+        EXPECT_EQ(
+            reveal(values.at(1)),
+            std::vector<int64_t>({10, 30, 60, 40, 50, 110, 70}));
+      });
+}
+
+TEST(ObliviousSortTest, TestGetAggregationStrategy) {
+  EXPECT_EQ(getAggregationStrategy(1000, 1), AggregationStrategy::PerAdId);
+  EXPECT_EQ(getAggregationStrategy(1000, 10), AggregationStrategy::PerAdId);
+  EXPECT_EQ(
+      getAggregationStrategy(1000, 1000), AggregationStrategy::ObliviousSort);
+  EXPECT_EQ(getAggregationStrategy(0, 1000), AggregationStrategy::PerAdId);
+}
+
+TEST(ObliviousSortTest, TestStrategiesAgree) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        const std::vector<int64_t> validAdIds{101, 102, 103, 104, 105};
+        // ad id 4 has no conversions, and the last conversion is not
+        // attributed
+        auto privateAggregation = getPrivateAggregation(
+            {{true, 2, 10},
+             {true, 1, 20},
+             {true, 2, 30},
+             {true, 5, 40},
+             {true, 3, 50},
+             {true, 2, 60},
+             {false, 1, 70}});
+
+        folly::dynamic expected = folly::dynamic::object(
+            "101", folly::dynamic::object("convs", 1)("sales", 20))(
+            "102", folly::dynamic::object("convs", 3)("sales", 100))(
+            "103", folly::dynamic::object("convs", 1)("sales", 50))(
+            "104", folly::dynamic::object("convs", 0)("sales", 0))(
+            "105", folly::dynamic::object("convs", 1)("sales", 40));
+
+        auto format = getAggregationFormatFromNameOrThrow("measurement");
+        for (auto strategy :
+             {AggregationStrategy::PerAdId,
+              AggregationStrategy::ObliviousSort}) {
+          auto aggregator = format.newAggregator(
+              AggregationContext{validAdIds, strategy},
+              fbpcf::Visibility::Public);
+          aggregator->aggregateAttributions(privateAggregation);
+          EXPECT_EQ(aggregator->reveal(), expected);
+        }
+      });
+}
+
+} // namespace aggregation::private_aggregation
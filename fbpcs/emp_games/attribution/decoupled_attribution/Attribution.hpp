@@ -49,14 +49,10 @@ const auto privatelyShareConversions = std::bind(
     FLAGS_max_num_conversions,
     CONVERSION_PADDING_VALUE);
 
-template <int MY_ROLE>
+template <int MY_ROLE, class IOChannel>
 const std::vector<AttributionRule> shareAttributionRules(
+    IOChannel& io,
     const std::vector<AttributionRule>& rules) {
-  int64_t numAttributionRules =
-      emp::Integer{INT_SIZE, static_cast<int64_t>(rules.size()), PUBLISHER}
-          .reveal<int64_t>();
-  XLOGF(DBG, "Shared number of attribution rules: {}", numAttributionRules);
-
   std::vector<int64_t> attributionIds;
   if constexpr (MY_ROLE == PUBLISHER) {
     for (std::vector<AttributionRule>::size_type i = 0; i < rules.size(); i++) {
@@ -70,13 +66,20 @@ const std::vector<AttributionRule> shareAttributionRules(
 
   const auto action = MY_ROLE == PUBLISHER ? "sending" : "receiving";
   XLOGF(DBG, "{} attribution rules", action);
-  auto sharedAttributionIds =
-      private_measurement::secret_sharing::privatelyShareIntsFromAlice<MY_ROLE>(
-          attributionIds, numAttributionRules);
+  // All rule ids go over in the clear in one message, rather than one round
+  // trip per id
+  const auto sharedAttributionIds =
+      private_measurement::secret_sharing::publiclyShareIntListsFromAlice<
+          MY_ROLE>(io, {attributionIds}, 1)
+          .at(0);
+  XLOGF(
+      DBG,
+      "Shared number of attribution rules: {}",
+      sharedAttributionIds.size());
+
   std::vector<AttributionRule> out;
   for (auto sharedId : sharedAttributionIds) {
-    auto rule =
-        AttributionRule::fromIdOrThrow(sharedId.template reveal<int64_t>());
+    auto rule = AttributionRule::fromIdOrThrow(sharedId);
     XLOGF(DBG, "Found rule: {}", rule.name);
     out.push_back(rule);
   }
@@ -145,8 +148,9 @@ inline const std::vector<PrivateAttribution> computeAttributionsForId(
   return attributions;
 }
 
-template <int MY_ROLE>
+template <int MY_ROLE, class IOChannel>
 AttributionOutputMetrics computeAttributions(
+    IOChannel& io,
     const AttributionInputMetrics& inputData,
     fbpcf::Visibility outputVisibility) {
   auto ids = inputData.getIds();
@@ -156,7 +160,7 @@ AttributionOutputMetrics computeAttributions(
   // Send over all of the data needed for this computation
   XLOG(INFO, "Sharing attribution rules...");
   const auto attributionRules =
-      shareAttributionRules<MY_ROLE>(inputData.getAttributionRules());
+      shareAttributionRules<MY_ROLE>(io, inputData.getAttributionRules());
   XLOG(INFO, "Privately sharing touchpoints...");
   const auto tpArrays = privatelyShareTouchpoints<MY_ROLE>(
       inputData.getTouchpointArrays(), numIds);
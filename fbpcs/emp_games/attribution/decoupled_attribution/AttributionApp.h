@@ -25,18 +25,30 @@ class AttributionGame : public fbpcf::EmpGame<
                             AttributionOutputMetrics> {
  public:
   AttributionGame(std::unique_ptr<IOChannel> ioChannel, fbpcf::Party party)
-      : fbpcf::EmpGame<
-            IOChannel,
-            AttributionInputMetrics,
-            AttributionOutputMetrics>(std::move(ioChannel), party) {}
+      : AttributionGame(ioChannel.get(), std::move(ioChannel), party) {}
 
   AttributionOutputMetrics play(
       const AttributionInputMetrics& inputData) override {
     XLOG(INFO, "Running attribution");
-    const auto out = computeAttributions<MY_ROLE>(inputData, OUTPUT_VISIBILITY);
+    const auto out = computeAttributions<MY_ROLE>(
+        *ioChannel_, inputData, OUTPUT_VISIBILITY);
     XLOG(INFO, "Attribution completed.");
     return out;
   }
+
+ private:
+  AttributionGame(
+      IOChannel* ioChannelPtr,
+      std::unique_ptr<IOChannel> ioChannel,
+      fbpcf::Party party)
+      : fbpcf::EmpGame<
+            IOChannel,
+            AttributionInputMetrics,
+            AttributionOutputMetrics>(std::move(ioChannel), party),
+        ioChannel_{ioChannelPtr} {}
+
+  // Owned by EmpGame. Public metadata is sent over it in the clear.
+  IOChannel* ioChannel_;
 };
 
 template <int MY_ROLE, fbpcf::Visibility OUTPUT_VISIBILITY>
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcs/emp_games/attribution/shard_aggregator/AggMetricsShape.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+namespace private_measurement {
+namespace {
+bool isLeaf(const AggMetrics& metrics) {
+  return metrics.getTag() == AggMetricsTag::Integer ||
+      metrics.getTag() == AggMetricsTag::EmpInteger;
+}
+
+template <typename F>
+void forEachLeaf(const AggMetrics& metrics, F& f) {
+  switch (metrics.getTag()) {
+    case AggMetricsTag::Map: {
+      // map stores keys in sorted order, so parties will visit leaves in the
+      // same order
+      for (const auto& [key, value] : metrics.getAsMap()) {
+        forEachLeaf(*value, f);
+      }
+      break;
+    }
+    case AggMetricsTag::List: {
+      for (const auto& m : metrics.getAsList()) {
+        forEachLeaf(*m, f);
+      }
+      break;
+    }
+    default: {
+      f(metrics);
+    }
+  }
+}
+
+// copies the structure of a tree, numbering its leaves from numLeaves on
+std::shared_ptr<AggMetrics> buildShape(
+    const AggMetrics& metrics,
+    std::size_t& numLeaves) {
+  if (isLeaf(metrics)) {
+    return std::make_shared<AggMetrics>(
+        AggMetrics{static_cast<int64_t>(numLeaves++)});
+  }
+
+  auto shape = std::make_shared<AggMetrics>(metrics.getTag());
+  if (metrics.getTag() == AggMetricsTag::Map) {
+    for (const auto& [key, value] : metrics.getAsMap()) {
+      shape->emplace(key, buildShape(*value, numLeaves));
+    }
+  } else {
+    for (const auto& m : metrics.getAsList()) {
+      shape->pushBack(buildShape(*m, numLeaves));
+    }
+  }
+  return shape;
+}
+
+void mergeShape(
+    AggMetrics& shape,
+    const AggMetrics& metrics,
+    std::size_t& numLeaves) {
+  if (isLeaf(metrics)) {
+    // fails unless the shape has a leaf here too
+    shape.getIntValue();
+    return;
+  }
+
+  if (metrics.getTag() == AggMetricsTag::Map) {
+    const auto& shapeMap = shape.getAsMap();
+    for (const auto& [key, value] : metrics.getAsMap()) {
+      auto it = shapeMap.find(key);
+      if (it == shapeMap.end()) {
+        shape.emplace(key, buildShape(*value, numLeaves));
+      } else {
+        mergeShape(*it->second, *value, numLeaves);
+      }
+    }
+  } else {
+    const auto& list = metrics.getAsList();
+    for (std::size_t i = 0; i < list.size(); ++i) {
+      if (shape.getAsList().size() <= i) {
+        shape.pushBack(buildShape(*list.at(i), numLeaves));
+      } else {
+        mergeShape(*shape.getAtIndex(i), *list.at(i), numLeaves);
+      }
+    }
+  }
+}
+
+void collectLeafIndices(
+    const AggMetrics& shape,
+    const AggMetrics& metrics,
+    std::vector<std::size_t>& indices) {
+  switch (metrics.getTag()) {
+    case AggMetricsTag::Map: {
+      for (const auto& [key, value] : metrics.getAsMap()) {
+        collectLeafIndices(*shape.getAtKey(key), *value, indices);
+      }
+      break;
+    }
+    case AggMetricsTag::List: {
+      const auto& list = metrics.getAsList();
+      for (std::size_t i = 0; i < list.size(); ++i) {
+        collectLeafIndices(*shape.getAtIndex(i), *list.at(i), indices);
+      }
+      break;
+    }
+    default: {
+      indices.push_back(shape.getIntValue());
+    }
+  }
+}
+
+template <typename T>
+std::shared_ptr<AggMetrics> fillShape(
+    const AggMetrics& shape,
+    const std::vector<T>& values) {
+  switch (shape.getTag()) {
+    case AggMetricsTag::Map: {
+      auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+      for (const auto& [key, value] : shape.getAsMap()) {
+        metrics->emplace(key, fillShape(*value, values));
+      }
+      return metrics;
+    }
+    case AggMetricsTag::List: {
+      auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::List);
+      for (const auto& m : shape.getAsList()) {
+        metrics->pushBack(fillShape(*m, values));
+      }
+      return metrics;
+    }
+    default: {
+      return std::make_shared<AggMetrics>(
+          AggMetrics{values.at(shape.getIntValue())});
+    }
+  }
+}
+} // namespace
+
+std::vector<int64_t> flattenIntValues(const AggMetrics& metrics) {
+  std::vector<int64_t> values;
+  auto f = [&values](const AggMetrics& leaf) {
+    values.push_back(leaf.getIntValue());
+  };
+  forEachLeaf(metrics, f);
+  return values;
+}
+
+std::vector<emp::Integer> flattenEmpIntValues(const AggMetrics& metrics) {
+  std::vector<emp::Integer> values;
+  auto f = [&values](const AggMetrics& leaf) {
+    values.push_back(leaf.getEmpIntValue());
+  };
+  forEachLeaf(metrics, f);
+  return values;
+}
+
+AggMetricsShape::AggMetricsShape(const AggMetrics& metrics)
+    : root_{buildShape(metrics, numLeaves_)} {}
+
+void AggMetricsShape::mergeWith(const AggMetrics& metrics) {
+  // AggMetrics accessors fail on a different structure, like
+  // mergeWithViaAddition
+  mergeShape(*root_, metrics, numLeaves_);
+}
+
+std::vector<std::size_t> AggMetricsShape::getLeafIndices(
+    const AggMetrics& metrics) const {
+  std::vector<std::size_t> indices;
+  collectLeafIndices(*root_, metrics, indices);
+  return indices;
+}
+
+std::shared_ptr<AggMetrics> AggMetricsShape::toAggMetrics(
+    const std::vector<int64_t>& values) const {
+  return fillShape(*root_, values);
+}
+
+std::shared_ptr<AggMetrics> AggMetricsShape::toAggMetrics(
+    const std::vector<emp::Integer>& values) const {
+  return fillShape(*root_, values);
+}
+} // namespace private_measurement
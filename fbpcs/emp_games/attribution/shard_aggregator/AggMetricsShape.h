@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+#include "fbpcs/emp_games/attribution/shard_aggregator/AggMetrics.h"
+
+namespace private_measurement {
+
+// Collects the integer (or emp::Integer) leaves of a tree in pre-order, with
+// map entries in key order. Both parties hold trees of the same structure, so
+// their leaves line up.
+std::vector<int64_t> flattenIntValues(const AggMetrics& metrics);
+std::vector<emp::Integer> flattenEmpIntValues(const AggMetrics& metrics);
+
+/*
+ * The structure of an AggMetrics tree without its values: which maps have
+ * which keys and how long each list is. Every leaf has an index into a flat
+ * vector of values, so that the values of many trees can be secret shared,
+ * added and revealed as a few large batches instead of one emp::Integer at a
+ * time, and put back into a tree afterwards.
+ *
+ * The shape is public, and both parties build it from trees of the same
+ * structure in the same order, so they agree on every leaf index.
+ */
+class AggMetricsShape {
+ public:
+  // the shape of a single tree, whose leaves are numbered in pre-order
+  explicit AggMetricsShape(const AggMetrics& metrics);
+
+  // Adds the map keys and list entries of another tree which this shape does
+  // not have yet, the same way AggMetrics::mergeWithViaAddition would. New
+  // leaves are numbered after the existing ones.
+  void mergeWith(const AggMetrics& metrics);
+
+  std::size_t numLeaves() const {
+    return numLeaves_;
+  }
+
+  // for each leaf of the given tree in pre-order, the index of the same leaf
+  // in this shape. The tree must have been merged into this shape.
+  std::vector<std::size_t> getLeafIndices(const AggMetrics& metrics) const;
+
+  // builds a tree of this shape, where leaf i holds values.at(i)
+  std::shared_ptr<AggMetrics> toAggMetrics(
+      const std::vector<int64_t>& values) const;
+  std::shared_ptr<AggMetrics> toAggMetrics(
+      const std::vector<emp::Integer>& values) const;
+
+ private:
+  // declared first, since building root_ counts the leaves
+  std::size_t numLeaves_ = 0;
+  // a tree of the same structure, where each leaf holds its leaf index
+  std::shared_ptr<AggMetrics> root_;
+};
+} // namespace private_measurement
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "AggMetricsShape.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <folly/dynamic.h>
+#include <folly/json.h>
+
+#include "AggMetrics.h"
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+using AggMetricsShape = private_measurement::AggMetricsShape;
+
+namespace {
+AggMetrics fromJson(const std::string& json) {
+  return AggMetrics::fromDynamic(folly::parseJson(json));
+}
+} // namespace
+
+TEST(AggMetricsShapeTest, TestFlattenInPreOrder) {
+  auto metrics = fromJson(R"({"b": [3, {"y": 5, "x": 4}], "a": 1, "c": 6})");
+  EXPECT_EQ(
+      private_measurement::flattenIntValues(metrics),
+      std::vector<int64_t>({1, 3, 4, 5, 6}));
+
+  AggMetricsShape shape{metrics};
+  EXPECT_EQ(shape.numLeaves(), 5);
+  EXPECT_EQ(
+      shape.getLeafIndices(metrics), std::vector<std::size_t>({0, 1, 2, 3, 4}));
+  EXPECT_EQ(
+      shape.toAggMetrics(private_measurement::flattenIntValues(metrics))
+          ->toDynamic(),
+      metrics.toDynamic());
+}
+
+TEST(AggMetricsShapeTest, TestSingleValue) {
+  AggMetrics metrics{int64_t{7}};
+  AggMetricsShape shape{metrics};
+  shape.mergeWith(metrics);
+
+  EXPECT_EQ(shape.numLeaves(), 1);
+  EXPECT_EQ(shape.toAggMetrics(std::vector<int64_t>{8})->getIntValue(), 8);
+}
+
+TEST(AggMetricsShapeTest, TestMergeDifferentStructures) {
+  auto first = fromJson(R"({"a": 1, "c": [2]})");
+  auto second = fromJson(R"({"b": 3, "c": [4, {"d": 5}]})");
+
+  AggMetricsShape shape{first};
+  shape.mergeWith(second);
+  // new leaves are numbered after the existing ones
+  EXPECT_EQ(shape.numLeaves(), 4);
+  EXPECT_EQ(shape.getLeafIndices(first), std::vector<std::size_t>({0, 1}));
+  EXPECT_EQ(shape.getLeafIndices(second), std::vector<std::size_t>({2, 1, 3}));
+
+  // merging the same structure again adds nothing
+  shape.mergeWith(second);
+  EXPECT_EQ(shape.numLeaves(), 4);
+
+  // adding the leaves of both trees gives the same result as
+  // mergeWithViaAddition
+  std::vector<int64_t> sums(shape.numLeaves());
+  for (const auto& metrics : {first, second}) {
+    auto values = private_measurement::flattenIntValues(metrics);
+    auto indices = shape.getLeafIndices(metrics);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      sums.at(indices.at(i)) += values.at(i);
+    }
+  }
+  EXPECT_EQ(
+      shape.toAggMetrics(sums)->toDynamic(),
+      folly::parseJson(R"({"a": 1, "b": 3, "c": [6, {"d": 5}]})"));
+}
+} // namespace measurement::private_attribution
@@ -12,74 +12,112 @@
 #include "fbpcs/emp_games/attribution/Constants.h"
 #include "fbpcs/emp_games/attribution/shard_aggregator/AggMetrics.h"
 
+#include <cstddef>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 namespace {
 using private_measurement::AggMetrics;
 
 static constexpr int64_t kHiddenMetricConstant = -1;
 
-// liftMetrics should store a MetricsMap containing all the lift metrics
-void hideIfConditionFails(
-    std::shared_ptr<AggMetrics> value,
-    emp::Bit& condition,
-    emp::Integer& hiddenMetric) {
+// Everything a threshold checker needs, gathered from the tree in one walk:
+// the count that each condition compares against the threshold, and every
+// leaf to hide along with the index of the condition it depends on
+struct ThresholdBatch {
+  std::vector<emp::Integer> counts;
+  std::vector<std::shared_ptr<AggMetrics>> leaves;
+  std::vector<std::size_t> conditionIndices;
+};
+
+// adds every leaf under value to the batch, hidden if condition fails
+void gatherLeavesToHide(
+    const std::shared_ptr<AggMetrics>& value,
+    std::size_t condition,
+    ThresholdBatch& batch) {
   if (value->getTag() == private_measurement::AggMetricsTag::EmpInteger) {
-    value->setEmpIntValue(
-        emp::If(condition, value->getEmpIntValue(), hiddenMetric));
+    batch.leaves.push_back(value);
+    batch.conditionIndices.push_back(condition);
   } else if (value->getTag() == private_measurement::AggMetricsTag::List) {
-    for (auto& innerValue : value->getAsList()) {
-      hideIfConditionFails(innerValue, condition, hiddenMetric);
+    for (const auto& innerValue : value->getAsList()) {
+      gatherLeavesToHide(innerValue, condition, batch);
     }
   } else if (value->getTag() == private_measurement::AggMetricsTag::Map) {
-    for (auto& [_, innerValue] : value->getAsMap()) {
-      hideIfConditionFails(innerValue, condition, hiddenMetric);
+    for (const auto& [_, innerValue] : value->getAsMap()) {
+      gatherLeavesToHide(innerValue, condition, batch);
     }
   } else {
     throw std::invalid_argument{"Unexpected AggmetricsTag::Integer"};
   }
 }
 
-void applyLiftThresholdCondition(
-    std::shared_ptr<AggMetrics> liftMetrics,
-    emp::Integer kAnonymityLevel,
-    emp::Integer hiddenMetric) {
-  auto condition = liftMetrics->getAtKey("testConverters")->getEmpIntValue() +
-          liftMetrics->getAtKey("controlConverters")->getEmpIntValue() >=
-      kAnonymityLevel;
+// Evaluates every condition first, then hides the leaves of the failed ones
+// in a single pass over a flat buffer of their values
+void applyThresholdBatch(ThresholdBatch& batch, int64_t threshold) {
+  const emp::Integer hiddenMetric{
+      private_measurement::INT_SIZE, kHiddenMetricConstant, emp::PUBLIC};
+  const emp::Integer kAnonymityLevel{
+      private_measurement::INT_SIZE, threshold, emp::PUBLIC};
+
+  std::vector<emp::Bit> conditions;
+  conditions.reserve(batch.counts.size());
+  for (const auto& count : batch.counts) {
+    conditions.push_back(count >= kAnonymityLevel);
+  }
+
+  std::vector<emp::Integer> values;
+  values.reserve(batch.leaves.size());
+  for (const auto& leaf : batch.leaves) {
+    values.push_back(leaf->getEmpIntValue());
+  }
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    values[i] = emp::If(
+        conditions.at(batch.conditionIndices.at(i)), values[i], hiddenMetric);
+  }
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    batch.leaves.at(i)->setEmpIntValue(std::move(values[i]));
+  }
+}
+
+// liftMetrics should store a MetricsMap containing all the lift metrics
+void gatherLiftThresholdCondition(
+    const std::shared_ptr<AggMetrics>& liftMetrics,
+    ThresholdBatch& batch) {
+  auto condition = batch.counts.size();
+  batch.counts.push_back(
+      liftMetrics->getAtKey("testConverters")->getEmpIntValue() +
+      liftMetrics->getAtKey("controlConverters")->getEmpIntValue());
   for (const auto& [key, value] : liftMetrics->getAsMap()) {
     if (key == "controlPopulation" || key == "testPopulation") {
       // These two values are always revealed
       continue;
     } else {
-      // Call the hide function which will recursively hide metrics if the
-      // condition above failed the anonymity check
-      hideIfConditionFails(value, condition, hiddenMetric);
+      // Every metric below this node is hidden if the condition above fails
+      // the anonymity check
+      gatherLeavesToHide(value, condition, batch);
     }
   }
 }
 
 void findLiftThresholdConditionValidNodes(
-    std::shared_ptr<AggMetrics> metrics,
-    emp::Integer kAnonymityLevel,
-    emp::Integer hiddenMetric) {
+    const std::shared_ptr<AggMetrics>& metrics,
+    ThresholdBatch& batch) {
   if (metrics->getTag() == private_measurement::AggMetricsTag::List) {
-    for (auto& innerValue : metrics->getAsList()) {
-      findLiftThresholdConditionValidNodes(
-          innerValue, kAnonymityLevel, hiddenMetric);
+    for (const auto& innerValue : metrics->getAsList()) {
+      findLiftThresholdConditionValidNodes(innerValue, batch);
     }
   } else if (metrics->getTag() == private_measurement::AggMetricsTag::Map) {
-    auto& innerMap = metrics->getAsMap();
+    const auto& innerMap = metrics->getAsMap();
     if (innerMap.find("testConverters") != innerMap.end() &&
         innerMap.find("controlConverters") != innerMap.end()) {
-      // We found a valid inner node, call the apply function
-      applyLiftThresholdCondition(metrics, kAnonymityLevel, hiddenMetric);
+      // We found a valid inner node, gather its condition and metrics
+      gatherLiftThresholdCondition(metrics, batch);
     } else {
       // Otherwise, we need to keep iterating inside to see if there might be
       // a valid node deeper within the structure
-      for (auto& [_, innerValue] : innerMap) {
-        findLiftThresholdConditionValidNodes(
-            innerValue, kAnonymityLevel, hiddenMetric);
+      for (const auto& [_, innerValue] : innerMap) {
+        findLiftThresholdConditionValidNodes(innerValue, batch);
       }
     }
   }
@@ -90,43 +128,32 @@ namespace measurement::private_attribution {
 std::function<void(std::shared_ptr<AggMetrics>)> constructLiftThresholdChecker(
     int64_t threshold) {
   return [threshold](std::shared_ptr<AggMetrics> metrics) {
-    const emp::Integer hiddenMetric{
-        INT_SIZE, kHiddenMetricConstant, emp::PUBLIC};
-    const emp::Integer kAnonymityLevel{
-        private_measurement::INT_SIZE, threshold, emp::PUBLIC};
-
-    for (auto& [key, value] : metrics->getAsMap()) {
-      findLiftThresholdConditionValidNodes(
-          value, kAnonymityLevel, hiddenMetric);
+    ThresholdBatch batch;
+    for (const auto& [key, value] : metrics->getAsMap()) {
+      findLiftThresholdConditionValidNodes(value, batch);
     }
+    applyThresholdBatch(batch, threshold);
   };
 }
 
 std::function<void(std::shared_ptr<AggMetrics>)>
 constructAdObjectFormatThresholdChecker(int64_t threshold) {
   return [threshold](std::shared_ptr<AggMetrics> metrics) {
-    const emp::Integer hiddenMetric{
-        INT_SIZE, kHiddenMetricConstant, emp::PUBLIC};
-    const emp::Integer kAnonymityLevel{
-        private_measurement::INT_SIZE, threshold, emp::PUBLIC};
-
+    ThresholdBatch batch;
     for (const auto& [rule, metricsMap] : metrics->getAsMap()) {
       for (const auto& [aggregationName, aggregationData] :
            metricsMap->getAsMap()) {
         for (const auto& [id, metrics] : aggregationData->getAsMap()) {
-          auto condition =
-              metrics->getAtKey("convs")->getEmpIntValue() >= kAnonymityLevel;
-          metrics->getAtKey("sales")->setEmpIntValue(emp::If(
-              condition,
-              metrics->getAtKey("sales")->getEmpIntValue(),
-              hiddenMetric));
-          metrics->getAtKey("convs")->setEmpIntValue(emp::If(
-              condition,
-              metrics->getAtKey("convs")->getEmpIntValue(),
-              hiddenMetric));
+          auto condition = batch.counts.size();
+          batch.counts.push_back(metrics->getAtKey("convs")->getEmpIntValue());
+          for (const auto& key : {"sales", "convs"}) {
+            batch.leaves.push_back(metrics->getAtKey(key));
+            batch.conditionIndices.push_back(condition);
+          }
         }
       }
     }
+    applyThresholdBatch(batch, threshold);
   };
 }
 } // namespace measurement::private_attribution
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include "AggMetrics.h"
+#include "AggMetricsThresholdCheckers.h"
+#include "fbpcs/emp_games/attribution/Constants.h"
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+using AggMetricsTag = private_measurement::AggMetricsTag;
+
+// An aggregated ad object output with convs and sales for numLeaves / 2 ids.
+// Every other id passes the threshold.
+std::shared_ptr<AggMetrics> getAdObjectMetrics(int64_t numLeaves) {
+  auto ids = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+  for (int64_t id = 0; id < numLeaves / 2; ++id) {
+    auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+    metrics->emplace(
+        "convs",
+        std::make_shared<AggMetrics>(
+            AggMetrics{emp::Integer{INT_SIZE, id % 2 ? 200 : 10, emp::ALICE}}));
+    metrics->emplace(
+        "sales",
+        std::make_shared<AggMetrics>(
+            AggMetrics{emp::Integer{INT_SIZE, id * 100, emp::ALICE}}));
+    ids->emplace(std::to_string(id), metrics);
+  }
+  auto rule = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+  rule->emplace("measurement", ids);
+  auto res = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+  res->emplace("last_click_1d", rule);
+  return res;
+}
+
+// The previous checker, which builds the circuit of each id as it walks the
+// tree
+void checkPerNode(std::shared_ptr<AggMetrics> metrics, int64_t threshold) {
+  const emp::Integer hiddenMetric{INT_SIZE, -1, emp::PUBLIC};
+  const emp::Integer kAnonymityLevel{INT_SIZE, threshold, emp::PUBLIC};
+  for (const auto& [rule, metricsMap] : metrics->getAsMap()) {
+    for (const auto& [aggregationName, aggregationData] :
+         metricsMap->getAsMap()) {
+      for (const auto& [id, m] : aggregationData->getAsMap()) {
+        auto condition =
+            m->getAtKey("convs")->getEmpIntValue() >= kAnonymityLevel;
+        for (const auto& key : {"sales", "convs"}) {
+          m->getAtKey(key)->setEmpIntValue(emp::If(
+              condition, m->getAtKey(key)->getEmpIntValue(), hiddenMetric));
+        }
+      }
+    }
+  }
+}
+
+void benchmarkChecker(
+    std::function<void(std::shared_ptr<AggMetrics>)> checker,
+    int64_t numLeaves) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [&checker, numLeaves](fbpcf::Party /* party */) {
+        checker(getAdObjectMetrics(numLeaves));
+      });
+}
+
+void runPerNode(int64_t numLeaves) {
+  benchmarkChecker(
+      [](std::shared_ptr<AggMetrics> metrics) { checkPerNode(metrics, 100); },
+      numLeaves);
+}
+
+void runBatched(int64_t numLeaves) {
+  benchmarkChecker(constructAdObjectFormatThresholdChecker(100), numLeaves);
+}
+
+// Both include building the tree of emp::Integers
+BENCHMARK(ThresholdChecker_PerNode_1k) {
+  runPerNode(1000);
+}
+
+BENCHMARK_RELATIVE(ThresholdChecker_Batched_1k) {
+  runBatched(1000);
+}
+
+BENCHMARK(ThresholdChecker_PerNode_10k) {
+  runPerNode(10000);
+}
+
+BENCHMARK_RELATIVE(ThresholdChecker_Batched_10k) {
+  runBatched(10000);
+}
+
+BENCHMARK(ThresholdChecker_PerNode_100k) {
+  runPerNode(100000);
+}
+
+BENCHMARK_RELATIVE(ThresholdChecker_Batched_100k) {
+  runBatched(100000);
+}
+
+BENCHMARK(ThresholdChecker_PerNode_1M) {
+  runPerNode(1000000);
+}
+
+BENCHMARK_RELATIVE(ThresholdChecker_Batched_1M) {
+  runBatched(1000000);
+}
+
+} // namespace measurement::private_attribution
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
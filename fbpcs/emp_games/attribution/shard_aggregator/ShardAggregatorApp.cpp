@@ -8,6 +8,7 @@
 #include "ShardAggregatorApp.h"
 
 #include <memory>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -18,20 +19,25 @@
 #include <folly/logging/xlog.h>
 #include "folly/Conv.h"
 
-#include <fbpcf/common/FunctionalUtil.h>
 #include <fbpcf/io/FileManagerUtil.h>
 #include <fbpcf/mpc/EmpGame.h>
 #include "AggMetrics.h"
+#include "AggMetricsShape.h"
 #include "ShardAggregatorGame.h"
-#include "ShardAggregatorValidation.h"
+#include "ShardStream.h"
 #include "fbpcs/emp_games/attribution/shard_aggregator/AggMetricsThresholdCheckers.h"
+#include "fbpcs/emp_games/common/EmpOperationUtil.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
 
 namespace measurement::private_attribution {
 using AggMetrics = private_measurement::AggMetrics;
 using AggMetricsTag = private_measurement::AggMetricsTag;
 
 void ShardAggregatorApp::run() {
-  auto inputData = getInputData();
+  // start reading the first shards while waiting for the other party
+  ShardStream shards{
+      getInputPaths(inputPath_, firstShardIndex_, numShards_),
+      metricsFormatType_};
 
   auto io = std::make_unique<emp::NetIO>(
       party_ == fbpcf::Party::Alice ? nullptr : serverIp_.c_str(),
@@ -52,12 +58,40 @@ void ShardAggregatorApp::run() {
                 << " passed to aggregator";
   }
 
-  ShardAggregatorGame game{
-      std::move(io), party_, thresholdChecker, visibility_};
-  auto encryptedResult = game.perfPlay(inputData);
+  // emp counts AND gates and sent bytes, but neither free gates nor received
+  // bytes, so those stay zero. The game owns the channel once it is built, so
+  // the sampler keeps a plain pointer to it.
+  std::unique_ptr<common::PhaseTracker> phaseTracker;
+  if (!phaseProfilePath_.empty()) {
+    phaseTracker = std::make_unique<common::PhaseTracker>([netIO = io.get()]() {
+      return common::SchedulerStatistics{
+          static_cast<uint64_t>(emp::CircuitExecution::circ_exec->num_and()),
+          0,
+          netIO->counter,
+          0};
+    });
+  }
 
+  ShardAggregatorGame game{
+      std::move(io),
+      party_,
+      thresholdChecker,
+      visibility_,
+      phaseTracker.get()};
+  auto encryptedResult =
+      game.playStreaming([&shards]() { return shards.next(); });
+
+  std::optional<common::ScopedPhase> phase;
+  phase.emplace(phaseTracker.get(), "reveal");
   auto result = revealMetrics(encryptedResult);
+  phase.emplace(phaseTracker.get(), "write_output");
   putOutputData(result);
+  phase.reset();
+
+  if (phaseTracker) {
+    auto profile = common::getPhaseProfile(phaseTracker->getPhases());
+    fbpcf::io::write(phaseProfilePath_, folly::toPrettyJson(profile));
+  }
 };
 
 std::vector<std::string> ShardAggregatorApp::getInputPaths(
@@ -75,17 +109,14 @@ std::vector<std::string> ShardAggregatorApp::getInputPaths(
 
 std::vector<std::shared_ptr<AggMetrics>> ShardAggregatorApp::getInputData() {
   XLOG(INFO) << "getting input data ...";
-  auto inputPaths = ShardAggregatorApp::getInputPaths(
-      inputPath_, firstShardIndex_, numShards_);
-
-  auto inputData =
-      fbpcf::functional::map<std::string, std::shared_ptr<AggMetrics>>(
-          inputPaths, [](const auto& inputPath) {
-            XLOG(INFO) << "Opening file at <" << inputPath << ">";
-            return std::make_shared<AggMetrics>(AggMetrics::fromDynamic(
-                folly::parseJson(fbpcf::io::read(inputPath))));
-          });
-  validateInputDataAggMetrics(inputData, metricsFormatType_);
+  ShardStream shards{
+      getInputPaths(inputPath_, firstShardIndex_, numShards_),
+      metricsFormatType_};
+
+  std::vector<std::shared_ptr<AggMetrics>> inputData;
+  while (auto shard = shards.next()) {
+    inputData.push_back(std::move(shard));
+  }
   return inputData;
 }
 
@@ -97,30 +128,11 @@ void ShardAggregatorApp::putOutputData(
 
 std::shared_ptr<AggMetrics> ShardAggregatorApp::revealMetrics(
     const std::shared_ptr<AggMetrics>& metrics) {
-  switch (metrics->getTag()) {
-    case AggMetricsTag::Map: {
-      auto revealedMetrics = std::make_shared<AggMetrics>(AggMetricsTag::Map);
-      for (const auto& [key, value] : metrics->getAsMap()) {
-        revealedMetrics->emplace(key, revealMetrics(value));
-      }
-      return revealedMetrics;
-    }
-    case AggMetricsTag::List: {
-      auto revealedMetrics = std::make_shared<AggMetrics>(AggMetricsTag::List);
-      for (const auto& m : metrics->getAsList()) {
-        revealedMetrics->pushBack(revealMetrics(m));
-      }
-      return revealedMetrics;
-    }
-    case AggMetricsTag::EmpInteger: {
-      return std::make_shared<AggMetrics>(
-          AggMetrics{metrics->getEmpIntValue().reveal<int64_t>(
-              static_cast<int32_t>(visibility_))});
-    }
-    default: {
-      XLOG(FATAL)
-          << "AggMetrics should only store a map, list, or emp::Integer at this point";
-    }
-  }
+  // reveal every leaf in a single round, then put the values back in place
+  private_measurement::AggMetricsShape shape{*metrics};
+  auto values = private_measurement::emp_utils::batchReveal(
+      private_measurement::flattenEmpIntValues(*metrics),
+      static_cast<int32_t>(visibility_));
+  return shape.toAggMetrics(values);
 }
 } // namespace measurement::private_attribution
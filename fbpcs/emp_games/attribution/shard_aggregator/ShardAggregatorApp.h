@@ -33,7 +33,8 @@ class ShardAggregatorApp
       int64_t threshold,
       const std::string& inputPath,
       const std::string& outputPath,
-      const std::string& metricsFormatType = "ad_object")
+      const std::string& metricsFormatType = "ad_object",
+      const std::string& phaseProfilePath = "")
       : fbpcf::EmpApp<
             ShardAggregatorGame<emp::NetIO>,
             std::vector<std::shared_ptr<private_measurement::AggMetrics>>,
@@ -45,7 +46,8 @@ class ShardAggregatorApp
         inputPath_{inputPath},
         outputPath_{outputPath},
         visibility_{visibility},
-        metricsFormatType_{metricsFormatType} {}
+        metricsFormatType_{metricsFormatType},
+        phaseProfilePath_{phaseProfilePath} {}
 
   void run() override;
 
@@ -71,5 +73,7 @@ class ShardAggregatorApp
   std::string outputPath_;
   fbpcf::Visibility visibility_;
   std::string metricsFormatType_;
+  // if not empty, the cost of every phase is written here as JSON
+  std::string phaseProfilePath_;
 };
 } // namespace measurement::private_attribution
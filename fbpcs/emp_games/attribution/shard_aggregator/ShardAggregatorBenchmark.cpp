@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include <gflags/gflags.h>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include <fbpcf/mpc/QueueIO.h>
+#include "AggMetrics.h"
+#include "AggMetricsShape.h"
+#include "ShardAggregatorGame.h"
+#include "fbpcs/emp_games/common/EmpOperationUtil.h"
+
+DEFINE_int64(num_shards, 1000, "Number of shards to aggregate");
+DEFINE_int64(num_leaves, 10000, "Number of metrics in each shard");
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+using AggMetricsTag = private_measurement::AggMetricsTag;
+
+// An ad object shard: ten metrics for each of num_leaves / 10 ad ids
+const std::vector<std::shared_ptr<AggMetrics>>& getShards() {
+  static const auto shards = []() {
+    auto shard = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+    for (int64_t adId = 0; adId < FLAGS_num_leaves / 10; ++adId) {
+      auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+      for (int64_t i = 0; i < 10; ++i) {
+        metrics->emplace(
+            "metric_" + std::to_string(i),
+            std::make_shared<AggMetrics>(AggMetrics{adId + i}));
+      }
+      shard->emplace(std::to_string(adId), metrics);
+    }
+    return std::vector<std::shared_ptr<AggMetrics>>(
+        FLAGS_num_shards, shard);
+  }();
+  return shards;
+}
+
+// The previous reconstruction, which inputs every leaf on its own
+std::shared_ptr<AggMetrics> reconstructPerLeaf(
+    const std::shared_ptr<AggMetrics>& metrics) {
+  switch (metrics->getTag()) {
+    case AggMetricsTag::Map: {
+      auto res = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+      for (const auto& [key, value] : metrics->getAsMap()) {
+        res->emplace(key, reconstructPerLeaf(value));
+      }
+      return res;
+    }
+    case AggMetricsTag::List: {
+      auto res = std::make_shared<AggMetrics>(AggMetricsTag::List);
+      for (const auto& m : metrics->getAsList()) {
+        res->pushBack(reconstructPerLeaf(m));
+      }
+      return res;
+    }
+    default: {
+      auto alice = emp::Integer{INT_SIZE, metrics->getIntValue(), emp::ALICE};
+      auto bob = emp::Integer{INT_SIZE, metrics->getIntValue(), emp::BOB};
+      return std::make_shared<AggMetrics>(AggMetrics{alice ^ bob});
+    }
+  }
+}
+
+// The previous reveal, with one round per leaf
+std::shared_ptr<AggMetrics> revealPerLeaf(
+    const std::shared_ptr<AggMetrics>& metrics) {
+  switch (metrics->getTag()) {
+    case AggMetricsTag::Map: {
+      auto res = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+      for (const auto& [key, value] : metrics->getAsMap()) {
+        res->emplace(key, revealPerLeaf(value));
+      }
+      return res;
+    }
+    case AggMetricsTag::List: {
+      auto res = std::make_shared<AggMetrics>(AggMetricsTag::List);
+      for (const auto& m : metrics->getAsList()) {
+        res->pushBack(revealPerLeaf(m));
+      }
+      return res;
+    }
+    default: {
+      return std::make_shared<AggMetrics>(
+          AggMetrics{metrics->getEmpIntValue().reveal<int64_t>(emp::PUBLIC)});
+    }
+  }
+}
+
+void runPerLeaf(fbpcf::Party /* party */) {
+  const auto& shards = getShards();
+  auto accumulator = reconstructPerLeaf(shards.at(0));
+  for (std::size_t i = 1; i < shards.size(); ++i) {
+    accumulator->mergeWithViaAddition(reconstructPerLeaf(shards.at(i)));
+  }
+  folly::doNotOptimizeAway(revealPerLeaf(accumulator));
+}
+
+void runBatched(fbpcf::Party /* party */) {
+  auto result = ShardAggregatorGame<fbpcf::QueueIO>::
+      applyReconstructAndAggregate(getShards());
+  private_measurement::AggMetricsShape shape{*result};
+  auto values = private_measurement::emp_utils::batchReveal(
+      private_measurement::flattenEmpIntValues(*result), emp::PUBLIC);
+  folly::doNotOptimizeAway(shape.toAggMetrics(values));
+}
+
+BENCHMARK(ShardAggregator_PerLeaf) {
+  BENCHMARK_SUSPEND {
+    getShards();
+  }
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      runPerLeaf);
+}
+
+BENCHMARK_RELATIVE(ShardAggregator_Batched) {
+  BENCHMARK_SUSPEND {
+    getShards();
+  }
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      runBatched);
+}
+
+} // namespace measurement::private_attribution
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
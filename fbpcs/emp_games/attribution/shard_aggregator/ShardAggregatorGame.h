@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <functional>
 #include <memory>
 #include <vector>
 
@@ -20,6 +21,9 @@
 #include "fbpcs/emp_games/attribution/Aggregator.h"
 #include "fbpcs/emp_games/attribution/AttributionMetrics.h"
 #include "fbpcs/emp_games/attribution/shard_aggregator/AggMetrics.h"
+#include "fbpcs/emp_games/attribution/shard_aggregator/AggMetricsShape.h"
+#include "fbpcs/emp_games/common/EmpOperationUtil.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
 
 namespace measurement::private_attribution {
 template <class IOChannel>
@@ -37,7 +41,8 @@ class ShardAggregatorGame
       std::optional<
           std::function<void(std::shared_ptr<private_measurement::AggMetrics>)>>
           thresholdChecker = std::nullopt,
-      fbpcf::Visibility visibility = fbpcf::Visibility::Public)
+      fbpcf::Visibility visibility = fbpcf::Visibility::Public,
+      common::PhaseTracker* phaseTracker = nullptr)
       : fbpcf::EmpGame<
             IOChannel,
             std::vector<std::shared_ptr<private_measurement::AggMetrics>>,
@@ -48,7 +53,8 @@ class ShardAggregatorGame
         visibility_{visibility},
         thresholdChecker_{thresholdChecker.value_or(
             [](std::shared_ptr<private_measurement::AggMetrics>
-                   metrics /* unused */) {})} {}
+                   metrics /* unused */) {})},
+        phaseTracker_{phaseTracker} {}
 
   static constexpr int64_t kHiddenMetricConstant = -1;
   static constexpr int64_t kAnonymityThreshold = 100;
@@ -56,55 +62,78 @@ class ShardAggregatorGame
   std::shared_ptr<private_measurement::AggMetrics> play(
       const vector<std::shared_ptr<private_measurement::AggMetrics>>& inputData)
       override {
-    vector<std::shared_ptr<private_measurement::AggMetrics>>
-        reconstructedMetrics;
-
-    // apply reconstruct function
-    for (const auto& metrics : inputData) {
-      reconstructedMetrics.push_back(applyReconstruct(metrics));
-    }
-
-    // aggregate everything
-    auto result = applyAggregate(reconstructedMetrics);
+    return playStreaming(getShardsFrom(inputData));
+  }
 
+  // Same as play, but takes the shards one at a time from getNextShard until
+  // it returns nullptr, so that they never all have to be in memory
+  std::shared_ptr<private_measurement::AggMetrics> playStreaming(
+      const std::function<std::shared_ptr<private_measurement::AggMetrics>()>&
+          getNextShard) {
+    // reconstruct and aggregate everything
+    std::optional<common::ScopedPhase> phase;
+    phase.emplace(phaseTracker_, "reconstruct_and_aggregate");
+    auto result = applyReconstructAndAggregate(getNextShard);
+
+    phase.emplace(phaseTracker_, "threshold_check");
     thresholdChecker_(result);
     return result;
   }
 
   std::shared_ptr<private_measurement::AggMetrics> applyReconstruct(
       const std::shared_ptr<private_measurement::AggMetrics>& metrics) const {
-    if (metrics->getTag() == private_measurement::AggMetricsTag::Map) {
-      // map stores keys in sorted order, so parties will access keys in the
-      // same order
-      auto reconstructedMetrics =
-          std::make_shared<private_measurement::AggMetrics>(
-              private_measurement::AggMetricsTag::Map);
-      for (const auto& [key, value] : metrics->getAsMap()) {
-        reconstructedMetrics->emplace(key, applyReconstruct(value));
-      }
-      return reconstructedMetrics;
-
-    } else if (metrics->getTag() == private_measurement::AggMetricsTag::List) {
-      auto reconstructedMetrics =
-          std::make_shared<private_measurement::AggMetrics>(
-              private_measurement::AggMetricsTag::List);
-      for (const auto& m : metrics->getAsList()) {
-        reconstructedMetrics->pushBack(applyReconstruct(m));
-      }
-      return reconstructedMetrics;
+    private_measurement::AggMetricsShape shape{*metrics};
+    return shape.toAggMetrics(reconstructValues(*metrics));
+  }
 
-    } else if (
-        metrics->getTag() == private_measurement::AggMetricsTag::Integer) {
-      // XOR the integers
-      auto alice = emp::Integer{INT_SIZE, metrics->getIntValue(), emp::ALICE};
-      auto bob = emp::Integer{INT_SIZE, metrics->getIntValue(), emp::BOB};
+  static std::shared_ptr<private_measurement::AggMetrics>
+  applyReconstructAndAggregate(
+      const std::vector<std::shared_ptr<private_measurement::AggMetrics>>&
+          metricsVector) {
+    return applyReconstructAndAggregate(getShardsFrom(metricsVector));
+  }
+
+  // Same result as applyReconstruct on every shard followed by
+  // applyAggregate, but works on the flattened leaves instead of walking the
+  // trees: each shard is reconstructed with one batched input per party, and
+  // its leaves are added straight into the leaves of the result. Only the
+  // current shard and the sums are held at any time.
+  static std::shared_ptr<private_measurement::AggMetrics>
+  applyReconstructAndAggregate(
+      const std::function<std::shared_ptr<private_measurement::AggMetrics>()>&
+          getNextShard) {
+    auto metrics = getNextShard();
+    if (metrics == nullptr) {
       return std::make_shared<private_measurement::AggMetrics>(
-          private_measurement::AggMetrics{alice ^ bob});
+          private_measurement::AggMetrics{
+              private_measurement::AggMetricsTag::Map});
+    }
 
-    } else {
-      XLOG(FATAL)
-          << "AggMetrics should only store a map, list, or int at this point";
+    // both parties hold shares of trees with the same structures in the same
+    // order, so they build the same shape for the result. Leaves first seen
+    // in a later shard are numbered after the existing ones.
+    private_measurement::AggMetricsShape shape{*metrics};
+    // like applyAggregate, the first shard with a leaf is its accumulator
+    std::vector<emp::Integer> sums;
+    std::vector<bool> hasSum;
+    for (; metrics != nullptr; metrics = getNextShard()) {
+      shape.mergeWith(*metrics);
+      sums.resize(shape.numLeaves());
+      hasSum.resize(shape.numLeaves(), false);
+
+      auto values = reconstructValues(*metrics);
+      auto indices = shape.getLeafIndices(*metrics);
+      for (std::size_t i = 0; i < values.size(); ++i) {
+        auto leaf = indices.at(i);
+        if (hasSum.at(leaf)) {
+          sums.at(leaf) = sums.at(leaf) + values.at(i);
+        } else {
+          sums.at(leaf) = std::move(values.at(i));
+          hasSum.at(leaf) = true;
+        }
+      }
     }
+    return shape.toAggMetrics(sums);
   }
 
   // uses the first metrics object as the accumulator
@@ -125,8 +154,35 @@ class ShardAggregatorGame
   }
 
  private:
+  // hands out the shards of a vector in order, then nullptr
+  static std::function<std::shared_ptr<private_measurement::AggMetrics>()>
+  getShardsFrom(
+      const std::vector<std::shared_ptr<private_measurement::AggMetrics>>&
+          metricsVector) {
+    return [&metricsVector, next = std::size_t{0}]() mutable
+           -> std::shared_ptr<private_measurement::AggMetrics> {
+      if (next < metricsVector.size()) {
+        return metricsVector.at(next++);
+      }
+      return nullptr;
+    };
+  }
+
+  // XOR both parties' shares of every leaf of a tree, in pre-order
+  static std::vector<emp::Integer> reconstructValues(
+      const private_measurement::AggMetrics& metrics) {
+    auto values = private_measurement::flattenIntValues(metrics);
+    auto alice = private_measurement::emp_utils::batchInput(values, emp::ALICE);
+    auto bob = private_measurement::emp_utils::batchInput(values, emp::BOB);
+    for (std::size_t i = 0; i < values.size(); ++i) {
+      alice.at(i) = alice.at(i) ^ bob.at(i);
+    }
+    return alice;
+  }
+
   fbpcf::Visibility visibility_;
   std::function<void(std::shared_ptr<private_measurement::AggMetrics>)>
       thresholdChecker_;
+  common::PhaseTracker* phaseTracker_;
 };
 } // namespace measurement::private_attribution
@@ -210,6 +210,33 @@ TEST_F(ShardAggregatorGameTest, TestPlayLift) {
   runPlayTest(aliceInput, bobInput, constructLiftThresholdChecker(100), 1);
 }
 
+TEST_F(ShardAggregatorGameTest, TestPlayStreamingLift) {
+  std::vector<std::shared_ptr<AggMetrics>> aliceInput;
+  std::vector<std::shared_ptr<AggMetrics>> bobInput;
+  for (const auto& i : {"0", "1", "2"}) {
+    aliceInput.push_back(
+        outputAggMetricsObjFromPath(std::string{"lift/aggregator_alice_"} + i));
+    bobInput.push_back(
+        outputAggMetricsObjFromPath(std::string{"lift/aggregator_bob_"} + i));
+  }
+
+  auto lambda = [](std::vector<std::shared_ptr<AggMetrics>> input,
+                   ShardAggregatorGame<fbpcf::QueueIO>& game) {
+    std::size_t next = 0;
+    return game.playStreaming(
+        [&input, &next]() -> std::shared_ptr<AggMetrics> {
+          return next < input.size() ? input.at(next++) : nullptr;
+        });
+  };
+
+  auto result = runGameFunctionTest<std::vector<std::shared_ptr<AggMetrics>>>(
+      lambda, aliceInput, bobInput, placeholderThresholdChecker_);
+
+  // the shard with the most cohorts has the structure of the result
+  assertSameStructure(result.first, aliceInput.at(1));
+  assertSameStructure(result.second, bobInput.at(1));
+}
+
 TEST_F(ShardAggregatorGameTest, TestPlayGeneric) {
   const std::vector<std::string> aliceInput = {
       "test_new_parser/simple_map.json",
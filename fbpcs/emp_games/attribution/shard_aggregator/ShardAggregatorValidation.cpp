@@ -7,10 +7,20 @@
 
 #include "ShardAggregatorValidation.h"
 
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
 #include <set>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include <fbpcf/common/FunctionalUtil.h>
+#include <folly/Format.h>
 #include <folly/dynamic.h>
 #include <folly/logging/xlog.h>
 #include <stdexcept>
@@ -78,6 +88,353 @@ void validateLiftMetrics(
         groupedLiftMetrics->getAtKey("metrics"), "metrics should map to a map");
   }
 }
+
+// The structure that shards of a metrics format must have, compiled once and
+// checked while a shard is parsed. Messages may contain "{}", which is
+// replaced by the key of the value being checked.
+struct ShardSchema {
+  // if set, the value must be a map
+  std::optional<std::string> notMapMessage;
+  // if set, the map must not be empty
+  std::optional<std::string> emptyMessage;
+  // keys the map must have, and the message if one is missing
+  std::vector<std::pair<std::string, std::string>> requiredKeys;
+  // if not empty, the only keys the map may have
+  std::set<std::string> allowedKeys;
+  std::string unexpectedKeyMessage;
+  // the schema of the values of specific keys, then of every other key. A
+  // null schema accepts anything.
+  std::map<std::string, std::shared_ptr<const ShardSchema>> keySchemas;
+  std::shared_ptr<const ShardSchema> valueSchema;
+
+  const ShardSchema* getChild(const std::string& key) const {
+    auto it = keySchemas.find(key);
+    return it != keySchemas.end() ? it->second.get() : valueSchema.get();
+  }
+};
+
+std::string formatMessage(std::string message, const std::string& key) {
+  auto pos = message.find("{}");
+  if (pos != std::string::npos) {
+    message.replace(pos, 2, key);
+  }
+  return message;
+}
+
+// the same checks as validateAdObjectFormatMetrics
+std::shared_ptr<const ShardSchema> compileAdObjectFormatSchema() {
+  auto aggregationData = std::make_shared<ShardSchema>();
+  aggregationData->notMapMessage = "Aggregation data should be a map";
+
+  auto rule = std::make_shared<ShardSchema>();
+  rule->notMapMessage = "Rule [{}] does not map to a map";
+  rule->emptyMessage = "Rule [{}] does not map to any metrics";
+  rule->allowedKeys = {"measurement"};
+  rule->unexpectedKeyMessage =
+      "Unsupported aggregationName [{}] passed to Shard Aggregator";
+  rule->valueSchema = aggregationData;
+
+  auto root = std::make_shared<ShardSchema>();
+  root->notMapMessage = "Expected rules to be stored in a map";
+  root->emptyMessage = "Map contains no rules";
+  root->valueSchema = rule;
+  return root;
+}
+
+// the same checks as validateLiftMetrics
+std::shared_ptr<const ShardSchema> compileLiftSchema() {
+  auto metrics = std::make_shared<ShardSchema>();
+  metrics->notMapMessage = "metrics should map to a map";
+
+  auto root = std::make_shared<ShardSchema>();
+  root->notMapMessage = "Expected grouped lift metrics to be stored in a map";
+  root->requiredKeys = {
+      {"metrics", "Map should contain 'metrics' at a minimum"}};
+  root->keySchemas = {{"metrics", metrics}};
+  return root;
+}
+
+const ShardSchema& getShardSchema(const std::string& metricsFormatType) {
+  static const std::map<std::string, std::shared_ptr<const ShardSchema>>
+      schemas = {
+          {"ad_object", compileAdObjectFormatSchema()},
+          {"lift", compileLiftSchema()},
+      };
+  auto it = schemas.find(metricsFormatType);
+  if (it == schemas.end()) {
+    throw std::runtime_error(folly::sformat(
+        "Unsupported format type {} passed to aggregator", metricsFormatType));
+  }
+  return *it->second;
+}
+
+// A recursive descent JSON parser which builds AggMetrics directly, and
+// checks every map against its schema as soon as the map is complete
+class ShardParser {
+ public:
+  explicit ShardParser(std::string_view json) : json_{json} {}
+
+  std::shared_ptr<AggMetrics> parse(const ShardSchema* schema) {
+    auto metrics = parseValue(schema, "");
+    skipWhitespace();
+    if (pos_ != json_.size()) {
+      fail("unexpected trailing characters");
+    }
+    return metrics;
+  }
+
+ private:
+  std::shared_ptr<AggMetrics> parseValue(
+      const ShardSchema* schema,
+      const std::string& key) {
+    skipWhitespace();
+    auto c = peek();
+    if (schema != nullptr && schema->notMapMessage.has_value() && c != '{') {
+      throw InvalidFormatException(formatMessage(*schema->notMapMessage, key));
+    }
+
+    if (c == '{') {
+      return parseMap(schema, key);
+    } else if (c == '[') {
+      return parseList();
+    } else if (c == '-' || std::isdigit(static_cast<unsigned char>(c))) {
+      return parseInt();
+    } else if (c == '"' || c == 't' || c == 'f' || c == 'n') {
+      throw InvalidFormatException("Metric values should be integers");
+    }
+    fail("unexpected character");
+  }
+
+  std::shared_ptr<AggMetrics> parseMap(
+      const ShardSchema* schema,
+      const std::string& mapKey) {
+    expect('{');
+    auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::Map);
+    skipWhitespace();
+    if (peek() == '}') {
+      ++pos_;
+    } else {
+      while (true) {
+        skipWhitespace();
+        auto key = parseString();
+        if (schema != nullptr && !schema->allowedKeys.empty() &&
+            schema->allowedKeys.count(key) == 0) {
+          throw InvalidFormatException(
+              formatMessage(schema->unexpectedKeyMessage, key));
+        }
+        skipWhitespace();
+        expect(':');
+        auto value = parseValue(
+            schema != nullptr ? schema->getChild(key) : nullptr, key);
+        if (metrics->getAsMap().count(key) > 0) {
+          throw InvalidFormatException(
+              folly::sformat("Duplicate key [{}] in map", key));
+        }
+        metrics->emplace(key, std::move(value));
+
+        skipWhitespace();
+        if (peek() == ',') {
+          ++pos_;
+        } else {
+          expect('}');
+          break;
+        }
+      }
+    }
+
+    if (schema != nullptr) {
+      if (schema->emptyMessage.has_value() && metrics->getAsMap().empty()) {
+        throw InvalidFormatException(
+            formatMessage(*schema->emptyMessage, mapKey));
+      }
+      for (const auto& [requiredKey, message] : schema->requiredKeys) {
+        if (metrics->getAsMap().count(requiredKey) == 0) {
+          throw InvalidFormatException(formatMessage(message, mapKey));
+        }
+      }
+    }
+    return metrics;
+  }
+
+  std::shared_ptr<AggMetrics> parseList() {
+    expect('[');
+    auto metrics = std::make_shared<AggMetrics>(AggMetricsTag::List);
+    skipWhitespace();
+    if (peek() == ']') {
+      ++pos_;
+      return metrics;
+    }
+    while (true) {
+      metrics->pushBack(parseValue(nullptr, ""));
+      skipWhitespace();
+      if (peek() == ',') {
+        ++pos_;
+      } else {
+        expect(']');
+        return metrics;
+      }
+    }
+  }
+
+  std::shared_ptr<AggMetrics> parseInt() {
+    auto start = pos_;
+    if (peek() == '-') {
+      ++pos_;
+    }
+    while (pos_ < json_.size() &&
+           std::isdigit(static_cast<unsigned char>(json_[pos_]))) {
+      ++pos_;
+    }
+    if (pos_ < json_.size() &&
+        (json_[pos_] == '.' || json_[pos_] == 'e' || json_[pos_] == 'E')) {
+      throw InvalidFormatException("Metric values should be integers");
+    }
+
+    int64_t value;
+    auto first = json_.data() + start;
+    auto last = json_.data() + pos_;
+    auto [ptr, ec] = std::from_chars(first, last, value);
+    if (ec == std::errc::result_out_of_range) {
+      throw InvalidFormatException("Metric values should be integers");
+    } else if (ec != std::errc{} || ptr != last) {
+      pos_ = start;
+      fail("invalid number");
+    }
+    return std::make_shared<AggMetrics>(AggMetrics{value});
+  }
+
+  std::string parseString() {
+    expect('"');
+    std::string res;
+    while (true) {
+      auto c = next();
+      if (c == '"') {
+        return res;
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        fail("control character in string");
+      } else if (c != '\\') {
+        res.push_back(c);
+        continue;
+      }
+
+      auto escaped = next();
+      switch (escaped) {
+        case '"':
+        case '\\':
+        case '/':
+          res.push_back(escaped);
+          break;
+        case 'b':
+          res.push_back('\b');
+          break;
+        case 'f':
+          res.push_back('\f');
+          break;
+        case 'n':
+          res.push_back('\n');
+          break;
+        case 'r':
+          res.push_back('\r');
+          break;
+        case 't':
+          res.push_back('\t');
+          break;
+        case 'u':
+          appendUtf8(res, parseCodePoint());
+          break;
+        default:
+          fail("invalid escape sequence");
+      }
+    }
+  }
+
+  // parses the hex digits after a \u, and the low half of a surrogate pair
+  uint32_t parseCodePoint() {
+    auto codePoint = parseHex4();
+    if (codePoint >= 0xD800 && codePoint < 0xDC00) {
+      expect('\\');
+      expect('u');
+      auto low = parseHex4();
+      if (low < 0xDC00 || low >= 0xE000) {
+        fail("invalid surrogate pair");
+      }
+      codePoint = 0x10000 + ((codePoint - 0xD800) << 10) + (low - 0xDC00);
+    }
+    return codePoint;
+  }
+
+  uint32_t parseHex4() {
+    uint32_t res = 0;
+    for (int i = 0; i < 4; ++i) {
+      auto c = next();
+      res <<= 4;
+      if (c >= '0' && c <= '9') {
+        res |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        res |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        res |= c - 'A' + 10;
+      } else {
+        fail("invalid unicode escape");
+      }
+    }
+    return res;
+  }
+
+  static void appendUtf8(std::string& out, uint32_t codePoint) {
+    if (codePoint < 0x80) {
+      out.push_back(static_cast<char>(codePoint));
+    } else if (codePoint < 0x800) {
+      out.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else if (codePoint < 0x10000) {
+      out.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    } else {
+      out.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+      out.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+  }
+
+  void skipWhitespace() {
+    while (pos_ < json_.size() &&
+           (json_[pos_] == ' ' || json_[pos_] == '\n' ||
+            json_[pos_] == '\r' || json_[pos_] == '\t')) {
+      ++pos_;
+    }
+  }
+
+  char peek() {
+    if (pos_ >= json_.size()) {
+      fail("unexpected end of input");
+    }
+    return json_[pos_];
+  }
+
+  char next() {
+    auto c = peek();
+    ++pos_;
+    return c;
+  }
+
+  void expect(char c) {
+    if (next() != c) {
+      --pos_;
+      fail(folly::sformat("expected '{}'", c));
+    }
+  }
+
+  [[noreturn]] void fail(const std::string& what) {
+    throw InvalidFormatException(
+        folly::sformat("Invalid JSON at offset {}: {}", pos_, what));
+  }
+
+  std::string_view json_;
+  std::size_t pos_ = 0;
+};
 } // namespace
 
 namespace measurement::private_attribution {
@@ -99,4 +456,11 @@ void validateInputDataAggMetrics(
         "Unsupported format type {} passed to aggregator", metricsFormatType));
   }
 }
+
+std::shared_ptr<AggMetrics> parseAndValidateShard(
+    std::string_view json,
+    const std::string& metricsFormatType) {
+  const auto& schema = getShardSchema(metricsFormatType);
+  return ShardParser{json}.parse(&schema);
+}
 } // namespace measurement::private_attribution
@@ -8,6 +8,9 @@
 #pragma once
 
 #include <folly/dynamic.h>
+#include <memory>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include "AggMetrics.h"
@@ -23,4 +26,12 @@ void validateInputDataAggMetrics(
     const std::vector<std::shared_ptr<private_measurement::AggMetrics>>&
         inputData,
     const std::string& metricsFormatType);
+
+// Parses the JSON of a shard straight into AggMetrics, checking it against
+// the metrics format in the same pass instead of building a folly::dynamic
+// and walking the tree again. Throws InvalidFormatException as soon as a
+// value does not fit the format, before the rest of the shard is parsed.
+std::shared_ptr<private_measurement::AggMetrics> parseAndValidateShard(
+    std::string_view json,
+    const std::string& metricsFormatType);
 } // namespace measurement::private_attribution
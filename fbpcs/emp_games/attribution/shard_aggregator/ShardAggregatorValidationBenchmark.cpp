@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/Format.h>
+#include <folly/json.h>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "AggMetrics.h"
+#include "ShardAggregatorValidation.h"
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+
+// 64 MiB of ad object shard JSON, so the time per GB is 16 times the time
+// of one iteration
+constexpr std::size_t kShardBytes = 64 << 20;
+
+const std::string& getShardJson() {
+  static const std::string json = []() {
+    std::string res = R"({"last_click_1d": {"measurement": {)";
+    for (int64_t id = 0; res.size() < kShardBytes; ++id) {
+      res += (id == 0 ? "" : ", ") + folly::sformat(
+          R"("{}": {{"convs": {}, "sales": {}}})",
+          id,
+          -831273128088263600 + id,
+          339959610281870460 - id);
+    }
+    return res + "}}}";
+  }();
+  return json;
+}
+
+BENCHMARK(ParseJsonThenValidate, iters) {
+  BENCHMARK_SUSPEND {
+    getShardJson();
+  }
+  for (std::size_t i = 0; i < iters; ++i) {
+    auto shard = std::make_shared<AggMetrics>(
+        AggMetrics::fromDynamic(folly::parseJson(getShardJson())));
+    validateInputDataAggMetrics({shard}, "ad_object");
+    folly::doNotOptimizeAway(shard);
+  }
+}
+
+BENCHMARK_RELATIVE(ParseAndValidateShard, iters) {
+  BENCHMARK_SUSPEND {
+    getShardJson();
+  }
+  for (std::size_t i = 0; i < iters; ++i) {
+    auto shard = parseAndValidateShard(getShardJson(), "ad_object");
+    folly::doNotOptimizeAway(shard);
+  }
+}
+
+} // namespace measurement::private_attribution
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -6,6 +6,8 @@
  */
 
 #include <map>
+#include <string>
+#include <utility>
 #include <vector>
 
 #include <folly/dynamic.h>
@@ -163,4 +165,66 @@ TEST_F(ShardAggregatorValidationTest, LiftTestValidInputEmptyCohortMetrics) {
 
   validateInputDataAggMetrics(validData, "lift");
 }
+
+// Tests for validating while parsing
+using FileAndFormat = std::pair<std::string, std::string>;
+
+TEST_F(ShardAggregatorValidationTest, ParseAndValidateSameAsParseJson) {
+  for (const auto& [file, format] : std::vector<FileAndFormat>{
+           {"valid_measurement_shard.json", "ad_object"},
+           {"valid_lift_input.json", "lift"},
+           {"valid_lift_no_cohort_metrics.json", "lift"},
+       }) {
+    auto json = fbpcf::io::read(baseDir_ + file);
+    auto metrics = parseAndValidateShard(json, format);
+    EXPECT_EQ(metrics->toDynamic(), folly::parseJson(json));
+  }
+}
+
+TEST_F(ShardAggregatorValidationTest, ParseAndValidateInvalidShards) {
+  for (const auto& [file, format] : std::vector<FileAndFormat>{
+           {"invalid_pcm_shard.json", "ad_object"},
+           {"valid_lift_input.json", "ad_object"},
+           {"invalid_bad_structure.json", "ad_object"},
+           {"invalid_empty_map_0.json", "ad_object"},
+           {"invalid_empty_map_1.json", "ad_object"},
+           {"invalid_aggregation_name.json", "ad_object"},
+           {"valid_measurement_shard.json", "lift"},
+           {"invalid_empty_map_0.json", "lift"},
+       }) {
+    EXPECT_THROW(
+        parseAndValidateShard(fbpcf::io::read(baseDir_ + file), format),
+        InvalidFormatException);
+  }
+}
+
+TEST_F(ShardAggregatorValidationTest, ParseAndValidateRejectsEarly) {
+  // the shard is rejected at the unsupported aggregation, before the
+  // malformed JSON after it is reached
+  try {
+    parseAndValidateShard(R"({"rule": {"pcm": {"1": 2}}, "x)", "ad_object");
+    FAIL() << "Expected InvalidFormatException";
+  } catch (const InvalidFormatException& e) {
+    EXPECT_EQ(
+        std::string{e.what()},
+        "Unsupported aggregationName [pcm] passed to Shard Aggregator");
+  }
+}
+
+TEST_F(ShardAggregatorValidationTest, ParseAndValidateMalformedJson) {
+  for (const auto& json : {
+           R"({"rule": {"measurement": {"1": 1.5}}})",
+           R"({"rule": {"measurement": {"1": "2"}}})",
+           R"({"rule": {"measurement": {"1": 99999999999999999999}}})",
+           R"({"rule": {"measurement": {"1": [1 2]}}})",
+           R"({"rule": {"measurement": {"1": 1, "1": 2}}})",
+           R"({"rule": {"measurement": {}}} {})",
+           R"({"rule": {"measurement": {})",
+           "",
+       }) {
+    EXPECT_THROW(
+        parseAndValidateShard(json, "ad_object"), InvalidFormatException);
+  }
+  EXPECT_THROW(parseAndValidateShard("{}", "unknown"), std::runtime_error);
+}
 } // namespace measurement::private_attribution
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcs/emp_games/attribution/shard_aggregator/ShardStream.h"
+
+#include <algorithm>
+#include <thread>
+#include <utility>
+
+#include <folly/logging/xlog.h>
+
+#include <fbpcf/io/FileManagerUtil.h>
+#include "fbpcs/emp_games/attribution/shard_aggregator/ShardAggregatorValidation.h"
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+
+ShardStream::ShardStream(
+    std::vector<std::string> inputPaths,
+    std::string metricsFormatType,
+    std::size_t maxPending)
+    : inputPaths_{std::move(inputPaths)},
+      metricsFormatType_{std::move(metricsFormatType)},
+      maxPending_{
+          maxPending > 0 ? maxPending
+                         : std::max(1U, std::thread::hardware_concurrency())} {
+  if (inputPaths_.empty()) {
+    throw InvalidFormatException("Input is empty");
+  }
+  while (pending_.size() < maxPending_ && numStarted_ < inputPaths_.size()) {
+    startNext();
+  }
+}
+
+std::shared_ptr<AggMetrics> ShardStream::next() {
+  if (pending_.empty()) {
+    return nullptr;
+  }
+  auto shard = pending_.front().get();
+  pending_.pop_front();
+  if (numStarted_ < inputPaths_.size()) {
+    startNext();
+  }
+  return shard;
+}
+
+void ShardStream::startNext() {
+  pending_.push_back(std::async(
+      std::launch::async,
+      [](const std::string& inputPath, const std::string& metricsFormatType) {
+        XLOG(INFO) << "Opening file at <" << inputPath << ">";
+        return parseAndValidateShard(
+            fbpcf::io::read(inputPath), metricsFormatType);
+      },
+      inputPaths_.at(numStarted_++),
+      metricsFormatType_));
+}
+} // namespace measurement::private_attribution
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <future>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fbpcs/emp_games/attribution/shard_aggregator/AggMetrics.h"
+
+namespace measurement::private_attribution {
+/*
+ * Reads, parses and validates shards on background threads ahead of the
+ * game, and hands them out in shard order. Parsing the next shards overlaps
+ * with the secure computation on the current one, and at most maxPending
+ * shards are held in memory at any time instead of all of them.
+ *
+ * Both parties must consume their shards in the same order, which is the
+ * order of inputPaths.
+ */
+class ShardStream {
+ public:
+  // maxPending = 0 means one shard per hardware thread
+  ShardStream(
+      std::vector<std::string> inputPaths,
+      std::string metricsFormatType,
+      std::size_t maxPending = 0);
+
+  // returns the next shard, or nullptr after the last one. Throws
+  // InvalidFormatException if the shard is not valid for the format.
+  std::shared_ptr<private_measurement::AggMetrics> next();
+
+ private:
+  void startNext();
+
+  std::vector<std::string> inputPaths_;
+  std::string metricsFormatType_;
+  std::size_t maxPending_;
+  std::size_t numStarted_ = 0;
+  std::deque<std::future<std::shared_ptr<private_measurement::AggMetrics>>>
+      pending_;
+};
+} // namespace measurement::private_attribution
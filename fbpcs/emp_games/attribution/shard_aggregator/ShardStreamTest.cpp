@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <folly/json.h>
+#include <gtest/gtest.h>
+
+#include <fbpcf/io/FileManagerUtil.h>
+#include "../../common/TestUtil.h"
+#include "AggMetrics.h"
+#include "ShardAggregatorValidation.h"
+#include "ShardStream.h"
+
+namespace measurement::private_attribution {
+using AggMetrics = private_measurement::AggMetrics;
+
+class ShardStreamTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    baseDir_ =
+        private_measurement::test_util::getBaseDirFromPath(__FILE__) + "test/";
+  }
+
+  std::vector<std::string> getAdObjectPaths(int32_t numShards) {
+    std::vector<std::string> paths;
+    for (int32_t i = 0; i < numShards; ++i) {
+      paths.push_back(
+          baseDir_ + "ad_object_format/publisher_attribution_out.json_" +
+          std::to_string(i % 2));
+    }
+    return paths;
+  }
+
+  std::string baseDir_;
+};
+
+TEST_F(ShardStreamTest, TestShardsInOrder) {
+  auto paths = getAdObjectPaths(5);
+  // fewer pending shards than there are shards, and more
+  for (std::size_t maxPending : {1, 2, 8}) {
+    ShardStream shards{paths, "ad_object", maxPending};
+    for (const auto& path : paths) {
+      auto shard = shards.next();
+      ASSERT_NE(shard, nullptr);
+      EXPECT_EQ(shard->toDynamic(), folly::parseJson(fbpcf::io::read(path)));
+    }
+    EXPECT_EQ(shards.next(), nullptr);
+    EXPECT_EQ(shards.next(), nullptr);
+  }
+}
+
+TEST_F(ShardStreamTest, TestInvalidShard) {
+  auto paths = getAdObjectPaths(2);
+  paths.push_back(
+      baseDir_ + "shard_validation_test/invalid_aggregation_name.json");
+  ShardStream shards{paths, "ad_object", 1};
+  EXPECT_NE(shards.next(), nullptr);
+  EXPECT_NE(shards.next(), nullptr);
+  EXPECT_THROW(shards.next(), InvalidFormatException);
+}
+
+TEST_F(ShardStreamTest, TestEmptyInput) {
+  EXPECT_THROW(ShardStream({}, "ad_object"), InvalidFormatException);
+}
+} // namespace measurement::private_attribution
@@ -43,6 +43,14 @@ DEFINE_bool(
     log_cost,
     false,
     "Log cost info into cloud which will be used for dashboard");
+DEFINE_string(
+    phase_profile_path,
+    "",
+    "If set, write the gates, traffic and time of every game phase as JSON to this path");
+DEFINE_int32(
+    resource_sampling_interval_ms,
+    0,
+    "If positive, sample CPU, memory, I/O, network and threads at this interval and log the timeline with the cost info");
 
 int main(int argc, char* argv[]) {
   fbpcs::performance_tools::CostEstimation cost{"shard_aggregator"};
@@ -51,6 +59,8 @@ int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   fbpcf::AwsSdk::aquire();
+  cost.startResourceSampling(
+      std::chrono::milliseconds{FLAGS_resource_sampling_interval_ms});
 
   XLOGF(INFO, "Party: {}", FLAGS_party);
   XLOGF(INFO, "Visibility: {}", FLAGS_visibility);
@@ -66,6 +76,7 @@ int main(int argc, char* argv[]) {
   auto party = static_cast<fbpcf::Party>(FLAGS_party);
   auto visibility = static_cast<fbpcf::Visibility>(FLAGS_visibility);
 
+  cost.markPhase("run_game");
   try {
     measurement::private_attribution::ShardAggregatorApp(
         party,
@@ -77,7 +88,8 @@ int main(int argc, char* argv[]) {
         FLAGS_threshold,
         FLAGS_input_base_path,
         FLAGS_output_path,
-        FLAGS_metrics_format_type)
+        FLAGS_metrics_format_type,
+        FLAGS_phase_profile_path)
         .run();
   } catch (const fbpcf::ExceptionBase& e) {
     XLOGF(ERR, "Some error occurred: {}", e.what());
@@ -92,6 +104,7 @@ int main(int argc, char* argv[]) {
       "Aggregation is completed. Please find the metrics at {}",
       FLAGS_output_path);
 
+  cost.markPhase("finish");
   cost.end();
   XLOG(INFO) << cost.getEstimatedCostString();
   if (FLAGS_log_cost) {
@@ -7,11 +7,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <numeric>
 #include <vector>
 
 #include <emp-sh2pc/emp-sh2pc.h>
 
+#include "PrivateData.h"
+
 namespace private_measurement::emp_utils {
 
 // Converts a vector of emp::Integers to emp::Bits.
@@ -33,10 +38,41 @@ const int64_t sum(const std::vector<emp::Integer>& in);
 template <int TO = emp::PUBLIC>
 const int64_t sum(const std::vector<emp::Bit>& in);
 
+// Reveals a sum computed by secretSum
+// Supports 32 bit and 64 bit sums
+template <int TO = emp::PUBLIC>
+const int64_t revealSum(const emp::Integer& sum);
+
 // Sum operations that do *not* call reveal at the end
+// Integers are added pairwise in a tree, at the width of the inputs.
 emp::Integer secretSum(const std::vector<emp::Integer>& in);
+// Bits are counted with an adder tree that starts from 1-bit integers and
+// grows the width by one bit per level, so that summing N bits takes about 2N
+// AND gates instead of a 64-bit mux and adder per bit. The result is INT_SIZE
+// bits wide.
 emp::Integer secretSum(const std::vector<emp::Bit>& in);
 
+// Adds two unsigned integers of the same width into an integer one bit wider,
+// so that the sum never overflows
+emp::Integer addWithCarry(emp::Integer a, emp::Integer b);
+
+// Inputs every value as an emp::Integer of bitLen bits from the given party,
+// with a single call into the protocol instead of one per value. For the
+// evaluator this is one oblivious transfer round for the whole batch. The
+// other party must call this with the same number of values, which it may
+// fill with anything.
+std::vector<emp::Integer> batchInput(
+    const std::vector<int64_t>& in,
+    int party,
+    int32_t bitLen = INT_SIZE);
+
+// Reveals every integer to the given party (or emp::PUBLIC / emp::XOR) in a
+// single round, instead of one round per integer. Integers narrower than 64
+// bits are sign extended.
+std::vector<int64_t> batchReveal(
+    const std::vector<emp::Integer>& in,
+    int party);
+
 // Computes and returns the minimum between two emp::Integer values
 const emp::Integer getMin(emp::Integer value1, emp::Integer value2);
 
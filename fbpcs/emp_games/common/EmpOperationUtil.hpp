@@ -36,6 +36,62 @@ inline const std::vector<emp::Integer> bitsToInts(
   return ints;
 }
 
+inline std::vector<emp::Integer>
+batchInput(const std::vector<int64_t>& in, int party, int32_t bitLen) {
+  auto numBits = in.size() * bitLen;
+  // The bits of every value back to back, least significant first like
+  // emp::Integer
+  std::unique_ptr<bool[]> plaintext{new bool[numBits]};
+  for (size_t i = 0; i < in.size(); ++i) {
+    for (int32_t j = 0; j < bitLen; ++j) {
+      plaintext[i * bitLen + j] = (in[i] >> std::min(j, 63)) & 1;
+    }
+  }
+  std::vector<emp::block> labels(numBits);
+  emp::ProtocolExecution::prot_exec->feed(
+      labels.data(), party, plaintext.get(), numBits);
+
+  std::vector<emp::Integer> res(in.size());
+  for (size_t i = 0; i < in.size(); ++i) {
+    res[i].bits.reserve(bitLen);
+    for (int32_t j = 0; j < bitLen; ++j) {
+      res[i].bits.emplace_back(labels[i * bitLen + j]);
+    }
+  }
+  return res;
+}
+
+inline std::vector<int64_t> batchReveal(
+    const std::vector<emp::Integer>& in,
+    int party) {
+  std::vector<emp::block> labels;
+  for (const auto& value : in) {
+    for (const auto& bit : value.bits) {
+      labels.push_back(bit.bit);
+    }
+  }
+  std::unique_ptr<bool[]> plaintext{new bool[labels.size()]};
+  emp::ProtocolExecution::prot_exec->reveal(
+      plaintext.get(), party, labels.data(), labels.size());
+
+  std::vector<int64_t> res;
+  res.reserve(in.size());
+  size_t offset = 0;
+  for (const auto& value : in) {
+    uint64_t bits = 0;
+    auto size = value.size();
+    for (int j = 0; j < size && j < 64; ++j) {
+      bits |= static_cast<uint64_t>(plaintext[offset + j]) << j;
+    }
+    if (size > 0 && size < 64 && plaintext[offset + size - 1]) {
+      bits |= ~uint64_t{0} << size;
+    }
+    res.push_back(static_cast<int64_t>(bits));
+    offset += size;
+  }
+  return res;
+}
+
 inline const emp::Integer getMin(emp::Integer value1, emp::Integer value2) {
   emp::Bit cmp = value1 > value2;
   return emp::If(cmp, value2, value1);
@@ -50,37 +106,87 @@ inline const emp::Integer getMin(const std::vector<emp::Integer>& values) {
 }
 
 template <int TO>
-const int64_t sum(const std::vector<emp::Integer>& in) {
-  // TODO: If `in` is empty for some reason, immediately return 0.
-  const auto res = secretSum(in);
-
+const int64_t revealSum(const emp::Integer& sum) {
   // Support 32 bit and 64 bit integers
-  if (res.size() == 32) {
-    return res.reveal<int32_t>(TO);
-  } else if (res.size() == 64) {
-    return res.reveal<int64_t>(TO);
+  if (sum.size() == 32) {
+    return sum.reveal<int32_t>(TO);
+  } else if (sum.size() == 64) {
+    return sum.reveal<int64_t>(TO);
   } else {
     throw std::runtime_error(
         "Only 32 and 64 bit integers are supported by sum()");
   }
 }
 
+template <int TO>
+const int64_t sum(const std::vector<emp::Integer>& in) {
+  return revealSum<TO>(secretSum(in));
+}
+
 template <int TO>
 const int64_t sum(const std::vector<emp::Bit>& in) {
-  // POTENTIAL OPTIMIZATION: this wastes memory since it stores an additional
-  // vector<Integer> whereas we could instead calculate on the fly.
-  return sum<TO>(bitsToInts(in));
+  return revealSum<TO>(secretSum(in));
+}
+
+inline emp::Integer addWithCarry(emp::Integer a, emp::Integer b) {
+  a.resize(a.size() + 1, false);
+  b.resize(b.size() + 1, false);
+  return a + b;
 }
 
 inline emp::Integer secretSum(const std::vector<emp::Integer>& in) {
-  const emp::Integer zero{static_cast<int>(in.at(0).size()), 0, emp::PUBLIC};
-  return std::accumulate(in.begin(), in.end(), zero);
+  if (in.empty()) {
+    return emp::Integer{INT_SIZE, 0, emp::PUBLIC};
+  }
+
+  std::vector<emp::Integer> level(in.begin(), in.end());
+  // Each level adds neighbouring pairs in place, and carries over the last
+  // element when the level has odd size
+  while (level.size() > 1) {
+    auto half = (level.size() + 1) / 2;
+    for (size_t i = 0; i < level.size() / 2; ++i) {
+      level[i] = level[2 * i] + level[2 * i + 1];
+    }
+    if (level.size() % 2 == 1) {
+      level[half - 1] = level.back();
+    }
+    level.erase(level.begin() + half, level.end());
+  }
+  return level.at(0);
 }
 
 inline emp::Integer secretSum(const std::vector<emp::Bit>& in) {
-  // POTENTIAL OPTIMIZATION: this wastes memory since it stores an additional
-  // vector<Integer> whereas we could instead calculate on the fly.
-  return secretSum(bitsToInts(in));
+  if (in.empty()) {
+    return emp::Integer{INT_SIZE, 0, emp::PUBLIC};
+  }
+
+  std::vector<emp::Integer> level;
+  level.reserve(in.size());
+  for (const auto& bit : in) {
+    emp::Integer oneBit{1, 0, emp::PUBLIC};
+    oneBit[0] = bit;
+    level.push_back(std::move(oneBit));
+  }
+
+  // All integers of a level have the same width. Pairs are added into an
+  // integer one bit wider, and the last element of an odd level is
+  // zero-extended, which costs no gates.
+  while (level.size() > 1) {
+    auto half = (level.size() + 1) / 2;
+    for (size_t i = 0; i < level.size() / 2; ++i) {
+      level[i] = addWithCarry(level[2 * i], level[2 * i + 1]);
+    }
+    if (level.size() % 2 == 1) {
+      auto last = level.back();
+      last.resize(last.size() + 1, false);
+      level[half - 1] = std::move(last);
+    }
+    level.erase(level.begin() + half, level.end());
+  }
+
+  auto res = level.at(0);
+  res.resize(INT_SIZE, false);
+  return res;
 }
 
 template <typename T>
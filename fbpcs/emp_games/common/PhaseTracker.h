@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <time.h>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <string>
+
+#include "folly/dynamic.h"
+
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
+
+namespace common {
+
+/**
+ * Splits the gates, network traffic, wall time and CPU time of a game into
+ * named phases, like input sharing, the attribution circuit or reveal. Phases
+ * with the same name are summed.
+ *
+ * The counters come from a sampler, which returns the current totals of the
+ * game's backend, e.g. SchedulerKeeper<schedulerId> statistics. A phase is the
+ * difference between two samples, so a phase only sees the traffic which was
+ * sent while it ran. With a lazy scheduler, gates are evaluated when their
+ * results are first needed, so their traffic shows up in the phase which needs
+ * them, usually the next reveal.
+ */
+class PhaseTracker {
+ public:
+  using CounterSampler = std::function<SchedulerStatistics()>;
+
+  explicit PhaseTracker(CounterSampler sampler)
+      : sampler_{std::move(sampler)} {}
+
+  SchedulerStatistics sample() const {
+    return sampler_();
+  }
+
+  void addPhase(const std::string& name, const PhaseStatistics& phase) {
+    phases_[name].add(phase);
+  }
+
+  const std::map<std::string, PhaseStatistics>& getPhases() const {
+    return phases_;
+  }
+
+ private:
+  CounterSampler sampler_;
+  std::map<std::string, PhaseStatistics> phases_;
+};
+
+/**
+ * Records the cost of everything between its construction and destruction as
+ * one run of the named phase. A null tracker disables tracking, which then
+ * costs a single branch, so games can always declare their phases.
+ */
+class ScopedPhase {
+ public:
+  ScopedPhase(PhaseTracker* tracker, const char* name)
+      : tracker_{tracker}, name_{name} {
+    if (tracker_ != nullptr) {
+      start_ = tracker_->sample();
+      wallStart_ = std::chrono::steady_clock::now();
+      cpuStart_ = getThreadCpuSeconds();
+    }
+  }
+
+  ScopedPhase(const ScopedPhase&) = delete;
+  ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+  ~ScopedPhase() {
+    if (tracker_ == nullptr) {
+      return;
+    }
+    auto end = tracker_->sample();
+    PhaseStatistics phase;
+    phase.count = 1;
+    phase.nonFreeGates = end.nonFreeGates - start_.nonFreeGates;
+    phase.freeGates = end.freeGates - start_.freeGates;
+    phase.sentNetwork = end.sentNetwork - start_.sentNetwork;
+    phase.receivedNetwork = end.receivedNetwork - start_.receivedNetwork;
+    phase.wallTimeSeconds = std::chrono::duration<double>(
+                                std::chrono::steady_clock::now() - wallStart_)
+                                .count();
+    phase.cpuTimeSeconds = getThreadCpuSeconds() - cpuStart_;
+    tracker_->addPhase(name_, phase);
+  }
+
+ private:
+  // games run on a single thread, so only that thread's CPU time counts
+  static double getThreadCpuSeconds() {
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+  }
+
+  PhaseTracker* tracker_;
+  const char* name_;
+  SchedulerStatistics start_{0, 0, 0, 0};
+  std::chrono::steady_clock::time_point wallStart_;
+  double cpuStart_ = 0;
+};
+
+/**
+ * A machine readable profile of the given phases, keyed by phase name.
+ */
+inline folly::dynamic getPhaseProfile(
+    const std::map<std::string, PhaseStatistics>& phases) {
+  folly::dynamic profile = folly::dynamic::object();
+  for (const auto& [name, phase] : phases) {
+    profile[name] = folly::dynamic::object("count", phase.count)(
+        "non_free_gates", phase.nonFreeGates)("free_gates", phase.freeGates)(
+        "scheduler_transmitted_network", phase.sentNetwork)(
+        "scheduler_received_network", phase.receivedNetwork)(
+        "wall_time_seconds", phase.wallTimeSeconds)(
+        "cpu_time_seconds", phase.cpuTimeSeconds);
+  }
+  return profile;
+}
+
+} // namespace common
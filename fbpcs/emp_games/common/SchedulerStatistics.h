@@ -8,20 +8,48 @@
 #pragma once
 
 #include <cstdint>
+#include <map>
+#include <string>
 
 namespace common {
 
+// Cost of one named phase of a game, summed over every time it ran
+struct PhaseStatistics {
+  uint64_t count = 0;
+  uint64_t nonFreeGates = 0;
+  uint64_t freeGates = 0;
+  uint64_t sentNetwork = 0;
+  uint64_t receivedNetwork = 0;
+  double wallTimeSeconds = 0;
+  double cpuTimeSeconds = 0;
+
+  void add(const PhaseStatistics& other) {
+    count += other.count;
+    nonFreeGates += other.nonFreeGates;
+    freeGates += other.freeGates;
+    sentNetwork += other.sentNetwork;
+    receivedNetwork += other.receivedNetwork;
+    wallTimeSeconds += other.wallTimeSeconds;
+    cpuTimeSeconds += other.cpuTimeSeconds;
+  }
+};
+
 struct SchedulerStatistics {
   uint64_t nonFreeGates;
   uint64_t freeGates;
   uint64_t sentNetwork;
   uint64_t receivedNetwork;
+  // only filled in when phase tracking is enabled, see PhaseTracker.h
+  std::map<std::string, PhaseStatistics> phases = {};
 
   void add(SchedulerStatistics other) {
     nonFreeGates += other.nonFreeGates;
     freeGates += other.freeGates;
     sentNetwork += other.sentNetwork;
     receivedNetwork += other.receivedNetwork;
+    for (const auto& [name, phase] : other.phases) {
+      phases[name].add(phase);
+    }
   }
 };
 
@@ -254,6 +254,38 @@ privatelyShareIntArraysNoPaddingFromBob(
       in, numVals, arraySize, bitLen);
 }
 
+/*
+ * Send lists of public ints, like rule ids or ad ids, from SOURCE_ROLE to the
+ * opposite party in the clear over io, instead of inputting and revealing
+ * them as emp::Integers. The list lengths go first, then all values, so the
+ * exchange takes one message however many values it holds.
+ *
+ * The values are sent in the clear, so this must only be used for data which
+ * both parties may see. No digest or commitment is added: the games are
+ * semi-honest, so the source sends its lists as they are, and committing to
+ * values which are disclosed right away would not bind them to anything.
+ *
+ * io = channel of the running game, which the emp protocol also uses
+ * numLists = number of lists to share, which both parties must know
+ */
+template <int MY_ROLE, int SOURCE_ROLE, class IOChannel>
+const std::vector<std::vector<int64_t>> publiclyShareIntListsFrom(
+    IOChannel& io,
+    const std::vector<std::vector<int64_t>>& in,
+    size_t numLists);
+
+/*
+ * Send lists of public ints from ALICE to BOB in the clear
+ * numLists = number of lists to share
+ */
+template <int MY_ROLE, class IOChannel>
+const std::vector<std::vector<int64_t>> publiclyShareIntListsFromAlice(
+    IOChannel& io,
+    const std::vector<std::vector<int64_t>>& in,
+    size_t numLists) {
+  return publiclyShareIntListsFrom<MY_ROLE, emp::ALICE>(io, in, numLists);
+}
+
 /*
  * Execute map_fn on pairwise items from vec1 and vec2
  */
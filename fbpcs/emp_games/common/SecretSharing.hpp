@@ -16,6 +16,7 @@
 #include <tuple>
 #include <vector>
 
+#include "EmpOperationUtil.h"
 #include "SecretSharing.h"
 #include "folly/logging/xlog.h"
 
@@ -309,6 +310,53 @@ privatelyShareIntArraysNoPaddingFrom(
   return out;
 }
 
+template <int MY_ROLE, int SOURCE_ROLE, class IOChannel>
+const std::vector<std::vector<int64_t>> publiclyShareIntListsFrom(
+    IOChannel& io,
+    const std::vector<std::vector<int64_t>>& in,
+    size_t numLists) {
+  const auto receiveStr = MY_ROLE == SOURCE_ROLE ? "sending" : "receiving";
+  XLOGF(DBG, "Publicly {} frame of {} lists", receiveStr, numLists);
+
+  std::vector<int64_t> lengths(numLists, 0);
+  if constexpr (MY_ROLE == SOURCE_ROLE) {
+    if (in.size() != numLists) {
+      throw std::runtime_error(fmt::format(
+          "Expected {} lists to share, but got {}", numLists, in.size()));
+    }
+    std::vector<int64_t> body;
+    for (size_t i = 0; i < numLists; ++i) {
+      lengths.at(i) = in.at(i).size();
+      body.insert(body.end(), in.at(i).begin(), in.at(i).end());
+    }
+    io.send_data(lengths.data(), lengths.size() * sizeof(int64_t));
+    io.send_data(body.data(), body.size() * sizeof(int64_t));
+    io.flush();
+    return in;
+  }
+
+  io.recv_data(lengths.data(), lengths.size() * sizeof(int64_t));
+  size_t numValues = 0;
+  for (auto length : lengths) {
+    if (length < 0) {
+      throw std::runtime_error(
+          fmt::format("Received a list of negative length {}", length));
+    }
+    numValues += length;
+  }
+  std::vector<int64_t> body(numValues);
+  io.recv_data(body.data(), body.size() * sizeof(int64_t));
+
+  std::vector<std::vector<int64_t>> out;
+  out.reserve(numLists);
+  auto it = body.begin();
+  for (auto length : lengths) {
+    out.emplace_back(it, it + length);
+    it += length;
+  }
+  return out;
+}
+
 template <typename T, typename S>
 void zip(
     const std::vector<T>& vec1,
@@ -82,6 +82,35 @@ std::vector<std::vector<O>> privatelyShareArrays(
   return outputArrays;
 }
 
+/**
+ * Helper method to share arrays as batches, with input type T and output type
+ * O, where O can be constructed from a vector of T. The input arrays are given
+ * row by row, and must all have the same length. Each output batch holds one
+ * column of the input, i.e. the element at the same position in every row.
+ */
+template <typename T, typename O>
+std::vector<O> privatelyShareTransposedArrays(
+    const std::vector<std::vector<T>>& inputArrays) {
+  std::vector<O> outputArray;
+  if (inputArrays.empty()) {
+    return outputArray;
+  }
+
+  auto numColumns = inputArrays.at(0).size();
+  for (size_t j = 0; j < numColumns; ++j) {
+    std::vector<T> inputColumn;
+    inputColumn.reserve(inputArrays.size());
+    for (const auto& inputArray : inputArrays) {
+      CHECK_EQ(inputArray.size(), numColumns)
+          << "All input arrays must have the same length for batch sharing.";
+      inputColumn.push_back(inputArray.at(j));
+    }
+    outputArray.push_back(O{inputColumn});
+  }
+
+  return outputArray;
+}
+
 /**
  * Helper method to share array of integers, with input width number of bits,
  * from sender to receiver.
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <gtest/gtest.h>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+
+#include "folly/dynamic.h"
+#include "folly/json.h"
+#include "folly/logging/xlog.h"
+
+#include "fbpcf/io/FileManagerUtil.h"
+
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
+
+namespace common {
+
+// How much a game may grow over its checked-in budget before the test fails
+const double kCostBudgetTolerance = 0.05;
+
+// Set this to rewrite the budget file with the measured costs
+const std::string kUpdateCostBudgetsEnv = "UPDATE_COST_BUDGETS";
+
+inline folly::dynamic readCostBudgets(const std::string& budgetFile) {
+  if (!std::filesystem::exists(budgetFile)) {
+    return folly::dynamic::object;
+  }
+  return folly::parseJson(fbpcf::io::read(budgetFile));
+}
+
+/*
+ * Compares the non-free gates and the bytes sent plus received by one party
+ * with the budget stored under `name` in `budgetFile`, a JSON object like
+ *   {"<name>": {"non_free_gates": 1234, "traffic_bytes": 5678}}
+ * A missing budget fails the test. Costs that went down only get logged, so
+ * that budgets can be tightened on purpose rather than by accident.
+ */
+inline void expectWithinCostBudget(
+    const std::string& budgetFile,
+    const std::string& name,
+    const SchedulerStatistics& measured,
+    double tolerance = kCostBudgetTolerance) {
+  auto measuredTraffic = measured.sentNetwork + measured.receivedNetwork;
+  auto budgets = readCostBudgets(budgetFile);
+
+  if (std::getenv(kUpdateCostBudgetsEnv.c_str()) != nullptr) {
+    budgets[name] = folly::dynamic::object(
+        "non_free_gates", static_cast<int64_t>(measured.nonFreeGates))(
+        "traffic_bytes", static_cast<int64_t>(measuredTraffic));
+    folly::json::serialization_opts opts;
+    opts.pretty_formatting = true;
+    opts.sort_keys = true;
+    fbpcf::io::write(budgetFile, folly::json::serialize(budgets, opts) + "\n");
+    return;
+  }
+
+  auto budget = budgets.get_ptr(name);
+  if (budget == nullptr) {
+    ADD_FAILURE() << "No cost budget for " << name << " in " << budgetFile
+                  << " (measured " << measured.nonFreeGates
+                  << " non-free gates, " << measuredTraffic
+                  << " bytes), run with " << kUpdateCostBudgetsEnv
+                  << "=1 to record it";
+    return;
+  }
+
+  auto checkCost = [&](const std::string& key, uint64_t value) {
+    auto allowed = static_cast<uint64_t>(budget->at(key).asInt());
+    EXPECT_LE(value, allowed * (1 + tolerance))
+        << name << ": " << key << " went from " << allowed << " to " << value
+        << ", run with " << kUpdateCostBudgetsEnv
+        << "=1 if the increase is expected";
+    if (value < allowed) {
+      XLOGF(INFO, "{}: {} went down from {} to {}", name, key, allowed, value);
+    }
+  };
+  checkCost("non_free_gates", measured.nonFreeGates);
+  checkCost("traffic_bytes", measuredTraffic);
+}
+
+} // namespace common
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include <gtest/gtest.h>
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+
+#include "../EmpOperationUtil.h"
+
+namespace private_measurement {
+
+using namespace emp_utils;
+
+namespace {
+
+uint64_t numAndGates() {
+  return emp::CircuitExecution::circ_exec->num_and();
+}
+
+std::vector<emp::Bit> getBits(size_t size) {
+  std::vector<emp::Bit> bits;
+  for (size_t i = 0; i < size; ++i) {
+    bits.emplace_back(i % 3 == 0, emp::ALICE);
+  }
+  return bits;
+}
+
+// The previous bit sum: every bit becomes an INT_SIZE integer, then all are
+// added in a chain
+emp::Integer chainedBitSum(const std::vector<emp::Bit>& in) {
+  auto ints = bitsToInts(in);
+  const emp::Integer zero{INT_SIZE, 0, emp::PUBLIC};
+  return std::accumulate(ints.begin(), ints.end(), zero);
+}
+
+} // namespace
+
+TEST(EmpOperationUtilTest, TestSecretSumOfBits) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        for (size_t size : {1, 2, 3, 7, 8, 100}) {
+          auto expected = static_cast<int64_t>((size + 2) / 3);
+          auto res = secretSum(getBits(size));
+          EXPECT_EQ(res.size(), INT_SIZE);
+          EXPECT_EQ(res.reveal<int64_t>(), expected);
+          EXPECT_EQ(sum(getBits(size)), expected);
+        }
+
+        auto empty = secretSum(std::vector<emp::Bit>{});
+        EXPECT_EQ(empty.size(), INT_SIZE);
+        EXPECT_EQ(empty.reveal<int64_t>(), 0);
+        EXPECT_EQ(sum(std::vector<emp::Bit>{}), 0);
+      });
+}
+
+TEST(EmpOperationUtilTest, TestSecretSumOfIntegers) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        std::vector<emp::Integer> ints;
+        for (int64_t i = 1; i <= 11; ++i) {
+          ints.emplace_back(32, i * 10, emp::BOB);
+        }
+        auto res = secretSum(ints);
+        EXPECT_EQ(res.size(), 32);
+        EXPECT_EQ(res.reveal<int64_t>(), 660);
+        EXPECT_EQ(sum(ints), 660);
+
+        // Sums wrap around at the input width, like a chain of adders
+        std::vector<emp::Integer> large(
+            4, emp::Integer{32, 1 << 30, emp::BOB});
+        EXPECT_EQ(secretSum(large).reveal<uint32_t>(), 0);
+
+        auto empty = secretSum(std::vector<emp::Integer>{});
+        EXPECT_EQ(empty.size(), INT_SIZE);
+        EXPECT_EQ(empty.reveal<int64_t>(), 0);
+        EXPECT_EQ(sum(std::vector<emp::Integer>{}), 0);
+      });
+}
+
+TEST(EmpOperationUtilTest, TestAddWithCarry) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        emp::Integer a{4, 15, emp::ALICE};
+        emp::Integer b{4, 9, emp::BOB};
+        auto res = addWithCarry(a, b);
+        EXPECT_EQ(res.size(), 5);
+        EXPECT_EQ(res.reveal<uint32_t>(), 24);
+      });
+}
+
+TEST(EmpOperationUtilTest, TestBitSumGateCount) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        const size_t size = 1024;
+        auto bits = getBits(size);
+
+        auto start = numAndGates();
+        auto chained = chainedBitSum(bits);
+        auto chainedGates = numAndGates() - start;
+
+        start = numAndGates();
+        auto tree = secretSum(bits);
+        auto treeGates = numAndGates() - start;
+
+        EXPECT_EQ(tree.reveal<int64_t>(), chained.reveal<int64_t>());
+        // The chain takes a 64-bit mux and a 64-bit adder per bit, while the
+        // tree adds n / 2^k pairs of k-bit integers at level k
+        EXPECT_GE(chainedGates, 64 * size);
+        EXPECT_LE(treeGates, 3 * size);
+      });
+}
+
+TEST(EmpOperationUtilTest, TestIntegerSumGateCount) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        std::vector<emp::Integer> ints(100, emp::Integer{32, 3, emp::ALICE});
+        const emp::Integer zero{32, 0, emp::PUBLIC};
+
+        auto start = numAndGates();
+        auto chained = std::accumulate(ints.begin(), ints.end(), zero);
+        auto chainedGates = numAndGates() - start;
+
+        start = numAndGates();
+        auto tree = secretSum(ints);
+        auto treeGates = numAndGates() - start;
+
+        EXPECT_EQ(tree.reveal<int64_t>(), chained.reveal<int64_t>());
+        // The tree needs one adder less, since it does not start from zero
+        EXPECT_LT(treeGates, chainedGates);
+      });
+}
+
+TEST(EmpOperationUtilTest, TestBatchInputAndReveal) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        const std::vector<int64_t> values{0, 1, -1, 42, INT64_MIN, INT64_MAX};
+        auto alice = batchInput(values, emp::ALICE);
+        auto bob = batchInput(values, emp::BOB);
+        ASSERT_EQ(alice.size(), values.size());
+        for (size_t i = 0; i < values.size(); ++i) {
+          EXPECT_EQ(alice.at(i).size(), INT_SIZE);
+          // Same as inputting the values one at a time
+          EXPECT_EQ(alice.at(i).reveal<int64_t>(), values.at(i));
+          EXPECT_EQ((alice.at(i) ^ bob.at(i)).reveal<int64_t>(), 0);
+        }
+        EXPECT_EQ(batchReveal(alice, emp::PUBLIC), values);
+
+        // Narrow integers are sign extended
+        auto narrow = batchInput({-3, 5}, emp::BOB, 8);
+        EXPECT_EQ(narrow.at(0).size(), 8);
+        EXPECT_EQ(
+            batchReveal(narrow, emp::PUBLIC), std::vector<int64_t>({-3, 5}));
+
+        EXPECT_TRUE(batchInput({}, emp::ALICE).empty());
+        EXPECT_TRUE(batchReveal({}, emp::PUBLIC).empty());
+      });
+}
+
+} // namespace private_measurement
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+
+#include "fbpcs/emp_games/common/PhaseTracker.h"
+
+namespace common {
+
+TEST(PhaseTrackerTest, TestPhasesRecordCounterDeltas) {
+  SchedulerStatistics counters{0, 0, 0, 0};
+  PhaseTracker tracker{[&counters]() { return counters; }};
+
+  {
+    ScopedPhase phase{&tracker, "share_inputs"};
+    counters.nonFreeGates += 10;
+    counters.sentNetwork += 100;
+  }
+  counters.freeGates += 1000; // between phases, so not recorded
+  {
+    ScopedPhase phase{&tracker, "reveal"};
+    counters.freeGates += 5;
+    counters.receivedNetwork += 50;
+  }
+  {
+    ScopedPhase phase{&tracker, "share_inputs"};
+    counters.nonFreeGates += 20;
+  }
+
+  const auto& phases = tracker.getPhases();
+  ASSERT_EQ(phases.size(), 2);
+
+  const auto& shareInputs = phases.at("share_inputs");
+  EXPECT_EQ(shareInputs.count, 2);
+  EXPECT_EQ(shareInputs.nonFreeGates, 30);
+  EXPECT_EQ(shareInputs.freeGates, 0);
+  EXPECT_EQ(shareInputs.sentNetwork, 100);
+  EXPECT_GE(shareInputs.wallTimeSeconds, 0);
+
+  const auto& reveal = phases.at("reveal");
+  EXPECT_EQ(reveal.count, 1);
+  EXPECT_EQ(reveal.freeGates, 5);
+  EXPECT_EQ(reveal.receivedNetwork, 50);
+}
+
+TEST(PhaseTrackerTest, TestNullTrackerIsNoOp) {
+  ScopedPhase phase{nullptr, "share_inputs"};
+}
+
+TEST(PhaseTrackerTest, TestGetPhaseProfile) {
+  PhaseStatistics phase;
+  phase.count = 1;
+  phase.nonFreeGates = 7;
+  phase.sentNetwork = 8;
+
+  auto profile = getPhaseProfile({{"reveal", phase}});
+  EXPECT_EQ(profile["reveal"]["count"], 1);
+  EXPECT_EQ(profile["reveal"]["non_free_gates"], 7);
+  EXPECT_EQ(profile["reveal"]["scheduler_transmitted_network"], 8);
+  EXPECT_EQ(profile["reveal"]["scheduler_received_network"], 0);
+}
+
+} // namespace common
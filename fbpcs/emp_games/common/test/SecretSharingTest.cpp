@@ -6,8 +6,12 @@
  */
 
 #include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <queue>
 
 #include <fbpcf/mpc/EmpTestUtil.h>
+#include <fbpcf/mpc/QueueIO.h>
 
 #include "../SecretSharing.h"
 
@@ -175,4 +179,23 @@ TEST(SecretSharingTest, TestMultiplyBitmask) {
       });
 }
 
+TEST(SecretSharingTest, TestPubliclyShareIntListsFromAlice) {
+  auto queueA = std::make_shared<folly::Synchronized<std::queue<char>>>();
+  auto queueB = std::make_shared<folly::Synchronized<std::queue<char>>>();
+  std::vector<std::vector<int64_t>> aliceInput{{1, 2}, {}, {-5, INT64_MAX, 0}};
+
+  auto futureAlice = std::async([&queueA, &queueB, &aliceInput]() {
+    fbpcf::QueueIO io{queueA, queueB};
+    return publiclyShareIntListsFromAlice<emp::ALICE>(io, aliceInput, 3);
+  });
+  auto futureBob = std::async([&queueA, &queueB]() {
+    fbpcf::QueueIO io{queueB, queueA};
+    // Bob only knows how many lists to expect
+    return publiclyShareIntListsFromAlice<emp::BOB>(io, {}, 3);
+  });
+
+  EXPECT_EQ(aliceInput, futureAlice.get());
+  EXPECT_EQ(aliceInput, futureBob.get());
+}
+
 } // namespace private_measurement
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include "../../common/PrivateData.h"
+
+namespace private_lift {
+
+/*
+ * Helpers to pick the width of every secret column from the data instead of
+ * sharing everything as 32 or 64 bit integers. Each party computes the width
+ * its own column needs, both agree on it in the clear before any secret input
+ * is shared, and every comparison and sum on the column then runs at that
+ * width.
+ */
+
+// A purchase is valid if opportunityTs < purchaseTs + kPurchaseTimestampOffset
+constexpr int64_t kPurchaseTimestampOffset = 10;
+
+// InputData subtracts the epoch from timestamps, so that every valid timestamp
+// is non-negative, and a missing (zero) timestamp becomes -epoch. Missing
+// timestamps are shared as this value instead: it compares the same way as
+// -epoch against every valid timestamp, even with the purchase offset added,
+// as long as the epoch is at least the offset. But it only needs a few bits.
+constexpr int64_t kMissingTimestamp = -kPurchaseTimestampOffset - 1;
+
+// Number of bits of a two's complement integer that can hold every value in
+// [minValue, maxValue]
+inline int32_t signedBitsFor(int64_t minValue, int64_t maxValue) {
+  int32_t bits = 1;
+  while (bits < private_measurement::INT_SIZE &&
+         (minValue < -(int64_t{1} << (bits - 1)) ||
+          maxValue > (int64_t{1} << (bits - 1)) - 1)) {
+    ++bits;
+  }
+  return bits;
+}
+
+inline int64_t compactTimestamp(int64_t timestamp) {
+  return timestamp < 0 ? kMissingTimestamp : timestamp;
+}
+
+inline std::vector<int64_t> compactTimestamps(
+    const std::vector<int64_t>& timestamps) {
+  std::vector<int64_t> res;
+  res.reserve(timestamps.size());
+  std::transform(
+      timestamps.begin(),
+      timestamps.end(),
+      std::back_inserter(res),
+      compactTimestamp);
+  return res;
+}
+
+inline std::vector<std::vector<int64_t>> compactTimestamps(
+    const std::vector<std::vector<int64_t>>& timestampArrays) {
+  std::vector<std::vector<int64_t>> res;
+  res.reserve(timestampArrays.size());
+  for (const auto& timestamps : timestampArrays) {
+    res.push_back(compactTimestamps(timestamps));
+  }
+  return res;
+}
+
+// Number of bits needed for the given timestamps once compacted, both as they
+// are and with a non-negative offset added
+inline int32_t bitsForTimestamps(
+    const std::vector<int64_t>& timestamps,
+    int64_t offset = 0) {
+  int64_t minValue = 0;
+  int64_t maxValue = 0;
+  for (auto timestamp : timestamps) {
+    minValue = std::min(minValue, compactTimestamp(timestamp));
+    maxValue = std::max(maxValue, compactTimestamp(timestamp));
+  }
+  return signedBitsFor(minValue, maxValue + offset);
+}
+
+inline int32_t bitsForTimestamps(
+    const std::vector<std::vector<int64_t>>& timestampArrays,
+    int64_t offset = 0) {
+  int32_t bits = bitsForTimestamps(std::vector<int64_t>{}, offset);
+  for (const auto& timestamps : timestampArrays) {
+    bits = std::max(bits, bitsForTimestamps(timestamps, offset));
+  }
+  return bits;
+}
+
+} // namespace private_lift
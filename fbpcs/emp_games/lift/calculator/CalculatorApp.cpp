@@ -26,12 +26,19 @@ void CalculatorApp::run() {
     int32_t numValues = static_cast<int32_t>(config.inputData.getNumRows());
     XLOG(INFO) << "Have " << numValues << " values in inputData.";
 
-    XLOG(INFO) << "connecting...";
-    std::unique_ptr<emp::NetIO> io = std::make_unique<emp::NetIO>(
-        party_ == fbpcf::Party::Alice ? nullptr : serverIp_.c_str(), port_);
+    std::string output;
+    if (mux_) {
+      XLOG(INFO) << "opening shard channel " << channelId_;
+      CalculatorGame game{mux_->openChannel(channelId_), party_, visibility_};
+      output = game.perfPlay(config);
+    } else {
+      XLOG(INFO) << "connecting...";
+      std::unique_ptr<emp::NetIO> io = std::make_unique<emp::NetIO>(
+          party_ == fbpcf::Party::Alice ? nullptr : serverIp_.c_str(), port_);
 
-    CalculatorGame game{std::move(io), party_, visibility_};
-    auto output = game.perfPlay(config);
+      CalculatorGame game{std::move(io), party_, visibility_};
+      output = game.perfPlay(config);
+    }
     XLOG(INFO) << "done calculating";
 
     putOutputData(output);
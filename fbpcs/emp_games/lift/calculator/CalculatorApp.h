@@ -9,6 +9,7 @@
 
 #include <cstdlib>
 #include <filesystem>
+#include <memory>
 #include <string>
 
 #include <glog/logging.h>
@@ -18,6 +19,7 @@
 #include "CalculatorGame.h"
 #include "InputData.h"
 #include "OutputMetrics.h"
+#include "ShardChannelMux.h"
 
 // so that these FLAGS set in main.cpp are visible here
 DECLARE_bool(is_conversion_lift);
@@ -67,6 +69,27 @@ class CalculatorApp : public fbpcf::EmpApp<
             useXorEncryption ? fbpcf::Visibility::Xor
                              : fbpcf::Visibility::Public) {}
 
+  // Run on the logical channel channelId of a connection shared with other
+  // shards, instead of a connection of its own
+  CalculatorApp(
+      const fbpcf::Party party,
+      std::shared_ptr<ShardChannelMux> mux,
+      uint32_t channelId,
+      const std::filesystem::path& inputPath,
+      const std::string& outputPath,
+      const bool useXorEncryption)
+      : fbpcf::EmpApp<
+            CalculatorGame<emp::NetIO>,
+            CalculatorGameConfig,
+            std::string>{party, "", 0},
+        inputPath_(inputPath),
+        outputPath_(outputPath),
+        visibility_(
+            useXorEncryption ? fbpcf::Visibility::Xor
+                             : fbpcf::Visibility::Public),
+        mux_{std::move(mux)},
+        channelId_{channelId} {}
+
   void run() override;
 
  protected:
@@ -77,6 +100,8 @@ class CalculatorApp : public fbpcf::EmpApp<
   std::filesystem::path inputPath_;
   std::string outputPath_;
   fbpcf::Visibility visibility_;
+  std::shared_ptr<ShardChannelMux> mux_;
+  uint32_t channelId_ = 0;
 };
 
 } // namespace private_lift
@@ -0,0 +1,189 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+#include "../../common/PrivateData.h"
+
+namespace private_lift {
+
+/*
+ * Helpers to compute a metric for every publisher breakdown or partner cohort
+ * in a single pass over the rows. The secret group index of each row is
+ * expanded once into one bit per group (a one-hot demux), and every metric then
+ * adds each row into the accumulator of every group, gated by the row's group
+ * bit. This replaces masking and summing the whole column once per group.
+ */
+
+// Number of bits needed to represent every value in [0, maxValue]
+inline int32_t bitsFor(int64_t maxValue) {
+  int32_t bits = 1;
+  while (bits < private_measurement::INT_SIZE - 1 &&
+         (int64_t{1} << bits) <= maxValue) {
+    ++bits;
+  }
+  return bits;
+}
+
+// Expand a secret index into numGroups bits, where bit i is set iff
+// index == i. An index of numGroups or more sets no bit, which is how rows
+// without a group are encoded. Costs one AND gate per output bit.
+inline std::vector<emp::Bit> demux(
+    const emp::Integer& index,
+    int64_t numGroups) {
+  std::vector<emp::Bit> out{emp::Bit{true, emp::PUBLIC}};
+  // Walk the index from its most significant bit. After each step, out[p] is
+  // set iff the bits seen so far spell out the prefix p, and we only keep the
+  // prefixes that can still lead to an index below numGroups.
+  for (int i = index.size() - 1; i >= 0; --i) {
+    auto numPrefixes = (numGroups + (int64_t{1} << i) - 1) >> i;
+    std::vector<emp::Bit> next;
+    next.reserve(numPrefixes);
+    for (int64_t p = 0; p < numPrefixes; ++p) {
+      const auto& parent = out.at(p >> 1);
+      auto high = parent & index[i];
+      next.push_back((p & 1) ? high : parent ^ high);
+    }
+    out = std::move(next);
+  }
+  return out;
+}
+
+// Add a secret bit to an accumulator with a ripple of half adders, which costs
+// one AND gate per accumulator bit instead of a full mux and adder.
+inline void addBit(emp::Integer& accumulator, const emp::Bit& bit) {
+  emp::Bit carry = bit;
+  for (int i = 0; i < accumulator.size(); ++i) {
+    auto sum = accumulator[i] ^ carry;
+    carry = accumulator[i] & carry;
+    accumulator[i] = sum;
+  }
+}
+
+/*
+ * Running sums of every group. Rows are added one at a time, together with the
+ * one-hot group bits of the row.
+ */
+class GroupedSum {
+ public:
+  GroupedSum(int64_t numGroups, int32_t bitLen)
+      : bitLen_{bitLen},
+        accumulators_(numGroups, emp::Integer{bitLen, 0, emp::PUBLIC}) {}
+
+  void add(const std::vector<emp::Bit>& groupBits, const emp::Bit& bit) {
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+      addBit(accumulators_[i], groupBits.at(i) & bit);
+    }
+  }
+
+  void add(const std::vector<emp::Bit>& groupBits, const emp::Integer& value) {
+    const emp::Integer zero{bitLen_, 0, emp::PUBLIC};
+    for (size_t i = 0; i < accumulators_.size(); ++i) {
+      accumulators_[i] =
+          accumulators_[i] + emp::If(groupBits.at(i), value, zero);
+    }
+  }
+
+  template <class T>
+  void add(const std::vector<emp::Bit>& groupBits, const std::vector<T>& row) {
+    for (const auto& value : row) {
+      add(groupBits, value);
+    }
+  }
+
+  // The sums of every group, zero-extended to bitLen
+  std::vector<emp::Integer> getSums(int32_t bitLen) const {
+    std::vector<emp::Integer> sums = accumulators_;
+    for (auto& sum : sums) {
+      sum.resize(bitLen, false);
+    }
+    return sums;
+  }
+
+ private:
+  int32_t bitLen_;
+  std::vector<emp::Integer> accumulators_;
+};
+
+namespace detail {
+
+inline int64_t numBits(const std::vector<emp::Bit>& in) {
+  return in.size();
+}
+
+inline int64_t numBits(const std::vector<std::vector<emp::Bit>>& in) {
+  int64_t res = 0;
+  for (const auto& row : in) {
+    res += row.size();
+  }
+  return res;
+}
+
+inline int32_t bitLenOf(const std::vector<emp::Integer>& in) {
+  return in.empty() ? private_measurement::INT_SIZE : in.at(0).size();
+}
+
+inline int32_t bitLenOf(const std::vector<std::vector<emp::Integer>>& in) {
+  for (const auto& row : in) {
+    if (!row.empty()) {
+      return row.at(0).size();
+    }
+  }
+  return private_measurement::INT_SIZE;
+}
+
+template <class T>
+std::vector<emp::Integer> groupedSum(
+    const std::vector<std::vector<emp::Bit>>& groupBits,
+    int64_t numGroups,
+    const std::vector<T>& in,
+    int32_t accumulatorBitLen,
+    int32_t outputBitLen) {
+  GroupedSum sums{numGroups, accumulatorBitLen};
+  if (numGroups > 0) {
+    for (size_t i = 0; i < in.size(); ++i) {
+      sums.add(groupBits.at(i), in.at(i));
+    }
+  }
+  return sums.getSums(outputBitLen);
+}
+
+} // namespace detail
+
+/*
+ * Sum a column within every group, where groupBits[row] are the one-hot group
+ * bits of the row. Bit columns are counted with accumulators just wide enough
+ * for the number of bits in the column, and are returned as INT_SIZE integers
+ * like emp_utils::sum. Integer columns are summed at their own width.
+ */
+template <class T>
+std::vector<emp::Integer> groupedSum(
+    const std::vector<std::vector<emp::Bit>>& groupBits,
+    int64_t numGroups,
+    const std::vector<T>& in) {
+  if constexpr (
+      std::is_same_v<T, emp::Bit> ||
+      std::is_same_v<T, std::vector<emp::Bit>>) {
+    return detail::groupedSum(
+        groupBits,
+        numGroups,
+        in,
+        bitsFor(detail::numBits(in)),
+        private_measurement::INT_SIZE);
+  } else {
+    auto bitLen = detail::bitLenOf(in);
+    return detail::groupedSum(groupBits, numGroups, in, bitLen, bitLen);
+  }
+}
+
+} // namespace private_lift
@@ -90,7 +90,7 @@ void InputData::setValuesFields(std::string& str) {
       LOG(FATAL) << "Failed to parse '" << iss.str() << "' to int64_t";
     }
     purchaseValueArrays_.back().push_back(parsed);
-    totalValue_ += parsed;
+    totalAbsoluteValue_ += std::abs(parsed);
     // If this is secret_share lift, we can't pre-compute squared values
     if (liftMpcType_ == LiftMPCType::Standard) {
       purchaseValueSquaredArrays_.back().push_back(parsed * parsed);
@@ -99,7 +99,8 @@ void InputData::setValuesFields(std::string& str) {
 
   // For non-secret-share lift, we *can* use this valueSquared optimizations to
   // avoid doing addition/multiplication in MPC, though
-  if (liftMpcType_ == LiftMPCType::Standard) {
+  if (liftMpcType_ == LiftMPCType::Standard &&
+      !purchaseValueArrays_.back().empty()) {
     auto& valuesArr = purchaseValueArrays_.back();
     auto& valuesSquaredArr = purchaseValueSquaredArrays_.back();
     uint64_t acc = 0;
@@ -111,9 +112,10 @@ void InputData::setValuesFields(std::string& str) {
       // 2. Set valuesSquared at this index as acc**2
       valuesSquaredArr.at(i) = acc * acc;
     }
-    // Finally, update totalValueSquared with the *maximum possible* value,
-    // which is what we just stored into the first value
-    totalValueSquared_ += valuesSquaredArr.at(0);
+    // Finally, update totalValueSquared with the *maximum possible* value.
+    // With negative values (refunds) that is not always the first one.
+    totalValueSquared_ +=
+        *std::max_element(valuesSquaredArr.begin(), valuesSquaredArr.end());
   }
 }
 
@@ -219,7 +221,7 @@ void InputData::addFromCSV(
     } else if (column == "event_timestamps") {
       setTimestamps(value, purchaseTimestampArrays_);
     } else if (column == "value") {
-      totalValue_ += parsed;
+      totalAbsoluteValue_ += std::abs(parsed);
       purchaseValues_.push_back(parsed);
       // If this is secret_share lift, we can't pre-compute squared values
       if (liftMpcType_ == LiftMPCType::Standard) {
@@ -248,7 +250,7 @@ void InputData::addFromCSV(
         value = "[" + value + "]";
         setValuesFields(value);
       } else {
-        totalValue_ += parsed;
+        totalAbsoluteValue_ += std::abs(parsed);
         purchaseValues_.push_back(parsed);
       }
     } else if (column.rfind(kFeaturePrefix, 0) != std::string::npos) {
@@ -111,12 +111,15 @@ class InputData {
     return numGroups_;
   }
 
+  // Widths of signed integers that hold every sum of values, or of values
+  // squared. Values can be negative (refunds), so every sum lies within
+  // [-totalAbsoluteValue, totalAbsoluteValue], and one bit is kept for the sign.
   int64_t getNumBitsForValue() const {
-    return std::ceil(std::log2(totalValue_ + 1));
+    return std::ceil(std::log2(totalAbsoluteValue_ + 1)) + 1;
   }
 
   int64_t getNumBitsForValueSquared() const {
-    return std::ceil(std::log2(totalValueSquared_ + 1));
+    return std::ceil(std::log2(totalValueSquared_ + 1)) + 1;
   }
 
   int64_t getNumRows() const {
@@ -148,7 +151,8 @@ class InputData {
       std::vector<std::vector<int64_t>>& timestampArrays);
 
   /*
-   * Append values from str to valueArrays and add to totalValue.
+   * Append values from str to valueArrays and add their absolute values to
+   * totalAbsoluteValue.
    * If not secret_share lift, then also append squared values to
    * valuesSquaredArrays and add to totalValueSquared.
    *
@@ -186,7 +190,7 @@ class InputData {
   std::vector<std::string> featureHeader_;
   std::unordered_map<int64_t, std::vector<std::string>> groupIdToFeatures_;
   std::map<std::vector<std::string>, int64_t> featuresToGroupId_;
-  int64_t totalValue_ = 0;
+  int64_t totalAbsoluteValue_ = 0;
   int64_t totalValueSquared_ = 0;
   int64_t numGroups_ = 0;
   int32_t numConversionsPerUser_;
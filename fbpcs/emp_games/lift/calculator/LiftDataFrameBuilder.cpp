@@ -14,6 +14,7 @@
 
 #include "fbpcs/emp_games/lift/common/Column.h"
 #include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
 
 using namespace private_lift;
 
@@ -41,8 +42,7 @@ void LiftDataFrameBuilder::applyConversionCap(df::DataFrame& df) const {
     if (keys.find(key) != keys.end()) {
       // We take the *first N* conversions for this user
       // NOTE: This should later be switched to *last N*
-      df.get<std::vector<int64_t>>(key).apply(
-          [this](auto& innerVec) { innerVec.resize(conversionCap_); });
+      df.get<std::vector<int64_t>>(key).resizeRows(conversionCap_);
     }
   }
 }
@@ -50,20 +50,21 @@ void LiftDataFrameBuilder::applyConversionCap(df::DataFrame& df) const {
 void LiftDataFrameBuilder::precomputeValuesSquared(df::DataFrame& df) const {
   auto keys = df.keys();
   if (keys.find("values") != keys.end()) {
-    df.get<std::vector<int64_t>>("values_squared") =
-        df.get<std::vector<int64_t>>("values").map([](auto& innerVec) {
-          std::vector<int64_t> res(innerVec.size());
-          int64_t acc = 0;
-          // Reverse iterate to accumulate total value in range [i, end)
-          // This may look dumb, but size_t is an unsigned type, so we can't
-          // iterate down to zero (it underflows and never terminates)
-          std::size_t i = innerVec.size();
-          while (i--) {
-            acc += innerVec.at(i);
-            res.at(i) = acc * acc;
-          }
-          return res;
-        });
+    // Same row lengths as values, so overwrite a copy of it in place
+    df::ListColumn<int64_t> valuesSquared =
+        df.get<std::vector<int64_t>>("values");
+    valuesSquared.apply([](auto row) {
+      int64_t acc = 0;
+      // Reverse iterate to accumulate total value in range [i, end)
+      // This may look dumb, but size_t is an unsigned type, so we can't
+      // iterate down to zero (it underflows and never terminates)
+      std::size_t i = row.size();
+      while (i--) {
+        acc += row[i];
+        row[i] = acc * acc;
+      }
+    });
+    df.get<std::vector<int64_t>>("values_squared") = std::move(valuesSquared);
   }
 }
 
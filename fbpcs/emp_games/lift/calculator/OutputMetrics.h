@@ -9,6 +9,7 @@
 
 #include <cmath>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <emp-sh2pc/emp-sh2pc.h>
@@ -16,6 +17,8 @@
 #include "../../common/EmpOperationUtil.h"
 #include "../../common/PrivateData.h"
 #include "../../common/SecretSharing.h"
+#include "BitWidths.h"
+#include "GroupedAggregation.h"
 #include "InputData.h"
 #include "OutputMetricsData.h"
 
@@ -75,6 +78,9 @@ class OutputMetrics {
   std::string toJson() const;
 
  private:
+  // Sums of each publisher breakdown, then of each partner cohort
+  using GroupSums = std::pair<std::vector<int64_t>, std::vector<int64_t>>;
+
   std::string getGroupTypeStr(GroupType groupType) {
     if (groupType == GroupType::TEST) {
       return "test";
@@ -91,6 +97,11 @@ class OutputMetrics {
   // of groups* is revealed, but not the identities of those groups.
   void initNumGroups();
 
+  // Share the group index of every row from SOURCE_ROLE, and expand it into
+  // one bit per group. Returns the group bits indexed by [row][group].
+  template <int32_t SOURCE_ROLE>
+  std::vector<std::vector<emp::Bit>> shareGroupBits(int64_t numGroups) const;
+
   // Initialize whether or not value-based calculations should be entirely
   // skipped. This happens if we're dealing with a valueless objective.
   void initShouldSkipValues();
@@ -101,6 +112,18 @@ class OutputMetrics {
   // one side of the study).
   void initBitsForValues();
 
+  // Initialize the number of bits that will be used for timestamps. Each party
+  // shares the number of bits its own timestamps need, and both use the larger
+  // of the two.
+  void initBitsForTimestamps();
+
+  // Initialize the number of bits that will be used for impression counts,
+  // from the publisher.
+  void initBitsForImpressions();
+
+  // Share the opportunity and purchase timestamps once, at the agreed width
+  void shareTimestamps();
+
   // Calculate all metrics (helper function)
   void calculateAll();
 
@@ -139,8 +162,7 @@ class OutputMetrics {
   // Test/control match count: testPopulation/Control population &
   void calculateMatchCount(
       const OutputMetrics::GroupType& groupType,
-      const std::vector<emp::Bit>& populationBits,
-      const std::vector<std::vector<emp::Integer>>& purchaseValueArrays);
+      const std::vector<emp::Bit>& populationBits);
 
   // Test/Control value: testPurchaser/controlPurchaser ? purchaseValue : 0
   // Reached value: isReached ? purchaseValue : 0
@@ -157,6 +179,24 @@ class OutputMetrics {
       const std::vector<std::vector<emp::Integer>>& purchaseValueSquaredArrays,
       const std::vector<std::vector<emp::Bit>>& eventArrays);
 
+  /**
+   * Compute a private sum of the rows within every publisher breakdown and
+   * every partner cohort, in one pass over the rows for each, revealing to both
+   * parties at the end.
+   */
+  template <class T>
+  GroupSums groupedSums(const std::vector<T>& in) const;
+
+  // Store the sums of every breakdown and cohort in the given metric
+  void setGroupMetric(
+      const GroupSums& sums,
+      int64_t OutputMetricsData::*metric);
+
+  // Append the sums of every breakdown and cohort to the given histogram
+  void appendGroupHistogramBin(
+      const GroupSums& sums,
+      std::vector<int64_t> OutputMetricsData::*histogram);
+
   /**
    * Compute a private sum on a vector of bits, revealing to both parties at the
    * end.
@@ -191,15 +231,24 @@ class OutputMetrics {
   int64_t numPartnerCohorts_;
   int64_t valueBits_;
   int64_t valueSquaredBits_;
+  int32_t timestampBits_;
+  int32_t impressionBits_;
   OutputMetricsData metrics_{isConversionLift_};
 
-  std::unordered_map<int64_t, std::vector<emp::Bit>> publisherBitmasks_;
-  std::unordered_map<int64_t, std::vector<emp::Bit>> partnerBitmasks_;
+  std::vector<std::vector<emp::Bit>> publisherGroupBits_;
+  std::vector<std::vector<emp::Bit>> partnerGroupBits_;
+  std::vector<emp::Integer> opportunityTimestamps_;
+  std::vector<std::vector<emp::Integer>> purchaseTimestampArrays_;
   std::unordered_map<int64_t, OutputMetricsData> cohortMetrics_;
   std::unordered_map<int64_t, OutputMetricsData> publisherBreakdowns_;
 
   template <class T>
   T reveal(const emp::Integer& empInteger) const;
+
+  // Reveal a sum of any width up to INT_SIZE, by zero-extending it first
+  int64_t revealSum(emp::Integer sum) const;
+
+  std::vector<int64_t> revealSums(const std::vector<emp::Integer>& sums) const;
 };
 
 } // namespace private_lift
@@ -5,6 +5,7 @@
  * LICENSE file in the root directory of this source tree.
  */
 
+#include <algorithm>
 #include <tuple>
 
 #include "folly/logging/xlog.h"
@@ -17,8 +18,6 @@ namespace private_lift {
 
 constexpr int32_t PUBLISHER = static_cast<int>(fbpcf::Party::Alice);
 constexpr int32_t PARTNER = static_cast<int>(fbpcf::Party::Bob);
-constexpr int32_t QUICK_BITS = 32;
-constexpr int32_t FULL_BITS = 64;
 
 template <int32_t MY_ROLE>
 constexpr auto privatelyShareInt =
@@ -46,12 +45,22 @@ T OutputMetrics<MY_ROLE>::reveal(const emp::Integer& empInteger) const {
                                   : empInteger.reveal<T>();
 }
 
+template <int32_t MY_ROLE>
+int64_t OutputMetrics<MY_ROLE>::revealSum(emp::Integer sum) const {
+  // Sums of values are signed and may be negative, and every other sum is
+  // either INT_SIZE wide already or keeps its top bit clear
+  sum.resize(private_measurement::INT_SIZE, true);
+  return reveal<int64_t>(sum);
+}
+
 template <int32_t MY_ROLE>
 std::string OutputMetrics<MY_ROLE>::playGame() {
   validateNumRows();
   initNumGroups();
   initShouldSkipValues();
   initBitsForValues();
+  initBitsForTimestamps();
+  initBitsForImpressions();
   calculateAll();
 
   // Print the outputs
@@ -189,22 +198,42 @@ void OutputMetrics<MY_ROLE>::initNumGroups() {
   numPublisherBreakdowns_ = numGroups.publisherInt().template reveal<int64_t>();
   numPartnerCohorts_ = numGroups.partnerInt().template reveal<int64_t>();
 
-  // We pre-share the bitmasks for each group since they will be used
+  // We pre-share the group bits of each row since they will be used
   // multiple times throughout the computation
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    publisherBitmasks_[i] =
-        privatelyShareBitsFromPublisher<MY_ROLE>(inputData_.bitmaskFor(i), n_);
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    partnerBitmasks_[i] =
-        privatelyShareBitsFromPartner<MY_ROLE>(inputData_.bitmaskFor(i), n_);
-  }
+  publisherGroupBits_ = shareGroupBits<PUBLISHER>(numPublisherBreakdowns_);
+  partnerGroupBits_ = shareGroupBits<PARTNER>(numPartnerCohorts_);
   XLOG(INFO) << "Will be computing metrics for " << numPublisherBreakdowns_
              << " publisher breakdowns and " << numPartnerCohorts_
              << " partner cohorts";
 }
 
+template <int32_t MY_ROLE>
+template <int32_t SOURCE_ROLE>
+std::vector<std::vector<emp::Bit>> OutputMetrics<MY_ROLE>::shareGroupBits(
+    int64_t numGroups) const {
+  std::vector<std::vector<emp::Bit>> groupBits;
+  if (numGroups == 0) {
+    return groupBits;
+  }
+
+  // Rows without a group get the index numGroups, which sets no group bit
+  std::vector<int64_t> groupIndices;
+  if (MY_ROLE == SOURCE_ROLE) {
+    groupIndices = inputData_.getGroupIds();
+    groupIndices.resize(n_, numGroups);
+  }
+  auto bitLen = bitsFor(numGroups);
+  auto sharedIndices = SOURCE_ROLE == PUBLISHER
+      ? privatelyShareIntsFromPublisher<MY_ROLE>(groupIndices, n_, bitLen)
+      : privatelyShareIntsFromPartner<MY_ROLE>(groupIndices, n_, bitLen);
+
+  groupBits.reserve(n_);
+  for (const auto& index : sharedIndices) {
+    groupBits.push_back(demux(index, numGroups));
+  }
+  return groupBits;
+}
+
 template <int32_t MY_ROLE>
 void OutputMetrics<MY_ROLE>::initShouldSkipValues() {
   XLOG(INFO) << "Determine if value-based calculations should be skipped";
@@ -225,22 +254,71 @@ void OutputMetrics<MY_ROLE>::initBitsForValues() {
         private_measurement::INT_SIZE, valueBits, PARTNER};
     emp::Integer valueSquaredBitsInteger{
         private_measurement::INT_SIZE, valueSquaredBits, PARTNER};
-    // TODO: Figure out why this isn't working when using values other than
-    // 32/64
-    valueBits_ = valueBitsInteger.reveal<int64_t>() <= QUICK_BITS ? QUICK_BITS
-                                                                  : FULL_BITS;
-    valueSquaredBits_ = valueSquaredBitsInteger.reveal<int64_t>() <= QUICK_BITS
-        ? QUICK_BITS
-        : FULL_BITS;
+    // Every sum of values fits in these signed widths, since the sum of the
+    // absolute values does. Sums are sign-extended before they are revealed,
+    // so any width works.
+    auto toValueBits = [](int64_t bits) {
+      return std::clamp<int64_t>(bits, 1, private_measurement::INT_SIZE);
+    };
+    valueBits_ = toValueBits(valueBitsInteger.reveal<int64_t>());
+    valueSquaredBits_ = toValueBits(valueSquaredBitsInteger.reveal<int64_t>());
     XLOG(INFO) << "Num bits for values: " << valueBits_;
     XLOG(INFO) << "Num bits for values squared: " << valueSquaredBits_;
   }
 }
 
+template <int32_t MY_ROLE>
+void OutputMetrics<MY_ROLE>::initBitsForTimestamps() {
+  XLOG(INFO) << "Set up number of bits needed for timestamps";
+  // The partner's timestamps also need to hold purchaseTs + offset
+  auto timestampBits = MY_ROLE == PUBLISHER
+      ? bitsForTimestamps(inputData_.getOpportunityTimestamps())
+      : bitsForTimestamps(
+            inputData_.getPurchaseTimestampArrays(), kPurchaseTimestampOffset);
+  auto sharedBits = privatelyShareInt<MY_ROLE>(timestampBits);
+  timestampBits_ = std::max(
+      sharedBits.publisherInt().template reveal<int64_t>(),
+      sharedBits.partnerInt().template reveal<int64_t>());
+  XLOG(INFO) << "Num bits for timestamps: " << timestampBits_;
+}
+
+template <int32_t MY_ROLE>
+void OutputMetrics<MY_ROLE>::initBitsForImpressions() {
+  XLOG(INFO) << "Set up number of bits needed for impressions";
+  int64_t maxImpressions = 0;
+  for (auto numImpressions : inputData_.getNumImpressions()) {
+    maxImpressions = std::max(maxImpressions, numImpressions);
+  }
+  // Impressions are compared to zero as signed integers
+  emp::Integer impressionBitsInteger{
+      private_measurement::INT_SIZE,
+      signedBitsFor(0, maxImpressions),
+      PUBLISHER};
+  impressionBits_ = impressionBitsInteger.reveal<int64_t>();
+  XLOG(INFO) << "Num bits for impressions: " << impressionBits_;
+}
+
+template <int32_t MY_ROLE>
+void OutputMetrics<MY_ROLE>::shareTimestamps() {
+  XLOG(INFO) << "Share opportunity timestamps";
+  opportunityTimestamps_ = privatelyShareIntsFromPublisher<MY_ROLE>(
+      compactTimestamps(inputData_.getOpportunityTimestamps()),
+      n_,
+      timestampBits_);
+  XLOG(INFO) << "Share purchase timestamps";
+  purchaseTimestampArrays_ = privatelyShareIntArraysFromPartner<MY_ROLE>(
+      compactTimestamps(inputData_.getPurchaseTimestampArrays()),
+      n_, /* numVals */
+      numConversionsPerUser_ /* arraySize */,
+      timestampBits_ /* bitLen */);
+}
+
 template <int32_t MY_ROLE>
 void OutputMetrics<MY_ROLE>::calculateAll() {
   XLOG(INFO) << "Start calculation of output metrics";
 
+  shareTimestamps();
+
   std::vector<std::vector<emp::Integer>> purchaseValueArrays;
 
   if (!shouldSkipValues_) {
@@ -294,7 +372,7 @@ void OutputMetrics<MY_ROLE>::calculateStatistics(
                                    : inputData_.getControlPopulation());
   auto eventArrays = calculateEvents(groupType, bits, validPurchaseArrays);
   std::vector<emp::Bit> reachedArray;
-  calculateMatchCount(groupType, bits, purchaseValueArrays);
+  calculateMatchCount(groupType, bits);
   if (groupType == GroupType::TEST) {
     reachedArray = calculateImpressions(groupType, bits);
     calculateReachedConversions(groupType, validPurchaseArrays, reachedArray);
@@ -322,35 +400,23 @@ std::vector<emp::Bit> OutputMetrics<MY_ROLE>::calculatePopulation(
 template <int32_t MY_ROLE>
 std::vector<std::vector<emp::Bit>>
 OutputMetrics<MY_ROLE>::calculateValidPurchases() {
-  // TODO: We're using 32 bits for timestamps along with an offset setting the
-  // epoch to 2019-01-01. This will break in the year 2087.
-  XLOG(INFO) << "Share opportunity timestamps";
-  const std::vector<emp::Integer> opportunityTimestamps =
-      privatelyShareIntsFromPublisher<MY_ROLE>(
-          inputData_.getOpportunityTimestamps(), n_, QUICK_BITS);
-  XLOG(INFO) << "Share purchase timestamps";
-  const std::vector<std::vector<emp::Integer>> purchaseTimestampArrays =
-      privatelyShareIntArraysFromPartner<MY_ROLE>(
-          inputData_.getPurchaseTimestampArrays(),
-          n_, /* numVals */
-          numConversionsPerUser_ /* arraySize */,
-          QUICK_BITS /* bitLen */);
-
   XLOG(INFO) << "Calculate valid purchases";
   return private_measurement::functional::zip_apply(
       [](emp::Integer oppTs,
          std::vector<emp::Integer> purchaseTsArray) -> std::vector<emp::Bit> {
         std::vector<emp::Bit> vec;
         for (const auto& purchaseTs : purchaseTsArray) {
-          const emp::Integer ten{
-              static_cast<int>(purchaseTs.size()), 10, emp::PUBLIC};
-          vec.push_back(purchaseTs + ten > oppTs);
+          const emp::Integer offset{
+              static_cast<int>(purchaseTs.size()),
+              kPurchaseTimestampOffset,
+              emp::PUBLIC};
+          vec.push_back(purchaseTs + offset > oppTs);
         }
         return vec;
       },
-      opportunityTimestamps.begin(),
-      opportunityTimestamps.end(),
-      purchaseTimestampArrays.begin());
+      opportunityTimestamps_.begin(),
+      opportunityTimestamps_.end(),
+      purchaseTimestampArrays_.begin());
 }
 
 template <int32_t MY_ROLE>
@@ -450,70 +516,24 @@ std::vector<std::vector<emp::Bit>> OutputMetrics<MY_ROLE>::calculateEvents(
   }
 
   // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    const auto& mask = publisherBitmasks_.at(i);
-    auto groupEventBits =
-        private_measurement::secret_sharing::multiplyBitmask(eventArrays, mask);
-    auto groupConverterBits =
-        private_measurement::secret_sharing::multiplyBitmask(
-            converterArrays, mask);
-    auto groupEvents = sum(groupEventBits);
-    auto groupConverters = sum(groupConverterBits);
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        squaredNumConvs, mask);
-
-    std::vector<int64_t> groupConvHistogram;
-    for (size_t bin = 0; bin < convHistograms.size(); ++bin) {
-      auto binBits = private_measurement::secret_sharing::multiplyBitmask(
-          convHistograms.at(bin), mask);
-      groupConvHistogram.push_back(sum(binBits));
-    }
-
-    if (groupType == GroupType::TEST) {
-      publisherBreakdowns_[i].testEvents = groupEvents;
-      publisherBreakdowns_[i].testConverters = groupConverters;
-      publisherBreakdowns_[i].testNumConvSquared = sum(groupInts);
-      publisherBreakdowns_[i].testConvHistogram = std::move(groupConvHistogram);
-    } else {
-      publisherBreakdowns_[i].controlEvents = groupEvents;
-      publisherBreakdowns_[i].controlConverters = groupConverters;
-      publisherBreakdowns_[i].controlNumConvSquared = sum(groupInts);
-      publisherBreakdowns_[i].controlConvHistogram =
-          std::move(groupConvHistogram);
-    }
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    const auto& mask = partnerBitmasks_.at(i);
-    auto groupEventBits =
-        private_measurement::secret_sharing::multiplyBitmask(eventArrays, mask);
-    auto groupConverterBits =
-        private_measurement::secret_sharing::multiplyBitmask(
-            converterArrays, mask);
-    auto groupEvents = sum(groupEventBits);
-    auto groupConverters = sum(groupConverterBits);
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        squaredNumConvs, mask);
-
-    std::vector<int64_t> groupConvHistogram;
-    for (size_t bin = 0; bin < convHistograms.size(); ++bin) {
-      auto binBits = private_measurement::secret_sharing::multiplyBitmask(
-          convHistograms.at(bin), mask);
-      groupConvHistogram.push_back(sum(binBits));
-    }
-
-    if (groupType == GroupType::TEST) {
-      cohortMetrics_[i].testEvents = groupEvents;
-      cohortMetrics_[i].testConverters = groupConverters;
-      cohortMetrics_[i].testNumConvSquared = sum(groupInts);
-      cohortMetrics_[i].testConvHistogram = std::move(groupConvHistogram);
-    } else {
-      cohortMetrics_[i].controlEvents = groupEvents;
-      cohortMetrics_[i].controlConverters = groupConverters;
-      cohortMetrics_[i].controlNumConvSquared = sum(groupInts);
-      cohortMetrics_[i].controlConvHistogram = std::move(groupConvHistogram);
-    }
+  bool isTest = groupType == GroupType::TEST;
+  setGroupMetric(
+      groupedSums(eventArrays),
+      isTest ? &OutputMetricsData::testEvents
+             : &OutputMetricsData::controlEvents);
+  setGroupMetric(
+      groupedSums(converterArrays),
+      isTest ? &OutputMetricsData::testConverters
+             : &OutputMetricsData::controlConverters);
+  setGroupMetric(
+      groupedSums(squaredNumConvs),
+      isTest ? &OutputMetricsData::testNumConvSquared
+             : &OutputMetricsData::controlNumConvSquared);
+  for (size_t bin = 0; bin < convHistograms.size(); ++bin) {
+    appendGroupHistogramBin(
+        groupedSums(convHistograms.at(bin)),
+        isTest ? &OutputMetricsData::testConvHistogram
+               : &OutputMetricsData::controlConvHistogram);
   }
   return eventArrays;
 }
@@ -521,26 +541,13 @@ std::vector<std::vector<emp::Bit>> OutputMetrics<MY_ROLE>::calculateEvents(
 template <int32_t MY_ROLE>
 void OutputMetrics<MY_ROLE>::calculateMatchCount(
     const OutputMetrics::GroupType& groupType,
-    const std::vector<emp::Bit>& populationBits,
-    const std::vector<std::vector<emp::Integer>>& purchaseValueArrays) {
+    const std::vector<emp::Bit>& populationBits) {
   XLOG(INFO) << "Calculate " << getGroupTypeStr(groupType) << " MatchCount";
   // a valid test/control match is when a person with an opportunity who made
   // ANY nonzero conversion. Therefore we can just check first if an opportunity
   // is valid, then bitwise AND this with the bitwise OR over all purchases (to
   // check for purchases). This gets us a binary indication if a user is
   // matched with any opportunity
-
-  XLOG(INFO) << "Share opportunity timestamps";
-  const std::vector<emp::Integer> opportunityTimestamps =
-      privatelyShareIntsFromPublisher<MY_ROLE>(
-          inputData_.getOpportunityTimestamps(), n_, QUICK_BITS);
-  XLOG(INFO) << "Share purchase timestamps";
-  const std::vector<std::vector<emp::Integer>> purchaseTimestampArrays =
-      privatelyShareIntArraysFromPartner<MY_ROLE>(
-          inputData_.getPurchaseTimestampArrays(),
-          n_, /* numVals */
-          numConversionsPerUser_ /* arraySize */,
-          QUICK_BITS /* bitLen */);
   auto matchArrays = private_measurement::functional::zip_apply(
       [](emp::Bit isUser,
          emp::Integer opportunityTimestamp,
@@ -559,8 +566,8 @@ void OutputMetrics<MY_ROLE>::calculateMatchCount(
       },
       populationBits.begin(),
       populationBits.end(),
-      opportunityTimestamps.begin(),
-      purchaseTimestampArrays.begin());
+      opportunityTimestamps_.begin(),
+      purchaseTimestampArrays_.begin());
 
   if (groupType == GroupType::TEST) {
     metrics_.testMatchCount = sum(matchArrays);
@@ -569,26 +576,10 @@ void OutputMetrics<MY_ROLE>::calculateMatchCount(
   }
 
   // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    auto groupBits = private_measurement::secret_sharing::multiplyBitmask(
-        matchArrays, publisherBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      publisherBreakdowns_[i].testMatchCount = sum(groupBits);
-    } else {
-      publisherBreakdowns_[i].controlMatchCount = sum(groupBits);
-    }
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    auto groupBits = private_measurement::secret_sharing::multiplyBitmask(
-        matchArrays, partnerBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      cohortMetrics_[i].testMatchCount = sum(groupBits);
-    } else {
-      cohortMetrics_[i].controlMatchCount = sum(groupBits);
-    }
-  }
+  setGroupMetric(
+      groupedSums(matchArrays),
+      groupType == GroupType::TEST ? &OutputMetricsData::testMatchCount
+                                   : &OutputMetricsData::controlMatchCount);
 }
 
 template <int32_t MY_ROLE>
@@ -600,37 +591,19 @@ std::vector<emp::Bit> OutputMetrics<MY_ROLE>::calculateImpressions(
 
   const std::vector<emp::Integer> numImpressions =
       privatelyShareIntsFromPublisher<MY_ROLE>(
-          inputData_.getNumImpressions(), n_, FULL_BITS);
+          inputData_.getNumImpressions(), n_, impressionBits_);
 
-  auto [impressionsArray, reachArray] = private_measurement::secret_sharing::
-      zip_and_map<emp::Bit, emp::Integer, emp::Integer, emp::Bit>(
+  // Only reach is used, so impressions are not muxed by population
+  auto reachArray = private_measurement::secret_sharing::
+      zip_and_map<emp::Bit, emp::Integer, emp::Bit>(
           populationBits,
           numImpressions,
-          [](emp::Bit isUser,
-             emp::Integer numImpressions) -> std::pair<emp::Integer, emp::Bit> {
-            const emp::Integer zero =
-                emp::Integer{private_measurement::INT_SIZE, 0, emp::PUBLIC};
-            return std::make_pair(
-                emp::If(isUser, numImpressions, zero),
-                isUser & (numImpressions > zero));
+          [](emp::Bit isUser, emp::Integer numImpressions) -> emp::Bit {
+            const emp::Integer zero = emp::Integer{
+                static_cast<int>(numImpressions.size()), 0, emp::PUBLIC};
+            return isUser & (numImpressions > zero);
           });
 
-  // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        impressionsArray, publisherBitmasks_.at(i));
-    auto groupBits = private_measurement::secret_sharing::multiplyBitmask(
-        reachArray, publisherBitmasks_.at(i));
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        impressionsArray, partnerBitmasks_.at(i));
-    auto groupBits = private_measurement::secret_sharing::multiplyBitmask(
-        reachArray, partnerBitmasks_.at(i));
-  }
-
   return reachArray;
 }
 
@@ -668,28 +641,8 @@ void OutputMetrics<MY_ROLE>::calculateReachedConversions(
   }
 
   // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        reachedConversions, publisherBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      publisherBreakdowns_[i].reachedConversions = sum(groupInts);
-    } else {
-      XLOG(FATAL) << "Calculation of reached conversions for control group not "
-                     "supported";
-    }
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        reachedConversions, partnerBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      cohortMetrics_[i].reachedConversions = sum(groupInts);
-    } else {
-      XLOG(FATAL) << "Calculation of reached conversions for control group not "
-                     "supported";
-    }
-  }
+  setGroupMetric(
+      groupedSums(reachedConversions), &OutputMetricsData::reachedConversions);
 }
 
 template <int32_t MY_ROLE>
@@ -747,33 +700,12 @@ void OutputMetrics<MY_ROLE>::calculateValue(
   }
 
   // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        valueArrays, publisherBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      publisherBreakdowns_[i].testValue = sum(groupInts);
-      auto reachedGroupInts =
-          private_measurement::secret_sharing::multiplyBitmask(
-              reachedValue, publisherBitmasks_.at(i));
-      publisherBreakdowns_[i].reachedValue = sum(reachedGroupInts);
-    } else {
-      publisherBreakdowns_[i].controlValue = sum(groupInts);
-    }
-  }
-
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        valueArrays, partnerBitmasks_.at(i));
-    if (groupType == GroupType::TEST) {
-      cohortMetrics_[i].testValue = sum(groupInts);
-      auto reachedGroupInts =
-          private_measurement::secret_sharing::multiplyBitmask(
-              reachedValue, partnerBitmasks_.at(i));
-      cohortMetrics_[i].reachedValue = sum(reachedGroupInts);
-    } else {
-      cohortMetrics_[i].controlValue = sum(groupInts);
-    }
+  if (groupType == GroupType::TEST) {
+    setGroupMetric(groupedSums(valueArrays), &OutputMetricsData::testValue);
+    setGroupMetric(
+        groupedSums(reachedValue), &OutputMetricsData::reachedValue);
+  } else {
+    setGroupMetric(groupedSums(valueArrays), &OutputMetricsData::controlValue);
   }
 }
 
@@ -817,39 +749,68 @@ void OutputMetrics<MY_ROLE>::calculateValueSquared(
   }
 
   // And compute for breakdowns + cohorts
-  // TODO: These could be abstracted into a common function
-  for (size_t i = 0; i < numPublisherBreakdowns_; ++i) {
-    const auto& mask = publisherBitmasks_.at(i);
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        squaredValues, mask);
-    if (groupType == GroupType::TEST) {
-      publisherBreakdowns_[i].testValueSquared = sum(groupInts);
-    } else {
-      publisherBreakdowns_[i].controlValueSquared = sum(groupInts);
-    }
+  setGroupMetric(
+      groupedSums(squaredValues),
+      groupType == GroupType::TEST ? &OutputMetricsData::testValueSquared
+                                   : &OutputMetricsData::controlValueSquared);
+}
+
+template <int32_t MY_ROLE>
+template <class T>
+typename OutputMetrics<MY_ROLE>::GroupSums OutputMetrics<MY_ROLE>::groupedSums(
+    const std::vector<T>& in) const {
+  return std::make_pair(
+      revealSums(groupedSum(publisherGroupBits_, numPublisherBreakdowns_, in)),
+      revealSums(groupedSum(partnerGroupBits_, numPartnerCohorts_, in)));
+}
+
+template <int32_t MY_ROLE>
+void OutputMetrics<MY_ROLE>::setGroupMetric(
+    const GroupSums& sums,
+    int64_t OutputMetricsData::*metric) {
+  for (size_t i = 0; i < sums.first.size(); ++i) {
+    publisherBreakdowns_[i].*metric = sums.first.at(i);
   }
-  for (size_t i = 0; i < numPartnerCohorts_; ++i) {
-    const auto& mask = partnerBitmasks_.at(i);
-    auto groupInts = private_measurement::secret_sharing::multiplyBitmask(
-        squaredValues, mask);
-    if (groupType == GroupType::TEST) {
-      cohortMetrics_[i].testValueSquared = sum(groupInts);
-    } else {
-      cohortMetrics_[i].controlValueSquared = sum(groupInts);
-    }
+  for (size_t i = 0; i < sums.second.size(); ++i) {
+    cohortMetrics_[i].*metric = sums.second.at(i);
+  }
+}
+
+template <int32_t MY_ROLE>
+void OutputMetrics<MY_ROLE>::appendGroupHistogramBin(
+    const GroupSums& sums,
+    std::vector<int64_t> OutputMetricsData::*histogram) {
+  for (size_t i = 0; i < sums.first.size(); ++i) {
+    (publisherBreakdowns_[i].*histogram).push_back(sums.first.at(i));
+  }
+  for (size_t i = 0; i < sums.second.size(); ++i) {
+    (cohortMetrics_[i].*histogram).push_back(sums.second.at(i));
   }
 }
 
+template <int32_t MY_ROLE>
+std::vector<int64_t> OutputMetrics<MY_ROLE>::revealSums(
+    const std::vector<emp::Integer>& sums) const {
+  std::vector<int64_t> res;
+  res.reserve(sums.size());
+  for (const auto& groupSum : sums) {
+    res.push_back(revealSum(groupSum));
+  }
+  return res;
+}
+
 template <int32_t MY_ROLE>
 int64_t OutputMetrics<MY_ROLE>::sum(const std::vector<emp::Integer>& in) const {
-  return shouldUseXorEncryption()
-      ? private_measurement::emp_utils::sum<emp::XOR>(in)
-      : private_measurement::emp_utils::sum<emp::PUBLIC>(in);
+  // Integers are summed at their own width, which is just wide enough for the
+  // total of the column
+  return revealSum(private_measurement::emp_utils::secretSum(in));
 }
 
 template <int32_t MY_ROLE>
 int64_t OutputMetrics<MY_ROLE>::sum(const std::vector<emp::Bit>& in) const {
-  return sum(private_measurement::emp_utils::bitsToInts(in));
+  return shouldUseXorEncryption()
+      ? private_measurement::emp_utils::sum<emp::XOR>(in)
+      : private_measurement::emp_utils::sum<emp::PUBLIC>(in);
 }
 
 template <int32_t MY_ROLE>
@@ -0,0 +1,352 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "ShardChannelMux.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <folly/String.h>
+#include "folly/logging/xlog.h"
+
+namespace private_lift {
+
+// A channel that has read everything it was sent holds back less than
+// kCreditThreshold bytes of credit, which must leave room for a whole frame.
+// Otherwise a sender could wait for credit that a waiting reader never sends.
+static_assert(
+    ShardChannelMux::kCreditThreshold + ShardChannel::kMaxFrameSize <=
+    ShardChannelMux::kWindowSize);
+
+namespace {
+
+[[noreturn]] void throwSocketError(const std::string& what) {
+  throw std::runtime_error(
+      fmt::format("Shard connection: {}: {}", what, folly::errnoStr(errno)));
+}
+
+int listenAndAccept(uint16_t port) {
+  int listener = ::socket(AF_INET, SOCK_STREAM, 0);
+  if (listener < 0) {
+    throwSocketError("socket");
+  }
+  int reuse = 1;
+  ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_addr.s_addr = htonl(INADDR_ANY);
+  address.sin_port = htons(port);
+  auto bound = ::bind(
+      listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  if (bound < 0 || ::listen(listener, 1) < 0) {
+    ::close(listener);
+    throwSocketError(fmt::format("listen on port {}", port));
+  }
+
+  int connection = ::accept(listener, nullptr, nullptr);
+  ::close(listener);
+  if (connection < 0) {
+    throwSocketError("accept");
+  }
+  return connection;
+}
+
+// Retry until the publisher is listening, like emp::NetIO
+int connectTo(const std::string& serverIp, uint16_t port) {
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (::inet_pton(AF_INET, serverIp.c_str(), &address.sin_addr) != 1) {
+    throw std::invalid_argument(
+        fmt::format("Invalid server IP address: {}", serverIp));
+  }
+
+  while (true) {
+    int connection = ::socket(AF_INET, SOCK_STREAM, 0);
+    if (connection < 0) {
+      throwSocketError("socket");
+    }
+    if (::connect(
+            connection,
+            reinterpret_cast<sockaddr*>(&address),
+            sizeof(address)) == 0) {
+      return connection;
+    }
+    ::close(connection);
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  }
+}
+
+void sendAll(int socket, const char* data, size_t len) {
+  while (len > 0) {
+    auto sent = ::send(socket, data, len, MSG_NOSIGNAL);
+    if (sent < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSocketError("send");
+    }
+    data += sent;
+    len -= sent;
+  }
+}
+
+// Returns false if the connection was closed before the first byte
+bool receiveAll(int socket, char* data, size_t len) {
+  size_t received = 0;
+  while (received < len) {
+    auto res = ::recv(socket, data + received, len - received, 0);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throwSocketError("recv");
+    }
+    if (res == 0) {
+      if (received == 0) {
+        return false;
+      }
+      throw std::runtime_error(
+          "Shard connection closed in the middle of a frame");
+    }
+    received += res;
+  }
+  return true;
+}
+
+} // namespace
+
+ShardChannelMux::ShardChannelMux(
+    fbpcf::Party party,
+    const std::string& serverIp,
+    uint16_t port)
+    : party_{party},
+      socket_{
+          party == fbpcf::Party::Alice ? listenAndAccept(port)
+                                       : connectTo(serverIp, port)} {
+  // Frames are already batched, don't let them wait for more data
+  int noDelay = 1;
+  ::setsockopt(socket_, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+  XLOG(INFO) << "Shard connection established on port " << port;
+  reader_ = std::thread([this]() { readFrames(); });
+}
+
+ShardChannelMux::~ShardChannelMux() {
+  ::shutdown(socket_, SHUT_WR);
+  reader_.join();
+  ::close(socket_);
+}
+
+std::unique_ptr<ShardChannel> ShardChannelMux::openChannel(
+    uint32_t channelId) {
+  if (channelId == kCreditChannelId) {
+    throw std::invalid_argument(
+        fmt::format("Channel id {} is reserved", kCreditChannelId));
+  }
+  return std::make_unique<ShardChannel>(*this, channelId);
+}
+
+void ShardChannelMux::abort() {
+  XLOG(ERR) << "Closing the shard connection after an error";
+  ::shutdown(socket_, SHUT_RDWR);
+}
+
+void ShardChannelMux::sendFrame(
+    uint32_t channelId,
+    const std::vector<char>& frame) {
+  auto payloadSize = frame.size() - ShardChannel::kHeaderSize;
+  {
+    std::unique_lock<std::mutex> lock{receiveMutex_};
+    auto& unacknowledged = unacknowledgedBytes_[channelId];
+    creditReceived_.wait(lock, [&unacknowledged, payloadSize, this]() {
+      return unacknowledged + payloadSize <= kWindowSize || closed_;
+    });
+    if (closed_) {
+      throw std::runtime_error(fmt::format(
+          "Shard connection closed while channel {} was waiting to send",
+          channelId));
+    }
+    unacknowledged += payloadSize;
+  }
+  std::lock_guard<std::mutex> lock{sendMutex_};
+  sendAll(socket_, frame.data(), frame.size());
+}
+
+void ShardChannelMux::sendCredit(uint32_t channelId, size_t numBytes) {
+  uint32_t frame[4] = {
+      htonl(kCreditChannelId),
+      htonl(2 * sizeof(uint32_t)),
+      htonl(channelId),
+      htonl(static_cast<uint32_t>(numBytes))};
+  std::lock_guard<std::mutex> lock{sendMutex_};
+  sendAll(socket_, reinterpret_cast<const char*>(frame), sizeof(frame));
+}
+
+void ShardChannelMux::receive(uint32_t channelId, char* data, size_t len) {
+  std::unique_lock<std::mutex> lock{receiveMutex_};
+  auto& buffer = receiveBuffers_[channelId];
+  while (len > 0) {
+    frameReceived_.wait(
+        lock, [&buffer, this]() { return !buffer.frames.empty() || closed_; });
+    if (buffer.frames.empty()) {
+      throw std::runtime_error(fmt::format(
+          "Shard connection closed while channel {} was waiting for data",
+          channelId));
+    }
+
+    const auto& frame = buffer.frames.front();
+    auto numBytes = std::min(len, frame.size() - buffer.offset);
+    std::memcpy(data, frame.data() + buffer.offset, numBytes);
+    data += numBytes;
+    len -= numBytes;
+    buffer.offset += numBytes;
+    if (buffer.offset == frame.size()) {
+      buffer.frames.pop_front();
+      buffer.offset = 0;
+    }
+
+    // Credit is sent without holding the lock, so that the reader thread
+    // can keep handing out frames while the send waits for the socket
+    buffer.consumed += numBytes;
+    if (buffer.consumed >= kCreditThreshold) {
+      auto credit = std::exchange(buffer.consumed, 0);
+      lock.unlock();
+      sendCredit(channelId, credit);
+      lock.lock();
+    }
+  }
+}
+
+void ShardChannelMux::closeChannel(uint32_t channelId) {
+  std::lock_guard<std::mutex> lock{receiveMutex_};
+  receiveBuffers_.erase(channelId);
+  unacknowledgedBytes_.erase(channelId);
+}
+
+void ShardChannelMux::readFrames() {
+  try {
+    uint32_t header[2];
+    while (receiveAll(
+        socket_, reinterpret_cast<char*>(header), sizeof(header))) {
+      auto channelId = ntohl(header[0]);
+      std::vector<char> payload(ntohl(header[1]));
+      if (!payload.empty() &&
+          !receiveAll(socket_, payload.data(), payload.size())) {
+        throw std::runtime_error(
+            "Shard connection closed in the middle of a frame");
+      }
+      if (channelId == kCreditChannelId) {
+        receiveCredit(payload);
+        continue;
+      }
+      {
+        std::lock_guard<std::mutex> lock{receiveMutex_};
+        receiveBuffers_[channelId].frames.push_back(std::move(payload));
+      }
+      frameReceived_.notify_all();
+    }
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Error while reading from the shard connection: " << e.what();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock{receiveMutex_};
+    closed_ = true;
+  }
+  frameReceived_.notify_all();
+  creditReceived_.notify_all();
+}
+
+void ShardChannelMux::receiveCredit(const std::vector<char>& payload) {
+  uint32_t credit[2];
+  if (payload.size() != sizeof(credit)) {
+    throw std::runtime_error(fmt::format(
+        "Invalid credit frame of {} bytes on the shard connection",
+        payload.size()));
+  }
+  std::memcpy(credit, payload.data(), sizeof(credit));
+  {
+    std::lock_guard<std::mutex> lock{receiveMutex_};
+    // Credit can still arrive for a channel that was closed in the meantime
+    auto unacknowledged = unacknowledgedBytes_.find(ntohl(credit[0]));
+    if (unacknowledged != unacknowledgedBytes_.end()) {
+      unacknowledged->second -=
+          std::min<size_t>(unacknowledged->second, ntohl(credit[1]));
+    }
+  }
+  creditReceived_.notify_all();
+}
+
+ShardChannel::ShardChannel(ShardChannelMux& mux, uint32_t channelId)
+    : mux_{mux}, channelId_{channelId}, sendBuffer_(kHeaderSize) {}
+
+ShardChannel::~ShardChannel() {
+  try {
+    flush();
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Failed to flush channel " << channelId_ << ": " << e.what();
+  }
+  mux_.closeChannel(channelId_);
+}
+
+void ShardChannel::send_data_internal(const void* data, int len) {
+  auto bytes = static_cast<const char*>(data);
+  auto remaining = static_cast<size_t>(len);
+  while (remaining > 0) {
+    auto numBytes = std::min(
+        remaining, kMaxFrameSize - (sendBuffer_.size() - kHeaderSize));
+    sendBuffer_.insert(sendBuffer_.end(), bytes, bytes + numBytes);
+    bytes += numBytes;
+    remaining -= numBytes;
+    if (sendBuffer_.size() - kHeaderSize == kMaxFrameSize) {
+      flush();
+    }
+  }
+}
+
+void ShardChannel::recv_data_internal(void* data, int len) {
+  flush();
+  mux_.receive(channelId_, static_cast<char*>(data), len);
+}
+
+void ShardChannel::flush() {
+  if (sendBuffer_.size() == kHeaderSize) {
+    return;
+  }
+  uint32_t header[2] = {
+      htonl(channelId_),
+      htonl(static_cast<uint32_t>(sendBuffer_.size() - kHeaderSize))};
+  std::memcpy(sendBuffer_.data(), header, kHeaderSize);
+  mux_.sendFrame(channelId_, sendBuffer_);
+  sendBuffer_.resize(kHeaderSize);
+}
+
+void ShardChannel::sync() {
+  char tmp = 0;
+  if (mux_.getParty() == fbpcf::Party::Alice) {
+    send_data_internal(&tmp, 1);
+    recv_data_internal(&tmp, 1);
+  } else {
+    recv_data_internal(&tmp, 1);
+    send_data_internal(&tmp, 1);
+    flush();
+  }
+}
+
+} // namespace private_lift
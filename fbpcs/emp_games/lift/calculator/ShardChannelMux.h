@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+#include <fbpcf/mpc/EmpGame.h>
+
+namespace private_lift {
+
+class ShardChannel;
+
+/*
+ * Carries the EMP traffic of many shard games over a single TCP connection,
+ * instead of one connection and one port per shard. Every shard talks on its
+ * own logical channel: writes are buffered per channel and sent as frames of
+ * [channel id, length, payload], and a reader thread hands every incoming
+ * frame to the receive buffer of its channel. Channels never block each other,
+ * so any number of shards can run on the connection at the same time.
+ *
+ * Every channel has a window of kWindowSize bytes that may be sent but not
+ * yet read by the other party. A sender blocks once its window is full, and
+ * the reader hands credit back as it consumes data. That bounds what the
+ * connection buffers per channel, e.g. when the parties run with a different
+ * number of workers and the peer is not reading a channel yet.
+ */
+class ShardChannelMux {
+ public:
+  static constexpr size_t kWindowSize = 8 << 20;
+  // Credit is handed back once this many bytes of a channel have been read
+  static constexpr size_t kCreditThreshold = kWindowSize / 4;
+  // Frames on this channel id carry credit instead of shard traffic
+  static constexpr uint32_t kCreditChannelId = UINT32_MAX;
+
+  // The publisher listens on port, and the partner connects to serverIp:port
+  ShardChannelMux(
+      fbpcf::Party party,
+      const std::string& serverIp,
+      uint16_t port);
+
+  // Waits until the other party has closed its side of the connection, so
+  // that no frame is lost
+  ~ShardChannelMux();
+
+  ShardChannelMux(const ShardChannelMux&) = delete;
+  ShardChannelMux& operator=(const ShardChannelMux&) = delete;
+
+  // Open the logical channel of a shard. Both parties must open the same
+  // channel id for the same shard, and an id must not be opened again once
+  // its channel is closed. kCreditChannelId is reserved.
+  std::unique_ptr<ShardChannel> openChannel(uint32_t channelId);
+
+  // Close the connection right away, which fails every pending and later
+  // read or send on it, on both sides. This is how a failed shard keeps the
+  // other shards from waiting forever on a peer that will never answer.
+  void abort();
+
+  fbpcf::Party getParty() const {
+    return party_;
+  }
+
+ private:
+  friend class ShardChannel;
+
+  // The incoming frames of a channel that have not been read yet. The first
+  // offset bytes of the front frame have been read already, and consumed
+  // bytes have been read without handing credit back for them.
+  struct ReceiveBuffer {
+    std::deque<std::vector<char>> frames;
+    size_t offset = 0;
+    size_t consumed = 0;
+  };
+
+  // Send a whole frame of a channel, whose header has been filled in
+  // already. Blocks while the window of the channel is full.
+  void sendFrame(uint32_t channelId, const std::vector<char>& frame);
+
+  // Let the other party send numBytes more on the channel
+  void sendCredit(uint32_t channelId, size_t numBytes);
+
+  // Block until len bytes have been received on the channel
+  void receive(uint32_t channelId, char* data, size_t len);
+
+  void closeChannel(uint32_t channelId);
+
+  void readFrames();
+
+  void receiveCredit(const std::vector<char>& payload);
+
+  fbpcf::Party party_;
+  int socket_;
+
+  std::mutex sendMutex_;
+
+  // Guards the receive buffers, the send windows and closed_
+  std::mutex receiveMutex_;
+  std::condition_variable frameReceived_;
+  std::condition_variable creditReceived_;
+  std::unordered_map<uint32_t, ReceiveBuffer> receiveBuffers_;
+  // Bytes sent per channel that the other party has not handed credit for
+  std::unordered_map<uint32_t, size_t> unacknowledgedBytes_;
+  bool closed_ = false;
+
+  std::thread reader_;
+};
+
+/*
+ * The logical channel of one shard, which EMP games use like an emp::NetIO.
+ * Like NetIO, pending writes are flushed before every read.
+ */
+class ShardChannel : public emp::IOChannel<ShardChannel> {
+ public:
+  // Frame header: channel id and payload length, in network byte order
+  static constexpr size_t kHeaderSize = 2 * sizeof(uint32_t);
+  // Writes are sent once this many bytes are pending, and no frame is larger
+  static constexpr size_t kMaxFrameSize = 1 << 20;
+
+  ShardChannel(ShardChannelMux& mux, uint32_t channelId);
+  ~ShardChannel();
+
+  void send_data_internal(const void* data, int len);
+  void recv_data_internal(void* data, int len);
+  void flush();
+  void sync();
+
+ private:
+  ShardChannelMux& mux_;
+  uint32_t channelId_;
+  std::vector<char> sendBuffer_;
+};
+
+} // namespace private_lift
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace private_lift {
+
+/*
+ * Run every shard app on a fixed pool of workers, which take the next shard
+ * from a shared queue as soon as they are done with the previous one, instead
+ * of running the shards in batches of numWorkers.
+ *
+ * Workers take the shards in order, so the lowest unfinished shard is always
+ * running on both sides. That is what keeps shards that share a multiplexed
+ * connection from waiting on each other forever, even when the parties run
+ * with a different number of workers.
+ *
+ * Once a shard throws, no more shards are handed out. The workers that are
+ * still running are joined, and the first error is rethrown. onError is
+ * called as soon as that error happens, so that shards waiting on a peer that
+ * will never answer them can be unblocked, e.g. by closing the connection.
+ * Throws std::invalid_argument unless numWorkers is positive.
+ */
+template <class App>
+void runShards(
+    const std::vector<std::unique_ptr<App>>& apps,
+    int32_t numWorkers,
+    std::function<void()> onError = nullptr) {
+  if (numWorkers <= 0) {
+    throw std::invalid_argument(
+        "Must run the shards on a positive number of workers!");
+  }
+  if (apps.empty()) {
+    return;
+  }
+  std::atomic<size_t> nextShard{0};
+  std::atomic<bool> failed{false};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto numThreads = std::min<size_t>(numWorkers, apps.size());
+
+  std::vector<std::thread> workers;
+  workers.reserve(numThreads);
+  for (size_t i = 0; i < numThreads; ++i) {
+    workers.emplace_back([&]() {
+      for (auto shard = nextShard++; !failed && shard < apps.size();
+           shard = nextShard++) {
+        try {
+          apps.at(shard)->run();
+        } catch (...) {
+          std::lock_guard<std::mutex> lock{errorMutex};
+          if (!error) {
+            error = std::current_exception();
+            failed = true;
+            if (onError) {
+              onError();
+            }
+          }
+        }
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace private_lift
@@ -7,6 +7,7 @@
 
 #include <cstdio>
 #include <cstdlib>
+#include <exception>
 
 #include <glog/logging.h>
 #include <filesystem>
@@ -21,6 +22,8 @@
 #include <fbpcf/aws/AwsSdk.h>
 #include <fbpcf/mpc/MpcAppExecutor.h>
 #include "CalculatorApp.h"
+#include "ShardChannelMux.h"
+#include "ShardWorkerPool.h"
 
 DEFINE_int32(party, 1, "1 = publisher, 2 = partner");
 DEFINE_string(server_ip, "127.0.0.1", "Server's IP Address");
@@ -77,6 +80,11 @@ DEFINE_int32(
     concurrency,
     1,
     "max number of game(s) that will run concurrently?");
+DEFINE_bool(
+    multiplex_shards,
+    false,
+    "Run all shards over a single connection on port, instead of one "
+    "connection per shard on port + i. Both parties must use the same setting");
 
 using namespace private_lift;
 
@@ -138,6 +146,7 @@ int main(int argc, char** argv) {
                << "\tserver_ip_address: " << FLAGS_server_ip << "\n"
                << "\tport: " << FLAGS_port << "\n"
                << "\tconcurrency: " << FLAGS_concurrency << "\n"
+               << "\tmultiplex_shards: " << FLAGS_multiplex_shards << "\n"
                << "\tinput: " << inputFileLogList.str() << "\n"
                << "\toutput: " << outputFileLogList.str();
   }
@@ -148,6 +157,31 @@ int main(int argc, char** argv) {
   // int16_t is necessarys here
   int16_t concurrency = static_cast<int16_t>(FLAGS_concurrency);
 
+  if (FLAGS_multiplex_shards) {
+    // Every shard runs on its own channel of one shared connection, and a
+    // fixed pool of workers takes the shards in order. The connection is
+    // closed once every shard is done, or as soon as one of them fails.
+    auto mux = std::make_shared<ShardChannelMux>(
+        party, FLAGS_server_ip, FLAGS_port);
+    std::vector<std::unique_ptr<CalculatorApp>> calculatorApps;
+    for (std::size_t i = 0; i < inputFilepaths.size(); i++) {
+      calculatorApps.push_back(std::make_unique<CalculatorApp>(
+          party,
+          mux,
+          i,
+          inputFilepaths[i],
+          outputFilepaths[i],
+          FLAGS_use_xor_encryption));
+    }
+    try {
+      runShards(calculatorApps, concurrency, [&mux]() { mux->abort(); });
+    } catch (const std::exception& e) {
+      XLOGF(ERR, "Error: running the shards failed: {}", e.what());
+      return 1;
+    }
+    return 0;
+  }
+
   // construct calculatorApps according to  FLAGS_num_shards and
   // FLAGS_concurrency
   std::vector<std::unique_ptr<CalculatorApp>> calculatorApps;
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../BitWidths.h"
+
+namespace private_lift {
+
+const int64_t kEpoch = 1546300800;
+
+TEST(BitWidthsTest, TestSignedBitsFor) {
+  EXPECT_EQ(signedBitsFor(0, 0), 1);
+  EXPECT_EQ(signedBitsFor(-1, 0), 1);
+  EXPECT_EQ(signedBitsFor(0, 1), 2);
+  EXPECT_EQ(signedBitsFor(-2, 1), 2);
+  EXPECT_EQ(signedBitsFor(-3, 1), 3);
+  EXPECT_EQ(signedBitsFor(0, 255), 9);
+  EXPECT_EQ(signedBitsFor(-kEpoch, 0), 32);
+  EXPECT_EQ(signedBitsFor(0, INT64_MAX), 64);
+  EXPECT_EQ(signedBitsFor(INT64_MIN, 0), 64);
+}
+
+TEST(BitWidthsTest, TestCompactTimestampsKeepComparisons) {
+  // Missing timestamps, and timestamps around the offset
+  std::vector<int64_t> timestamps{-kEpoch, 0, 1, 9, 10, 11, 100};
+  for (auto opportunityTs : timestamps) {
+    for (auto purchaseTs : timestamps) {
+      EXPECT_EQ(
+          purchaseTs + kPurchaseTimestampOffset > opportunityTs,
+          compactTimestamp(purchaseTs) + kPurchaseTimestampOffset >
+              compactTimestamp(opportunityTs));
+    }
+    EXPECT_EQ(opportunityTs > 0, compactTimestamp(opportunityTs) > 0);
+  }
+}
+
+TEST(BitWidthsTest, TestBitsForTimestamps) {
+  // 30 days after the epoch fits in 23 bits with the sign bit
+  std::vector<int64_t> opportunityTimestamps{-kEpoch, 0, 2592000};
+  EXPECT_EQ(
+      compactTimestamps(opportunityTimestamps),
+      (std::vector<int64_t>{kMissingTimestamp, 0, 2592000}));
+  EXPECT_EQ(bitsForTimestamps(opportunityTimestamps), 23);
+
+  std::vector<std::vector<int64_t>> purchaseTimestampArrays{
+      {-kEpoch}, {}, {5, 1000}};
+  EXPECT_EQ(bitsForTimestamps(purchaseTimestampArrays), 11);
+  // The offset never makes the width smaller than what the offset and the
+  // missing timestamps need on their own
+  EXPECT_EQ(
+      bitsForTimestamps(
+          std::vector<std::vector<int64_t>>{}, kPurchaseTimestampOffset),
+      5);
+  EXPECT_EQ(
+      bitsForTimestamps(purchaseTimestampArrays, kPurchaseTimestampOffset),
+      11);
+  EXPECT_EQ(
+      bitsForTimestamps(
+          std::vector<std::vector<int64_t>>{{1020}}, kPurchaseTimestampOffset),
+      12);
+}
+
+} // namespace private_lift
@@ -6,8 +6,11 @@
  */
 
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -18,6 +21,8 @@
 #include <fbpcf/mpc/EmpGame.h>
 #include "../../../common/Csv.h"
 #include "../CalculatorApp.h"
+#include "../ShardChannelMux.h"
+#include "../ShardWorkerPool.h"
 #include "common/GenFakeData.h"
 #include "common/LiftCalculator.h"
 
@@ -75,6 +80,44 @@ class CalculatorAppTest : public ::testing::Test {
         .run();
   }
 
+  // Run numShards copies of the input as shards of one multiplexed connection
+  static void runMultiplexedShards(
+      const fbpcf::Party party,
+      const std::string& serverIp,
+      const uint16_t port,
+      const std::filesystem::path& inputPath,
+      const std::vector<std::string>& outputPaths,
+      int32_t concurrency) {
+    auto mux = std::make_shared<ShardChannelMux>(party, serverIp, port);
+    std::vector<std::unique_ptr<CalculatorApp>> apps;
+    for (size_t i = 0; i < outputPaths.size(); ++i) {
+      apps.push_back(std::make_unique<CalculatorApp>(
+          party, mux, i, inputPath, outputPaths.at(i), false));
+    }
+    runShards(apps, concurrency);
+  }
+
+  GroupedLiftMetrics computeExpectedMetrics() {
+    LiftCalculator liftCalculator;
+    std::ifstream inFileAlice{inputPathAlice_};
+    std::ifstream inFileBob{inputPathBob_};
+    std::string linePublisher;
+    std::string linePartner;
+    getline(inFileAlice, linePublisher);
+    getline(inFileBob, linePartner);
+    auto headerPublisher =
+        private_measurement::csv::splitByComma(linePublisher, false);
+    auto headerPartner =
+        private_measurement::csv::splitByComma(linePartner, false);
+    auto colNameToIndex =
+        liftCalculator.mapColToIndex(headerPublisher, headerPartner);
+    OutputMetricsData computedResult = liftCalculator.compute(
+        inFileAlice, inFileBob, colNameToIndex, tsOffset);
+    GroupedLiftMetrics expectedRes;
+    expectedRes.metrics = computedResult.toLiftMetrics();
+    return expectedRes;
+  }
+
  protected:
   uint16_t port_;
   std::string inputPathAlice_;
@@ -104,28 +147,54 @@ TEST_F(CalculatorAppTest, RandomInputTestVisibilityPublic) {
   futureAlice.wait();
   futureBob.wait();
 
-  LiftCalculator liftCalculator;
-  std::ifstream inFileAlice{inputPathAlice_};
-  std::ifstream inFileBob{inputPathBob_};
-  std::string linePublisher;
-  std::string linePartner;
-  getline(inFileAlice, linePublisher);
-  getline(inFileBob, linePartner);
-  auto headerPublisher =
-      private_measurement::csv::splitByComma(linePublisher, false);
-  auto headerPartner =
-      private_measurement::csv::splitByComma(linePartner, false);
-  auto colNameToIndex =
-      liftCalculator.mapColToIndex(headerPublisher, headerPartner);
-  OutputMetricsData computedResult =
-      liftCalculator.compute(inFileAlice, inFileBob, colNameToIndex, tsOffset);
-  GroupedLiftMetrics expectedRes;
-  expectedRes.metrics = computedResult.toLiftMetrics();
-
+  auto expectedRes = computeExpectedMetrics();
   auto resAlice =
       GroupedLiftMetrics::fromJson(fbpcf::io::read(outputPathAlice_));
   auto resBob = GroupedLiftMetrics::fromJson(fbpcf::io::read(outputPathBob_));
   EXPECT_EQ(expectedRes, resAlice);
   EXPECT_EQ(expectedRes, resBob);
 }
+
+TEST_F(CalculatorAppTest, RandomInputTestMultiplexedShards) {
+  const size_t numShards = 3;
+  std::vector<std::string> outputPathsAlice;
+  std::vector<std::string> outputPathsBob;
+  for (size_t i = 0; i < numShards; ++i) {
+    outputPathsAlice.push_back(folly::sformat("{}_{}", outputPathAlice_, i));
+    outputPathsBob.push_back(folly::sformat("{}_{}", outputPathBob_, i));
+  }
+
+  // The parties don't need to run the same number of shards at once
+  auto futureAlice = std::async(
+      runMultiplexedShards,
+      fbpcf::Party::Alice,
+      "",
+      port_,
+      inputPathAlice_,
+      outputPathsAlice,
+      2 /* concurrency */);
+  auto futureBob = std::async(
+      runMultiplexedShards,
+      fbpcf::Party::Bob,
+      "127.0.0.1",
+      port_,
+      inputPathBob_,
+      outputPathsBob,
+      3 /* concurrency */);
+
+  futureAlice.get();
+  futureBob.get();
+
+  auto expectedRes = computeExpectedMetrics();
+  for (size_t i = 0; i < numShards; ++i) {
+    EXPECT_EQ(
+        expectedRes,
+        GroupedLiftMetrics::fromJson(fbpcf::io::read(outputPathsAlice.at(i))));
+    EXPECT_EQ(
+        expectedRes,
+        GroupedLiftMetrics::fromJson(fbpcf::io::read(outputPathsBob.at(i))));
+    std::filesystem::remove(outputPathsAlice.at(i));
+    std::filesystem::remove(outputPathsBob.at(i));
+  }
+}
 } // namespace private_lift
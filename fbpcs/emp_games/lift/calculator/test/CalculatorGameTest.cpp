@@ -6,6 +6,7 @@
  */
 
 #include <filesystem>
+#include <fstream>
 #include <memory>
 #include <string>
 #include <thread>
@@ -151,4 +152,32 @@ TEST_F(CalculatorGameTest, TestRandomInputConversionLiftValueless) {
       std::move(configRandomConversionAlice),
       std::move(configRandomConversionBob));
 }
+TEST_F(CalculatorGameTest, TestConversionLiftWithRefunds) {
+  // Refunds are negative purchase values, which make some partial sums and
+  // both the test and control totals negative
+  {
+    std::ofstream publisherFile{aliceInputFilename_};
+    publisherFile
+        << "id_,opportunity,test_flag,opportunity_timestamp,num_impressions,"
+        << "num_clicks,total_spend\n"
+        << "a,1,1,1600000000,2,1,100\n"
+        << "b,1,1,1600000000,0,0,50\n"
+        << "c,1,0,1600000000,0,0,0\n"
+        << "d,1,0,1600000000,3,1,20\n";
+    std::ofstream partnerFile{bobInputFilename_};
+    partnerFile << "id_,event_timestamps,values\n"
+                << "a,[1600000100,1600000200,1600000300,1600000400],"
+                << "[40,-40,10,-25]\n"
+                << "b,[0,0,1600000100,1600000200],[0,0,-30,5]\n"
+                << "c,[0,0,0,1600000100],[0,0,0,-70]\n"
+                << "d,[0,0,1600000100,1600000200],[0,0,20,-5]\n";
+  }
+
+  CalculatorGameConfig configAlice =
+      CalculatorGameTest::getInputData(aliceInputFilename_, true);
+  CalculatorGameConfig configBob =
+      CalculatorGameTest::getInputData(bobInputFilename_, true);
+
+  runTest(std::move(configAlice), std::move(configBob));
+}
 } // namespace private_lift
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include "../../../common/EmpOperationUtil.h"
+#include "../../../common/SecretSharing.h"
+#include "../GroupedAggregation.h"
+
+namespace private_lift {
+
+using private_measurement::secret_sharing::privatelyShareArraysFromBob;
+using private_measurement::secret_sharing::privatelyShareBitsFromAlice;
+using private_measurement::secret_sharing::privatelyShareIntsFromAlice;
+
+const size_t kNumRows = 1000;
+const size_t kNumConversionsPerUser = 4;
+
+// Every row is in group (row % numGroups) and has kNumConversionsPerUser
+// event bits, every other one of which is set.
+std::vector<int64_t> getGroupIndices(int64_t numGroups) {
+  std::vector<int64_t> groupIndices;
+  for (size_t i = 0; i < kNumRows; ++i) {
+    groupIndices.push_back(i % numGroups);
+  }
+  return groupIndices;
+}
+
+std::vector<std::vector<emp::Bit>> shareEvents(fbpcf::Party party) {
+  std::vector<std::vector<bool>> events(
+      kNumRows, std::vector<bool>(kNumConversionsPerUser));
+  for (size_t i = 0; i < kNumRows; ++i) {
+    for (size_t j = 0; j < kNumConversionsPerUser; ++j) {
+      events.at(i).at(j) = (i + j) % 2;
+    }
+  }
+  return party == fbpcf::Party::Alice
+      ? privatelyShareArraysFromBob<emp::ALICE, bool, emp::Bit>(
+            {}, kNumRows, 0, false)
+      : privatelyShareArraysFromBob<emp::BOB, bool, emp::Bit>(
+            events, kNumRows, kNumConversionsPerUser, false);
+}
+
+// Share one bitmask per group, then mask and sum the events once per group
+void runBitmaskAggregation(fbpcf::Party party, int64_t numGroups) {
+  auto events = shareEvents(party);
+  auto groupIndices = getGroupIndices(numGroups);
+  for (int64_t group = 0; group < numGroups; ++group) {
+    std::vector<int64_t> bitmask;
+    for (auto groupIndex : groupIndices) {
+      bitmask.push_back(groupIndex == group);
+    }
+    auto mask = party == fbpcf::Party::Alice
+        ? privatelyShareBitsFromAlice<emp::ALICE>(bitmask, kNumRows)
+        : privatelyShareBitsFromAlice<emp::BOB>({}, kNumRows);
+    auto groupEvents =
+        private_measurement::secret_sharing::multiplyBitmask(events, mask);
+    std::vector<emp::Bit> flattened;
+    for (const auto& row : groupEvents) {
+      flattened.insert(flattened.end(), row.begin(), row.end());
+    }
+    folly::doNotOptimizeAway(private_measurement::emp_utils::sum(flattened));
+  }
+}
+
+// Share the group index of every row once, then fill every group in one pass
+void runGroupedAggregation(fbpcf::Party party, int64_t numGroups) {
+  auto events = shareEvents(party);
+  auto bitLen = bitsFor(numGroups);
+  auto indices = party == fbpcf::Party::Alice
+      ? privatelyShareIntsFromAlice<emp::ALICE>(
+            getGroupIndices(numGroups), kNumRows, bitLen)
+      : privatelyShareIntsFromAlice<emp::BOB>({}, kNumRows, bitLen);
+  std::vector<std::vector<emp::Bit>> groupBits;
+  for (const auto& index : indices) {
+    groupBits.push_back(demux(index, numGroups));
+  }
+  for (const auto& sum : groupedSum(groupBits, numGroups, events)) {
+    folly::doNotOptimizeAway(sum.reveal<int64_t>());
+  }
+}
+
+void benchmarkAggregation(
+    std::function<void(fbpcf::Party, int64_t)> aggregation,
+    int64_t numGroups) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [&aggregation, numGroups](fbpcf::Party party) {
+        aggregation(party, numGroups);
+      });
+}
+
+BENCHMARK(BitmaskAggregation_1Cohort) {
+  benchmarkAggregation(runBitmaskAggregation, 1);
+}
+
+BENCHMARK_RELATIVE(GroupedAggregation_1Cohort) {
+  benchmarkAggregation(runGroupedAggregation, 1);
+}
+
+BENCHMARK(BitmaskAggregation_8Cohorts) {
+  benchmarkAggregation(runBitmaskAggregation, 8);
+}
+
+BENCHMARK_RELATIVE(GroupedAggregation_8Cohorts) {
+  benchmarkAggregation(runGroupedAggregation, 8);
+}
+
+BENCHMARK(BitmaskAggregation_64Cohorts) {
+  benchmarkAggregation(runBitmaskAggregation, 64);
+}
+
+BENCHMARK_RELATIVE(GroupedAggregation_64Cohorts) {
+  benchmarkAggregation(runGroupedAggregation, 64);
+}
+
+} // namespace private_lift
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
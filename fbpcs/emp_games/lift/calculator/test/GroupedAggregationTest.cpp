@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <functional>
+#include <vector>
+
+#include <emp-sh2pc/emp-sh2pc.h>
+#include <gtest/gtest.h>
+
+#include <fbpcf/mpc/EmpTestUtil.h>
+#include "../../../common/SecretSharing.h"
+#include "../GroupedAggregation.h"
+
+namespace private_lift {
+
+using private_measurement::secret_sharing::privatelyShareBitsFromBob;
+using private_measurement::secret_sharing::privatelyShareIntsFromAlice;
+using private_measurement::secret_sharing::privatelyShareIntsFromBob;
+
+// Alice shares the group index of each row, and returns the group bits
+std::vector<std::vector<emp::Bit>> shareGroupBits(
+    fbpcf::Party party,
+    const std::vector<int64_t>& groupIndices,
+    int64_t numGroups) {
+  auto bitLen = bitsFor(numGroups);
+  auto indices = party == fbpcf::Party::Alice
+      ? privatelyShareIntsFromAlice<emp::ALICE>(
+            groupIndices, groupIndices.size(), bitLen)
+      : privatelyShareIntsFromAlice<emp::BOB>(
+            std::vector<int64_t>(), groupIndices.size(), bitLen);
+  std::vector<std::vector<emp::Bit>> groupBits;
+  for (const auto& index : indices) {
+    groupBits.push_back(demux(index, numGroups));
+  }
+  return groupBits;
+}
+
+std::vector<int64_t> revealSums(const std::vector<emp::Integer>& sums) {
+  std::vector<int64_t> res;
+  for (const auto& sum : sums) {
+    res.push_back(sum.reveal<int64_t>());
+  }
+  return res;
+}
+
+TEST(GroupedAggregationTest, TestBitsFor) {
+  EXPECT_EQ(bitsFor(0), 1);
+  EXPECT_EQ(bitsFor(1), 1);
+  EXPECT_EQ(bitsFor(2), 2);
+  EXPECT_EQ(bitsFor(7), 3);
+  EXPECT_EQ(bitsFor(8), 4);
+  EXPECT_EQ(bitsFor(65536), 17);
+}
+
+TEST(GroupedAggregationTest, TestDemux) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party party) {
+        // index 5 is the sentinel for rows without a group
+        std::vector<int64_t> groupIndices{0, 4, 2, 5, 1, 3};
+        auto groupBits = shareGroupBits(party, groupIndices, 5);
+
+        ASSERT_EQ(groupBits.size(), groupIndices.size());
+        for (size_t row = 0; row < groupIndices.size(); ++row) {
+          ASSERT_EQ(groupBits.at(row).size(), 5);
+          for (int64_t group = 0; group < 5; ++group) {
+            EXPECT_EQ(
+                groupBits.at(row).at(group).reveal<bool>(),
+                groupIndices.at(row) == group);
+          }
+        }
+      });
+}
+
+TEST(GroupedAggregationTest, TestAddBit) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        emp::Integer accumulator{8, 254, emp::PUBLIC};
+        addBit(accumulator, emp::Bit{true, emp::ALICE});
+        EXPECT_EQ(accumulator.reveal<int64_t>(), 255);
+        addBit(accumulator, emp::Bit{false, emp::BOB});
+        EXPECT_EQ(accumulator.reveal<int64_t>(), 255);
+      });
+}
+
+TEST(GroupedAggregationTest, TestGroupedSumOfBits) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party party) {
+        std::vector<int64_t> groupIndices{0, 1, 2, 0, 1, 2, 3};
+        std::vector<int64_t> bobBits{1, 1, 0, 1, 0, 1, 1};
+        auto groupBits = shareGroupBits(party, groupIndices, 3);
+        auto bits = party == fbpcf::Party::Alice
+            ? privatelyShareBitsFromBob<emp::ALICE>(
+                  std::vector<int64_t>(), bobBits.size())
+            : privatelyShareBitsFromBob<emp::BOB>(bobBits, bobBits.size());
+
+        auto sums = groupedSum(groupBits, 3, bits);
+        ASSERT_EQ(sums.size(), 3);
+        EXPECT_EQ(sums.at(0).size(), private_measurement::INT_SIZE);
+        EXPECT_EQ(revealSums(sums), std::vector<int64_t>({2, 1, 1}));
+      });
+}
+
+TEST(GroupedAggregationTest, TestGroupedSumOfIntegerArrays) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party party) {
+        std::vector<int64_t> groupIndices{1, 0, 1, 2};
+        std::vector<std::vector<int64_t>> bobValues{
+            {10, 20}, {1, 2}, {100, 200}, {7, 8}};
+        auto groupBits = shareGroupBits(party, groupIndices, 2);
+
+        std::vector<std::vector<emp::Integer>> values;
+        for (const auto& row : bobValues) {
+          values.push_back(
+              party == fbpcf::Party::Alice
+                  ? privatelyShareIntsFromBob<emp::ALICE>(
+                        std::vector<int64_t>(), row.size(), 32)
+                  : privatelyShareIntsFromBob<emp::BOB>(row, row.size(), 32));
+        }
+
+        auto sums = groupedSum(groupBits, 2, values);
+        ASSERT_EQ(sums.size(), 2);
+        EXPECT_EQ(sums.at(0).size(), 32);
+        EXPECT_EQ(revealSums(sums), std::vector<int64_t>({3, 330}));
+      });
+}
+
+TEST(GroupedAggregationTest, TestGroupedSumWithoutGroups) {
+  fbpcf::mpc::wrapTestWithParty<std::function<void(fbpcf::Party party)>>(
+      [](fbpcf::Party /* party */) {
+        std::vector<emp::Bit> bits(4, emp::Bit{true, emp::PUBLIC});
+        EXPECT_TRUE(groupedSum({}, 0, bits).empty());
+      });
+}
+
+} // namespace private_lift
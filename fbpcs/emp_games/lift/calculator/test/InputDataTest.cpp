@@ -6,10 +6,12 @@
  */
 
 #include <filesystem>
+#include <fstream>
 #include <string>
 
 #include <gtest/gtest.h>
 
+#include "folly/Format.h"
 #include "folly/Random.h"
 
 #include "../../../common/TestUtil.h"
@@ -156,6 +158,39 @@ TEST_F(InputDataTest, TestInputDataPartnerConverterLift) {
   EXPECT_EQ(expectPurchaseValuesSquared, resPurchaseValuesSquared);
 }
 
+TEST_F(InputDataTest, TestNumBitsForNegativeValues) {
+  auto filename = folly::sformat(
+      "{}/partner_refunds_{}.csv",
+      std::filesystem::temp_directory_path().string(),
+      folly::Random::secureRand64());
+  {
+    std::ofstream file{filename};
+    file << "id_,event_timestamps,values\n"
+         << "a,[1600000000, 1600000001, 1600000002, 1600000003],"
+         << "[10, -20, 5, 0]\n"
+         << "b,[1600000000, 0, 0, 0],[-3, 0, 0, 0]\n";
+  }
+  InputData inputData{
+      filename,
+      InputData::LiftMPCType::Standard,
+      InputData::LiftGranularityType::Conversion,
+      0, /* epoch */
+      4 /* num_conversions_per_user */};
+  std::filesystem::remove(filename);
+
+  // The squares of the sums of every suffix of values. The largest one is not
+  // the first when some values are negative.
+  std::vector<std::vector<int64_t>> expectPurchaseValueSquaredArrays = {
+      {25, 225, 25, 0}, {9, 0, 0, 0}};
+  EXPECT_EQ(
+      expectPurchaseValueSquaredArrays,
+      inputData.getPurchaseValueSquaredArrays());
+  // |10| + |-20| + |5| + |-3| = 38 needs 6 bits, plus a sign bit
+  EXPECT_EQ(7, inputData.getNumBitsForValue());
+  // 225 + 9 = 234 needs 8 bits, plus a sign bit
+  EXPECT_EQ(9, inputData.getNumBitsForValueSquared());
+}
+
 TEST_F(InputDataTest, TestAnyFeatureColumns) {
   InputData inputData{
       bobInputFilename_,
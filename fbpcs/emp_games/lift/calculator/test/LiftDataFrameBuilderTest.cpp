@@ -13,6 +13,7 @@
 #include "fbpcs/emp_games/lift/calculator/LiftDataFrameBuilder.h"
 #include "fbpcs/emp_games/lift/common/Column.h"
 #include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
 
 constexpr int64_t kConversionCap = 2;
 
@@ -51,9 +52,9 @@ class LiftDataFrameBuilderTest : public ::testing::Test {
   df::DataFrame dfPartner;
   df::Column<int64_t> expectedTestPopulation;
   df::Column<int64_t> expectedControlPopulation;
-  df::Column<std::vector<int64_t>> expectedEventTimestampsCapped;
-  df::Column<std::vector<int64_t>> expectedValuesCapped;
-  df::Column<std::vector<int64_t>> expectedValuesSquaredPrecomputed;
+  df::ListColumn<int64_t> expectedEventTimestampsCapped;
+  df::ListColumn<int64_t> expectedValuesCapped;
+  df::ListColumn<int64_t> expectedValuesSquaredPrecomputed;
 };
 
 TEST_F(LiftDataFrameBuilderTest, ApplyLiftRules) {
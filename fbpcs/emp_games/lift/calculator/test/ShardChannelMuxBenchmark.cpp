@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <future>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include <fbpcf/mpc/EmpGame.h>
+#include "../ShardChannelMux.h"
+
+namespace private_lift {
+
+const uint16_t kPort = 15300;
+const size_t kNumRounds = 64;
+const size_t kMessageSize = 64 * 1024;
+
+// Every round, the publisher sends a message and the partner answers with a
+// message of the same size, like the rounds of a game. Shards only wait on
+// their own round trips, so more shards keep more data on the link.
+void exchangeMessages(ShardChannel& channel, fbpcf::Party party) {
+  std::vector<char> message(kMessageSize, 1);
+  for (size_t round = 0; round < kNumRounds; ++round) {
+    if (party == fbpcf::Party::Alice) {
+      channel.send_data(message.data(), message.size());
+      channel.recv_data(message.data(), message.size());
+    } else {
+      channel.recv_data(message.data(), message.size());
+      channel.send_data(message.data(), message.size());
+      channel.flush();
+    }
+  }
+}
+
+// Channel ids are never reused, so every iteration uses the next ones
+void runChannels(ShardChannelMux& mux, size_t iteration, size_t numShards) {
+  std::vector<std::thread> shards;
+  for (size_t i = 0; i < numShards; ++i) {
+    shards.emplace_back([&mux, channelId = iteration * numShards + i]() {
+      auto channel = mux.openChannel(channelId);
+      exchangeMessages(*channel, mux.getParty());
+    });
+  }
+  for (auto& shard : shards) {
+    shard.join();
+  }
+}
+
+// Every iteration moves the same amount of data per shard, so a time per
+// iteration that grows slower than the number of shards is a higher throughput
+void benchmarkShards(size_t iters, size_t numShards) {
+  std::unique_ptr<ShardChannelMux> publisher;
+  std::unique_ptr<ShardChannelMux> partner;
+  BENCHMARK_SUSPEND {
+    auto futurePublisher = std::async([]() {
+      return std::make_unique<ShardChannelMux>(fbpcf::Party::Alice, "", kPort);
+    });
+    partner = std::make_unique<ShardChannelMux>(
+        fbpcf::Party::Bob, "127.0.0.1", kPort);
+    publisher = futurePublisher.get();
+  }
+
+  for (size_t i = 0; i < iters; ++i) {
+    std::thread publisherThread([&publisher, i, numShards]() {
+      runChannels(*publisher, i, numShards);
+    });
+    runChannels(*partner, i, numShards);
+    publisherThread.join();
+  }
+
+  BENCHMARK_SUSPEND {
+    // Both sides wait for each other to close the connection
+    std::thread publisherThread([&publisher]() { publisher.reset(); });
+    partner.reset();
+    publisherThread.join();
+  }
+}
+
+BENCHMARK_PARAM(benchmarkShards, 1)
+BENCHMARK_RELATIVE_PARAM(benchmarkShards, 2)
+BENCHMARK_RELATIVE_PARAM(benchmarkShards, 4)
+BENCHMARK_RELATIVE_PARAM(benchmarkShards, 8)
+BENCHMARK_RELATIVE_PARAM(benchmarkShards, 16)
+
+} // namespace private_lift
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
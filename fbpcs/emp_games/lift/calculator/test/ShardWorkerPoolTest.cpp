@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "../ShardWorkerPool.h"
+
+namespace private_lift {
+
+class FakeShardApp {
+ public:
+  FakeShardApp(std::atomic<int>& numRuns, bool fails)
+      : numRuns_{numRuns}, fails_{fails} {}
+
+  void run() {
+    ++numRuns_;
+    if (fails_) {
+      throw std::runtime_error("shard failed");
+    }
+  }
+
+ private:
+  std::atomic<int>& numRuns_;
+  bool fails_;
+};
+
+TEST(ShardWorkerPoolTest, TestRunsEveryShard) {
+  std::atomic<int> numRuns{0};
+  std::vector<std::unique_ptr<FakeShardApp>> apps;
+  for (int i = 0; i < 10; ++i) {
+    apps.push_back(std::make_unique<FakeShardApp>(numRuns, false));
+  }
+
+  runShards(apps, 3);
+  EXPECT_EQ(numRuns, 10);
+}
+
+TEST(ShardWorkerPoolTest, TestRethrowsFirstError) {
+  std::atomic<int> numRuns{0};
+  std::vector<std::unique_ptr<FakeShardApp>> apps;
+  for (int i = 0; i < 10; ++i) {
+    apps.push_back(std::make_unique<FakeShardApp>(numRuns, i == 0));
+  }
+
+  int numErrors = 0;
+  EXPECT_THROW(
+      runShards(apps, 1, [&numErrors]() { ++numErrors; }), std::runtime_error);
+  EXPECT_EQ(numErrors, 1);
+  // no shard is handed out after the failed one
+  EXPECT_EQ(numRuns, 1);
+}
+
+TEST(ShardWorkerPoolTest, TestReportsOnlyFirstError) {
+  std::atomic<int> numRuns{0};
+  std::vector<std::unique_ptr<FakeShardApp>> apps;
+  for (int i = 0; i < 4; ++i) {
+    apps.push_back(std::make_unique<FakeShardApp>(numRuns, true));
+  }
+
+  std::atomic<int> numErrors{0};
+  EXPECT_THROW(
+      runShards(apps, 4, [&numErrors]() { ++numErrors; }), std::runtime_error);
+  EXPECT_EQ(numErrors, 1);
+}
+
+TEST(ShardWorkerPoolTest, TestRejectsNonPositiveWorkers) {
+  std::atomic<int> numRuns{0};
+  std::vector<std::unique_ptr<FakeShardApp>> apps;
+  apps.push_back(std::make_unique<FakeShardApp>(numRuns, false));
+
+  EXPECT_THROW(runShards(apps, 0), std::invalid_argument);
+  EXPECT_THROW(runShards(apps, -1), std::invalid_argument);
+  EXPECT_EQ(numRuns, 0);
+}
+
+} // namespace private_lift
@@ -7,60 +7,64 @@
 
 #pragma once
 
+#include <functional>
+#include <type_traits>
+#include <utility>
+
 #include "fbpcs/emp_games/lift/common/Column.h"
+#include "fbpcs/emp_games/lift/common/ColumnExpression.h"
 
 namespace df {
 
-template <typename T, typename T2>
-auto operator+(const Column<T>& a, const Column<T2>& b)
-    -> Column<decltype(a.at(0) + b.at(0))> {
-  return a.mapWith(
-      b, [](const T& aValue, const T2& bValue) { return aValue + bValue; });
-}
-
-template <typename T, typename T2>
-auto operator+(const Column<T>& a, T2& b) -> Column<decltype(a.at(0) + b)> {
-  return a.mapWithScalar(
-      b, [](const T& aValue, const T2& bValue) { return aValue + bValue; });
-}
-
-template <typename T, typename T2>
-auto operator-(const Column<T>& a, const Column<T2>& b)
-    -> Column<decltype(a.at(0) - b.at(0))> {
-  return a.mapWith(
-      b, [](const T& aValue, const T2& bValue) { return aValue - bValue; });
-}
-
-template <typename T, typename T2>
-auto operator-(const Column<T>& a, T2& b) -> Column<decltype(a.at(0) - b)> {
-  return a.mapWithScalar(
-      b, [](const T& aValue, const T2& bValue) { return aValue - bValue; });
-}
+/*
+ * Elementwise arithmetic on Columns, and on Columns with scalars. These build a
+ * lazy expression instead of a new Column, so that a chain like `(a + b) * c`
+ * is evaluated in one pass when it is assigned to a Column (see
+ * ColumnExpression.h).
+ */
 
-template <typename T, typename T2>
-auto operator*(const Column<T>& a, const Column<T2>& b)
-    -> Column<decltype(a.at(0) * b.at(0))> {
-  return a.mapWith(
-      b, [](const T& aValue, const T2& bValue) { return aValue * bValue; });
+template <
+    typename L,
+    typename R,
+    std::enable_if_t<
+        detail::isColumnOperand<L> || detail::isColumnOperand<R>,
+        int> = 0>
+auto operator+(L&& a, R&& b) {
+  return detail::makeExpression<std::plus<>>(
+      std::forward<L>(a), std::forward<R>(b));
 }
 
-template <typename T, typename T2>
-auto operator*(const Column<T>& a, T2& b) -> Column<decltype(a.at(0) * b)> {
-  return a.mapWithScalar(
-      b, [](const T& aValue, const T2& bValue) { return aValue * bValue; });
+template <
+    typename L,
+    typename R,
+    std::enable_if_t<
+        detail::isColumnOperand<L> || detail::isColumnOperand<R>,
+        int> = 0>
+auto operator-(L&& a, R&& b) {
+  return detail::makeExpression<std::minus<>>(
+      std::forward<L>(a), std::forward<R>(b));
 }
 
-template <typename T, typename T2>
-auto operator/(const Column<T>& a, const Column<T2>& b)
-    -> Column<decltype(a.at(0) / b.at(0))> {
-  return a.mapWith(
-      b, [](const T& aValue, const T2& bValue) { return aValue / bValue; });
+template <
+    typename L,
+    typename R,
+    std::enable_if_t<
+        detail::isColumnOperand<L> || detail::isColumnOperand<R>,
+        int> = 0>
+auto operator*(L&& a, R&& b) {
+  return detail::makeExpression<std::multiplies<>>(
+      std::forward<L>(a), std::forward<R>(b));
 }
 
-template <typename T, typename T2>
-auto operator/(const Column<T>& a, T2& b) -> Column<decltype(a.at(0) / b)> {
-  return a.mapWithScalar(
-      b, [](const T& aValue, const T2& bValue) { return aValue / bValue; });
+template <
+    typename L,
+    typename R,
+    std::enable_if_t<
+        detail::isColumnOperand<L> || detail::isColumnOperand<R>,
+        int> = 0>
+auto operator/(L&& a, R&& b) {
+  return detail::makeExpression<std::divides<>>(
+      std::forward<L>(a), std::forward<R>(b));
 }
 
 } // namespace df
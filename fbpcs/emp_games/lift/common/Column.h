@@ -12,18 +12,10 @@
 #include <iterator>
 #include <optional>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
-namespace {
-// Taken from https://stackoverflow.com/a/28796458/15625637
-// Useful to denote if if a class Test is a specialization of a Reference class
-// Example: is_specialization<std::vector<int64_t>, std::vector>::value -> true
-template <typename Test, template <typename...> class Ref>
-struct is_specialization : std::false_type {};
-
-template <template <typename...> class Ref, typename... Args>
-struct is_specialization<Ref<Args...>, Ref> : std::true_type {};
-} // anonymous namespace
+#include "fbpcs/emp_games/lift/common/ColumnExpression.h"
 
 namespace df {
 
@@ -74,6 +66,23 @@ class Column {
     return *this;
   }
 
+  /* Constructors from lazy expressions like `(a + b) * c` */
+
+  template <
+      typename E,
+      std::enable_if_t<std::is_base_of_v<ColumnExpressionBase, E>, int> = 0>
+  /* implicit */ Column(const E& expression) {
+    assign(expression);
+  }
+
+  template <
+      typename E,
+      std::enable_if_t<std::is_base_of_v<ColumnExpressionBase, E>, int> = 0>
+  Column<T>& operator=(const E& expression) {
+    assign(expression);
+    return *this;
+  }
+
   /**
    * Get a const_iterator to the beginning of this Column's data by deferring to
    * the underlying vector's implementation.
@@ -422,45 +431,40 @@ class Column {
 
   /* Binary assignment operators */
   template <typename T2>
-  void operator+=(T2& other) {
-    if constexpr (is_specialization<T2, Column>::value) {
-      mapWithInPlace(other, [](const T& a, const typename T2::value_type& b) {
-        return a + b;
-      });
-    } else {
-      mapWithScalarInPlace(
-          other, [](const T& a, const T2& b) { return a + b; });
-    }
+  void operator+=(const T2& other) {
+    *this = *this + other;
   }
 
   template <typename T2>
-  void operator-=(T2& other) {
-    if constexpr (is_specialization<T2, Column>::value) {
-      mapWithInPlace(other, [](const T& a, const T& b) { return a - b; });
-    } else {
-      mapWithScalarInPlace(other, [](const T& a, const T& b) { return a - b; });
-    }
+  void operator-=(const T2& other) {
+    *this = *this - other;
   }
 
   template <typename T2>
-  void operator*=(T2& other) {
-    if constexpr (is_specialization<T2, Column>::value) {
-      mapWithInPlace(other, [](const T& a, const T& b) { return a * b; });
-    } else {
-      mapWithScalarInPlace(other, [](const T& a, const T& b) { return a * b; });
-    }
+  void operator*=(const T2& other) {
+    *this = *this * other;
   }
 
   template <typename T2>
-  void operator/=(T2& other) {
-    if constexpr (is_specialization<T2, Column>::value) {
-      mapWithInPlace(other, [](const T& a, const T& b) { return a / b; });
-    } else {
-      mapWithScalarInPlace(other, [](const T& a, const T& b) { return a / b; });
-    }
+  void operator/=(const T2& other) {
+    *this = *this / other;
   }
 
  private:
+  /**
+   * Evaluate an expression into this Column in a single pass. Every element
+   * only depends on the operands at the same index, so this is safe even when
+   * the expression refers to this Column.
+   */
+  template <typename E>
+  void assign(const E& expression) {
+    auto size = expression.size();
+    v_.resize(size);
+    for (std::size_t i = 0; i < size; ++i) {
+      v_[i] = expression[i];
+    }
+  }
+
   std::vector<T> v_;
 };
 
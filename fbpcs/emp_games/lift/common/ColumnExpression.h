@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace df {
+
+template <typename T>
+class Column;
+
+/**
+ * The base class of the lazy expressions built by the arithmetic operators on
+ * Columns. An expression like `(a + b) * c` does not compute anything until it
+ * is assigned to a Column, at which point the whole expression is evaluated in
+ * a single loop, without allocating a Column for `a + b`.
+ *
+ * Expressions refer to the Columns they were built from, so they must be
+ * evaluated before those Columns change or go away. Temporary Columns are moved
+ * into the expression instead.
+ */
+class ColumnExpressionBase {};
+
+namespace detail {
+
+template <typename X>
+struct IsColumn : std::false_type {};
+
+template <typename T>
+struct IsColumn<Column<T>> : std::true_type {};
+
+template <typename X>
+constexpr bool isColumnExpression =
+    std::is_base_of_v<ColumnExpressionBase, std::decay_t<X>>;
+
+// Anything the arithmetic operators treat as a Column instead of a scalar
+template <typename X>
+constexpr bool isColumnOperand =
+    IsColumn<std::decay_t<X>>::value || isColumnExpression<X>;
+
+/**
+ * A Column inside an expression. C is `const Column<T>&` for Columns that
+ * outlive the expression, and `Column<T>` for temporaries.
+ */
+template <typename C>
+class ColumnLeaf {
+ public:
+  explicit ColumnLeaf(C column) : column_(std::forward<C>(column)) {}
+
+  std::size_t size() const {
+    return column_.size();
+  }
+
+  decltype(auto) operator[](std::size_t i) const {
+    return column_.data()[i];
+  }
+
+ private:
+  C column_;
+};
+
+/**
+ * A scalar inside an expression, which is the same for every index.
+ */
+template <typename S>
+class ScalarLeaf {
+ public:
+  explicit ScalarLeaf(S value) : value_(std::move(value)) {}
+
+  const S& operator[](std::size_t) const {
+    return value_;
+  }
+
+ private:
+  S value_;
+};
+
+template <typename X>
+struct IsScalarLeaf : std::false_type {};
+
+template <typename S>
+struct IsScalarLeaf<ScalarLeaf<S>> : std::true_type {};
+
+/**
+ * An elementwise binary operation on two operands, at least one of which is
+ * not a scalar.
+ */
+template <typename Op, typename L, typename R>
+class BinaryExpression : public ColumnExpressionBase {
+ public:
+  BinaryExpression(L lhs, R rhs) : lhs_(std::move(lhs)), rhs_(std::move(rhs)) {
+    if constexpr (!IsScalarLeaf<L>::value && !IsScalarLeaf<R>::value) {
+      if (lhs_.size() != rhs_.size()) {
+        std::stringstream ss;
+        ss << "This Column has size() = " << lhs_.size()
+           << ", but other Column has size() = " << rhs_.size();
+        throw std::invalid_argument{ss.str()};
+      }
+    }
+  }
+
+  std::size_t size() const {
+    if constexpr (IsScalarLeaf<L>::value) {
+      return rhs_.size();
+    } else {
+      return lhs_.size();
+    }
+  }
+
+  auto operator[](std::size_t i) const {
+    return Op{}(lhs_[i], rhs_[i]);
+  }
+
+ private:
+  L lhs_;
+  R rhs_;
+};
+
+/**
+ * Wrap an operator argument for storage in an expression: sub-expressions are
+ * copied, Columns become leaves and anything else is a scalar.
+ */
+template <typename X>
+auto toOperand(X&& x) {
+  using D = std::decay_t<X>;
+  if constexpr (isColumnExpression<D>) {
+    return D(std::forward<X>(x));
+  } else if constexpr (IsColumn<D>::value) {
+    if constexpr (std::is_lvalue_reference_v<X>) {
+      return ColumnLeaf<const D&>(x);
+    } else {
+      return ColumnLeaf<D>(std::move(x));
+    }
+  } else {
+    return ScalarLeaf<D>(std::forward<X>(x));
+  }
+}
+
+template <typename Op, typename L, typename R>
+auto makeExpression(L&& lhs, R&& rhs) {
+  auto l = toOperand(std::forward<L>(lhs));
+  auto r = toOperand(std::forward<R>(rhs));
+  return BinaryExpression<Op, decltype(l), decltype(r)>{
+      std::move(l), std::move(r)};
+}
+
+// Splitting a reduction up costs more than it saves below this many elements
+// per thread
+constexpr std::size_t kMinElementsPerThread = 1 << 16;
+
+/**
+ * Add up `reduceRange(begin, end)` over chunks of `[0, size)`, on as many
+ * threads as the hardware has for large sizes.
+ *
+ * @tparam R the type of the result of reduceRange
+ * @tparam F an unspecified function type which can be called with a range of
+ *     indices and returns an R
+ * @param size the number of elements to reduce
+ * @param reduceRange the function reducing the elements in `[begin, end)`
+ * @returns the sum of the reductions of every chunk
+ */
+template <typename R, typename F>
+R reduceInParallel(std::size_t size, F reduceRange) {
+  std::size_t numThreads = std::min<std::size_t>(
+      std::max(1U, std::thread::hardware_concurrency()),
+      size / kMinElementsPerThread);
+  if (numThreads <= 1) {
+    return reduceRange(0, size);
+  }
+
+  auto chunkSize = (size + numThreads - 1) / numThreads;
+  std::vector<R> partials(numThreads);
+  std::vector<std::thread> threads;
+  threads.reserve(numThreads);
+  for (std::size_t t = 0; t < numThreads; ++t) {
+    auto begin = std::min(size, t * chunkSize);
+    auto end = std::min(size, begin + chunkSize);
+    threads.emplace_back([&partials, &reduceRange, t, begin, end]() {
+      partials.at(t) = reduceRange(begin, end);
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  R res{};
+  for (const auto& partial : partials) {
+    res += partial;
+  }
+  return res;
+}
+
+} // namespace detail
+
+/**
+ * Sum the elements of a Column or an expression. The expression is evaluated
+ * as it is summed, and large inputs are summed on several threads.
+ *
+ * @tparam E a Column or an expression over Columns
+ * @param operand the elements to sum
+ * @returns the sum of all elements, promoted like `a + b` would be
+ */
+template <
+    typename E,
+    std::enable_if_t<detail::isColumnOperand<E>, int> = 0>
+auto sum(const E& operand) {
+  auto values = detail::toOperand(operand);
+  using R = std::decay_t<decltype(values[0] + values[0])>;
+  return detail::reduceInParallel<R>(
+      values.size(), [&values](std::size_t begin, std::size_t end) {
+        R res{};
+        for (std::size_t i = begin; i < end; ++i) {
+          res += values[i];
+        }
+        return res;
+      });
+}
+
+/**
+ * Count the elements of a Column or an expression which are true (or nonzero).
+ * Like `sum`, the expression is evaluated as it is counted.
+ *
+ * @tparam E a Column or an expression over Columns
+ * @param operand the elements to count
+ * @returns the number of elements which convert to true
+ */
+template <
+    typename E,
+    std::enable_if_t<detail::isColumnOperand<E>, int> = 0>
+std::size_t count(const E& operand) {
+  auto values = detail::toOperand(operand);
+  return detail::reduceInParallel<std::size_t>(
+      values.size(), [&values](std::size_t begin, std::size_t end) {
+        std::size_t res = 0;
+        for (std::size_t i = begin; i < end; ++i) {
+          res += static_cast<bool>(values[i]);
+        }
+        return res;
+      });
+}
+
+} // namespace df
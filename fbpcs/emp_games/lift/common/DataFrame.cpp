@@ -11,14 +11,13 @@
 #include <string>
 #include <vector>
 
-#include "fbpcs/emp_games/lift/common/CsvReader.h"
+#include "fbpcs/emp_games/lift/common/StreamingCsvLoader.h"
 
 namespace df {
 DataFrame DataFrame::readCsv(
     const TypeMap& typeMap,
     const std::string& filePath) {
-  CsvReader rdr{filePath};
-  return loadFromRows(typeMap, rdr.getHeader(), rdr.getRows());
+  return StreamingCsvLoader{typeMap}.load(filePath);
 }
 
 DataFrame DataFrame::loadFromRows(
@@ -45,8 +44,8 @@ DataFrame DataFrame::loadFromRows(
               typeMap.intVecColumns.begin(),
               typeMap.intVecColumns.end(),
               colName) != typeMap.intVecColumns.end()) {
-        df.get<std::vector<int64_t>>(colName).push_back(
-            detail::parseVector<int64_t>(row.at(i)));
+        detail::parseVectorInto<int64_t>(
+            row.at(i), df.get<std::vector<int64_t>>(colName));
       } else {
         // Either we don't know what this column is, or it's supposed to be a
         // string anyway. Safest approach is to not do *any* parsing in this
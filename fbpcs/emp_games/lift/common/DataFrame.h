@@ -19,6 +19,7 @@
 #include <utility>
 
 #include "fbpcs/emp_games/lift/common/Column.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
 
 /*
  * This DataFrame implementation is loosely based on an answer from
@@ -61,6 +62,30 @@ class BaseMap {
   virtual ~BaseMap() {}
 };
 
+namespace detail {
+/**
+ * The Column type used to store values of type T: a `Column<T>`, except for
+ * lists, which are stored in a contiguous `ListColumn`.
+ */
+template <typename T>
+struct ColumnFor {
+  using type = Column<T>;
+};
+
+template <typename T>
+struct ColumnFor<std::vector<T>> {
+  using type = ListColumn<T>;
+};
+} // namespace detail
+
+/**
+ * The Column type a DataFrame returns for a key of type T.
+ *
+ * @tparam T the type of data stored in the Column
+ */
+template <typename T>
+using ColumnOf = typename detail::ColumnFor<T>::type;
+
 // actual map of Columns
 /**
  * A class which represents an unordered_map of strings to type T. It extends
@@ -71,7 +96,7 @@ class BaseMap {
  */
 template <typename T>
 class MapT : public BaseMap,
-             public std::unordered_map<std::string, Column<T>> {};
+             public std::unordered_map<std::string, ColumnOf<T>> {};
 
 /**
  * This class is a convenience wrapper for an error in accessing our DataFrame
@@ -129,6 +154,8 @@ class DataFrame {
    * values during reading. Columns encountered in the CSV which are not listed
    * in the typeMap, will be parsed as `std::string`. The caller may choose
    * later to convert these to a new type via functions like `Column::map`.
+   * The file is streamed straight into typed columns, parsing chunks of it in
+   * parallel (see `StreamingCsvLoader`).
    *
    * @param typeMap expected typing for each column that will be read from the
    *     CSV. If a type is given in this map, all values in the Column *must*
@@ -221,7 +248,8 @@ class DataFrame {
   }
 
   /**
-   * Get a `Column<T>` at the given key within this DataFrame. A `dynamic_cast`
+   * Get a `Column<T>` at the given key within this DataFrame (a `ListColumn`
+   * when `T` is a `std::vector`, see `ColumnOf`). A `dynamic_cast`
    * is necessary since we're dynamically altering types at runtime depending
    * on the values being read or set. While there is a small computational cost
    * to this cast, since we can guarantee that all elements of the resulting
@@ -235,7 +263,7 @@ class DataFrame {
    * @throws `std::out_of_range` if `key` does not exist within this DataFrame
    */
   template <typename T>
-  const Column<T>& get(const std::string& key) const {
+  const ColumnOf<T>& get(const std::string& key) const {
     auto idx = std::type_index(typeid(T));
     // If this column is defined, ensure the type is correct
     if (types_.find(key) != types_.end()) {
@@ -260,7 +288,7 @@ class DataFrame {
    *     stored as a type other than `T`
    */
   template <typename T>
-  Column<T>& get(const std::string& key) {
+  ColumnOf<T>& get(const std::string& key) {
     auto idx = std::type_index(typeid(T));
     auto typeName = typeid(T).name();
 
@@ -274,7 +302,7 @@ class DataFrame {
       types_.emplace(key, std::make_pair(idx, typeName));
     }
 
-    return const_cast<Column<T>&>(
+    return const_cast<ColumnOf<T>&>(
         const_cast<const DataFrame&>(*this).get<T>(key));
   }
 
@@ -289,7 +317,7 @@ class DataFrame {
    * @throws `std::out_of_range` if `key` does not exist within this DataFrame
    */
   template <typename T>
-  const Column<T>& at(const std::string& key) const {
+  const ColumnOf<T>& at(const std::string& key) const {
     auto idx = std::type_index(typeid(T));
     auto typeName = typeid(T).name();
     // Ensure the type is correct
@@ -310,8 +338,8 @@ class DataFrame {
    * @throws `std::out_of_range` if `key` does not exist within this DataFrame
    */
   template <typename T>
-  Column<T>& at(const std::string& key) {
-    return const_cast<Column<T>&>(
+  ColumnOf<T>& at(const std::string& key) {
+    return const_cast<ColumnOf<T>&>(
         const_cast<const DataFrame&>(*this).at<T>(key));
   }
 
@@ -374,36 +402,67 @@ T parse(const std::string& value) {
 }
 
 /**
- * Parse a `std::string` into a vector the given type by splitting across commas
- * and calling `parse<T>` on each relevant substring.
+ * Split a `std::string` list across commas and call `f` with each value parsed
+ * by `parse<T>`, in order.
  *
- * @tparam T the type to parse `value` into
- * @param value the string to be parsed into a new T
- * @returns `value` parsed as a `T`
- * @throws `ParseException` if the value cannot be parsed into a `T`
+ * @tparam T the type to parse each value into
+ * @tparam F an unspecified function type which can be called with a `T`
+ * @param value the string to be parsed
+ * @param f the function to call on each parsed value
+ * @throws `ParseException` if the value cannot be parsed into a list of `T`
  * @note requires that `value` begin with `[` and end with `]`
  */
-template <typename T>
-std::vector<T> parseVector(const std::string& value) {
+template <typename T, typename F>
+void forEachListValue(const std::string& value, F f) {
   if (value.empty() || value.at(0) != '[' ||
       value.at(value.size() - 1) != ']') {
     auto typeName = std::string{"std::vector<"} + typeid(T).name() + ">";
     throw ParseException{value, typeName};
   }
 
-  std::vector<T> res;
-
   // get substr between [ and ]
   std::stringstream ss{value.substr(1, value.size() - 2)};
   while (ss.good()) {
     std::string part;
     std::getline(ss, part, ',');
     if (!part.empty()) {
-      res.push_back(parse<T>(part));
+      f(parse<T>(part));
     }
   }
+}
 
+/**
+ * Parse a `std::string` into a vector the given type by splitting across commas
+ * and calling `parse<T>` on each relevant substring.
+ *
+ * @tparam T the type to parse `value` into
+ * @param value the string to be parsed into a new T
+ * @returns `value` parsed as a `T`
+ * @throws `ParseException` if the value cannot be parsed into a `T`
+ * @note requires that `value` begin with `[` and end with `]`
+ */
+template <typename T>
+std::vector<T> parseVector(const std::string& value) {
+  std::vector<T> res;
+  forEachListValue<T>(value, [&res](T v) { res.push_back(std::move(v)); });
   return res;
 }
+
+/**
+ * Parse a `std::string` as a new row of a `ListColumn`, appending the values
+ * to the column directly instead of building a vector first.
+ *
+ * @tparam T the type to parse each value into
+ * @param value the string to be parsed into a new row
+ * @param column the column to append the row to
+ * @throws `ParseException` if the value cannot be parsed into a list of `T`,
+ *     in which case the column must be discarded
+ * @note requires that `value` begin with `[` and end with `]`
+ */
+template <typename T>
+void parseVectorInto(const std::string& value, ListColumn<T>& column) {
+  forEachListValue<T>(value, [&column](T v) { column.pushValue(v); });
+  column.endRow();
+}
 } // namespace detail
 } // namespace df
@@ -0,0 +1,305 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <folly/Range.h>
+
+#include "fbpcs/emp_games/lift/common/Column.h"
+
+namespace df {
+
+/**
+ * A Column of lists stored in compressed sparse row (CSR) layout: the values of
+ * every row live back to back in a single buffer, and `offsets[i]` is where row
+ * `i` starts in that buffer. Compared to a `Column<std::vector<T>>`, loading a
+ * row does not allocate, and walking the rows walks contiguous memory.
+ *
+ * This is the Column type that a DataFrame uses for `std::vector<T>` keys, so
+ * `df.get<std::vector<T>>(key)` returns a `ListColumn<T>&`. Rows are accessed
+ * as `folly::Range` views into the values buffer, which stay valid until the
+ * next row is added to the Column.
+ *
+ * @tparam T the type of the values in each row
+ */
+template <typename T>
+class ListColumn {
+ public:
+  typedef std::vector<T> value_type;
+  using Row = folly::Range<const T*>;
+  using MutableRow = folly::Range<T*>;
+
+  /* Basic constructors */
+  ListColumn() : offsets_{0} {}
+
+  /* implicit */ ListColumn(std::initializer_list<std::vector<T>> init)
+      : ListColumn() {
+    for (const auto& row : init) {
+      push_back(row);
+    }
+  }
+
+  ListColumn<T>& operator=(std::initializer_list<std::vector<T>> init) {
+    clear();
+    for (const auto& row : init) {
+      push_back(row);
+    }
+    return *this;
+  }
+
+  /**
+   * Copy a Column of vectors into CSR layout.
+   *
+   * @param rows the rows to copy
+   */
+  explicit ListColumn(const Column<std::vector<T>>& rows) : ListColumn() {
+    std::size_t numValues = 0;
+    for (const auto& row : rows) {
+      numValues += row.size();
+    }
+    reserve(rows.size(), numValues);
+    for (const auto& row : rows) {
+      push_back(row);
+    }
+  }
+
+  /**
+   * Retrieve the row at a specific index in the column.
+   *
+   * @param pos the index into this Column
+   * @returns a view of the values of row `pos`
+   * @throws `std::out_of_range` if `pos` is larger than `this->size()`
+   */
+  Row at(std::size_t pos) const {
+    checkRow(pos);
+    return Row{
+        values_.data() + offsets_[pos], values_.data() + offsets_[pos + 1]};
+  }
+
+  /**
+   * Non-const version of `ListColumn::at`. The values of the row can be
+   * modified in place, but not its length.
+   */
+  MutableRow at(std::size_t pos) {
+    checkRow(pos);
+    return MutableRow{
+        values_.data() + offsets_[pos], values_.data() + offsets_[pos + 1]};
+  }
+
+  /**
+   * Reserve capacity in the Column.
+   *
+   * @param numRows the number of rows to reserve room for
+   * @param numValues the total number of values in those rows, if known
+   */
+  void reserve(std::size_t numRows, std::size_t numValues = 0) {
+    offsets_.reserve(numRows + 1);
+    values_.reserve(numValues);
+  }
+
+  /**
+   * Checks whether this Column is empty.
+   *
+   * @returns true if this Column has no rows
+   */
+  bool empty() const {
+    return size() == 0;
+  }
+
+  /**
+   * Get the number of rows stored in this Column.
+   *
+   * @returns the number of rows in this Column
+   */
+  std::size_t size() const {
+    return offsets_.size() - 1;
+  }
+
+  /**
+   * Remove every row from this Column.
+   */
+  void clear() {
+    offsets_.resize(1);
+    values_.clear();
+  }
+
+  /**
+   * Add a new row to this Column.
+   *
+   * @param row the values of the row to add
+   */
+  void push_back(const std::vector<T>& row) {
+    values_.insert(values_.end(), row.begin(), row.end());
+    endRow();
+  }
+
+  /**
+   * Add a new row to this Column.
+   *
+   * @param row the values of the row to add
+   */
+  void push_back(Row row) {
+    values_.insert(values_.end(), row.begin(), row.end());
+    endRow();
+  }
+
+  /**
+   * Append a value to the row being built. Together with `endRow`, this fills
+   * the Column without materializing each row as a vector first.
+   *
+   * @param value the value to append
+   */
+  void pushValue(const T& value) {
+    values_.push_back(value);
+  }
+
+  /**
+   * Finish the row being built: every value pushed since the last row ended
+   * belongs to it.
+   */
+  void endRow() {
+    offsets_.push_back(values_.size());
+  }
+
+  /**
+   * Add every row of another Column after the rows of this Column.
+   *
+   * @param other the Column whose rows to add
+   */
+  void append(const ListColumn<T>& other) {
+    auto base = values_.size();
+    values_.insert(values_.end(), other.values_.begin(), other.values_.end());
+    offsets_.reserve(offsets_.size() + other.size());
+    for (std::size_t i = 1; i < other.offsets_.size(); ++i) {
+      offsets_.push_back(base + other.offsets_[i]);
+    }
+  }
+
+  /**
+   * Apply a function on each row of this Column.
+   *
+   * @tparam F an unspecified function type which can be called with a `Row`
+   * @param f the function to call on each row of this Column
+   */
+  template <typename F>
+  void apply(F f) const {
+    for (std::size_t i = 0; i < size(); ++i) {
+      f(at(i));
+    }
+  }
+
+  /**
+   * Non-const version of `ListColumn::apply`. Apply a function on each row of
+   * this Column, which may modify its values in place.
+   *
+   * @tparam F an unspecified function type which can be called with a
+   *     `MutableRow`
+   * @param f the function to call on each row of this Column
+   */
+  template <typename F>
+  void apply(F f) {
+    for (std::size_t i = 0; i < size(); ++i) {
+      f(at(i));
+    }
+  }
+
+  /**
+   * Map this column into a new Column by applying a function to each row.
+   *
+   * @tparam F an unspecified function type which can be called with a `Row`
+   * @param f the function to call on each row of this column
+   * @returns a new Column where each element is the result of calling f on the
+   *     the respective row from this Column
+   */
+  template <typename F>
+  auto map(F f) const -> Column<decltype(f(std::declval<Row>()))> {
+    Column<decltype(f(std::declval<Row>()))> res;
+    res.reserve(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+      res.push_back(f(at(i)));
+    }
+    return res;
+  }
+
+  /**
+   * Truncate or pad every row to the same length, like calling
+   * `std::vector::resize` on each of them. Afterwards, row `i` starts at
+   * `i * length` in the values buffer.
+   *
+   * @param length the new length of every row
+   * @param value the value to pad short rows with
+   */
+  void resizeRows(std::size_t length, const T& value = T()) {
+    std::vector<T> values;
+    values.reserve(size() * length);
+    // Where the current row starts in the old buffer, since its offset has
+    // been overwritten already
+    std::size_t begin = 0;
+    for (std::size_t i = 0; i < size(); ++i) {
+      auto end = offsets_[i + 1];
+      auto numKept = std::min(end - begin, length);
+      values.insert(
+          values.end(),
+          values_.begin() + begin,
+          values_.begin() + begin + numKept);
+      values.insert(values.end(), length - numKept, value);
+      offsets_[i + 1] = (i + 1) * length;
+      begin = end;
+    }
+    values_ = std::move(values);
+  }
+
+  /**
+   * Get the values of every row, back to back.
+   *
+   * @returns the buffer backing this Column
+   */
+  const std::vector<T>& values() const {
+    return values_;
+  }
+
+  /**
+   * Get where each row starts in the values buffer. The last offset is the
+   * total number of values, so row `i` spans `[offsets[i], offsets[i + 1])`.
+   *
+   * @returns the `size() + 1` row offsets of this Column
+   */
+  const std::vector<std::size_t>& offsets() const {
+    return offsets_;
+  }
+
+  /* Comparison operators */
+  friend bool operator==(const ListColumn<T>& a, const ListColumn<T>& b) {
+    return a.offsets_ == b.offsets_ && a.values_ == b.values_;
+  }
+
+  friend bool operator!=(const ListColumn<T>& a, const ListColumn<T>& b) {
+    return !(a == b);
+  }
+
+ private:
+  void checkRow(std::size_t pos) const {
+    if (pos >= size()) {
+      throw std::out_of_range{
+          "Row " + std::to_string(pos) + " is out of range for a ListColumn " +
+          "with " + std::to_string(size()) + " rows"};
+    }
+  }
+
+  std::vector<std::size_t> offsets_;
+  std::vector<T> values_;
+};
+
+} // namespace df
@@ -0,0 +1,273 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcs/emp_games/lift/common/StreamingCsvLoader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <deque>
+#include <future>
+#include <iterator>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+
+#include "fbpcf/io/FileManagerUtil.h"
+#include "fbpcs/emp_games/lift/common/Column.h"
+#include "fbpcs/emp_games/lift/common/CsvReader.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
+
+namespace df {
+namespace detail {
+int64_t parseInt(std::string_view field) {
+  int64_t res;
+  auto end = field.data() + field.size();
+  auto [ptr, ec] = std::from_chars(field.data(), end, res);
+  if (ec == std::errc{} && ptr == end) {
+    return res;
+  }
+  return parse<int64_t>(std::string{field});
+}
+
+bool parseBool(std::string_view field) {
+  if (field == "1" || field == "true") {
+    return true;
+  } else if (field == "0" || field == "false") {
+    return false;
+  }
+  return parse<bool>(std::string{field});
+}
+
+void parseIntVectorInto(std::string_view field, ListColumn<int64_t>& column) {
+  if (field.empty() || field.front() != '[' || field.back() != ']') {
+    auto typeName = std::string{"std::vector<"} + typeid(int64_t).name() + ">";
+    throw ParseException{std::string{field}, typeName};
+  }
+
+  auto values = field.substr(1, field.size() - 2);
+  while (!values.empty()) {
+    auto comma = values.find(',');
+    auto part = values.substr(0, comma);
+    if (!part.empty()) {
+      column.pushValue(parseInt(part));
+    }
+    if (comma == std::string_view::npos) {
+      break;
+    }
+    values.remove_prefix(comma + 1);
+  }
+  column.endRow();
+}
+} // namespace detail
+
+namespace {
+using ParsedColumn = std::variant<
+    Column<bool>,
+    Column<int64_t>,
+    ListColumn<int64_t>,
+    Column<std::string>>;
+
+// Type every column once from the header, instead of looking each cell up in
+// the TypeMap
+std::vector<ParsedColumn> makeColumns(
+    const TypeMap& typeMap,
+    const std::vector<std::string>& header) {
+  auto contains = [](const std::vector<std::string>& names,
+                     const std::string& name) {
+    return std::find(names.begin(), names.end(), name) != names.end();
+  };
+
+  std::vector<ParsedColumn> res;
+  for (const auto& colName : header) {
+    if (contains(typeMap.boolColumns, colName)) {
+      res.emplace_back(Column<bool>{});
+    } else if (contains(typeMap.intColumns, colName)) {
+      res.emplace_back(Column<int64_t>{});
+    } else if (contains(typeMap.intVecColumns, colName)) {
+      res.emplace_back(ListColumn<int64_t>{});
+    } else {
+      // Same as DataFrame::loadFromRows, unknown columns are kept as strings
+      res.emplace_back(Column<std::string>{});
+    }
+  }
+  return res;
+}
+
+// Call f with the index and text of each field of a line, splitting it the
+// same way as detail::split. Returns the number of fields.
+template <typename F>
+std::size_t forEachField(std::string_view line, F f) {
+  std::size_t numFields = 0;
+  std::size_t i = 0;
+  while (i < line.size()) {
+    auto start = i;
+    if (line[i] == '[') {
+      i = line.find(']', i);
+      if (i == std::string_view::npos) {
+        throw std::out_of_range{
+            "Missing ']' in line '" + std::string{line} + "'"};
+      }
+      // Include the ']' in the field
+      ++i;
+    } else {
+      i = std::min(line.find(',', i), line.size());
+    }
+    f(numFields++, line.substr(start, i - start));
+    // Skip the separator
+    ++i;
+  }
+  return numFields;
+}
+
+void appendField(ParsedColumn& column, std::string_view field) {
+  std::visit(
+      [field](auto& c) {
+        using C = std::decay_t<decltype(c)>;
+        if constexpr (std::is_same_v<C, Column<bool>>) {
+          c.push_back(detail::parseBool(field));
+        } else if constexpr (std::is_same_v<C, Column<int64_t>>) {
+          c.push_back(detail::parseInt(field));
+        } else if constexpr (std::is_same_v<C, ListColumn<int64_t>>) {
+          detail::parseIntVectorInto(field, c);
+        } else {
+          c.emplace_back(field);
+        }
+      },
+      column);
+}
+
+// Parse whole lines of text into a copy of the empty columns
+std::vector<ParsedColumn> parseChunk(
+    const std::string& chunk,
+    std::vector<ParsedColumn> columns) {
+  std::string_view text{chunk};
+  auto numColumns = columns.size();
+  std::size_t pos = 0;
+  while (pos < text.size()) {
+    auto end = std::min(text.find('\n', pos), text.size());
+    auto numFields = forEachField(
+        text.substr(pos, end - pos),
+        [&columns, numColumns](std::size_t i, std::string_view field) {
+          if (i < numColumns) {
+            appendField(columns.at(i), field);
+          }
+        });
+    if (numFields != numColumns) {
+      throw RowLengthMismatch{numColumns, numFields};
+    }
+    pos = end + 1;
+  }
+  return columns;
+}
+
+void appendColumns(
+    DataFrame& df,
+    const std::vector<std::string>& header,
+    std::vector<ParsedColumn>& columns) {
+  for (std::size_t i = 0; i < header.size(); ++i) {
+    std::visit(
+        [&df, &colName = header.at(i)](auto& c) {
+          using C = std::decay_t<decltype(c)>;
+          if (c.empty()) {
+            return;
+          }
+          auto& dst = df.get<typename C::value_type>(colName);
+          if (dst.empty()) {
+            dst = std::move(c);
+          } else if constexpr (std::is_same_v<C, ListColumn<int64_t>>) {
+            dst.append(c);
+          } else {
+            dst.data().insert(
+                dst.data().end(),
+                std::make_move_iterator(c.data().begin()),
+                std::make_move_iterator(c.data().end()));
+          }
+        },
+        columns.at(i));
+  }
+}
+} // namespace
+
+StreamingCsvLoader::StreamingCsvLoader(
+    const TypeMap& typeMap,
+    std::size_t chunkSize,
+    std::size_t numThreads)
+    : typeMap_{typeMap},
+      chunkSize_{std::max<std::size_t>(chunkSize, 1)},
+      numThreads_{
+          numThreads > 0 ? numThreads
+                         : std::max(1U, std::thread::hardware_concurrency())} {}
+
+DataFrame StreamingCsvLoader::load(const std::string& filePath) const {
+  auto infilePtr = fbpcf::io::getInputStream(filePath);
+  auto& infile = infilePtr->get();
+  if (!infile.good()) {
+    throw CsvFileReadException{filePath};
+  }
+  return load(infile);
+}
+
+DataFrame StreamingCsvLoader::load(std::istream& in) const {
+  DataFrame df;
+  std::string line;
+  if (!std::getline(in, line)) {
+    return df;
+  }
+  auto header = detail::split(line);
+  auto emptyColumns = makeColumns(typeMap_, header);
+
+  // Chunks being parsed, in file order
+  std::deque<std::future<std::vector<ParsedColumn>>> pending;
+  auto appendNext = [&df, &header, &pending]() {
+    auto columns = pending.front().get();
+    pending.pop_front();
+    appendColumns(df, header, columns);
+  };
+
+  std::string buffer;
+  bool done = false;
+  while (!done) {
+    auto start = buffer.size();
+    buffer.resize(start + chunkSize_);
+    in.read(buffer.data() + start, chunkSize_);
+    buffer.resize(start + in.gcount());
+    done = !in;
+
+    // Only hand whole lines over, the rest starts the next chunk
+    auto chunkEnd = buffer.size();
+    if (!done) {
+      auto lastNewline = buffer.rfind('\n');
+      if (lastNewline == std::string::npos) {
+        // This line is longer than a chunk, keep reading it
+        continue;
+      }
+      chunkEnd = lastNewline + 1;
+    }
+    if (chunkEnd == 0) {
+      continue;
+    }
+
+    auto rest = buffer.substr(chunkEnd);
+    buffer.resize(chunkEnd);
+    // Read ahead while up to numThreads_ chunks are being parsed
+    if (pending.size() >= numThreads_) {
+      appendNext();
+    }
+    pending.push_back(std::async(
+        std::launch::async, parseChunk, std::move(buffer), emptyColumns));
+    buffer = std::move(rest);
+  }
+
+  while (!pending.empty()) {
+    appendNext();
+  }
+  return df;
+}
+} // namespace df
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <istream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "fbpcs/emp_games/lift/common/DataFrame.h"
+
+namespace df {
+namespace detail {
+/**
+ * Parse a CSV field as an int64_t without copying it into a string first. The
+ * fast path only accepts plain decimal integers, anything else falls back to
+ * `parse<int64_t>` so that both accept the same input.
+ *
+ * @param field the text of the field
+ * @returns `field` parsed as an int64_t
+ * @throws `ParseException` if the field cannot be parsed into an int64_t
+ */
+int64_t parseInt(std::string_view field);
+
+/**
+ * Parse a CSV field as a bool, accepting `0`/`1` and `false`/`true` like
+ * `parse<bool>`.
+ *
+ * @param field the text of the field
+ * @returns `field` parsed as a bool
+ * @throws `ParseException` if the field cannot be parsed into a bool
+ */
+bool parseBool(std::string_view field);
+
+/**
+ * Parse a CSV field like `[1,2,3]` as a new row of a `ListColumn`, the same way
+ * `parseVector<int64_t>` would.
+ *
+ * @param field the text of the field
+ * @param column the column to append the row to
+ * @throws `ParseException` if the field cannot be parsed into a list
+ */
+void parseIntVectorInto(std::string_view field, ListColumn<int64_t>& column);
+} // namespace detail
+
+/**
+ * Loads a CSV straight into the typed columns of a DataFrame. Instead of
+ * reading the whole file as rows of strings and converting them afterwards,
+ * the file is read in fixed-size chunks of whole lines, and every chunk is
+ * parsed into typed columns on its own thread while the next chunks are read.
+ * The parsed chunks are then appended to the DataFrame in file order.
+ *
+ * Only a few chunks of text are held at any time, so peak memory is close to
+ * the size of the typed columns. Cells are parsed exactly like
+ * `DataFrame::loadFromRows` would parse them.
+ */
+class StreamingCsvLoader {
+ public:
+  static constexpr std::size_t kDefaultChunkSize = 8 << 20;
+
+  /**
+   * Construct a loader for CSVs with the given schema.
+   *
+   * @param typeMap expected typing for each column, as in `DataFrame::readCsv`
+   * @param chunkSize how many bytes to read at a time. Lines are never split
+   *     between chunks, so a chunk can be larger to end on a whole line.
+   * @param numThreads how many chunks to parse at the same time; 0 means one
+   *     per hardware thread
+   */
+  explicit StreamingCsvLoader(
+      const TypeMap& typeMap,
+      std::size_t chunkSize = kDefaultChunkSize,
+      std::size_t numThreads = 0);
+
+  /**
+   * Load the CSV at the given path.
+   *
+   * @param filePath a path to the CSV to be loaded
+   * @returns a DataFrame object loaded from the filePath
+   * @throws `CsvFileReadException` if the file cannot be read
+   * @throws `ParseException` if a value cannot be parsed to its column's type
+   * @throws `RowLengthMismatch` if a row has a different length than the header
+   */
+  DataFrame load(const std::string& filePath) const;
+
+  /**
+   * Load a CSV from a stream, starting with its header line.
+   *
+   * @param in the stream to read the CSV from
+   * @returns a DataFrame object loaded from the stream
+   * @throws `ParseException` if a value cannot be parsed to its column's type
+   * @throws `RowLengthMismatch` if a row has a different length than the header
+   */
+  DataFrame load(std::istream& in) const;
+
+ private:
+  TypeMap typeMap_;
+  std::size_t chunkSize_;
+  std::size_t numThreads_;
+};
+} // namespace df
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "fbpcs/emp_games/lift/common/Column.h"
+
+namespace df {
+
+const size_t kNumRows = 10000000;
+
+struct Columns {
+  Column<int64_t> a;
+  Column<int64_t> b;
+  Column<int64_t> c;
+};
+
+Columns getColumns() {
+  Columns columns;
+  for (size_t i = 0; i < kNumRows; ++i) {
+    columns.a.push_back(i % 7);
+    columns.b.push_back(i % 3);
+    columns.c.push_back(i % 2);
+  }
+  return columns;
+}
+
+// (a + b) * c the way the operators used to compute it: one pass and one new
+// Column per operator
+BENCHMARK(Eager_Expression, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto sum = columns.a.mapWith(
+        columns.b, [](int64_t a, int64_t b) { return a + b; });
+    auto res =
+        sum.mapWith(columns.c, [](int64_t a, int64_t b) { return a * b; });
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_RELATIVE(Fused_Expression, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    Column<int64_t> res = (columns.a + columns.b) * columns.c;
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(Reduce_Sum, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto res =
+        columns.a.reduce([](int64_t acc, int64_t v) { return acc + v; }, 0);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_RELATIVE(Parallel_Sum, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto res = sum(columns.a);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+// sum((a + b) * c) without materializing the product first
+BENCHMARK(Eager_SumOfExpression, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto sum = columns.a.mapWith(
+        columns.b, [](int64_t a, int64_t b) { return a + b; });
+    auto product =
+        sum.mapWith(columns.c, [](int64_t a, int64_t b) { return a * b; });
+    auto res =
+        product.reduce([](int64_t acc, int64_t v) { return acc + v; }, 0);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_RELATIVE(Fused_SumOfExpression, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto res = sum((columns.a + columns.b) * columns.c);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(Reduce_Count, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto res = columns.c.reduce(
+        [](int64_t acc, int64_t v) { return acc + (v != 0); }, 0);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+BENCHMARK_RELATIVE(Parallel_Count, iters) {
+  Columns columns;
+  BENCHMARK_SUSPEND {
+    columns = getColumns();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto res = count(columns.c);
+    folly::doNotOptimizeAway(res);
+  }
+}
+
+} // namespace df
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -430,6 +430,73 @@ TEST(BinaryAssignmentOpTest, Divide) {
   EXPECT_EQ(expected2, c2);
 }
 
+TEST(ExpressionTest, ChainedExpression) {
+  Column<int64_t> a{1, 2, 3};
+  Column<int64_t> b{4, 5, 6};
+  Column<int64_t> c{2, 3, 4};
+
+  Column<int64_t> actual = (a + b) * c - 1;
+  Column<int64_t> expected{9, 20, 35};
+  EXPECT_EQ(expected, actual);
+
+  // Scalars can be on either side
+  Column<int64_t> actual2 = 100 - a * 10;
+  Column<int64_t> expected2{90, 80, 70};
+  EXPECT_EQ(expected2, actual2);
+}
+
+TEST(ExpressionTest, TemporaryColumn) {
+  Column<int64_t> a{1, 2, 3};
+
+  // The temporary is moved into the expression, so it outlives the statement
+  auto expression = Column<int64_t>(a.size(), 1) - a;
+  Column<int64_t> expected{0, -1, -2};
+  EXPECT_EQ(expected, Column<int64_t>(expression));
+}
+
+TEST(ExpressionTest, AssignToOperand) {
+  Column<int64_t> a{1, 2, 3};
+  Column<int64_t> b{4, 5, 6};
+
+  a = a * b + a;
+  Column<int64_t> expected{5, 12, 21};
+  EXPECT_EQ(expected, a);
+}
+
+TEST(ExpressionTest, SizeMismatch) {
+  Column<int64_t> a{1, 2, 3};
+  Column<int64_t> b{4, 5};
+
+  EXPECT_THROW(a + b, std::invalid_argument);
+  EXPECT_THROW((a + 1) * b, std::invalid_argument);
+}
+
+TEST(ReductionTest, SumAndCount) {
+  Column<int64_t> a{1, 2, 3};
+  Column<int64_t> b{0, 5, 0};
+  Column<bool> flags{true, false, true};
+
+  EXPECT_EQ(sum(a), 6);
+  EXPECT_EQ(sum(a * b), 10);
+  EXPECT_EQ(count(b), 1);
+  EXPECT_EQ(count(flags), 2);
+  EXPECT_EQ(sum(flags), 2);
+  EXPECT_EQ(sum(Column<int64_t>{}), 0);
+}
+
+TEST(ReductionTest, LargeColumns) {
+  // Large enough to be reduced on several threads
+  const int64_t size = 1 << 20;
+  Column<int64_t> a;
+  for (int64_t i = 0; i < size; ++i) {
+    a.push_back(i);
+  }
+
+  EXPECT_EQ(sum(a), size * (size - 1) / 2);
+  EXPECT_EQ(sum(a * 2), size * (size - 1));
+  EXPECT_EQ(count(a), size - 1);
+}
+
 TEST(IteratorTest, IteratorFunctionality) {
   Column<int64_t> c{300, 200, 100};
   auto iter = c.begin();
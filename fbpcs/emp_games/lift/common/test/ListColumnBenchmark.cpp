@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "fbpcs/emp_games/lift/common/Column.h"
+#include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
+
+namespace df {
+
+const size_t kNumRows = 1000000;
+const size_t kMaxConversionsPerUser = 8;
+const size_t kConversionCap = 4;
+
+// Row i has (i % (kMaxConversionsPerUser + 1)) values, like users with a
+// varying number of conversions
+std::vector<int64_t> getRow(size_t i) {
+  std::vector<int64_t> row;
+  for (size_t j = 0; j < i % (kMaxConversionsPerUser + 1); ++j) {
+    row.push_back(i + j);
+  }
+  return row;
+}
+
+std::vector<std::string> getCells(size_t numRows) {
+  std::vector<std::string> cells;
+  cells.reserve(numRows);
+  for (size_t i = 0; i < numRows; ++i) {
+    std::string cell = "[";
+    for (auto value : getRow(i)) {
+      cell += std::to_string(value) + ",";
+    }
+    if (cell.size() > 1) {
+      cell.pop_back();
+    }
+    cells.push_back(cell + "]");
+  }
+  return cells;
+}
+
+// Load the cells and cap every row, like LiftDataFrameBuilder does
+BENCHMARK(VectorColumn_Load, iters) {
+  std::vector<std::string> cells;
+  BENCHMARK_SUSPEND {
+    cells = getCells(iters);
+  }
+  Column<std::vector<int64_t>> column;
+  for (const auto& cell : cells) {
+    column.push_back(detail::parseVector<int64_t>(cell));
+  }
+  column.apply([](auto& row) { row.resize(kConversionCap); });
+  folly::doNotOptimizeAway(column);
+}
+
+BENCHMARK_RELATIVE(ListColumn_Load, iters) {
+  std::vector<std::string> cells;
+  BENCHMARK_SUSPEND {
+    cells = getCells(iters);
+  }
+  ListColumn<int64_t> column;
+  for (const auto& cell : cells) {
+    detail::parseVectorInto<int64_t>(cell, column);
+  }
+  column.resizeRows(kConversionCap);
+  folly::doNotOptimizeAway(column);
+}
+
+BENCHMARK_DRAW_LINE();
+
+// Sum every value of a million rows
+BENCHMARK(VectorColumn_Iterate, iters) {
+  Column<std::vector<int64_t>> column;
+  BENCHMARK_SUSPEND {
+    column.reserve(kNumRows);
+    for (size_t i = 0; i < kNumRows; ++i) {
+      column.push_back(getRow(i));
+    }
+  }
+  for (size_t iter = 0; iter < iters; ++iter) {
+    int64_t sum = 0;
+    column.apply([&sum](const auto& row) {
+      for (auto value : row) {
+        sum += value;
+      }
+    });
+    folly::doNotOptimizeAway(sum);
+  }
+}
+
+BENCHMARK_RELATIVE(ListColumn_Iterate, iters) {
+  ListColumn<int64_t> column;
+  BENCHMARK_SUSPEND {
+    column.reserve(kNumRows);
+    for (size_t i = 0; i < kNumRows; ++i) {
+      column.push_back(getRow(i));
+    }
+  }
+  for (size_t iter = 0; iter < iters; ++iter) {
+    int64_t sum = 0;
+    column.apply([&sum](auto row) {
+      for (auto value : row) {
+        sum += value;
+      }
+    });
+    folly::doNotOptimizeAway(sum);
+  }
+}
+
+} // namespace df
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
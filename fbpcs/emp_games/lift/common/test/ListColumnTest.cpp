@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbpcs/emp_games/lift/common/Column.h"
+#include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
+
+using namespace df;
+
+namespace {
+template <typename Row>
+std::vector<int64_t> toVector(Row row) {
+  return std::vector<int64_t>(row.begin(), row.end());
+}
+} // namespace
+
+TEST(ListColumnTest, FromInitializerList) {
+  ListColumn<int64_t> c{{1, 2, 3}, {}, {4}};
+
+  ASSERT_EQ(c.size(), 3);
+  EXPECT_EQ(toVector(c.at(0)), (std::vector<int64_t>{1, 2, 3}));
+  EXPECT_TRUE(c.at(1).empty());
+  EXPECT_EQ(toVector(c.at(2)), (std::vector<int64_t>{4}));
+  EXPECT_THROW(c.at(3), std::out_of_range);
+
+  EXPECT_EQ(c.values(), (std::vector<int64_t>{1, 2, 3, 4}));
+  EXPECT_EQ(c.offsets(), (std::vector<std::size_t>{0, 3, 3, 4}));
+}
+
+TEST(ListColumnTest, PushValues) {
+  ListColumn<int64_t> c;
+  EXPECT_TRUE(c.empty());
+
+  c.pushValue(5);
+  c.pushValue(6);
+  c.endRow();
+  c.endRow();
+  c.push_back(std::vector<int64_t>{7});
+
+  ListColumn<int64_t> expected{{5, 6}, {}, {7}};
+  EXPECT_EQ(c, expected);
+}
+
+TEST(ListColumnTest, FromColumnOfVectors) {
+  Column<std::vector<int64_t>> rows{{1}, {2, 3}, {}};
+  ListColumn<int64_t> c(rows);
+
+  ListColumn<int64_t> expected{{1}, {2, 3}, {}};
+  EXPECT_EQ(c, expected);
+}
+
+TEST(ListColumnTest, ApplyInPlace) {
+  ListColumn<int64_t> c{{1, 2}, {3}};
+  c.apply([](auto row) {
+    for (auto& value : row) {
+      value *= 10;
+    }
+  });
+
+  ListColumn<int64_t> expected{{10, 20}, {30}};
+  EXPECT_EQ(c, expected);
+}
+
+TEST(ListColumnTest, Map) {
+  ListColumn<int64_t> c{{1, 2}, {}, {3, 4, 5}};
+  auto sizes = c.map([](auto row) { return row.size(); });
+
+  Column<std::size_t> expected{2, 0, 3};
+  EXPECT_EQ(sizes, expected);
+}
+
+TEST(ListColumnTest, ResizeRows) {
+  ListColumn<int64_t> c{{1, 2, 3}, {}, {4}, {5, 6}};
+  c.resizeRows(2);
+
+  ListColumn<int64_t> expected{{1, 2}, {0, 0}, {4, 0}, {5, 6}};
+  EXPECT_EQ(c, expected);
+
+  c.resizeRows(3, -1);
+  ListColumn<int64_t> expectedPadded{
+      {1, 2, -1}, {0, 0, -1}, {4, 0, -1}, {5, 6, -1}};
+  EXPECT_EQ(c, expectedPadded);
+}
+
+TEST(ListColumnTest, DataFrameLookup) {
+  DataFrame df;
+  df.get<std::vector<int64_t>>("intVec") = {{7, 8, 9}, {333}};
+
+  ListColumn<int64_t>& c = df.at<std::vector<int64_t>>("intVec");
+  ASSERT_EQ(c.size(), 2);
+  EXPECT_EQ(toVector(c.at(1)), (std::vector<int64_t>{333}));
+}
+
+TEST(ListColumnTest, ParseVectorInto) {
+  ListColumn<int64_t> c;
+  detail::parseVectorInto<int64_t>("[1,2,3]", c);
+  detail::parseVectorInto<int64_t>("[]", c);
+
+  ListColumn<int64_t> expected{{1, 2, 3}, {}};
+  EXPECT_EQ(c, expected);
+  EXPECT_THROW(detail::parseVectorInto<int64_t>("1,2", c), ParseException);
+}
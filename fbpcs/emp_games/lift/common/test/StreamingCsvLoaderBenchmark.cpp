@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "fbpcs/emp_games/lift/common/CsvReader.h"
+#include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/StreamingCsvLoader.h"
+
+namespace df {
+
+const size_t kNumRows = 1000000;
+const TypeMap kTypeMap{
+    .boolColumns = {},
+    .intColumns = {"opportunity_timestamp", "test_flag", "num_impressions"},
+    .intVecColumns = {"event_timestamps", "values"},
+};
+
+// A lift input with both parties' columns, written once for all benchmarks
+const std::string& getInputPath() {
+  static const std::string path = []() {
+    auto res = (std::filesystem::temp_directory_path() /
+                "streaming_csv_loader_benchmark.csv")
+                   .string();
+    std::ofstream out{res};
+    out << "id_,opportunity_timestamp,test_flag,num_impressions,"
+        << "event_timestamps,values\n";
+    for (size_t i = 0; i < kNumRows; ++i) {
+      out << "id" << i << "," << 1600000000 + i << "," << i % 2 << ","
+          << i % 5 << ",[" << 1600000100 + i << "," << 1600000200 + i << "],["
+          << i % 100 << "," << i % 1000 << "]\n";
+    }
+    return res;
+  }();
+  return path;
+}
+
+BENCHMARK(CsvReader_LoadFromRows, iters) {
+  BENCHMARK_SUSPEND {
+    getInputPath();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    CsvReader rdr{getInputPath()};
+    auto df = DataFrame::loadFromRows(kTypeMap, rdr.getHeader(), rdr.getRows());
+    folly::doNotOptimizeAway(df);
+  }
+}
+
+BENCHMARK_RELATIVE(StreamingCsvLoader_OneThread, iters) {
+  BENCHMARK_SUSPEND {
+    getInputPath();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto df = StreamingCsvLoader{
+        kTypeMap, StreamingCsvLoader::kDefaultChunkSize, 1}
+                  .load(getInputPath());
+    folly::doNotOptimizeAway(df);
+  }
+}
+
+BENCHMARK_RELATIVE(StreamingCsvLoader_AllThreads, iters) {
+  BENCHMARK_SUSPEND {
+    getInputPath();
+  }
+  for (size_t i = 0; i < iters; ++i) {
+    auto df = StreamingCsvLoader{kTypeMap}.load(getInputPath());
+    folly::doNotOptimizeAway(df);
+  }
+}
+
+} // namespace df
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "fbpcs/emp_games/lift/common/CsvReader.h"
+#include "fbpcs/emp_games/lift/common/DataFrame.h"
+#include "fbpcs/emp_games/lift/common/ListColumn.h"
+#include "fbpcs/emp_games/lift/common/StreamingCsvLoader.h"
+
+using namespace df;
+
+namespace {
+const TypeMap kTypeMap{
+    .boolColumns = {"bool1"},
+    .intColumns = {"int1"},
+    .intVecColumns = {"intVec"},
+};
+
+const std::vector<std::string> kHeader{"bool1", "int1", "intVec", "str"};
+
+std::string toCsv(const std::vector<std::vector<std::string>>& rows) {
+  std::string res = "bool1,int1,intVec,str\n";
+  for (const auto& row : rows) {
+    for (std::size_t i = 0; i < row.size(); ++i) {
+      res += (i == 0 ? "" : ",") + row.at(i);
+    }
+    res += "\n";
+  }
+  return res;
+}
+
+void expectSameAsLoadFromRows(
+    const std::vector<std::vector<std::string>>& rows,
+    std::size_t chunkSize,
+    std::size_t numThreads) {
+  std::istringstream in{toCsv(rows)};
+  auto actual = StreamingCsvLoader{kTypeMap, chunkSize, numThreads}.load(in);
+  auto expected = DataFrame::loadFromRows(kTypeMap, kHeader, rows);
+
+  EXPECT_EQ(expected.keys(), actual.keys());
+  EXPECT_EQ(expected.at<bool>("bool1"), actual.at<bool>("bool1"));
+  EXPECT_EQ(expected.at<int64_t>("int1"), actual.at<int64_t>("int1"));
+  EXPECT_EQ(
+      expected.at<std::vector<int64_t>>("intVec"),
+      actual.at<std::vector<int64_t>>("intVec"));
+  EXPECT_EQ(expected.at<std::string>("str"), actual.at<std::string>("str"));
+}
+} // namespace
+
+TEST(StreamingCsvLoaderDetail, ParseFields) {
+  EXPECT_EQ(123, detail::parseInt("123"));
+  EXPECT_EQ(-5, detail::parseInt("-5"));
+  // Falls back to the same parsing as detail::parse
+  EXPECT_EQ(7, detail::parseInt(" 7"));
+  EXPECT_THROW(detail::parseInt("abc"), ParseException);
+  EXPECT_THROW(detail::parseInt("99999999999999999999"), ParseException);
+
+  EXPECT_TRUE(detail::parseBool("1"));
+  EXPECT_TRUE(detail::parseBool("true"));
+  EXPECT_FALSE(detail::parseBool("0"));
+  EXPECT_FALSE(detail::parseBool("false"));
+  EXPECT_THROW(detail::parseBool("abc"), ParseException);
+
+  ListColumn<int64_t> c;
+  detail::parseIntVectorInto("[1,2,3]", c);
+  detail::parseIntVectorInto("[]", c);
+  ListColumn<int64_t> expected{{1, 2, 3}, {}};
+  EXPECT_EQ(expected, c);
+  EXPECT_THROW(detail::parseIntVectorInto("1,2", c), ParseException);
+}
+
+TEST(StreamingCsvLoaderTest, SameAsLoadFromRows) {
+  std::vector<std::vector<std::string>> rows;
+  for (int64_t i = 0; i < 100; ++i) {
+    std::string intVec = "[";
+    for (int64_t j = 0; j < i % 4; ++j) {
+      intVec += (j == 0 ? "" : ",") + std::to_string(i * j);
+    }
+    rows.push_back(
+        {i % 2 ? "true" : "0", std::to_string(i - 50), intVec + "]",
+         "row" + std::to_string(i)});
+  }
+
+  // Chunks smaller than a line, several lines per chunk, and the whole file
+  for (std::size_t chunkSize : {1, 7, 64, 1 << 20}) {
+    for (std::size_t numThreads : {1, 3}) {
+      expectSameAsLoadFromRows(rows, chunkSize, numThreads);
+    }
+  }
+}
+
+TEST(StreamingCsvLoaderTest, NoTrailingNewline) {
+  std::istringstream in{"bool1,int1,intVec,str\n1,2,[3],a\n0,4,[],b"};
+  auto df = StreamingCsvLoader{kTypeMap, 4}.load(in);
+
+  Column<int64_t> expected{2, 4};
+  EXPECT_EQ(expected, df.at<int64_t>("int1"));
+}
+
+TEST(StreamingCsvLoaderTest, EmptyInput) {
+  std::istringstream empty{""};
+  EXPECT_TRUE(StreamingCsvLoader{kTypeMap}.load(empty).keys().empty());
+
+  std::istringstream headerOnly{"bool1,int1,intVec,str\n"};
+  EXPECT_TRUE(StreamingCsvLoader{kTypeMap}.load(headerOnly).keys().empty());
+}
+
+TEST(StreamingCsvLoaderTest, Errors) {
+  std::istringstream badInt{"bool1,int1,intVec,str\n1,abc,[],a\n"};
+  EXPECT_THROW(StreamingCsvLoader{kTypeMap}.load(badInt), ParseException);
+
+  std::istringstream shortRow{"bool1,int1,intVec,str\n1,2,[]\n"};
+  EXPECT_THROW(StreamingCsvLoader{kTypeMap}.load(shortRow), RowLengthMismatch);
+
+  std::istringstream longRow{"bool1,int1,intVec,str\n1,2,[],a,b\n"};
+  EXPECT_THROW(StreamingCsvLoader{kTypeMap}.load(longRow), RowLengthMismatch);
+
+  std::istringstream unclosedList{"bool1,int1,intVec,str\n1,2,[3,a\n"};
+  EXPECT_THROW(
+      StreamingCsvLoader{kTypeMap}.load(unclosedList), std::out_of_range);
+}
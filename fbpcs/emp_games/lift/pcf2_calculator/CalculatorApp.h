@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fbpcf/io/FileManagerUtil.h>
+
+#include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGame.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGameConfig.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/InputData.h"
+
+namespace private_lift {
+
+template <int MY_ROLE, int schedulerId>
+class CalculatorApp {
+ public:
+  CalculatorApp(
+      std::unique_ptr<
+          fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+          communicationAgentFactory,
+      const std::vector<std::string>& inputFilenames,
+      const std::vector<std::string>& outputFilenames,
+      bool isConversionLift,
+      int32_t numConversionsPerUser,
+      int64_t epoch,
+      bool useXorEncryption,
+      const int startFileIndex = 0,
+      const int numFiles = 1)
+      : communicationAgentFactory_(std::move(communicationAgentFactory)),
+        inputFilenames_(inputFilenames),
+        outputFilenames_(outputFilenames),
+        isConversionLift_{isConversionLift},
+        numConversionsPerUser_{numConversionsPerUser},
+        epoch_{epoch},
+        useXorEncryption_{useXorEncryption},
+        startFileIndex_(startFileIndex),
+        numFiles_(numFiles),
+        schedulerStatistics_{0, 0, 0, 0} {}
+
+  void run() {
+    auto scheduler = fbpcf::scheduler::createLazySchedulerWithRealEngine(
+        MY_ROLE, *communicationAgentFactory_);
+
+    CalculatorGame<schedulerId> game(
+        MY_ROLE, std::move(scheduler), useXorEncryption_);
+
+    // Compute lift metrics sequentially on numFiles files, starting from
+    // startFileIndex
+    for (auto i = startFileIndex_; i < startFileIndex_ + numFiles_; ++i) {
+      auto config = getInputData(inputFilenames_.at(i));
+      auto output = game.play(config);
+      putOutputData(output, outputFilenames_.at(i));
+    }
+
+    auto gateStatistics =
+        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getGateStatistics();
+    XLOGF(
+        INFO,
+        "Non-free gate count = {}, Free gate count = {}",
+        gateStatistics.first,
+        gateStatistics.second);
+
+    auto trafficStatistics =
+        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getTrafficStatistics();
+    XLOGF(
+        INFO,
+        "Sent network traffic = {}, Received network traffic = {}",
+        trafficStatistics.first,
+        trafficStatistics.second);
+
+    schedulerStatistics_.nonFreeGates = gateStatistics.first;
+    schedulerStatistics_.freeGates = gateStatistics.second;
+    schedulerStatistics_.sentNetwork = trafficStatistics.first;
+    schedulerStatistics_.receivedNetwork = trafficStatistics.second;
+  }
+
+  common::SchedulerStatistics getSchedulerStatistics() {
+    return schedulerStatistics_;
+  }
+
+ protected:
+  CalculatorGameConfig getInputData(std::string inputPath) {
+    XLOG(INFO) << "MY_ROLE: " << MY_ROLE << ", schedulerId: " << schedulerId
+               << ", input_path: " << inputPath;
+    // Converter Lift always only supports 1 conversion per user
+    int32_t numConversionsPerUser =
+        isConversionLift_ ? numConversionsPerUser_ : 1;
+    auto liftGranularityType = isConversionLift_
+        ? InputData::LiftGranularityType::Conversion
+        : InputData::LiftGranularityType::Converter;
+
+    InputData inputData{
+        inputPath,
+        InputData::LiftMPCType::Standard,
+        liftGranularityType,
+        epoch_,
+        numConversionsPerUser};
+    return CalculatorGameConfig{
+        std::move(inputData), isConversionLift_, numConversionsPerUser};
+  }
+
+  void putOutputData(const std::string& output, std::string outputPath) {
+    fbpcf::io::write(outputPath, output);
+  }
+
+ private:
+  std::unique_ptr<fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+      communicationAgentFactory_;
+  std::vector<std::string> inputFilenames_;
+  std::vector<std::string> outputFilenames_;
+  bool isConversionLift_;
+  int32_t numConversionsPerUser_;
+  int64_t epoch_;
+  bool useXorEncryption_;
+  int startFileIndex_;
+  int numFiles_;
+  common::SchedulerStatistics schedulerStatistics_;
+};
+
+} // namespace private_lift
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "fbpcf/frontend/mpcGame.h"
+#include "fbpcf/scheduler/IScheduler.h"
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/lift/common/GroupedLiftMetrics.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGameConfig.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/Constants.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/InputData.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/OutputMetricsData.h"
+
+namespace private_lift {
+
+/**
+ * The PCF2 version of the lift game. It computes the same metrics as the EMP
+ * game, for the overall population, every publisher breakdown and every
+ * partner cohort, and outputs them in the same GroupedLiftMetrics JSON.
+ *
+ * Every input column is shared as one batch of all rows, and every conversion
+ * slot of the partner arrays as one batch as well, so that each step of the
+ * computation is a single batched gate. All metrics are then summed together
+ * by a single adder tree, and revealed in a single batch.
+ */
+template <int schedulerId>
+class CalculatorGame : public fbpcf::frontend::MpcGame<schedulerId> {
+ public:
+  CalculatorGame(
+      int myRole,
+      std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler,
+      bool useXorEncryption)
+      : fbpcf::frontend::MpcGame<schedulerId>(std::move(scheduler)),
+        myRole_{myRole},
+        useXorEncryption_{useXorEncryption} {}
+
+  /**
+   * Compute all metrics and return them as a GroupedLiftMetrics JSON. With XOR
+   * encryption, the metrics of each party are its XOR shares.
+   */
+  std::string play(const CalculatorGameConfig& config);
+
+  GroupedLiftMetrics computeMetrics(const CalculatorGameConfig& config);
+
+ private:
+  // Sizes that both parties need to know before sharing any input
+  struct Dimensions {
+    int64_t numRows;
+    int64_t numPublisherBreakdowns;
+    int64_t numPartnerCohorts;
+    bool shouldSkipValues;
+  };
+
+  // The shared inputs, and the columns derived from them that do not depend
+  // on the test or control population. Array columns have one batch per
+  // conversion slot.
+  struct PrivateInputs {
+    std::vector<SecBit<schedulerId>> validPurchases;
+    SecBit<schedulerId> isMatched;
+    SecBit<schedulerId> isReached;
+    std::vector<SecValue<schedulerId>> purchaseValues;
+    std::vector<SecValue<schedulerId>> purchaseValuesSquared;
+  };
+
+  // The shares of all rows that add up to one metric of one group
+  struct Summand {
+    size_t group;
+    std::function<void(OutputMetricsData&, int64_t)> setMetric;
+    std::vector<uint64_t> shares;
+  };
+
+  Dimensions shareDimensions(const InputData& inputData) const;
+
+  SecBit<schedulerId> shareBits(
+      const std::vector<int64_t>& bits,
+      int sourceRole) const;
+
+  template <size_t width>
+  SecUnsignedInt<schedulerId, width> shareInts(
+      const std::vector<uint64_t>& values,
+      int sourceRole) const;
+
+  template <size_t width>
+  std::vector<SecUnsignedInt<schedulerId, width>> shareIntArrays(
+      const std::vector<std::vector<uint64_t>>& arrays,
+      int sourceRole) const;
+
+  PrivateInputs sharePrivateInputs(const InputData& inputData);
+
+  void computePopulationMetrics(
+      bool isTest,
+      const SecBit<schedulerId>& isUser,
+      const PrivateInputs& inputs);
+
+  // Add the rows of the given columns to a metric of every group
+  void addBitSum(
+      const std::vector<SecBit<schedulerId>>& columns,
+      std::function<void(OutputMetricsData&, int64_t)> setMetric);
+  void addIntSum(
+      const std::vector<SecValue<schedulerId>>& columns,
+      std::function<void(OutputMetricsData&, int64_t)> setMetric);
+
+  GroupedLiftMetrics revealMetrics(bool isConversionLift);
+
+  int myRole_;
+  bool useXorEncryption_;
+
+  // State of the current play
+  int64_t numRows_ = 0;
+  int32_t numConversionsPerUser_ = 0;
+  int64_t numPublisherBreakdowns_ = 0;
+  int64_t numPartnerCohorts_ = 0;
+  bool shouldSkipValues_ = true;
+  // One bit per row for every publisher breakdown, then every partner cohort
+  std::vector<SecBit<schedulerId>> groupBits_;
+  std::vector<Summand> bitSummands_;
+  std::vector<Summand> intSummands_;
+};
+
+} // namespace private_lift
+
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGame_impl.h"
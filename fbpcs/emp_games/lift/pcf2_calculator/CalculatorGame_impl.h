@@ -0,0 +1,487 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <fmt/format.h>
+#include "folly/logging/xlog.h"
+
+#include "fbpcs/emp_games/common/Util.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGame.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/ColumnSums.h"
+
+namespace private_lift {
+
+namespace detail {
+
+inline std::vector<uint64_t> toUnsigned(const std::vector<int64_t>& values) {
+  return std::vector<uint64_t>(values.begin(), values.end());
+}
+
+// Truncate every timestamp to timeStampWidth bits and flip its sign bit. Throws
+// if a timestamp does not fit.
+inline std::vector<uint64_t> biasTimestamps(
+    const std::vector<int64_t>& timestamps) {
+  std::vector<uint64_t> biased;
+  biased.reserve(timestamps.size());
+  for (auto timestamp : timestamps) {
+    if (timestamp < kMinTimestamp || timestamp > kMaxTimestamp) {
+      throw std::invalid_argument(fmt::format(
+          "Timestamp {} relative to the epoch does not fit in {} bits",
+          timestamp,
+          timeStampWidth));
+    }
+    biased.push_back(
+        (static_cast<uint64_t>(timestamp) & ((kTimestampSignBit << 1) - 1)) ^
+        kTimestampSignBit);
+  }
+  return biased;
+}
+
+inline std::vector<std::vector<uint64_t>> biasTimestampArrays(
+    const std::vector<std::vector<int64_t>>& timestampArrays) {
+  std::vector<std::vector<uint64_t>> biased;
+  biased.reserve(timestampArrays.size());
+  for (const auto& timestamps : timestampArrays) {
+    biased.push_back(biasTimestamps(timestamps));
+  }
+  return biased;
+}
+
+inline std::vector<std::vector<uint64_t>> toUnsignedArrays(
+    const std::vector<std::vector<int64_t>>& arrays) {
+  std::vector<std::vector<uint64_t>> res;
+  res.reserve(arrays.size());
+  for (const auto& array : arrays) {
+    res.push_back(toUnsigned(array));
+  }
+  return res;
+}
+
+inline std::function<void(OutputMetricsData&, int64_t)> setField(
+    int64_t OutputMetricsData::*field) {
+  return [field](OutputMetricsData& data, int64_t value) {
+    data.*field = value;
+  };
+}
+
+inline std::function<void(OutputMetricsData&, int64_t)> setHistogramBin(
+    std::vector<int64_t> OutputMetricsData::*histogram,
+    size_t bin) {
+  return [histogram, bin](OutputMetricsData& data, int64_t value) {
+    (data.*histogram).at(bin) = value;
+  };
+}
+
+} // namespace detail
+
+template <int schedulerId>
+std::string CalculatorGame<schedulerId>::play(
+    const CalculatorGameConfig& config) {
+  auto metrics = computeMetrics(config);
+  XLOG(INFO) << "\nPCF2 Output (Role=" << myRole_ << "):\n" << metrics;
+  return metrics.toJson();
+}
+
+template <int schedulerId>
+GroupedLiftMetrics CalculatorGame<schedulerId>::computeMetrics(
+    const CalculatorGameConfig& config) {
+  auto dimensions = shareDimensions(config.inputData);
+  numRows_ = dimensions.numRows;
+  numPublisherBreakdowns_ = dimensions.numPublisherBreakdowns;
+  numPartnerCohorts_ = dimensions.numPartnerCohorts;
+  numConversionsPerUser_ = config.numConversionsPerUser;
+  // Value metrics are only computed for conversion lift
+  shouldSkipValues_ = dimensions.shouldSkipValues ||
+      config.inputData.getLiftGranularityType() !=
+          InputData::LiftGranularityType::Conversion;
+  groupBits_.clear();
+  bitSummands_.clear();
+  intSummands_.clear();
+
+  XLOG(INFO) << "Will be computing metrics for " << numPublisherBreakdowns_
+             << " publisher breakdowns and " << numPartnerCohorts_
+             << " partner cohorts";
+  if (numRows_ > 0) {
+    auto inputs = sharePrivateInputs(config.inputData);
+
+    XLOG(INFO) << "Calculate test metrics";
+    computePopulationMetrics(
+        true,
+        shareBits(config.inputData.getTestPopulation(), common::PUBLISHER),
+        inputs);
+    XLOG(INFO) << "Calculate control metrics";
+    computePopulationMetrics(
+        false,
+        shareBits(config.inputData.getControlPopulation(), common::PUBLISHER),
+        inputs);
+  }
+  return revealMetrics(config.isConversionLift);
+}
+
+template <int schedulerId>
+typename CalculatorGame<schedulerId>::Dimensions
+CalculatorGame<schedulerId>::shareDimensions(
+    const InputData& inputData) const {
+  // Each party tells the other its number of rows and groups, and the partner
+  // also tells whether it has any purchase values
+  std::vector<uint64_t> publisherDimensions;
+  std::vector<uint64_t> partnerDimensions;
+  if (myRole_ == common::PUBLISHER) {
+    publisherDimensions = {
+        static_cast<uint64_t>(inputData.getNumRows()),
+        static_cast<uint64_t>(inputData.getNumGroups())};
+  } else {
+    partnerDimensions = {
+        static_cast<uint64_t>(inputData.getNumRows()),
+        static_cast<uint64_t>(inputData.getNumGroups()),
+        static_cast<uint64_t>(inputData.getPurchaseValueArrays().empty())};
+  }
+  publisherDimensions = common::privatelyShareIntArrayFrom<
+      schedulerId,
+      64,
+      common::PUBLISHER,
+      common::PARTNER>(myRole_, publisherDimensions);
+  partnerDimensions = common::privatelyShareIntArrayFrom<
+      schedulerId,
+      64,
+      common::PARTNER,
+      common::PUBLISHER>(myRole_, partnerDimensions);
+
+  if (publisherDimensions.at(0) != partnerDimensions.at(0)) {
+    throw std::runtime_error(fmt::format(
+        "The publisher has {} rows in their input, while the partner has {} rows.",
+        publisherDimensions.at(0),
+        partnerDimensions.at(0)));
+  }
+  return Dimensions{
+      static_cast<int64_t>(publisherDimensions.at(0)),
+      static_cast<int64_t>(publisherDimensions.at(1)),
+      static_cast<int64_t>(partnerDimensions.at(1)),
+      partnerDimensions.at(2) != 0};
+}
+
+template <int schedulerId>
+SecBit<schedulerId> CalculatorGame<schedulerId>::shareBits(
+    const std::vector<int64_t>& bits,
+    int sourceRole) const {
+  std::vector<bool> values(numRows_, false);
+  if (myRole_ == sourceRole) {
+    for (int64_t i = 0; i < numRows_; ++i) {
+      values.at(i) = bits.at(i) != 0;
+    }
+  }
+  return SecBit<schedulerId>(values, sourceRole);
+}
+
+template <int schedulerId>
+template <size_t width>
+SecUnsignedInt<schedulerId, width> CalculatorGame<schedulerId>::shareInts(
+    const std::vector<uint64_t>& values,
+    int sourceRole) const {
+  // Columns missing from the input, like impressions, are shared as zeros
+  std::vector<uint64_t> batch(numRows_, 0);
+  if (myRole_ == sourceRole) {
+    std::copy_n(
+        values.begin(),
+        std::min<size_t>(values.size(), numRows_),
+        batch.begin());
+  }
+  return SecUnsignedInt<schedulerId, width>(batch, sourceRole);
+}
+
+template <int schedulerId>
+template <size_t width>
+std::vector<SecUnsignedInt<schedulerId, width>>
+CalculatorGame<schedulerId>::shareIntArrays(
+    const std::vector<std::vector<uint64_t>>& arrays,
+    int sourceRole) const {
+  std::vector<std::vector<uint64_t>> batches(
+      numConversionsPerUser_, std::vector<uint64_t>(numRows_, 0));
+  if (myRole_ == sourceRole) {
+    for (int64_t i = 0; i < numRows_; ++i) {
+      const auto& array = arrays.at(i);
+      if (array.size() != static_cast<size_t>(numConversionsPerUser_)) {
+        throw std::runtime_error(fmt::format(
+            "Input array {} of length {} does not have required size {}",
+            i,
+            array.size(),
+            numConversionsPerUser_));
+      }
+      for (int32_t j = 0; j < numConversionsPerUser_; ++j) {
+        batches.at(j).at(i) = array.at(j);
+      }
+    }
+  }
+
+  std::vector<SecUnsignedInt<schedulerId, width>> res;
+  res.reserve(numConversionsPerUser_);
+  for (const auto& batch : batches) {
+    res.push_back(SecUnsignedInt<schedulerId, width>(batch, sourceRole));
+  }
+  return res;
+}
+
+template <int schedulerId>
+typename CalculatorGame<schedulerId>::PrivateInputs
+CalculatorGame<schedulerId>::sharePrivateInputs(const InputData& inputData) {
+  if (numConversionsPerUser_ <= 0) {
+    throw std::invalid_argument(
+        "Must use a positive number of conversions per user!");
+  }
+
+  // Rows are put in groups by the party that owns the group ids, without
+  // any computation
+  XLOG(INFO) << "Share group bits";
+  for (int64_t i = 0; i < numPublisherBreakdowns_; ++i) {
+    groupBits_.push_back(shareBits(
+        myRole_ == common::PUBLISHER ? inputData.bitmaskFor(i)
+                                     : std::vector<int64_t>{},
+        common::PUBLISHER));
+  }
+  for (int64_t i = 0; i < numPartnerCohorts_; ++i) {
+    groupBits_.push_back(shareBits(
+        myRole_ == common::PARTNER ? inputData.bitmaskFor(i)
+                                   : std::vector<int64_t>{},
+        common::PARTNER));
+  }
+
+  XLOG(INFO) << "Share opportunity timestamps and impressions";
+  auto opportunityTimestamps = shareInts<timeStampWidth>(
+      detail::biasTimestamps(inputData.getOpportunityTimestamps()),
+      common::PUBLISHER);
+  auto numImpressions = shareInts<valueWidth>(
+      detail::toUnsigned(inputData.getNumImpressions()), common::PUBLISHER);
+
+  XLOG(INFO) << "Share purchase timestamps";
+  auto purchaseTimestamps = shareIntArrays<timeStampWidth>(
+      detail::biasTimestampArrays(inputData.getPurchaseTimestampArrays()),
+      common::PARTNER);
+
+  PrivateInputs inputs;
+  if (!shouldSkipValues_) {
+    XLOG(INFO) << "Share purchase values and values squared";
+    inputs.purchaseValues = shareIntArrays<valueWidth>(
+        detail::toUnsignedArrays(inputData.getPurchaseValueArrays()),
+        common::PARTNER);
+    inputs.purchaseValuesSquared = shareIntArrays<valueWidth>(
+        detail::toUnsignedArrays(inputData.getPurchaseValueSquaredArrays()),
+        common::PARTNER);
+  }
+
+  XLOG(INFO) << "Calculate valid purchases";
+  const PubTimestamp<schedulerId> offset(
+      std::vector<uint64_t>(numRows_, kPurchaseTimestampOffset));
+  for (const auto& purchaseTimestamp : purchaseTimestamps) {
+    inputs.validPurchases.push_back(
+        opportunityTimestamps < purchaseTimestamp + offset);
+  }
+
+  // A row is matched if it has a valid opportunity and any purchase, and
+  // reached if it has any impression
+  const PubTimestamp<schedulerId> zeroTimestamp(
+      std::vector<uint64_t>(numRows_, kTimestampSignBit));
+  auto hasPurchase = zeroTimestamp < purchaseTimestamps.at(0);
+  for (size_t i = 1; i < purchaseTimestamps.size(); ++i) {
+    hasPurchase = hasPurchase | (zeroTimestamp < purchaseTimestamps.at(i));
+  }
+  inputs.isMatched = hasPurchase & (zeroTimestamp < opportunityTimestamps);
+  const PubValue<schedulerId> zero(std::vector<uint64_t>(numRows_, 0));
+  inputs.isReached = zero < numImpressions;
+  return inputs;
+}
+
+template <int schedulerId>
+void CalculatorGame<schedulerId>::computePopulationMetrics(
+    bool isTest,
+    const SecBit<schedulerId>& isUser,
+    const PrivateInputs& inputs) {
+  auto histogram = isTest ? &OutputMetricsData::testConvHistogram
+                          : &OutputMetricsData::controlConvHistogram;
+
+  // events[i] is set if the user made a valid purchase at slot i, and
+  // firstEvents[i] if it is the first one. A user whose first valid purchase
+  // is at slot i has numConversionsPerUser - i valid purchases.
+  std::vector<SecBit<schedulerId>> events;
+  std::vector<SecBit<schedulerId>> firstEvents;
+  for (const auto& validPurchase : inputs.validPurchases) {
+    events.push_back(isUser & validPurchase);
+  }
+  auto anyEvent = events.at(0);
+  firstEvents.push_back(events.at(0));
+  for (size_t i = 1; i < events.size(); ++i) {
+    firstEvents.push_back(events.at(i) & !anyEvent);
+    anyEvent = anyEvent | events.at(i);
+  }
+
+  addBitSum(
+      events,
+      detail::setField(
+          isTest ? &OutputMetricsData::testEvents
+                 : &OutputMetricsData::controlEvents));
+  addBitSum(
+      {anyEvent},
+      detail::setField(
+          isTest ? &OutputMetricsData::testConverters
+                 : &OutputMetricsData::controlConverters));
+  addBitSum({isUser & !anyEvent}, detail::setHistogramBin(histogram, 0));
+  for (size_t i = 0; i < firstEvents.size(); ++i) {
+    addBitSum(
+        {firstEvents.at(i)},
+        detail::setHistogramBin(histogram, numConversionsPerUser_ - i));
+  }
+  addBitSum(
+      {isUser & inputs.isMatched},
+      detail::setField(
+          isTest ? &OutputMetricsData::testMatchCount
+                 : &OutputMetricsData::controlMatchCount));
+
+  const PubValue<schedulerId> zero(std::vector<uint64_t>(numRows_, 0));
+  std::vector<SecValue<schedulerId>> numConvSquared;
+  for (size_t i = 0; i < firstEvents.size(); ++i) {
+    uint64_t numConv = numConversionsPerUser_ - i;
+    SecValue<schedulerId> numConvSquaredIfFirst(
+        std::vector<uint64_t>(numRows_, numConv * numConv), common::PUBLISHER);
+    numConvSquared.push_back(
+        zero.mux(firstEvents.at(i), numConvSquaredIfFirst));
+  }
+  addIntSum(
+      numConvSquared,
+      detail::setField(
+          isTest ? &OutputMetricsData::testNumConvSquared
+                 : &OutputMetricsData::controlNumConvSquared));
+
+  auto isReached = isUser & inputs.isReached;
+  if (isTest) {
+    std::vector<SecBit<schedulerId>> reachedConversions;
+    for (const auto& validPurchase : inputs.validPurchases) {
+      reachedConversions.push_back(validPurchase & isReached);
+    }
+    addBitSum(
+        reachedConversions,
+        detail::setField(&OutputMetricsData::reachedConversions));
+  }
+
+  if (shouldSkipValues_) {
+    return;
+  }
+  std::vector<SecValue<schedulerId>> values;
+  std::vector<SecValue<schedulerId>> valuesSquared;
+  for (size_t i = 0; i < events.size(); ++i) {
+    values.push_back(zero.mux(events.at(i), inputs.purchaseValues.at(i)));
+    // The squared value of the first event is the square of the sum of all
+    // values from there on
+    valuesSquared.push_back(
+        zero.mux(firstEvents.at(i), inputs.purchaseValuesSquared.at(i)));
+  }
+  if (isTest) {
+    std::vector<SecValue<schedulerId>> reachedValues;
+    for (const auto& value : values) {
+      reachedValues.push_back(zero.mux(isReached, value));
+    }
+    addIntSum(
+        reachedValues, detail::setField(&OutputMetricsData::reachedValue));
+  }
+  addIntSum(
+      values,
+      detail::setField(
+          isTest ? &OutputMetricsData::testValue
+                 : &OutputMetricsData::controlValue));
+  addIntSum(
+      valuesSquared,
+      detail::setField(
+          isTest ? &OutputMetricsData::testValueSquared
+                 : &OutputMetricsData::controlValueSquared));
+}
+
+template <int schedulerId>
+void CalculatorGame<schedulerId>::addBitSum(
+    const std::vector<SecBit<schedulerId>>& columns,
+    std::function<void(OutputMetricsData&, int64_t)> setMetric) {
+  // Group 0 is the overall population
+  for (size_t group = 0; group <= groupBits_.size(); ++group) {
+    Summand summand{group, setMetric, {}};
+    for (const auto& column : columns) {
+      auto shares = column_sums::bitShares<schedulerId>(
+          group == 0 ? column : column & groupBits_.at(group - 1));
+      summand.shares.insert(summand.shares.end(), shares.begin(), shares.end());
+    }
+    bitSummands_.push_back(std::move(summand));
+  }
+}
+
+template <int schedulerId>
+void CalculatorGame<schedulerId>::addIntSum(
+    const std::vector<SecValue<schedulerId>>& columns,
+    std::function<void(OutputMetricsData&, int64_t)> setMetric) {
+  const PubValue<schedulerId> zero(std::vector<uint64_t>(numRows_, 0));
+  for (size_t group = 0; group <= groupBits_.size(); ++group) {
+    Summand summand{group, setMetric, {}};
+    for (const auto& column : columns) {
+      auto shares = column_sums::intShares<schedulerId, valueWidth>(
+          group == 0 ? column : zero.mux(groupBits_.at(group - 1), column));
+      summand.shares.insert(summand.shares.end(), shares.begin(), shares.end());
+    }
+    intSummands_.push_back(std::move(summand));
+  }
+}
+
+template <int schedulerId>
+GroupedLiftMetrics CalculatorGame<schedulerId>::revealMetrics(
+    bool isConversionLift) {
+  XLOG(INFO) << "Sum and reveal " << bitSummands_.size() + intSummands_.size()
+             << " metrics";
+  // Bit columns are counted with adders that grow with the counts, while
+  // integer columns are summed at their own width
+  std::vector<std::vector<uint64_t>> bitColumns;
+  for (auto& summand : bitSummands_) {
+    bitColumns.push_back(std::move(summand.shares));
+  }
+  std::vector<std::vector<uint64_t>> intColumns;
+  for (auto& summand : intSummands_) {
+    intColumns.push_back(std::move(summand.shares));
+  }
+  auto sumShares =
+      column_sums::sumColumns<schedulerId, 1, true>(std::move(bitColumns));
+  auto intSumShares = column_sums::sumColumns<schedulerId, valueWidth, false>(
+      std::move(intColumns));
+  sumShares.insert(sumShares.end(), intSumShares.begin(), intSumShares.end());
+  auto sums = column_sums::revealSums<schedulerId>(
+      myRole_, sumShares, useXorEncryption_);
+
+  std::vector<OutputMetricsData> groupMetrics(
+      1 + numPublisherBreakdowns_ + numPartnerCohorts_,
+      OutputMetricsData{isConversionLift});
+  if (numRows_ > 0) {
+    for (auto& metrics : groupMetrics) {
+      metrics.testConvHistogram.resize(numConversionsPerUser_ + 1);
+      metrics.controlConvHistogram.resize(numConversionsPerUser_ + 1);
+    }
+  }
+  size_t i = 0;
+  for (const auto& summands : {&bitSummands_, &intSummands_}) {
+    for (const auto& summand : *summands) {
+      summand.setMetric(groupMetrics.at(summand.group), sums.at(i++));
+    }
+  }
+
+  GroupedLiftMetrics res;
+  res.metrics = groupMetrics.at(0).toLiftMetrics();
+  for (int64_t j = 0; j < numPublisherBreakdowns_; ++j) {
+    res.publisherBreakdowns.push_back(groupMetrics.at(1 + j).toLiftMetrics());
+  }
+  for (int64_t j = 0; j < numPartnerCohorts_; ++j) {
+    res.cohortMetrics.push_back(
+        groupMetrics.at(1 + numPublisherBreakdowns_ + j).toLiftMetrics());
+  }
+  return res;
+}
+
+} // namespace private_lift
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/Constants.h"
+
+namespace private_lift {
+
+/**
+ * Helpers to sum many secret columns at once. Columns are given as the
+ * extracted XOR shares of their rows, and are all reduced together by an adder
+ * tree: every round adds the pairs of neighbouring rows of every column in a
+ * single batch, so summing any number of columns takes log2(rows) batched
+ * additions.
+ */
+namespace column_sums {
+
+/**
+ * The shares of a batch of secret bits, as the shares of 1-bit integers.
+ */
+template <int schedulerId>
+std::vector<uint64_t> bitShares(const SecBit<schedulerId>& bits) {
+  auto shares = bits.extractBit().getValue();
+  return std::vector<uint64_t>(shares.begin(), shares.end());
+}
+
+/**
+ * The shares of a batch of secret integers.
+ */
+template <int schedulerId, size_t width>
+std::vector<uint64_t> intShares(
+    const SecUnsignedInt<schedulerId, width>& ints) {
+  return ints.extractIntShare().getValue();
+}
+
+/**
+ * Sum every column, where all shares are below 2^width. If growWidth is set,
+ * every round adds with one more bit than the previous one, so that no sum can
+ * overflow while the adders of the first rounds stay narrow. Otherwise sums
+ * wrap around at width bits. Returns the shares of the sum of every column,
+ * which is zero for an empty column.
+ */
+template <int schedulerId, size_t width, bool growWidth>
+std::vector<uint64_t> sumColumns(std::vector<std::vector<uint64_t>> columns) {
+  constexpr size_t nextWidth = (growWidth && width < 64) ? width + 1 : width;
+  using SecInt = SecUnsignedInt<schedulerId, nextWidth>;
+
+  size_t maxNumRows = 0;
+  for (const auto& column : columns) {
+    maxNumRows = std::max(maxNumRows, column.size());
+  }
+  if (maxNumRows <= 1) {
+    std::vector<uint64_t> sums;
+    sums.reserve(columns.size());
+    for (const auto& column : columns) {
+      sums.push_back(column.empty() ? 0 : column.at(0));
+    }
+    return sums;
+  }
+
+  // Add rows 2i and 2i + 1 of every column. A missing last row is a share of
+  // zero on both sides.
+  std::vector<uint64_t> leftShares;
+  std::vector<uint64_t> rightShares;
+  for (const auto& column : columns) {
+    for (size_t i = 0; i < column.size(); i += 2) {
+      leftShares.push_back(column.at(i));
+      rightShares.push_back(i + 1 < column.size() ? column.at(i + 1) : 0);
+    }
+  }
+  typename SecInt::ExtractedInt left(leftShares);
+  typename SecInt::ExtractedInt right(rightShares);
+  auto sumShares =
+      (SecInt(std::move(left)) + SecInt(std::move(right)))
+          .extractIntShare()
+          .getValue();
+
+  size_t offset = 0;
+  for (auto& column : columns) {
+    auto numPairs = (column.size() + 1) / 2;
+    column.assign(
+        sumShares.begin() + offset, sumShares.begin() + offset + numPairs);
+    offset += numPairs;
+  }
+  return sumColumns<schedulerId, nextWidth, growWidth>(std::move(columns));
+}
+
+/**
+ * Reveal the sums from their shares, all in one batch. With XOR encryption,
+ * every party gets its XOR share of the sums. Otherwise both parties get the
+ * sums in the clear.
+ */
+template <int schedulerId>
+std::vector<int64_t> revealSums(
+    int myRole,
+    const std::vector<uint64_t>& shares,
+    bool useXorEncryption) {
+  using SecInt = SecUnsignedInt<schedulerId, 64>;
+  if (shares.empty()) {
+    return std::vector<int64_t>{};
+  }
+
+  typename SecInt::ExtractedInt extractedSums(shares);
+  SecInt sums(std::move(extractedSums));
+  std::vector<uint64_t> values;
+  if (useXorEncryption) {
+    values = sums.extractIntShare().getValue();
+  } else {
+    auto publisherValues = sums.openToParty(common::PUBLISHER).getValue();
+    auto partnerValues = sums.openToParty(common::PARTNER).getValue();
+    values = myRole == common::PUBLISHER ? std::move(publisherValues)
+                                         : std::move(partnerValues);
+  }
+  return std::vector<int64_t>(values.begin(), values.end());
+}
+
+} // namespace column_sums
+
+} // namespace private_lift
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include "fbpcf/frontend/mpcGame.h"
+
+namespace private_lift {
+
+const int kMaxConcurrency = 16;
+
+// Unlike the EMP game, which picks its widths from the data (see BitWidths.h),
+// the widths here are template arguments and therefore fixed. Timestamps are
+// relative to the epoch and must fit in 32 signed bits, even with
+// kPurchaseTimestampOffset added; sharing inputs fails otherwise. Values,
+// values squared and impressions always use 64 bits.
+const size_t timeStampWidth = 32;
+const size_t valueWidth = 64;
+
+// Timestamps are signed, but secret integers are unsigned. Flipping the sign
+// bit of every timestamp before sharing keeps their order, so that unsigned
+// comparisons give the same results as the signed comparisons of the EMP game.
+const uint64_t kTimestampSignBit = uint64_t{1} << (timeStampWidth - 1);
+
+// A purchase is valid if it happened no more than this many seconds before the
+// opportunity
+const uint64_t kPurchaseTimestampOffset = 10;
+
+// Range of the timestamps that fit in timeStampWidth bits
+const int64_t kMinTimestamp = -(int64_t{1} << (timeStampWidth - 1));
+const int64_t kMaxTimestamp =
+    (int64_t{1} << (timeStampWidth - 1)) - 1 -
+    static_cast<int64_t>(kPurchaseTimestampOffset);
+
+template <int schedulerId>
+using PubBit =
+    typename fbpcf::frontend::MpcGame<schedulerId>::template PubBit<true>;
+template <int schedulerId>
+using SecBit =
+    typename fbpcf::frontend::MpcGame<schedulerId>::template SecBit<true>;
+
+template <int schedulerId, size_t width>
+using PubUnsignedInt = typename fbpcf::frontend::MpcGame<
+    schedulerId>::template PubUnsignedInt<width, true>;
+template <int schedulerId, size_t width>
+using SecUnsignedInt = typename fbpcf::frontend::MpcGame<
+    schedulerId>::template SecUnsignedInt<width, true>;
+
+template <int schedulerId>
+using PubTimestamp = PubUnsignedInt<schedulerId, timeStampWidth>;
+template <int schedulerId>
+using SecTimestamp = SecUnsignedInt<schedulerId, timeStampWidth>;
+
+template <int schedulerId>
+using PubValue = PubUnsignedInt<schedulerId, valueWidth>;
+template <int schedulerId>
+using SecValue = SecUnsignedInt<schedulerId, valueWidth>;
+
+} // namespace private_lift
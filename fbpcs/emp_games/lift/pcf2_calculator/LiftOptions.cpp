@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+
+#include "fbpcs/emp_games/lift/pcf2_calculator/LiftOptions.h"
+
+DEFINE_int32(party, 1, "1 = publisher, 2 = partner");
+DEFINE_string(server_ip, "127.0.0.1", "Server's IP address");
+DEFINE_int32(
+    port,
+    15200,
+    "Network port for establishing connection to other player");
+DEFINE_string(
+    input_base_path,
+    "",
+    "Local or s3 base path for the sharded input files");
+DEFINE_string(
+    output_base_path,
+    "",
+    "Local or s3 base path where output files are written to");
+DEFINE_int32(
+    file_start_index,
+    0,
+    "First file that will be read with base path");
+DEFINE_int32(num_files, 1, "Number of files that should be read");
+DEFINE_int64(
+    epoch,
+    1546300800,
+    "Unixtime of 2019-01-01. Used as our 'new epoch' for timestamps");
+DEFINE_bool(
+    is_conversion_lift,
+    true,
+    "Use conversion_lift logic (as opposed to converter_lift logic)");
+DEFINE_bool(
+    use_xor_encryption,
+    true,
+    "Reveal output with XOR secret shares instead of in the clear to both parties");
+DEFINE_int32(
+    num_conversions_per_user,
+    25,
+    "Cap and pad to this many conversions per user");
+DEFINE_int32(
+    concurrency,
+    1,
+    "max number of game(s) that will run concurrently");
+DEFINE_string(
+    run_name,
+    "",
+    "A user given run name that will be used in s3 filename");
+DEFINE_bool(
+    use_postfix,
+    true,
+    "A postfix number added to input/output files to accommodate sharding");
+DEFINE_bool(
+    log_cost,
+    false,
+    "Log cost info into cloud which will be used for dashboard");
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <future>
+#include <memory>
+
+#include "fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorApp.h"
+
+namespace private_lift {
+
+inline std::pair<std::vector<std::string>, std::vector<std::string>>
+getIOFilenames(
+    int32_t numFiles,
+    std::string inputBasePath,
+    std::string outputBasePath,
+    int32_t fileStartIndex,
+    bool use_postfix) {
+  // get all input files (we have multiple files if they were sharded)
+  std::vector<std::string> inputFilenames;
+  std::vector<std::string> outputFilenames;
+
+  if (use_postfix) {
+    for (auto i = 0; i < numFiles; i++) {
+      inputFilenames.push_back(
+          folly::sformat("{}_{}", inputBasePath, (fileStartIndex + i)));
+      outputFilenames.push_back(
+          folly::sformat("{}_{}", outputBasePath, (fileStartIndex + i)));
+    }
+  } else {
+    inputFilenames.push_back(inputBasePath);
+    outputFilenames.push_back(outputBasePath);
+  }
+  return std::make_pair(inputFilenames, outputFilenames);
+}
+
+template <int PARTY, int index>
+inline common::SchedulerStatistics startCalculatorAppsForShardedFilesHelper(
+    int startFileIndex,
+    int remainingThreads,
+    std::string serverIp,
+    int port,
+    bool isConversionLift,
+    int32_t numConversionsPerUser,
+    int64_t epoch,
+    bool useXorEncryption,
+    std::vector<std::string>& inputFilenames,
+    std::vector<std::string>& outputFilenames) {
+  // aggregate scheduler statistics across apps
+  common::SchedulerStatistics schedulerStatistics{0, 0, 0, 0};
+
+  // split files evenly across threads
+  auto remainingFiles = inputFilenames.size() - startFileIndex;
+  if (remainingFiles > 0) {
+    auto numFiles = (remainingThreads > remainingFiles)
+        ? 1
+        : (remainingFiles / remainingThreads);
+
+    std::map<
+        int,
+        fbpcf::engine::communication::SocketPartyCommunicationAgentFactory::
+            PartyInfo>
+        partyInfos(
+            {{0, {serverIp, port + index * 100}},
+             {1, {serverIp, port + index * 100}}});
+
+    auto communicationAgentFactory = std::make_unique<
+        fbpcf::engine::communication::SocketPartyCommunicationAgentFactory>(
+        PARTY, partyInfos, false, "");
+
+    // Each CalculatorApp runs numFiles sequentially on a single thread
+    // Publisher uses even schedulerId and partner uses odd schedulerId
+    auto app = std::make_unique<CalculatorApp<PARTY, 2 * index + PARTY>>(
+        std::move(communicationAgentFactory),
+        inputFilenames,
+        outputFilenames,
+        isConversionLift,
+        numConversionsPerUser,
+        epoch,
+        useXorEncryption,
+        startFileIndex,
+        numFiles);
+
+    auto future = std::async([&app]() {
+      app->run();
+      return app->getSchedulerStatistics();
+    });
+
+    if constexpr (index < kMaxConcurrency) {
+      if (remainingThreads > 1) {
+        auto remainingStats =
+            startCalculatorAppsForShardedFilesHelper<PARTY, index + 1>(
+                startFileIndex + numFiles,
+                remainingThreads - 1,
+                serverIp,
+                port,
+                isConversionLift,
+                numConversionsPerUser,
+                epoch,
+                useXorEncryption,
+                inputFilenames,
+                outputFilenames);
+        schedulerStatistics.add(remainingStats);
+      }
+    }
+    auto stats = future.get();
+    schedulerStatistics.add(stats);
+  }
+  return schedulerStatistics;
+}
+
+template <int PARTY>
+inline common::SchedulerStatistics startCalculatorAppsForShardedFiles(
+    std::vector<std::string>& inputFilenames,
+    std::vector<std::string>& outputFilenames,
+    int16_t concurrency,
+    std::string serverIp,
+    int port,
+    bool isConversionLift,
+    int32_t numConversionsPerUser,
+    int64_t epoch,
+    bool useXorEncryption) {
+  // use only as many threads as the number of files
+  auto numThreads = std::min((int)inputFilenames.size(), (int)concurrency);
+
+  return startCalculatorAppsForShardedFilesHelper<PARTY, 0>(
+      0,
+      numThreads,
+      serverIp,
+      port,
+      isConversionLift,
+      numConversionsPerUser,
+      epoch,
+      useXorEncryption,
+      inputFilenames,
+      outputFilenames);
+}
+
+} // namespace private_lift
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gflags/gflags.h>
+#include <string>
+
+#include "folly/Format.h"
+#include "folly/init/Init.h"
+#include "folly/logging/xlog.h"
+
+#include <fbpcf/aws/AwsSdk.h>
+#include <fbpcs/performance_tools/CostEstimation.h>
+
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/common/Util.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/LiftOptions.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/MainUtil.h"
+
+int main(int argc, char* argv[]) {
+  fbpcs::performance_tools::CostEstimation cost =
+      fbpcs::performance_tools::CostEstimation("lift", "pcf2");
+  cost.start();
+
+  folly::init(&argc, &argv);
+  gflags::ParseCommandLineFlags(&argc, &argv, true);
+  fbpcf::AwsSdk::aquire();
+
+  FLAGS_party--; // subtract 1 because we use 0 and 1 for publisher and partner
+                 // instead of 1 and 2
+
+  XLOGF(INFO, "Party: {}", FLAGS_party);
+  XLOGF(INFO, "Server IP: {}", FLAGS_server_ip);
+  XLOGF(INFO, "Port: {}", FLAGS_port);
+  XLOGF(INFO, "Base input path: {}", FLAGS_input_base_path);
+  XLOGF(INFO, "Base output path: {}", FLAGS_output_base_path);
+
+  common::SchedulerStatistics schedulerStatistics;
+
+  try {
+    auto [inputFilenames, outputFilenames] = private_lift::getIOFilenames(
+        FLAGS_num_files,
+        FLAGS_input_base_path,
+        FLAGS_output_base_path,
+        FLAGS_file_start_index,
+        FLAGS_use_postfix);
+    int16_t concurrency = static_cast<int16_t>(FLAGS_concurrency);
+
+    if (FLAGS_party == common::PUBLISHER) {
+      XLOG(INFO) << "Starting lift as Publisher, will wait for Partner...";
+      schedulerStatistics =
+          private_lift::startCalculatorAppsForShardedFiles<common::PUBLISHER>(
+              inputFilenames,
+              outputFilenames,
+              concurrency,
+              FLAGS_server_ip,
+              FLAGS_port,
+              FLAGS_is_conversion_lift,
+              FLAGS_num_conversions_per_user,
+              FLAGS_epoch,
+              FLAGS_use_xor_encryption);
+    } else if (FLAGS_party == common::PARTNER) {
+      XLOG(INFO) << "Starting lift as Partner, will wait for Publisher...";
+      schedulerStatistics =
+          private_lift::startCalculatorAppsForShardedFiles<common::PARTNER>(
+              inputFilenames,
+              outputFilenames,
+              concurrency,
+              FLAGS_server_ip,
+              FLAGS_port,
+              FLAGS_is_conversion_lift,
+              FLAGS_num_conversions_per_user,
+              FLAGS_epoch,
+              FLAGS_use_xor_encryption);
+    } else {
+      XLOGF(FATAL, "Invalid Party: {}", FLAGS_party);
+    }
+  } catch (const std::exception& e) {
+    XLOG(ERR) << "Error: Exception caught in Lift run.\n \t error msg: "
+              << e.what() << "\n \t input directory: " << FLAGS_input_base_path;
+    std::exit(1);
+  }
+
+  cost.end();
+  XLOG(INFO, cost.getEstimatedCostString());
+
+  XLOGF(
+      INFO,
+      "Non-free gate count = {}, Free gate count = {}",
+      schedulerStatistics.nonFreeGates,
+      schedulerStatistics.freeGates);
+
+  XLOGF(
+      INFO,
+      "Sent network traffic = {}, Received network traffic = {}",
+      schedulerStatistics.sentNetwork,
+      schedulerStatistics.receivedNetwork);
+
+  if (FLAGS_log_cost) {
+    auto run_name = (FLAGS_run_name != "") ? FLAGS_run_name : "temp_run_name";
+    auto party = (FLAGS_party == common::PUBLISHER) ? "Publisher" : "Partner";
+
+    folly::dynamic extra_info = common::getCostExtraInfo(
+        party,
+        FLAGS_input_base_path,
+        FLAGS_output_base_path,
+        FLAGS_num_files,
+        FLAGS_file_start_index,
+        FLAGS_concurrency,
+        FLAGS_use_xor_encryption,
+        schedulerStatistics);
+
+    XLOGF(
+        INFO,
+        "{}",
+        cost.writeToS3(
+            party,
+            run_name,
+            cost.getEstimatedCostDynamic(run_name, party, extra_info)));
+  }
+
+  return 0;
+}
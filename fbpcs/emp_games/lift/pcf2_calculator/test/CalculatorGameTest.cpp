@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <string>
+#include <unordered_map>
+
+#include <gtest/gtest.h>
+
+#include "folly/Format.h"
+#include "folly/Random.h"
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/common/Csv.h"
+#include "fbpcs/emp_games/common/TestUtil.h"
+#include "fbpcs/emp_games/lift/common/GroupedLiftMetrics.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGame.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/CalculatorGameConfig.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/InputData.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/test/common/GenFakeData.h"
+#include "fbpcs/emp_games/lift/pcf2_calculator/test/common/LiftCalculator.h"
+
+namespace private_lift {
+
+const bool unsafe = true;
+const int64_t kEpoch = 1546300800;
+const int32_t kNumConversionsPerUser = 4;
+
+template <int schedulerId>
+GroupedLiftMetrics computeMetricsWithInsecureEngine(
+    int myRole,
+    CalculatorGameConfig config,
+    bool useXorEncryption,
+    std::reference_wrapper<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  CalculatorGame<schedulerId> game(
+      myRole,
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>(
+          myRole, factory),
+      useXorEncryption);
+  return game.computeMetrics(config);
+}
+
+/*
+ * The EMP game and this game both define the private_lift InputData, so they
+ * cannot be linked into the same test. Instead, this suite runs the PCF2 game
+ * on the lift test data and checks it against the plaintext LiftCalculator
+ * that the EMP game is tested against, and against the output of the EMP game
+ * on the cohort test data.
+ */
+class CalculatorGameTest : public ::testing::TestWithParam<bool> {
+ protected:
+  void SetUp() override {
+    std::string tempDir = std::filesystem::temp_directory_path();
+    publisherInputFilename_ = folly::sformat(
+        "{}/publisher_{}.csv", tempDir, folly::Random::secureRand64());
+    partnerInputFilename_ = folly::sformat(
+        "{}/partner_{}.csv", tempDir, folly::Random::secureRand64());
+    sampleInputDir_ =
+        private_measurement::test_util::getBaseDirFromPath(__FILE__) +
+        "../sample_input/";
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(publisherInputFilename_);
+    std::filesystem::remove(partnerInputFilename_);
+  }
+
+  CalculatorGameConfig getInputData(const std::string& inputPath) {
+    InputData inputData{
+        inputPath,
+        InputData::LiftMPCType::Standard,
+        InputData::LiftGranularityType::Conversion,
+        kEpoch,
+        kNumConversionsPerUser};
+    return CalculatorGameConfig{
+        std::move(inputData), true, kNumConversionsPerUser};
+  }
+
+  // Run both parties, and combine the XOR shares of their outputs if needed
+  GroupedLiftMetrics runGame(
+      const std::string& publisherInputPath,
+      const std::string& partnerInputPath) {
+    bool useXorEncryption = GetParam();
+    auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+
+    auto future0 = std::async(
+        computeMetricsWithInsecureEngine<0>,
+        common::PUBLISHER,
+        getInputData(publisherInputPath),
+        useXorEncryption,
+        std::reference_wrapper<
+            fbpcf::engine::communication::IPartyCommunicationAgentFactory>(
+            *factories[0]));
+    auto future1 = std::async(
+        computeMetricsWithInsecureEngine<1>,
+        common::PARTNER,
+        getInputData(partnerInputPath),
+        useXorEncryption,
+        std::reference_wrapper<
+            fbpcf::engine::communication::IPartyCommunicationAgentFactory>(
+            *factories[1]));
+    auto res0 = future0.get();
+    auto res1 = future1.get();
+
+    if (useXorEncryption) {
+      return res0 ^ res1;
+    }
+    EXPECT_EQ(res0, res1);
+    return res0;
+  }
+
+  GroupedLiftMetrics computeExpectedMetrics(
+      const std::string& publisherInputPath,
+      const std::string& partnerInputPath) {
+    LiftCalculator liftCalculator;
+    std::ifstream inFilePublisher{publisherInputPath};
+    std::ifstream inFilePartner{partnerInputPath};
+    int32_t tsOffset = 10;
+    std::string linePublisher;
+    std::string linePartner;
+    getline(inFilePublisher, linePublisher);
+    getline(inFilePartner, linePartner);
+    auto headerPublisher =
+        private_measurement::csv::splitByComma(linePublisher, false);
+    auto headerPartner =
+        private_measurement::csv::splitByComma(linePartner, false);
+    std::unordered_map<std::string, int> colNameToIndex =
+        liftCalculator.mapColToIndex(headerPublisher, headerPartner);
+    GroupedLiftMetrics expected;
+    expected.metrics = liftCalculator
+                           .compute(
+                               inFilePublisher,
+                               inFilePartner,
+                               colNameToIndex,
+                               tsOffset)
+                           .toLiftMetrics();
+    return expected;
+  }
+
+  void generateFakeData(bool omitValuesColumn) {
+    GenFakeData testDataGenerator;
+    LiftFakeDataParams params;
+    params.setNumRows(15)
+        .setOpportunityRate(0.5)
+        .setTestRate(0.5)
+        .setPurchaseRate(0.5)
+        .setIncrementalityRate(0.0)
+        .setEpoch(kEpoch);
+    testDataGenerator.genFakePublisherInputFile(
+        publisherInputFilename_, params);
+    params.setNumConversions(kNumConversionsPerUser)
+        .setOmitValuesColumn(omitValuesColumn);
+    testDataGenerator.genFakePartnerInputFile(partnerInputFilename_, params);
+  }
+
+  std::string publisherInputFilename_;
+  std::string partnerInputFilename_;
+  std::string sampleInputDir_;
+};
+
+TEST_P(CalculatorGameTest, TestSampleShard) {
+  auto publisherInputPath = sampleInputDir_ + "publisher_0";
+  auto partnerInputPath = sampleInputDir_ + "partner_4_convs_0";
+  EXPECT_EQ(
+      runGame(publisherInputPath, partnerInputPath),
+      computeExpectedMetrics(publisherInputPath, partnerInputPath));
+}
+
+TEST_P(CalculatorGameTest, TestRandomInputConversionLift) {
+  generateFakeData(false);
+  EXPECT_EQ(
+      runGame(publisherInputFilename_, partnerInputFilename_),
+      computeExpectedMetrics(publisherInputFilename_, partnerInputFilename_));
+}
+
+TEST_P(CalculatorGameTest, TestRandomInputConversionLiftValueless) {
+  generateFakeData(true);
+  EXPECT_EQ(
+      runGame(publisherInputFilename_, partnerInputFilename_),
+      computeExpectedMetrics(publisherInputFilename_, partnerInputFilename_));
+}
+
+TEST_P(CalculatorGameTest, TestCohorts) {
+  // Metrics of the EMP game on the same input
+  GroupedLiftMetrics expected;
+  expected.metrics = LiftMetrics{
+      3, 4, 2, 1, 179, 177, 16705, 31329, 5, 16, 2, 1, 0, 0,
+      {3, 1, 1, 0, 0}, {9, 0, 0, 0, 1}};
+  expected.cohortMetrics = {
+      LiftMetrics{
+          0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,
+          {3, 0, 0, 0, 0}, {9, 0, 0, 0, 0}},
+      LiftMetrics{
+          3, 0, 2, 0, 179, 0, 16705, 0, 5, 0, 2, 0, 0, 0,
+          {0, 1, 1, 0, 0}, {0, 0, 0, 0, 0}},
+      LiftMetrics{
+          0, 4, 0, 1, 0, 177, 0, 31329, 0, 16, 0, 1, 0, 0,
+          {0, 0, 0, 0, 0}, {0, 0, 0, 0, 1}}};
+
+  EXPECT_EQ(
+      runGame(
+          sampleInputDir_ + "publisher_unittest.csv",
+          sampleInputDir_ + "partner_4_convs_unittest.csv"),
+      expected);
+}
+
+TEST(CalculatorGameTimestampTest, TestTimestampsOutOfRange) {
+  EXPECT_NO_THROW(detail::biasTimestamps({kMinTimestamp, 0, kMaxTimestamp}));
+  EXPECT_THROW(
+      detail::biasTimestamps({kMaxTimestamp + 1}), std::invalid_argument);
+  EXPECT_THROW(
+      detail::biasTimestamps({kMinTimestamp - 1}), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    CalculatorGameTestSuite,
+    CalculatorGameTest,
+    ::testing::Bool(),
+    [](const testing::TestParamInfo<CalculatorGameTest::ParamType>& info) {
+      return info.param ? "XorEncryption" : "Public";
+    });
+
+} // namespace private_lift
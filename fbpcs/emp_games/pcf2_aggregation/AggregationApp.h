@@ -7,16 +7,20 @@
 
 #pragma once
 
+#include <memory>
+#include <optional>
+
 #include <fbpcf/io/FileManagerUtil.h>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
 #include "fbpcs/emp_games/common/SchedulerStatistics.h"
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationGame.h"
 
 namespace pcf2_aggregation {
 
-template <int MY_ROLE, int schedulerId>
+template <int MY_ROLE, int schedulerId, bool usingBatch>
 class AggregationApp {
  public:
   AggregationApp(
@@ -31,7 +35,8 @@ class AggregationApp {
       const std::vector<std::string>& outputFilePaths,
       const int startFileIndex = 0,
       const int numFiles = 1,
-      const int concurrency = 1)
+      const int concurrency = 1,
+      const int oramConcurrency = 1)
       : inputEncryption_(inputEncryption),
         outputVisibility_(outputVisibility),
         communicationAgentFactory_(std::move(communicationAgentFactory)),
@@ -42,52 +47,62 @@ class AggregationApp {
         startFileIndex_(startFileIndex),
         numFiles_(numFiles),
         concurrency_(concurrency),
+        oramConcurrency_(oramConcurrency),
         schedulerStatistics_{0, 0, 0, 0} {}
 
   void run() {
     auto scheduler = fbpcf::scheduler::createLazySchedulerWithRealEngine(
         MY_ROLE, *communicationAgentFactory_);
 
-    AggregationGame<schedulerId> game(
+    std::unique_ptr<AggregationGame<schedulerId, usingBatch>> game;
+    std::unique_ptr<common::PhaseTracker> phaseTracker;
+    if (!FLAGS_phase_profile_path.empty()) {
+      // Only sampled while the game runs, so the game exists by then
+      phaseTracker = std::make_unique<common::PhaseTracker>(
+          [&game]() { return game->getSchedulerStatistics(); });
+    }
+
+    game = std::make_unique<AggregationGame<schedulerId, usingBatch>>(
         std::move(scheduler),
         std::move(communicationAgentFactory_),
         inputEncryption_,
-        concurrency_);
+        concurrency_,
+        oramConcurrency_,
+        phaseTracker.get());
 
     // Compute aggregations sequentially on numFiles files, starting from
     // startFileIndex
     for (size_t i = startFileIndex_; i < startFileIndex_ + numFiles_; ++i) {
       CHECK_LT(i, inputSecretShareFilePaths_.size())
           << "File index exceeds number of files.";
+      std::optional<common::ScopedPhase> phase;
+      phase.emplace(phaseTracker.get(), "read_input");
       auto inputData = getInputData(
           inputEncryption_,
           inputSecretShareFilePaths_.at(i),
           inputClearTextFilePaths_.at(i));
+      phase.reset();
       auto output =
-          game.computeAggregations(MY_ROLE, inputData, outputVisibility_);
+          game->computeAggregations(MY_ROLE, inputData, outputVisibility_);
+      phase.emplace(phaseTracker.get(), "write_output");
       putOutputData(output, outputFilePaths_.at(i));
     }
 
-    auto gateStatistics =
-        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getGateStatistics();
+    // Includes the schedulers of the parallel ORAMs
+    schedulerStatistics_ = game->getSchedulerStatistics();
     XLOGF(
         INFO,
         "Non-free gate count = {}, Free gate count = {}",
-        gateStatistics.first,
-        gateStatistics.second);
-
-    auto trafficStatistics =
-        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getTrafficStatistics();
+        schedulerStatistics_.nonFreeGates,
+        schedulerStatistics_.freeGates);
     XLOGF(
         INFO,
         "Sent network traffic = {}, Received network traffic = {}",
-        trafficStatistics.first,
-        trafficStatistics.second);
-
-    schedulerStatistics_.nonFreeGates = gateStatistics.first;
-    schedulerStatistics_.freeGates = gateStatistics.second;
-    schedulerStatistics_.sentNetwork = trafficStatistics.first;
-    schedulerStatistics_.receivedNetwork = trafficStatistics.second;
+        schedulerStatistics_.sentNetwork,
+        schedulerStatistics_.receivedNetwork);
+    if (phaseTracker) {
+      schedulerStatistics_.phases = phaseTracker->getPhases();
+    }
   }
 
   common::SchedulerStatistics getSchedulerStatistics() {
@@ -132,6 +147,7 @@ class AggregationApp {
   int startFileIndex_;
   int numFiles_;
   int concurrency_;
+  int oramConcurrency_;
   common::SchedulerStatistics schedulerStatistics_;
 };
 
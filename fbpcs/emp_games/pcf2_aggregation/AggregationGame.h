@@ -7,12 +7,18 @@
 
 #pragma once
 
+#include <functional>
+#include <optional>
+
 #include "folly/logging/xlog.h"
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgent.h"
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/frontend/mpcGame.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
 #include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
 #include "fbpcs/emp_games/common/Util.h"
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationMetrics.h"
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationOptions.h"
@@ -24,46 +30,75 @@
 
 namespace pcf2_aggregation {
 
-template <int schedulerId>
+// Creates the scheduler of each ORAM after the first, see
+// createWriteOnlyOramFactories
+using SchedulerCreator = std::function<std::unique_ptr<
+    fbpcf::scheduler::IScheduler>(
+    int myRole,
+    fbpcf::engine::communication::IPartyCommunicationAgentFactory&
+        communicationAgentFactory)>;
+
+template <int schedulerId, bool usingBatch>
 class AggregationGame : public fbpcf::frontend::MpcGame<schedulerId> {
  public:
+  /**
+   * Phases of the game are recorded in phaseTracker, unless it is null.
+   * strategy overrides getAggregationStrategy, e.g. for tests. The schedulers
+   * of the parallel ORAMs are made by oramSchedulerCreator, which must use the
+   * same engine as scheduler.
+   */
   explicit AggregationGame(
       std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler,
       std::shared_ptr<
           fbpcf::engine::communication::IPartyCommunicationAgentFactory>
           communicationAgentFactory,
       common::InputEncryption inputEncryption,
-      const int concurrency = 1)
+      const int concurrency = 1,
+      const int oramConcurrency = 1,
+      common::PhaseTracker* phaseTracker = nullptr,
+      std::optional<AggregationStrategy> strategy = std::nullopt,
+      SchedulerCreator oramSchedulerCreator =
+          fbpcf::scheduler::createLazySchedulerWithRealEngine)
       : fbpcf::frontend::MpcGame<schedulerId>(std::move(scheduler)),
         communicationAgentFactory_(communicationAgentFactory),
         inputEncryption_(inputEncryption),
-        concurrency_(concurrency) {}
+        concurrency_(concurrency),
+        oramConcurrency_(oramConcurrency),
+        phaseTracker_(phaseTracker),
+        strategy_(strategy),
+        oramSchedulerCreator_(std::move(oramSchedulerCreator)) {}
 
   /**
    * Publisher shares aggregation formats with partner
    */
-  const std::vector<AggregationFormat<schedulerId>> shareAggregationFormats(
+  const std::vector<AggregationFormat<schedulerId, usingBatch>>
+  shareAggregationFormats(
       const int myRole,
       const std::vector<std::string>& aggregationFormatNames);
 
   /**
    * Publisher privately shares measurement touchpoint metadata with partner.
+   * With batching, each shared touchpoint holds a batch across all ids.
+   * Compressed ad ids are shared with adIdBits bits.
    */
-  std::vector<std::vector<PrivateMeasurementTouchpointMetadata<schedulerId>>>
+  template <size_t adIdBits = adIdWidth>
+  MeasurementTpmArrays<schedulerId, usingBatch, adIdBits>
   privatelyShareMeasurementTouchpointMetadata(
       const std::vector<std::vector<TouchpointMetadata>>& touchpointMetadata);
 
   /**
    * Partner privately shares measurement conversion metadata with publisher.
+   * With batching, each shared conversion holds a batch across all ids.
    */
-  std::vector<std::vector<PrivateMeasurementConversionMetadata<schedulerId>>>
+  MeasurementCvmArrays<schedulerId, usingBatch>
   privatelyShareMeasurementConversionMetadata(
       const std::vector<std::vector<ConversionMetadata>>& conversionMetadata);
 
   /**
-   * Both parties read attribution results as secret shared bits.
+   * Both parties read attribution results as secret shared bits. With
+   * batching, each shared result holds a batch across all ids.
    */
-  std::vector<std::vector<PrivateAttributionResult<schedulerId>>>
+  PrivateAttributionResultArrays<schedulerId, usingBatch>
   privatelyShareAttributionResults(
       const std::vector<std::vector<AttributionResult>>& attributionResults);
 
@@ -89,11 +124,72 @@ class AggregationGame : public fbpcf::frontend::MpcGame<schedulerId> {
       const AggregationInputMetrics& inputData,
       common::Visibility outputVisibility);
 
+  /**
+   * Create the write-only ORAM factories, one per ORAM that batches are added
+   * to in parallel. The first ORAM uses this game's scheduler, and every other
+   * ORAM gets a scheduler of its own, which later calls reuse. Returns no
+   * factories when the ad ids are aggregated by oblivious sort instead.
+   */
+  WriteOnlyOramFactories createWriteOnlyOramFactories(
+      const int myRole,
+      size_t numValidOriginalAdIds);
+
+  /**
+   * Gate and traffic counts of this game's scheduler plus those of the
+   * schedulers created for the other ORAMs.
+   */
+  common::SchedulerStatistics getSchedulerStatistics() const;
+
  private:
+  /**
+   * Compute the aggregations once the compressed ad id width, adIdBits, has
+   * been chosen from the number of valid ad ids.
+   */
+  template <size_t adIdBits>
+  AggregationOutputMetrics computeAggregationsWithAdIdWidth(
+      const int myRole,
+      const AggregationInputMetrics& inputData,
+      common::Visibility outputVisibility,
+      const std::vector<AggregationFormat<schedulerId, usingBatch>>&
+          aggregationFormats,
+      const std::vector<std::vector<TouchpointMetadata>>&
+          touchpointMetadataArrays,
+      const std::vector<uint64_t>& validOriginalAdIds);
+
+  AggregationStrategy getStrategy(size_t numValidOriginalAdIds) const {
+    return strategy_.value_or(getAggregationStrategy(numValidOriginalAdIds));
+  }
+
+  template <int oramIndex>
+  void addWriteOnlyOramFactories(
+      const int myRole,
+      size_t numValidOriginalAdIds,
+      size_t numOrams,
+      WriteOnlyOramFactories& writeOnlyOramFactories);
+
+  template <int oramIndex>
+  void addOramSchedulerStatistics(
+      common::SchedulerStatistics& schedulerStatistics) const;
+
+  template <int id>
+  static common::SchedulerStatistics getSchedulerKeeperStatistics();
+
+  template <int oramSchedulerId>
+  std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
+      fbpcf::mpc_std_lib::util::AggregationValue>>
+  createWriteOnlyOramFactory(const int myRole, size_t numValidOriginalAdIds);
+
   std::shared_ptr<fbpcf::engine::communication::IPartyCommunicationAgentFactory>
       communicationAgentFactory_;
   common::InputEncryption inputEncryption_;
   const int concurrency_;
+  const int oramConcurrency_;
+  common::PhaseTracker* phaseTracker_;
+  const std::optional<AggregationStrategy> strategy_;
+  SchedulerCreator oramSchedulerCreator_;
+  // Number of schedulers created for the ORAMs after the first. They are kept
+  // across calls, so their counts add up like those of the game's scheduler.
+  size_t numOramSchedulers_ = 0;
 };
 
 } // namespace pcf2_aggregation
@@ -7,124 +7,175 @@
 
 #pragma once
 
+#include <algorithm>
+#include <iterator>
+#include <optional>
+
 #include "fbpcf/engine/util/AesPrgFactory.h"
 #include "fbpcf/mpc_std_lib/oram/DifferenceCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/LinearOramFactory.h"
 #include "fbpcf/mpc_std_lib/oram/ObliviousDeltaCalculatorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/SinglePointArrayGeneratorFactory.h"
 #include "fbpcf/mpc_std_lib/oram/WriteOnlyOramFactory.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
 #include "folly/logging/xlog.h"
 
 namespace pcf2_aggregation {
 
-template <int schedulerId>
-std::vector<std::vector<PrivateMeasurementTouchpointMetadata<schedulerId>>>
-AggregationGame<schedulerId>::privatelyShareMeasurementTouchpointMetadata(
-    const std::vector<std::vector<TouchpointMetadata>>& touchpointMetadata) {
-  return common::privatelyShareArrays<
-      TouchpointMetadata,
-      PrivateMeasurementTouchpointMetadata<schedulerId>>(touchpointMetadata);
+template <int schedulerId, bool usingBatch>
+template <size_t adIdBits>
+MeasurementTpmArrays<schedulerId, usingBatch, adIdBits>
+AggregationGame<schedulerId, usingBatch>::
+    privatelyShareMeasurementTouchpointMetadata(
+        const std::vector<std::vector<TouchpointMetadata>>&
+            touchpointMetadata) {
+  if constexpr (usingBatch) {
+    return common::privatelyShareTransposedArrays<
+        TouchpointMetadata,
+        PrivateMeasurementTouchpointMetadata<
+            schedulerId,
+            usingBatch,
+            adIdBits>>(touchpointMetadata);
+  } else {
+    return common::privatelyShareArrays<
+        TouchpointMetadata,
+        PrivateMeasurementTouchpointMetadata<
+            schedulerId,
+            usingBatch,
+            adIdBits>>(touchpointMetadata);
+  }
 }
 
-template <int schedulerId>
-std::vector<std::vector<PrivateMeasurementConversionMetadata<schedulerId>>>
-AggregationGame<schedulerId>::privatelyShareMeasurementConversionMetadata(
-    const std::vector<std::vector<ConversionMetadata>>& conversionMetadata) {
-  return common::privatelyShareArrays<
-      ConversionMetadata,
-      PrivateMeasurementConversionMetadata<schedulerId>>(conversionMetadata);
+template <int schedulerId, bool usingBatch>
+MeasurementCvmArrays<schedulerId, usingBatch>
+AggregationGame<schedulerId, usingBatch>::
+    privatelyShareMeasurementConversionMetadata(
+        const std::vector<std::vector<ConversionMetadata>>&
+            conversionMetadata) {
+  if constexpr (usingBatch) {
+    return common::privatelyShareTransposedArrays<
+        ConversionMetadata,
+        PrivateMeasurementConversionMetadata<schedulerId, usingBatch>>(
+        conversionMetadata);
+  } else {
+    return common::privatelyShareArrays<
+        ConversionMetadata,
+        PrivateMeasurementConversionMetadata<schedulerId, usingBatch>>(
+        conversionMetadata);
+  }
 }
 
-template <int schedulerId>
-std::vector<std::vector<PrivateAttributionResult<schedulerId>>>
-AggregationGame<schedulerId>::privatelyShareAttributionResults(
+template <int schedulerId, bool usingBatch>
+PrivateAttributionResultArrays<schedulerId, usingBatch>
+AggregationGame<schedulerId, usingBatch>::privatelyShareAttributionResults(
     const std::vector<std::vector<AttributionResult>>& attributionResults) {
-  return common::privatelyShareArrays<
-      AttributionResult,
-      PrivateAttributionResult<schedulerId>>(attributionResults);
+  if constexpr (usingBatch) {
+    return common::privatelyShareTransposedArrays<
+        AttributionResult,
+        PrivateAttributionResult<schedulerId, usingBatch>>(attributionResults);
+  } else {
+    return common::privatelyShareArrays<
+        AttributionResult,
+        PrivateAttributionResult<schedulerId, usingBatch>>(attributionResults);
+  }
 }
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch>
 const std::vector<uint64_t>
-AggregationGame<schedulerId>::retrieveValidOriginalAdIds(
+AggregationGame<schedulerId, usingBatch>::retrieveValidOriginalAdIds(
     const int myRole,
     std::vector<std::vector<TouchpointMetadata>>& touchpointMetadataArrays) {
-  std::unordered_set<uint64_t> adIdSet;
-  for (auto& touchpointMetadataArray : touchpointMetadataArrays) {
-    for (auto& touchpointMetadata : touchpointMetadataArray) {
-      // Share ad id
-      SecOriginalAdId<schedulerId> secAdId;
-      if (inputEncryption_ == common::InputEncryption::Xor) {
-        typename SecOriginalAdId<schedulerId>::ExtractedInt extractedAdId(
-            touchpointMetadata.originalAdId);
-        secAdId = SecOriginalAdId<schedulerId>(std::move(extractedAdId));
-      } else {
-        secAdId = SecOriginalAdId<schedulerId>(
-            touchpointMetadata.originalAdId, common::PUBLISHER);
-      }
+  // Flatten the ad ids of all touchpoints, so that they can be shared and
+  // revealed to each party in a single batch.
+  std::vector<uint64_t> originalAdIds;
+  for (const auto& touchpointMetadataArray : touchpointMetadataArrays) {
+    for (const auto& touchpointMetadata : touchpointMetadataArray) {
+      originalAdIds.push_back(touchpointMetadata.originalAdId);
+    }
+  }
 
-      // Reveal ad id to publisher and partner
-      auto publisherAdId = secAdId.openToParty(common::PUBLISHER).getValue();
-      auto partnerAdId = secAdId.openToParty(common::PARTNER).getValue();
-      auto revealedAdId =
-          (myRole == common::PUBLISHER) ? publisherAdId : partnerAdId;
+  std::vector<uint64_t> validOriginalAdIds;
+  if (!originalAdIds.empty()) {
+    // Share ad ids
+    SecOriginalAdId<schedulerId, true> secAdIds;
+    if (inputEncryption_ == common::InputEncryption::Xor) {
+      typename SecOriginalAdId<schedulerId, true>::ExtractedInt extractedAdIds(
+          originalAdIds);
+      secAdIds = SecOriginalAdId<schedulerId, true>(std::move(extractedAdIds));
+    } else {
+      secAdIds =
+          SecOriginalAdId<schedulerId, true>(originalAdIds, common::PUBLISHER);
+    }
+
+    // Reveal ad ids to publisher and partner
+    auto publisherAdIds = secAdIds.openToParty(common::PUBLISHER).getValue();
+    auto partnerAdIds = secAdIds.openToParty(common::PARTNER).getValue();
+    const auto& revealedAdIds =
+        (myRole == common::PUBLISHER) ? publisherAdIds : partnerAdIds;
 
-      touchpointMetadata.originalAdId = revealedAdId;
-      if (revealedAdId > 0) {
-        adIdSet.insert(revealedAdId);
+    size_t i = 0;
+    for (auto& touchpointMetadataArray : touchpointMetadataArrays) {
+      for (auto& touchpointMetadata : touchpointMetadataArray) {
+        touchpointMetadata.originalAdId = revealedAdIds.at(i++);
       }
     }
+
+    // Deduplicate the valid (non-zero) ad ids by sorting them
+    std::copy_if(
+        revealedAdIds.begin(),
+        revealedAdIds.end(),
+        std::back_inserter(validOriginalAdIds),
+        [](uint64_t adId) { return adId > 0; });
+    std::sort(validOriginalAdIds.begin(), validOriginalAdIds.end());
+    validOriginalAdIds.erase(
+        std::unique(validOriginalAdIds.begin(), validOriginalAdIds.end()),
+        validOriginalAdIds.end());
   }
 
-  XLOGF(INFO, "Number of Ad Ids: {}", adIdSet.size());
-  // Added a check here to make sure that number of ad Ids never exceed 65,536
-  // (8 unsigned bit)
-  CHECK_LE(adIdSet.size(), 65536)
-      << "Number of ad Ids cannot be more than 65,536.";
+  XLOGF(INFO, "Number of Ad Ids: {}", validOriginalAdIds.size());
 
-  std::vector<uint64_t> validOriginalAdIds;
-  validOriginalAdIds.insert(
-      validOriginalAdIds.end(), adIdSet.begin(), adIdSet.end());
-  std::sort(validOriginalAdIds.begin(), validOriginalAdIds.end());
   return validOriginalAdIds;
 }
 
-template <int schedulerId>
-void AggregationGame<schedulerId>::replaceAdIdWithCompressedAdId(
+template <int schedulerId, bool usingBatch>
+void AggregationGame<schedulerId, usingBatch>::replaceAdIdWithCompressedAdId(
     std::vector<std::vector<TouchpointMetadata>>& touchpointMetadataArrays,
     std::vector<uint64_t>& validOriginalAdIds) {
-  uint16_t compressedAdId = 1;
-  std::unordered_map<uint64_t, uint16_t> adIdToCompressedAdIdMap;
-
-  for (auto adId : validOriginalAdIds) {
-    adIdToCompressedAdIdMap.insert({adId, compressedAdId});
-    compressedAdId++;
-  }
-
+  // validOriginalAdIds is sorted and unique, so the compressed ad id of an
+  // original ad id is its (1-based) position in validOriginalAdIds.
   for (auto& touchpointMetadataArray : touchpointMetadataArrays) {
     for (auto& touchpointMetadata : touchpointMetadataArray) {
       if (touchpointMetadata.originalAdId > 0) {
+        auto it = std::lower_bound(
+            validOriginalAdIds.begin(),
+            validOriginalAdIds.end(),
+            touchpointMetadata.originalAdId);
+        CHECK(
+            it != validOriginalAdIds.end() &&
+            *it == touchpointMetadata.originalAdId)
+            << "Ad id " << touchpointMetadata.originalAdId << " is not valid.";
         touchpointMetadata.adId =
-            adIdToCompressedAdIdMap.at(touchpointMetadata.originalAdId);
+            std::distance(validOriginalAdIds.begin(), it) + 1;
       }
     }
   }
 }
 
-template <int schedulerId>
-const std::vector<AggregationFormat<schedulerId>>
-AggregationGame<schedulerId>::shareAggregationFormats(
+template <int schedulerId, bool usingBatch>
+const std::vector<AggregationFormat<schedulerId, usingBatch>>
+AggregationGame<schedulerId, usingBatch>::shareAggregationFormats(
     const int myRole,
     const std::vector<std::string>& aggregationFormatNames) {
-  std::vector<AggregationFormat<schedulerId>> aggregationFormats;
+  std::vector<AggregationFormat<schedulerId, usingBatch>> aggregationFormats;
   std::vector<uint64_t> aggregationFormatIds;
 
   // Publisher converts aggregation format names to aggregation formats and
   // ids
   if (myRole == common::PUBLISHER) {
     for (auto aggregationFormatName : aggregationFormatNames) {
-      auto aggregationFormat = AggregationFormat<schedulerId>::fromNameOrThrow(
-          aggregationFormatName);
+      auto aggregationFormat =
+          AggregationFormat<schedulerId, usingBatch>::fromNameOrThrow(
+              aggregationFormatName);
       aggregationFormats.push_back(aggregationFormat);
       aggregationFormatIds.push_back(aggregationFormat.id);
     }
@@ -132,7 +183,7 @@ AggregationGame<schedulerId>::shareAggregationFormats(
 
   const size_t aggregationFormatIdWidth = 1; // currently we support 1 format
   CHECK_LT(
-      (SUPPORTED_AGGREGATION_FORMATS<schedulerId>).size(),
+      (SUPPORTED_AGGREGATION_FORMATS<schedulerId, usingBatch>).size(),
       (1 << aggregationFormatIdWidth));
 
   // Publisher shares aggregation format ids
@@ -145,15 +196,16 @@ AggregationGame<schedulerId>::shareAggregationFormats(
   if (myRole == common::PARTNER) {
     for (auto sharedAggregationFormatId : sharedAggregationFormatIds) {
       aggregationFormats.push_back(
-          AggregationFormat<schedulerId>::fromIdOrThrow(
+          AggregationFormat<schedulerId, usingBatch>::fromIdOrThrow(
               sharedAggregationFormatId));
     }
   }
   return aggregationFormats;
 }
 
-template <int schedulerId>
-AggregationOutputMetrics AggregationGame<schedulerId>::computeAggregations(
+template <int schedulerId, bool usingBatch>
+AggregationOutputMetrics
+AggregationGame<schedulerId, usingBatch>::computeAggregations(
     const int myRole,
     const AggregationInputMetrics& inputData,
     common::Visibility outputVisibility) {
@@ -164,6 +216,8 @@ AggregationOutputMetrics AggregationGame<schedulerId>::computeAggregations(
   XLOGF(INFO, "Have {} ids", numIds);
 
   // Send over all of the data needed for this computation
+  std::optional<common::ScopedPhase> phase;
+  phase.emplace(phaseTracker_, "share_metadata");
   XLOG(INFO, "Sharing aggregation formats...");
   const auto aggregationFormats =
       shareAggregationFormats(myRole, inputData.getAggregationFormats());
@@ -172,55 +226,90 @@ AggregationOutputMetrics AggregationGame<schedulerId>::computeAggregations(
   XLOG(INFO, "Sharing original Ad Ids...");
   auto validOriginalAdIds =
       retrieveValidOriginalAdIds(myRole, touchpointMetadataArrays);
+  phase.reset();
 
   XLOG(INFO, "Replacing original ad Ids with compressed ad Ids");
   replaceAdIdWithCompressedAdId(touchpointMetadataArrays, validOriginalAdIds);
 
+  auto compressedAdIdWidth = getCompressedAdIdWidth(validOriginalAdIds.size());
+  XLOGF(INFO, "Compressed ad Ids have {} bits", compressedAdIdWidth);
+  switch (compressedAdIdWidth) {
+    case adIdWidth:
+      return computeAggregationsWithAdIdWidth<adIdWidth>(
+          myRole,
+          inputData,
+          outputVisibility,
+          aggregationFormats,
+          touchpointMetadataArrays,
+          validOriginalAdIds);
+    case mediumAdIdWidth:
+      return computeAggregationsWithAdIdWidth<mediumAdIdWidth>(
+          myRole,
+          inputData,
+          outputVisibility,
+          aggregationFormats,
+          touchpointMetadataArrays,
+          validOriginalAdIds);
+    default:
+      return computeAggregationsWithAdIdWidth<maxAdIdWidth>(
+          myRole,
+          inputData,
+          outputVisibility,
+          aggregationFormats,
+          touchpointMetadataArrays,
+          validOriginalAdIds);
+  }
+}
+
+template <int schedulerId, bool usingBatch>
+template <size_t adIdBits>
+AggregationOutputMetrics
+AggregationGame<schedulerId, usingBatch>::computeAggregationsWithAdIdWidth(
+    const int myRole,
+    const AggregationInputMetrics& inputData,
+    common::Visibility outputVisibility,
+    const std::vector<AggregationFormat<schedulerId, usingBatch>>&
+        sharedAggregationFormats,
+    const std::vector<std::vector<TouchpointMetadata>>&
+        touchpointMetadataArrays,
+    const std::vector<uint64_t>& validOriginalAdIds) {
+  uint32_t numIds = inputData.getIds().size();
+
+  std::vector<AggregationFormat<schedulerId, usingBatch, adIdBits>>
+      aggregationFormats;
+  for (const auto& aggregationFormat : sharedAggregationFormats) {
+    aggregationFormats.push_back(
+        AggregationFormat<schedulerId, usingBatch, adIdBits>::fromIdOrThrow(
+            aggregationFormat.id));
+  }
+
+  std::optional<common::ScopedPhase> phase;
+  phase.emplace(phaseTracker_, "share_inputs");
   XLOG(INFO, "Sharing touchpoint and conversion metadata...");
-  MeasurementTpmArrays<schedulerId> privateTpmArrays;
-  MeasurementCvmArrays<schedulerId> privateCvmArrays;
-  std::vector<std::vector<PrivateAttributionResult<schedulerId>>>
-      privateAttributionResult;
+  MeasurementTpmArrays<schedulerId, usingBatch, adIdBits> privateTpmArrays;
+  MeasurementCvmArrays<schedulerId, usingBatch> privateCvmArrays;
   for (const auto& aggregationFormat : aggregationFormats) {
     switch (aggregationFormat.id) {
       case AGGREGATION_FORMAT::AD_OBJECT_FORMAT:
-        privateTpmArrays = AggregationGame<schedulerId>::
-            privatelyShareMeasurementTouchpointMetadata(
+        privateTpmArrays =
+            privatelyShareMeasurementTouchpointMetadata<adIdBits>(
                 touchpointMetadataArrays);
-        privateCvmArrays = AggregationGame<schedulerId>::
-            privatelyShareMeasurementConversionMetadata(
-                inputData.getConversionMetadata());
+        privateCvmArrays = privatelyShareMeasurementConversionMetadata(
+            inputData.getConversionMetadata());
         break;
     }
   }
 
-  const int8_t indicatorSumWidth = adIdWidth;
-  bool isPublisher = (myRole == common::PUBLISHER);
-  auto oramRole = isPublisher
-      ? fbpcf::mpc_std_lib::oram::IWriteOnlyOram<
-            fbpcf::mpc_std_lib::util::AggregationValue>::Alice
-      : fbpcf::mpc_std_lib::oram::IWriteOnlyOram<
-            fbpcf::mpc_std_lib::util::AggregationValue>::Bob;
-
-  PrivateAggregationMetrics<schedulerId> aggregationMetrics{
-      aggregationFormats,
-      AggregationContext{validOriginalAdIds},
-      outputVisibility,
-      myRole,
-      concurrency_,
-      // linear ORAM will be less efficient theoretically if ORAM size is larger
-      // than 4. Since ORAM size is adid size + 1, we use 3 as the threshold
-      // here.
-      std::move(
-          validOriginalAdIds.size() > 3
-              ? fbpcf::mpc_std_lib::oram::getSecureWriteOnlyOramFactory<
-                    fbpcf::mpc_std_lib::util::AggregationValue,
-                    indicatorSumWidth,
-                    schedulerId>(isPublisher, 0, 1, *communicationAgentFactory_)
-              : fbpcf::mpc_std_lib::oram::getSecureLinearOramFactory<
-                    fbpcf::mpc_std_lib::util::AggregationValue,
-                    schedulerId>(
-                    isPublisher, 0, 1, *communicationAgentFactory_))};
+  PrivateAggregationMetrics<schedulerId, usingBatch, adIdBits>
+      aggregationMetrics{
+          aggregationFormats,
+          AggregationContext{
+              validOriginalAdIds, getStrategy(validOriginalAdIds.size())},
+          outputVisibility,
+          myRole,
+          concurrency_,
+          createWriteOnlyOramFactories(myRole, validOriginalAdIds.size())};
+  phase.reset();
 
   AggregationOutputMetrics out;
   const auto& attributionRules = inputData.getAttributionRules();
@@ -238,15 +327,17 @@ AggregationOutputMetrics AggregationGame<schedulerId>::computeAggregations(
       attributionResultsPerRule.push_back(results);
     }
 
+    phase.emplace(phaseTracker_, "share_attribution_results");
     XLOG(INFO, "Sharing attribution results...");
     auto secretSharePerRule =
-        AggregationGame<schedulerId>::privatelyShareAttributionResults(
-            attributionResultsPerRule);
+        privatelyShareAttributionResults(attributionResultsPerRule);
 
-    PrivateAggregation<schedulerId> privateAggregation{
-        secretSharePerRule, privateTpmArrays, privateCvmArrays};
+    PrivateAggregation<schedulerId, usingBatch, adIdBits> privateAggregation{
+        secretSharePerRule, privateTpmArrays, privateCvmArrays, numIds};
 
+    phase.emplace(phaseTracker_, "aggregation_circuit");
     aggregationMetrics.computeAggregationsPerFormat(privateAggregation);
+    phase.reset();
 
     // currently we only support one aggregation format
     XLOGF(
@@ -255,10 +346,121 @@ AggregationOutputMetrics AggregationGame<schedulerId>::computeAggregations(
         aggregationFormats.at(0).name,
         attributionRules.at(i));
 
+    phase.emplace(phaseTracker_, "reveal");
     out.ruleToMetrics[attributionRules.at(i)] = aggregationMetrics.reveal();
+    phase.reset();
   }
 
   return out;
 }
 
+template <int schedulerId, bool usingBatch>
+WriteOnlyOramFactories
+AggregationGame<schedulerId, usingBatch>::createWriteOnlyOramFactories(
+    const int myRole,
+    size_t numValidOriginalAdIds) {
+  if (getStrategy(numValidOriginalAdIds) ==
+      AggregationStrategy::ObliviousSort) {
+    return WriteOnlyOramFactories{};
+  }
+
+  size_t numOrams =
+      std::max(1, std::min(oramConcurrency_, kMaxOramConcurrency));
+  XLOGF(INFO, "Adding ORAM batches with {} ORAMs in parallel", numOrams);
+
+  WriteOnlyOramFactories writeOnlyOramFactories;
+  writeOnlyOramFactories.push_back(
+      createWriteOnlyOramFactory<schedulerId>(myRole, numValidOriginalAdIds));
+  addWriteOnlyOramFactories<1>(
+      myRole, numValidOriginalAdIds, numOrams, writeOnlyOramFactories);
+  return writeOnlyOramFactories;
+}
+
+template <int schedulerId, bool usingBatch>
+template <int oramIndex>
+void AggregationGame<schedulerId, usingBatch>::addWriteOnlyOramFactories(
+    const int myRole,
+    size_t numValidOriginalAdIds,
+    size_t numOrams,
+    WriteOnlyOramFactories& writeOnlyOramFactories) {
+  if constexpr (oramIndex < kMaxOramConcurrency) {
+    if (static_cast<size_t>(oramIndex) < numOrams) {
+      constexpr int oramSchedulerId =
+          schedulerId + 2 * kMaxConcurrency * oramIndex;
+      if (static_cast<size_t>(oramIndex) > numOramSchedulers_) {
+        fbpcf::scheduler::SchedulerKeeper<oramSchedulerId>::setScheduler(
+            oramSchedulerCreator_(myRole, *communicationAgentFactory_));
+        numOramSchedulers_ = oramIndex;
+      }
+      writeOnlyOramFactories.push_back(
+          createWriteOnlyOramFactory<oramSchedulerId>(
+              myRole, numValidOriginalAdIds));
+      addWriteOnlyOramFactories<oramIndex + 1>(
+          myRole, numValidOriginalAdIds, numOrams, writeOnlyOramFactories);
+    }
+  }
+}
+
+template <int schedulerId, bool usingBatch>
+common::SchedulerStatistics
+AggregationGame<schedulerId, usingBatch>::getSchedulerStatistics() const {
+  auto schedulerStatistics = getSchedulerKeeperStatistics<schedulerId>();
+  addOramSchedulerStatistics<1>(schedulerStatistics);
+  return schedulerStatistics;
+}
+
+template <int schedulerId, bool usingBatch>
+template <int oramIndex>
+void AggregationGame<schedulerId, usingBatch>::addOramSchedulerStatistics(
+    common::SchedulerStatistics& schedulerStatistics) const {
+  if constexpr (oramIndex < kMaxOramConcurrency) {
+    if (static_cast<size_t>(oramIndex) <= numOramSchedulers_) {
+      constexpr int oramSchedulerId =
+          schedulerId + 2 * kMaxConcurrency * oramIndex;
+      schedulerStatistics.add(getSchedulerKeeperStatistics<oramSchedulerId>());
+      addOramSchedulerStatistics<oramIndex + 1>(schedulerStatistics);
+    }
+  }
+}
+
+template <int schedulerId, bool usingBatch>
+template <int id>
+common::SchedulerStatistics
+AggregationGame<schedulerId, usingBatch>::getSchedulerKeeperStatistics() {
+  auto gateStatistics =
+      fbpcf::scheduler::SchedulerKeeper<id>::getGateStatistics();
+  auto trafficStatistics =
+      fbpcf::scheduler::SchedulerKeeper<id>::getTrafficStatistics();
+  return common::SchedulerStatistics{
+      gateStatistics.first,
+      gateStatistics.second,
+      trafficStatistics.first,
+      trafficStatistics.second};
+}
+
+template <int schedulerId, bool usingBatch>
+template <int oramSchedulerId>
+std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
+    fbpcf::mpc_std_lib::util::AggregationValue>>
+AggregationGame<schedulerId, usingBatch>::createWriteOnlyOramFactory(
+    const int myRole,
+    size_t numValidOriginalAdIds) {
+  const int8_t indicatorSumWidth = adIdWidth;
+  bool isPublisher = (myRole == common::PUBLISHER);
+
+  // linear ORAM will be less efficient theoretically if ORAM size is larger
+  // than 4. Since ORAM size is adid size + 1, kMaxLinearOramAdIds is 3.
+  if (getStrategy(numValidOriginalAdIds) ==
+      AggregationStrategy::WriteOnlyOram) {
+    return fbpcf::mpc_std_lib::oram::getSecureWriteOnlyOramFactory<
+        fbpcf::mpc_std_lib::util::AggregationValue,
+        indicatorSumWidth,
+        oramSchedulerId>(isPublisher, 0, 1, *communicationAgentFactory_);
+  } else {
+    return fbpcf::mpc_std_lib::oram::getSecureLinearOramFactory<
+        fbpcf::mpc_std_lib::util::AggregationValue,
+        oramSchedulerId>(isPublisher, 0, 1, *communicationAgentFactory_);
+  }
+}
+
 } // namespace pcf2_aggregation
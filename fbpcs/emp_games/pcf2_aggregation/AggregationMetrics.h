@@ -204,17 +204,20 @@ class AggregationInputMetrics {
   std::vector<std::vector<ConversionMetadata>> conversionMetadataArrays_;
 };
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 class PrivateAggregationMetrics {
  public:
   PrivateAggregationMetrics(
-      std::vector<AggregationFormat<schedulerId>> aggregationFormats_,
+      std::vector<AggregationFormat<schedulerId, usingBatch, adIdBits>>
+          aggregationFormats_,
       const AggregationContext& ctx,
       const common::Visibility& outputVisibility,
       const int myRole,
       const int concurrency,
-      std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
-          fbpcf::mpc_std_lib::util::AggregationValue>> writeOnlyOramFactory) {
+      WriteOnlyOramFactories writeOnlyOramFactories) {
     for (auto aggregationFormat : aggregationFormats_) {
       formatToAggregator[aggregationFormat.name] =
           aggregationFormat.newAggregator(
@@ -222,12 +225,13 @@ class PrivateAggregationMetrics {
               outputVisibility,
               myRole,
               concurrency,
-              std::move(writeOnlyOramFactory));
+              std::move(writeOnlyOramFactories));
     }
   }
 
   void computeAggregationsPerFormat(
-      const PrivateAggregation<schedulerId>& privateAggregation) {
+      const PrivateAggregation<schedulerId, usingBatch, adIdBits>&
+          privateAggregation) {
     for (const auto& [format, aggregator] : formatToAggregator) {
       aggregator->aggregateAttributions(privateAggregation);
     }
@@ -244,7 +248,9 @@ class PrivateAggregationMetrics {
   }
 
  private:
-  std::unordered_map<std::string, std::unique_ptr<Aggregator<schedulerId>>>
+  std::unordered_map<
+      std::string,
+      std::unique_ptr<Aggregator<schedulerId, usingBatch, adIdBits>>>
       formatToAggregator;
 };
 
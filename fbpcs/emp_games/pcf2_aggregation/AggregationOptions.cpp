@@ -64,3 +64,11 @@ DEFINE_bool(
     log_cost,
     false,
     "Log cost info into cloud which will be used for dashboard");
+DEFINE_string(
+    phase_profile_path,
+    "",
+    "If set, write the gates, traffic and time of every game phase as JSON to this path");
+DEFINE_int32(
+    resource_sampling_interval_ms,
+    0,
+    "If positive, sample CPU, memory, I/O, network and threads at this interval and log the timeline with the cost info");
@@ -9,6 +9,8 @@
 
 #include <math.h>
 #include <memory>
+#include <optional>
+#include <vector>
 #include "folly/json.h"
 #include "folly/logging/xlog.h"
 
@@ -26,23 +28,41 @@ namespace pcf2_aggregation {
 using AttributionResultsList =
     std::vector<std::vector<std::vector<AttributionResult>>>;
 
-template <int schedulerId>
-using MeasurementTpmArrays =
-    std::vector<std::vector<PrivateMeasurementTouchpointMetadata<schedulerId>>>;
-
-template <int schedulerId>
-using MeasurementCvmArrays =
-    std::vector<std::vector<PrivateMeasurementConversionMetadata<schedulerId>>>;
+// Without batching, the outer vector is indexed by id and the inner vector by
+// touchpoint or conversion. With batching, the vector is indexed by touchpoint
+// or conversion, and each element holds a batch across all ids.
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
+using MeasurementTpmArrays = std::vector<ConditionalVector<
+    PrivateMeasurementTouchpointMetadata<schedulerId, usingBatch, adIdBits>,
+    !usingBatch>>;
+
+template <int schedulerId, bool usingBatch = false>
+using MeasurementCvmArrays = std::vector<ConditionalVector<
+    PrivateMeasurementConversionMetadata<schedulerId, usingBatch>,
+    !usingBatch>>;
+
+template <int schedulerId, bool usingBatch = false>
+using PrivateAttributionResultArrays = std::vector<ConditionalVector<
+    PrivateAttributionResult<schedulerId, usingBatch>,
+    !usingBatch>>;
 
 using AggregationOutput = folly::dynamic;
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 struct PrivateAggregation {
-  std::vector<std::vector<PrivateAttributionResult<schedulerId>>>
-      attributionResults;
-  MeasurementTpmArrays<schedulerId> privateTpm;
-  MeasurementCvmArrays<schedulerId> privateCvm;
+  PrivateAttributionResultArrays<schedulerId, usingBatch> attributionResults;
+  MeasurementTpmArrays<schedulerId, usingBatch, adIdBits> privateTpm;
+  MeasurementCvmArrays<schedulerId, usingBatch> privateCvm;
   // TODO: Add fields for additional aggregators to PrivateAggregation.
+
+  // Number of ids in each batch, only used for batch execution.
+  size_t batchSize = 0;
 };
 
 struct ConvMetrics {
@@ -61,7 +81,10 @@ struct ConvMetrics {
   }
 };
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 class Aggregator {
  public:
   explicit Aggregator(const common::Visibility& outputVisibility)
@@ -70,7 +93,8 @@ class Aggregator {
   virtual ~Aggregator() {}
 
   virtual void aggregateAttributions(
-      const PrivateAggregation<schedulerId>& privateAggregation) = 0;
+      const PrivateAggregation<schedulerId, usingBatch, adIdBits>&
+          privateAggregation) = 0;
 
   virtual AggregationOutput reveal() const = 0;
 
@@ -78,24 +102,64 @@ class Aggregator {
   const common::Visibility outputVisibility_;
 };
 
+// Write-only ORAM factories used by an aggregator, one per ORAM that batches
+// are added to in parallel. Each factory must use a different scheduler.
+using WriteOnlyOramFactories =
+    std::vector<std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
+        fbpcf::mpc_std_lib::util::AggregationValue>>>;
+
+enum class AggregationStrategy { LinearOram, WriteOnlyOram, ObliviousSort };
+
+/**
+ * Choose how to aggregate metrics per ad, based on the number of valid ad ids.
+ */
+inline AggregationStrategy getAggregationStrategy(size_t numAdIds) {
+  if (numAdIds <= kMaxLinearOramAdIds) {
+    return AggregationStrategy::LinearOram;
+  } else if (numAdIds <= kMaxWriteOnlyOramAdIds) {
+    return AggregationStrategy::WriteOnlyOram;
+  } else {
+    return AggregationStrategy::ObliviousSort;
+  }
+}
+
+/**
+ * Number of bits of the compressed ad ids. Compressed ad ids range from 1 to
+ * numAdIds, with 0 reserved for touchpoints that are not attributed.
+ */
+inline size_t getCompressedAdIdWidth(size_t numAdIds) {
+  if (numAdIds < (1ULL << adIdWidth)) {
+    return adIdWidth;
+  } else if (numAdIds < (1ULL << mediumAdIdWidth)) {
+    return mediumAdIdWidth;
+  }
+  CHECK_LT(numAdIds, 1ULL << maxAdIdWidth)
+      << "Number of ad Ids must be less than 2^" << maxAdIdWidth << ".";
+  return maxAdIdWidth;
+}
+
 struct AggregationContext {
   const std::vector<uint64_t>& validOriginalAdIds;
+  // overrides getAggregationStrategy, e.g. for tests
+  std::optional<AggregationStrategy> strategy = std::nullopt;
 };
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 class AggregationFormat {
  public:
   uint16_t id;
   std::string name;
-  Aggregator<schedulerId>& getAggregator();
+  Aggregator<schedulerId, usingBatch, adIdBits>& getAggregator();
 
-  std::function<std::unique_ptr<Aggregator<schedulerId>>(
+  std::function<std::unique_ptr<Aggregator<schedulerId, usingBatch, adIdBits>>(
       AggregationContext,
       common::Visibility,
       int myRole,
       int concurrency,
-      std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
-          fbpcf::mpc_std_lib::util::AggregationValue>> writeOnlyOramFactory)>
+      WriteOnlyOramFactories writeOnlyOramFactories)>
       newAggregator;
 
   static const AggregationFormat fromNameOrThrow(const std::string& name);
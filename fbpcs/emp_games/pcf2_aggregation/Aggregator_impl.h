@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <iterator>
 #include <memory>
 #include <string>
@@ -17,22 +18,26 @@
 
 #include "fbpcs/emp_games/common/Constants.h"
 #include "fbpcs/emp_games/pcf2_aggregation/Constants.h"
+#include "fbpcs/emp_games/pcf2_aggregation/ObliviousSort.h"
 
 namespace pcf2_aggregation {
 
 namespace {
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 struct MeasurementAggregation {
   // ad_id => metrics
   std::unordered_map<int64_t, ConvMetrics> metrics;
 
   // struct to store the touchpoint-conversion pairs.
   struct PrivateMeasurementAggregationResult {
-    SecBit<schedulerId> hasAttributedTouchpoint;
-    PrivateMeasurementConversionMetadata<schedulerId>
+    SecBit<schedulerId, usingBatch> hasAttributedTouchpoint;
+    PrivateMeasurementConversionMetadata<schedulerId, usingBatch>
         measurementConversionMetadata;
-    PrivateMeasurementTouchpointMetadata<schedulerId>
+    PrivateMeasurementTouchpointMetadata<schedulerId, usingBatch, adIdBits>
         measurementTouchpointMetadata;
   };
 
@@ -49,17 +54,34 @@ struct MeasurementAggregation {
   }
 };
 
-template <int schedulerId>
-class MeasurementAggregator : public Aggregator<schedulerId> {
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
+class MeasurementAggregator
+    : public Aggregator<schedulerId, usingBatch, adIdBits> {
  public:
+  using PrivateMeasurementAggregationResult = typename MeasurementAggregation<
+      schedulerId,
+      usingBatch,
+      adIdBits>::PrivateMeasurementAggregationResult;
+
+  // Without batching, the outer vector is indexed by id and the inner vector
+  // by conversion. With batching, the vector is indexed by conversion, and
+  // each element holds a batch across all ids.
+  using PrivateMeasurementAggregationResultArrays = std::vector<
+      ConditionalVector<PrivateMeasurementAggregationResult, !usingBatch>>;
+
   explicit MeasurementAggregator(
       const std::vector<uint64_t>& validOriginalAdIds,
+      AggregationStrategy strategy,
       const common::Visibility& outputVisibility,
       const int myRole,
       const int concurrency,
-      std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
-          fbpcf::mpc_std_lib::util::AggregationValue>> writeOnlyOramFactory)
-      : Aggregator<schedulerId>{outputVisibility} {
+      WriteOnlyOramFactories writeOnlyOramFactories)
+      : Aggregator<schedulerId, usingBatch, adIdBits>{outputVisibility},
+        _myRole{myRole},
+        _strategy{strategy} {
     _validOriginalAdIds = validOriginalAdIds;
     size_t oramSize = _validOriginalAdIds.size() + 1;
     // Note that oramSize must be nonzero because
@@ -67,14 +89,39 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
     CHECK_GT(oramSize, 0) << "ORAM size must be greater than zero.";
     _oramWidth =
         std::ceil(std::log2(oramSize)); // number of bits used to store the adId
-    _writeOnlyOram = writeOnlyOramFactory->create(oramSize);
-    _oramMaxBatchSize =
-        writeOnlyOramFactory->getMaxBatchSize(oramSize, concurrency);
-    XLOGF(INFO, "ORAM maxBatchSize = {}", _oramMaxBatchSize);
+    CHECK_LE(_oramWidth, adIdBits)
+        << "Compressed ad ids are too narrow for " << _validOriginalAdIds.size()
+        << " ad ids.";
+
+    if (_strategy == AggregationStrategy::ObliviousSort) {
+      XLOGF(
+          INFO,
+          "Aggregating {} ad ids with oblivious sort",
+          _validOriginalAdIds.size());
+      _sortIndexShares.resize(_oramWidth);
+      _sortValueShares.resize(salesValueWidth + convValueWidth);
+      return;
+    }
+
+    CHECK(!writeOnlyOramFactories.empty())
+        << "At least one write-only ORAM factory is required.";
+    for (auto& writeOnlyOramFactory : writeOnlyOramFactories) {
+      _writeOnlyOrams.push_back(writeOnlyOramFactory->create(oramSize));
+    }
+    // All ORAMs of all concurrent games hold their batches in memory at the
+    // same time.
+    _oramMaxBatchSize = writeOnlyOramFactories.at(0)->getMaxBatchSize(
+        oramSize, concurrency * _writeOnlyOrams.size());
+    XLOGF(
+        INFO,
+        "Number of ORAMs = {}, ORAM maxBatchSize = {}",
+        _writeOnlyOrams.size(),
+        _oramMaxBatchSize);
   }
 
   virtual void aggregateAttributions(
-      const PrivateAggregation<schedulerId>& privateAggregation) override {
+      const PrivateAggregation<schedulerId, usingBatch, adIdBits>&
+          privateAggregation) override {
     XLOG(INFO, "Computing measurement aggregation based on attributions...");
     const auto& privateTpmArrays = privateAggregation.privateTpm;
     const auto& privateCvmArrays = privateAggregation.privateCvm;
@@ -87,23 +134,37 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
         privateTpmArrays.size(),
         privateCvmArrays.size());
 
-    CHECK_EQ(privateAttributionArrays.size(), privateTpmArrays.size())
-        << "Size of attribution results and touchpoint metadata should be equal.";
-    CHECK_EQ(privateCvmArrays.size(), privateTpmArrays.size())
-        << "Size of conversion metadata and touchpoint metadata should be equal.";
+    PrivateMeasurementAggregationResultArrays touchpointConversionResults;
+    if constexpr (usingBatch) {
+      CHECK_EQ(
+          privateAttributionArrays.size(),
+          privateTpmArrays.size() * privateCvmArrays.size())
+          << "Size of attribution results should be the product of the number of touchpoints and conversions.";
 
-    std::vector<std::vector<typename MeasurementAggregation<
-        schedulerId>::PrivateMeasurementAggregationResult>>
-        touchpointConversionResults;
-    for (size_t i = 0; i < privateCvmArrays.size(); ++i) {
       // Retrieve the touchpoint-conversion metadata pairs based on
-      // attribution results.
-      auto touchpointConversionResultsPerId =
-          retrieveTouchpointForConversionPerID(
-              privateTpmArrays.at(i),
-              privateCvmArrays.at(i),
-              privateAttributionArrays.at(i));
-      touchpointConversionResults.push_back(touchpointConversionResultsPerId);
+      // attribution results, for all ids at once.
+      touchpointConversionResults = retrieveTouchpointForConversionPerID(
+          privateTpmArrays,
+          privateCvmArrays,
+          privateAttributionArrays,
+          privateAggregation.batchSize);
+    } else {
+      CHECK_EQ(privateAttributionArrays.size(), privateTpmArrays.size())
+          << "Size of attribution results and touchpoint metadata should be equal.";
+      CHECK_EQ(privateCvmArrays.size(), privateTpmArrays.size())
+          << "Size of conversion metadata and touchpoint metadata should be equal.";
+
+      for (size_t i = 0; i < privateCvmArrays.size(); ++i) {
+        // Retrieve the touchpoint-conversion metadata pairs based on
+        // attribution results.
+        auto touchpointConversionResultsPerId =
+            retrieveTouchpointForConversionPerID(
+                privateTpmArrays.at(i),
+                privateCvmArrays.at(i),
+                privateAttributionArrays.at(i));
+        touchpointConversionResults.push_back(
+            touchpointConversionResultsPerId);
+      }
     }
 
     XLOG(INFO, "Retrieved touchpoint-conversion metadata");
@@ -112,27 +173,53 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
     aggregateUsingOram(touchpointConversionResults);
   }
 
-  const std::vector<typename MeasurementAggregation<
-      schedulerId>::PrivateMeasurementAggregationResult>
+  /**
+   * Retrieve the attributed touchpoint of each conversion. Attribution results
+   * are ordered by conversion, then by touchpoint. With batching, every
+   * element holds a batch of batchSize ids.
+   **/
+  const std::vector<PrivateMeasurementAggregationResult>
   retrieveTouchpointForConversionPerID(
-      const std::vector<PrivateMeasurementTouchpointMetadata<schedulerId>>&
-          privateTpmArray,
-      const std::vector<PrivateMeasurementConversionMetadata<schedulerId>>&
+      const std::vector<PrivateMeasurementTouchpointMetadata<
+          schedulerId,
+          usingBatch,
+          adIdBits>>& privateTpmArray,
+      const std::vector<
+          PrivateMeasurementConversionMetadata<schedulerId, usingBatch>>&
           privateCvmArray,
-      const std::vector<PrivateAttributionResult<schedulerId>>&
-          attributionResults) {
-    std::vector<typename MeasurementAggregation<
-        schedulerId>::PrivateMeasurementAggregationResult>
-        aggregationResults;
-    int numOfResults = privateTpmArray.size() - 1;
+      const std::vector<PrivateAttributionResult<schedulerId, usingBatch>>&
+          attributionResults,
+      size_t batchSize = 0) {
+    std::vector<PrivateMeasurementAggregationResult> aggregationResults;
+    CHECK_EQ(
+        attributionResults.size(),
+        privateTpmArray.size() * privateCvmArray.size())
+        << "Size of attribution results should be the product of the number of touchpoints and conversions.";
+    int numTouchpoints = privateTpmArray.size();
+    int numConversions = privateCvmArray.size();
     int atIndex = attributionResults.size() - 1;
 
-    for (auto convIndex = numOfResults; convIndex >= 0; convIndex--) {
-      SecBit<schedulerId> hasAttributedTouchpoint(false, common::PUBLISHER);
-      uint8_t defaultAdId = 0;
-      SecAdId<schedulerId> attributedAdId(defaultAdId, common::PUBLISHER);
+    for (auto convIndex = numConversions - 1; convIndex >= 0; convIndex--) {
+      SecBit<schedulerId, usingBatch> hasAttributedTouchpoint;
+      SecAdId<schedulerId, usingBatch, adIdBits> attributedAdId;
+      if constexpr (usingBatch) {
+        if (batchSize == 0) {
+          throw std::invalid_argument(
+              "Must provide positive batch size for batch execution!");
+        }
+        hasAttributedTouchpoint = SecBit<schedulerId, usingBatch>(
+            std::vector<bool>(batchSize, false), common::PUBLISHER);
+        attributedAdId = SecAdId<schedulerId, usingBatch, adIdBits>(
+            std::vector<uint64_t>(batchSize, 0), common::PUBLISHER);
+      } else {
+        hasAttributedTouchpoint =
+            SecBit<schedulerId, usingBatch>(false, common::PUBLISHER);
+        uint8_t defaultAdId = 0;
+        attributedAdId = SecAdId<schedulerId, usingBatch, adIdBits>(
+            defaultAdId, common::PUBLISHER);
+      }
 
-      for (auto tpIndex = numOfResults; tpIndex >= 0; tpIndex--) {
+      for (auto tpIndex = numTouchpoints - 1; tpIndex >= 0; tpIndex--) {
         auto isAttributed = !hasAttributedTouchpoint &
             attributionResults.at(atIndex).isAttributed;
 
@@ -144,12 +231,14 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
         atIndex--;
       }
 
-      typename MeasurementAggregation<
-          schedulerId>::PrivateMeasurementAggregationResult aggregationResult{
+      PrivateMeasurementAggregationResult aggregationResult{
           /* hasAttributedTouchpoint */ hasAttributedTouchpoint,
           /* conv */ privateCvmArray.at(convIndex),
           /* tp */
-          PrivateMeasurementTouchpointMetadata<schedulerId>{attributedAdId}};
+          PrivateMeasurementTouchpointMetadata<
+              schedulerId,
+              usingBatch,
+              adIdBits>{attributedAdId}};
 
       aggregationResults.push_back(aggregationResult);
     }
@@ -157,22 +246,87 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
   }
 
   void aggregateUsingOram(
-      const std::vector<std::vector<typename MeasurementAggregation<
-          schedulerId>::PrivateMeasurementAggregationResult>>&
+      const PrivateMeasurementAggregationResultArrays&
           touchpointConversionResults) {
+    if constexpr (usingBatch) {
+      // Extract the shares of all ids at once, then split them into ORAM
+      // batches by id.
+      auto [indexShares, valueShares] =
+          extractOramInputShares(touchpointConversionResults);
+      size_t numIds = indexShares.empty() || indexShares.at(0).empty()
+          ? 0
+          : indexShares.at(0).at(0).size();
+      addToOrams(numIds, [&](size_t startIndex, size_t endIndex) {
+        return sliceOramInput(indexShares, valueShares, startIndex, endIndex);
+      });
+    } else {
+      addToOrams(
+          touchpointConversionResults.size(),
+          [&](size_t startIndex, size_t endIndex) {
+            return generateOramInput(
+                touchpointConversionResults, startIndex, endIndex);
+          });
+    }
+  }
+
+  /**
+   * Split numIds ids into ORAM batches and add them to the ORAMs. The inputs
+   * of up to one batch per ORAM are generated on this thread, since that uses
+   * this game's scheduler. The batches are then added to their ORAMs in
+   * parallel, each ORAM running on its own thread and scheduler.
+   **/
+  template <typename OramInputGenerator>
+  void addToOrams(size_t numIds, OramInputGenerator generateInput) {
+    if (_strategy == AggregationStrategy::ObliviousSort) {
+      // Without an ORAM, keep the inputs until they are sorted on reveal.
+      if (numIds > 0) {
+        auto [indexShares, valueShares] = generateInput(0, numIds);
+        appendShares(_sortIndexShares, indexShares);
+        appendShares(_sortValueShares, valueShares);
+      }
+      return;
+    }
+
+    // Spread the ids evenly across ORAMs, so that every ORAM gets work even
+    // when all ids fit in a single batch.
+    size_t numOrams = _writeOnlyOrams.size();
+    size_t batchSize = std::min(
+        static_cast<size_t>(_oramMaxBatchSize),
+        (numIds + numOrams - 1) / numOrams);
+
     size_t startIndex = 0;
-    while (startIndex < touchpointConversionResults.size()) {
-      size_t endIndex = std::min(
-          startIndex + _oramMaxBatchSize, touchpointConversionResults.size());
-      XLOGF(
-          INFO,
-          "ORAM batch startIndex = {}, endIndex = {}",
-          startIndex,
-          endIndex);
-      auto oramInput =
-          generateOramInput(touchpointConversionResults, startIndex, endIndex);
-      _writeOnlyOram->obliviousAddBatch(oramInput.first, oramInput.second);
-      startIndex = endIndex;
+    while (startIndex < numIds) {
+      std::vector<std::pair<
+          std::vector<std::vector<bool>>,
+          std::vector<std::vector<bool>>>>
+          oramInputs;
+      while (startIndex < numIds && oramInputs.size() < numOrams) {
+        size_t endIndex = std::min(startIndex + batchSize, numIds);
+        XLOGF(
+            INFO,
+            "ORAM batch startIndex = {}, endIndex = {}",
+            startIndex,
+            endIndex);
+        oramInputs.push_back(generateInput(startIndex, endIndex));
+        startIndex = endIndex;
+      }
+
+      if (oramInputs.size() == 1) {
+        _writeOnlyOrams.at(0)->obliviousAddBatch(
+            oramInputs.at(0).first, oramInputs.at(0).second);
+      } else {
+        std::vector<std::future<void>> futures;
+        for (size_t i = 0; i < oramInputs.size(); ++i) {
+          futures.push_back(
+              std::async(std::launch::async, [this, &oramInputs, i]() {
+                _writeOnlyOrams.at(i)->obliviousAddBatch(
+                    oramInputs.at(i).first, oramInputs.at(i).second);
+              }));
+        }
+        for (auto& future : futures) {
+          future.get();
+        }
+      }
     }
   }
 
@@ -183,8 +337,7 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
   const std::
       pair<std::vector<std::vector<bool>>, std::vector<std::vector<bool>>>
       generateOramInput(
-          const std::vector<std::vector<typename MeasurementAggregation<
-              schedulerId>::PrivateMeasurementAggregationResult>>&
+          const PrivateMeasurementAggregationResultArrays&
               touchpointConversionResults,
           const size_t startIndex,
           const size_t endIndex) {
@@ -230,60 +383,265 @@ class MeasurementAggregator : public Aggregator<schedulerId> {
     return std::make_pair(std::move(indexShares), std::move(valueShares));
   }
 
+  /**
+   * Extract the ORAM index and value shares of batched
+   * touchpointConversionResults. Shares are extracted once per conversion for
+   * the whole batch, and are indexed by [conversion][bit][id].
+   **/
+  const std::pair<
+      std::vector<std::vector<std::vector<bool>>>,
+      std::vector<std::vector<std::vector<bool>>>>
+  extractOramInputShares(const PrivateMeasurementAggregationResultArrays&
+                             touchpointConversionResults) {
+    std::vector<std::vector<std::vector<bool>>> indexShares;
+    std::vector<std::vector<std::vector<bool>>> valueShares;
+
+    for (const auto& touchpointConversionResult :
+         touchpointConversionResults) {
+      const auto& touchpoint =
+          touchpointConversionResult.measurementTouchpointMetadata;
+      const auto& conversion =
+          touchpointConversionResult.measurementConversionMetadata;
+      // Retrieve adId shares
+      auto indexShare = touchpoint.adId.extractIntShare().getBooleanShares();
+      indexShares.push_back(std::vector<std::vector<bool>>(
+          indexShare.begin(), indexShare.begin() + _oramWidth));
+      size_t batchSize = indexShare.at(0).size();
+
+      // Retrieve conversion value share if attributed, or zero if not
+      // attributed
+      const PubSalesValue<schedulerId, usingBatch> one(
+          std::vector<uint64_t>(batchSize, 1));
+      const PubConvValue<schedulerId, usingBatch> zero(
+          std::vector<uint64_t>(batchSize, 0));
+      auto salesValue =
+          zero.mux(touchpointConversionResult.hasAttributedTouchpoint, one);
+      auto convValue = zero.mux(
+          touchpointConversionResult.hasAttributedTouchpoint,
+          conversion.convValue);
+      auto valueShare = salesValue.extractIntShare().getBooleanShares();
+      auto convValueShare = convValue.extractIntShare().getBooleanShares();
+      valueShare.insert(
+          valueShare.end(),
+          std::make_move_iterator(convValueShare.begin()),
+          std::make_move_iterator(convValueShare.end()));
+      valueShares.push_back(std::move(valueShare));
+    }
+    return std::make_pair(std::move(indexShares), std::move(valueShares));
+  }
+
+  /**
+   * Generate input to ORAM from extracted batched shares, for ids between
+   * startIndex and endIndex.
+   **/
+  const std::
+      pair<std::vector<std::vector<bool>>, std::vector<std::vector<bool>>>
+      sliceOramInput(
+          const std::vector<std::vector<std::vector<bool>>>& indexShares,
+          const std::vector<std::vector<std::vector<bool>>>& valueShares,
+          const size_t startIndex,
+          const size_t endIndex) {
+    std::vector<std::vector<bool>> oramIndexShares(
+        _oramWidth, std::vector<bool>{});
+    std::vector<std::vector<bool>> oramValueShares(
+        salesValueWidth + convValueWidth, std::vector<bool>{});
+
+    for (size_t index = startIndex; index < endIndex; ++index) {
+      for (size_t conv = 0; conv < indexShares.size(); ++conv) {
+        for (size_t i = 0; i < _oramWidth; ++i) {
+          oramIndexShares.at(i).push_back(indexShares.at(conv).at(i).at(index));
+        }
+        for (size_t i = 0; i < salesValueWidth + convValueWidth; ++i) {
+          oramValueShares.at(i).push_back(valueShares.at(conv).at(i).at(index));
+        }
+      }
+    }
+    return std::make_pair(
+        std::move(oramIndexShares), std::move(oramValueShares));
+  }
+
   virtual AggregationOutput reveal() const override {
+    if (_validOriginalAdIds.empty()) {
+      return MeasurementAggregation<schedulerId>{}.toDynamic();
+    }
+    if (_strategy == AggregationStrategy::ObliviousSort) {
+      return revealUsingObliviousSort();
+    }
+
+    size_t numAdIds = _validOriginalAdIds.size();
+    // Read the additive shares of every ad id, summed over all ORAMs. Reading
+    // a share is local, so all ad ids are then converted to secret shares in a
+    // single batched circuit, by inputting the additive shares into MPC and
+    // adding them.
+    std::vector<uint64_t> conversionCountShares(numAdIds, 0);
+    std::vector<uint64_t> conversionValueShares(numAdIds, 0);
+    for (const auto& writeOnlyOram : _writeOnlyOrams) {
+      for (size_t i = 0; i < numAdIds; ++i) {
+        // ORAM index 0 is reserved for touchpoints that are not attributed
+        auto additiveAggregationValue = writeOnlyOram->secretRead(i + 1);
+        conversionCountShares.at(i) = static_cast<uint32_t>(
+            conversionCountShares.at(i) +
+            additiveAggregationValue.conversionCount);
+        conversionValueShares.at(i) = static_cast<uint32_t>(
+            conversionValueShares.at(i) +
+            additiveAggregationValue.conversionValue);
+      }
+    }
+
+    auto publisherConvs = SecConvValue<schedulerId, true>(
+        conversionCountShares, common::PUBLISHER);
+    auto partnerConvs =
+        SecConvValue<schedulerId, true>(conversionCountShares, common::PARTNER);
+
+    auto publisherSales = SecSalesValue<schedulerId, true>(
+        conversionValueShares, common::PUBLISHER);
+    auto partnerSales = SecSalesValue<schedulerId, true>(
+        conversionValueShares, common::PARTNER);
+
+    return revealMetrics(
+        publisherConvs + partnerConvs, publisherSales + partnerSales);
+  }
+
+ private:
+  /**
+   * Aggregate without an ORAM: obliviously sort the buffered inputs together
+   * with one empty record per ad id, sum every ad id's segment into its empty
+   * record, and sort these records to the front.
+   **/
+  AggregationOutput revealUsingObliviousSort() const {
+    // Sort keys hold the ad id above a flag marking the empty record of each
+    // ad id, which sorts after the inputs of the same ad id. Padding records
+    // use an ad id past all valid ones.
+    constexpr size_t sortKeyWidth = adIdBits + 2;
+    const uint64_t paddingAdId = 1ULL << adIdBits;
+
+    size_t numAdIds = _validOriginalAdIds.size();
+    size_t numInputs =
+        _sortIndexShares.empty() ? 0 : _sortIndexShares.at(0).size();
+    size_t numRecords = 1;
+    while (numRecords < numInputs + numAdIds) {
+      numRecords <<= 1;
+    }
+
+    // Public records are shared by letting the publisher hold the whole value.
+    bool isPublisher = (_myRole == common::PUBLISHER);
+    std::vector<uint64_t> keyShares(numRecords, 0);
+    std::vector<std::vector<uint64_t>> valueShares(
+        2, std::vector<uint64_t>(numRecords, 0));
+    for (size_t i = 0; i < numInputs; ++i) {
+      for (size_t bit = 0; bit < _oramWidth; ++bit) {
+        keyShares.at(i) |= uint64_t(_sortIndexShares.at(bit).at(i))
+            << (bit + 1);
+      }
+      for (size_t bit = 0; bit < salesValueWidth; ++bit) {
+        valueShares.at(0).at(i) |= uint64_t(_sortValueShares.at(bit).at(i))
+            << bit;
+      }
+      for (size_t bit = 0; bit < convValueWidth; ++bit) {
+        valueShares.at(1).at(i) |=
+            uint64_t(_sortValueShares.at(salesValueWidth + bit).at(i)) << bit;
+      }
+    }
+    for (size_t i = numInputs; i < numRecords; ++i) {
+      // ORAM index 0 is reserved for touchpoints that are not attributed
+      uint64_t adId =
+          (i < numInputs + numAdIds) ? i - numInputs + 1 : paddingAdId;
+      keyShares.at(i) = isPublisher ? (adId << 1) | 1 : 0;
+    }
+
+    oblivious_sort::sortByKey<schedulerId, sortKeyWidth, convValueWidth>(
+        keyShares, valueShares);
+
+    std::vector<uint64_t> adIdShares;
+    adIdShares.reserve(numRecords);
+    for (auto keyShare : keyShares) {
+      adIdShares.push_back(keyShare >> 1);
+    }
+    oblivious_sort::segmentedSums<schedulerId, adIdBits + 1, convValueWidth>(
+        adIdShares, valueShares);
+
+    // The empty record of every ad id now holds its sums. Move these records
+    // to the front, ordered by ad id.
+    for (size_t i = 0; i < numRecords; ++i) {
+      uint64_t isInputShare = (keyShares.at(i) & 1) ^ (isPublisher ? 1 : 0);
+      keyShares.at(i) = (isInputShare << (adIdBits + 1)) | adIdShares.at(i);
+    }
+    oblivious_sort::sortByKey<schedulerId, sortKeyWidth, convValueWidth>(
+        keyShares, valueShares);
+
+    for (auto& shares : valueShares) {
+      shares.resize(numAdIds);
+    }
+    typename SecConvValue<schedulerId, true>::ExtractedInt extractedConvs(
+        valueShares.at(0));
+    typename SecSalesValue<schedulerId, true>::ExtractedInt extractedSales(
+        valueShares.at(1));
+    return revealMetrics(
+        SecConvValue<schedulerId, true>(std::move(extractedConvs)),
+        SecSalesValue<schedulerId, true>(std::move(extractedSales)));
+  }
+
+  /**
+   * Reveal the metrics of all ad ids, ordered like _validOriginalAdIds, to the
+   * publisher, or as XOR shares to both parties.
+   **/
+  AggregationOutput revealMetrics(
+      const SecConvValue<schedulerId, true>& convs,
+      const SecSalesValue<schedulerId, true>& sales) const {
     MeasurementAggregation<schedulerId> out;
-    for (size_t i = 1; i < _validOriginalAdIds.size() + 1; ++i) {
-      const auto rAdId = _validOriginalAdIds.at(i - 1);
+    std::vector<uint64_t> convsValues;
+    std::vector<uint64_t> salesValues;
+    if (Aggregator<schedulerId, usingBatch, adIdBits>::outputVisibility_ ==
+        common::Visibility::Publisher) {
+      convsValues = convs.openToParty(common::PUBLISHER).getValue();
+      salesValues = sales.openToParty(common::PUBLISHER).getValue();
+    } else {
+      convsValues = convs.extractIntShare().getValue();
+      salesValues = sales.extractIntShare().getValue();
+    }
+
+    for (size_t i = 0; i < _validOriginalAdIds.size(); ++i) {
+      const auto rAdId = _validOriginalAdIds.at(i);
       XLOGF(DBG, "Revealing measurement metrics for adId={}", rAdId);
-      fbpcf::mpc_std_lib::util::AggregationValue aggregationValue;
-      if (Aggregator<schedulerId>::outputVisibility_ ==
-          common::Visibility::Publisher) {
-        aggregationValue = _writeOnlyOram->publicRead(
-            i,
-            fbpcf::mpc_std_lib::oram::IWriteOnlyOram<
-                fbpcf::mpc_std_lib::util::AggregationValue>::Alice);
-        out.metrics[rAdId] = ConvMetrics{
-            aggregationValue.conversionCount, aggregationValue.conversionValue};
-      } else {
-        auto additiveAggregationValue = _writeOnlyOram->secretRead(i);
-
-        // Convert additive shares to secret shares by inputting them into MPC
-        // and adding them, then extracting the secret shares.
-        auto publisherConvs = SecConvValue<schedulerId>(
-            additiveAggregationValue.conversionCount, common::PUBLISHER);
-        auto partnerConvs = SecConvValue<schedulerId>(
-            additiveAggregationValue.conversionCount, common::PARTNER);
-        auto convs = publisherConvs + partnerConvs;
-        auto extractedConvs = convs.extractIntShare().getValue();
-
-        auto publisherSales = SecSalesValue<schedulerId>(
-            additiveAggregationValue.conversionValue, common::PUBLISHER);
-        auto partnerSales = SecSalesValue<schedulerId>(
-            additiveAggregationValue.conversionValue, common::PARTNER);
-        auto sales = publisherSales + partnerSales;
-        auto extractedSales = sales.extractIntShare().getValue();
-
-        out.metrics[rAdId] = ConvMetrics{
-            static_cast<uint32_t>(extractedConvs),
-            static_cast<uint32_t>(extractedSales)};
-      }
+      out.metrics[rAdId] = ConvMetrics{
+          static_cast<uint32_t>(convsValues.at(i)),
+          static_cast<uint32_t>(salesValues.at(i))};
     }
     return out.toDynamic();
   }
 
- private:
+  static void appendShares(
+      std::vector<std::vector<bool>>& shares,
+      const std::vector<std::vector<bool>>& newShares) {
+    for (size_t i = 0; i < shares.size(); ++i) {
+      shares.at(i).insert(
+          shares.at(i).end(), newShares.at(i).begin(), newShares.at(i).end());
+    }
+  }
+
   std::vector<uint64_t> _validOriginalAdIds;
-  std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOram<
-      fbpcf::mpc_std_lib::util::AggregationValue>>
-      _writeOnlyOram;
+  int _myRole;
+  AggregationStrategy _strategy;
+  std::vector<std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOram<
+      fbpcf::mpc_std_lib::util::AggregationValue>>>
+      _writeOnlyOrams;
   uint32_t _oramMaxBatchSize;
   uint8_t _oramWidth;
+  // Inputs buffered for oblivious sort, indexed by [bit][input]
+  std::vector<std::vector<bool>> _sortIndexShares;
+  std::vector<std::vector<bool>> _sortValueShares;
 };
 } // namespace
 
-template <int schedulerId>
-static const std::vector<AggregationFormat<schedulerId>>
-    SUPPORTED_AGGREGATION_FORMATS{AggregationFormat<schedulerId>{
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
+static const std::vector<AggregationFormat<schedulerId, usingBatch, adIdBits>>
+    SUPPORTED_AGGREGATION_FORMATS{AggregationFormat<
+        schedulerId,
+        usingBatch,
+        adIdBits>{
         /* id */ 1,
         /* name */ common::MEASUREMENT,
         /* newAggregator */
@@ -291,22 +649,25 @@ static const std::vector<AggregationFormat<schedulerId>>
            common::Visibility outputVisibility,
            int myRole,
            int concurrency,
-           std::unique_ptr<fbpcf::mpc_std_lib::oram::IWriteOnlyOramFactory<
-               fbpcf::mpc_std_lib::util::AggregationValue>>
-               writeOnlyOramFactory)
-            -> std::unique_ptr<Aggregator<schedulerId>> {
-          return std::make_unique<MeasurementAggregator<schedulerId>>(
+           WriteOnlyOramFactories writeOnlyOramFactories)
+            -> std::unique_ptr<Aggregator<schedulerId, usingBatch, adIdBits>> {
+          return std::make_unique<
+              MeasurementAggregator<schedulerId, usingBatch, adIdBits>>(
               ctx.validOriginalAdIds,
+              ctx.strategy.value_or(
+                  getAggregationStrategy(ctx.validOriginalAdIds.size())),
               outputVisibility,
               myRole,
               concurrency,
-              std::move(writeOnlyOramFactory));
+              std::move(writeOnlyOramFactories));
         }}};
 
-template <int schedulerId>
-const AggregationFormat<schedulerId>
-AggregationFormat<schedulerId>::fromNameOrThrow(const std::string& name) {
-  for (auto rule : SUPPORTED_AGGREGATION_FORMATS<schedulerId>) {
+template <int schedulerId, bool usingBatch, size_t adIdBits>
+const AggregationFormat<schedulerId, usingBatch, adIdBits>
+AggregationFormat<schedulerId, usingBatch, adIdBits>::fromNameOrThrow(
+    const std::string& name) {
+  for (auto rule :
+       SUPPORTED_AGGREGATION_FORMATS<schedulerId, usingBatch, adIdBits>) {
     if (rule.name == name) {
       return rule;
     }
@@ -315,10 +676,12 @@ AggregationFormat<schedulerId>::fromNameOrThrow(const std::string& name) {
   throw std::runtime_error("Unknown aggregation format name: " + name);
 }
 
-template <int schedulerId>
-const AggregationFormat<schedulerId>
-AggregationFormat<schedulerId>::fromIdOrThrow(int64_t id) {
-  for (auto rule : SUPPORTED_AGGREGATION_FORMATS<schedulerId>) {
+template <int schedulerId, bool usingBatch, size_t adIdBits>
+const AggregationFormat<schedulerId, usingBatch, adIdBits>
+AggregationFormat<schedulerId, usingBatch, adIdBits>::fromIdOrThrow(
+    int64_t id) {
+  for (auto rule :
+       SUPPORTED_AGGREGATION_FORMATS<schedulerId, usingBatch, adIdBits>) {
     if (rule.id == id) {
       return rule;
     }
@@ -21,7 +21,7 @@ struct AttributionResult {
   }
 };
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false>
 struct PrivateAttributionResult {
   explicit PrivateAttributionResult(
       const AttributionResult& attributionResult) {
@@ -30,7 +30,22 @@ struct PrivateAttributionResult {
     this->isAttributed = SecBit<schedulerId>(std::move(extractedAttribution));
   }
 
-  SecBit<schedulerId> isAttributed;
+  // Used for batch execution, where attributionResults holds the result at
+  // the same position for every id.
+  explicit PrivateAttributionResult(
+      const std::vector<AttributionResult>& attributionResults) {
+    std::vector<bool> attributions;
+    attributions.reserve(attributionResults.size());
+    for (const auto& attributionResult : attributionResults) {
+      attributions.push_back(attributionResult.isAttributed);
+    }
+    typename SecBit<schedulerId, usingBatch>::ExtractedBit
+        extractedAttributions(attributions);
+    this->isAttributed =
+        SecBit<schedulerId, usingBatch>(std::move(extractedAttributions));
+  }
+
+  SecBit<schedulerId, usingBatch> isAttributed;
 };
 
 } // namespace pcf2_aggregation
@@ -17,45 +17,67 @@ enum AGGREGATION_FORMAT { AD_OBJECT_FORMAT = 1 };
 
 const int kMaxConcurrency = 16;
 
+// Maximum number of write-only ORAMs that one aggregation game adds batches to
+// in parallel. Every ORAM runs on its own scheduler, whose schedulerId is
+// offset by 2 * kMaxConcurrency from the previous one, so that it does not
+// collide with the schedulers of other games running in the same process.
+const int kMaxOramConcurrency = 4;
+
 // We are compressing the original Ad Id (64 bit integer), by mapping it to
-// an integer in the range 1 - num_of_ad_ids. Assumption here is that the
-// number of ad_ids will be less than 65,536 per run.
+// an integer in the range 1 - num_of_ad_ids. The width of the compressed ad id
+// is chosen at runtime from the number of ad ids, among adIdWidth,
+// mediumAdIdWidth and maxAdIdWidth.
 const size_t adIdWidth = 16;
+const size_t mediumAdIdWidth = 24;
+const size_t maxAdIdWidth = 32;
+
+// Ad counts up to kMaxLinearOramAdIds are aggregated with a linear ORAM, and up
+// to kMaxWriteOnlyOramAdIds with a write-only ORAM. Above that, the per-access
+// cost of the ORAM grows too large, and aggregation falls back to obliviously
+// sorting the conversions by ad id and summing each segment.
+const size_t kMaxLinearOramAdIds = 3;
+const size_t kMaxWriteOnlyOramAdIds = 65535;
 const size_t originalAdIdWidth = 64;
 const size_t convValueWidth = 32;
 const size_t salesValueWidth = 32;
 
-template <int schedulerId>
-using PubBit = typename pcf_frontend::MpcGame<schedulerId>::template PubBit<>;
-template <int schedulerId>
-using SecBit = typename pcf_frontend::MpcGame<schedulerId>::template SecBit<>;
+template <int schedulerId, bool usingBatch = false>
+using PubBit =
+    typename pcf_frontend::MpcGame<schedulerId>::template PubBit<usingBatch>;
+template <int schedulerId, bool usingBatch = false>
+using SecBit =
+    typename pcf_frontend::MpcGame<schedulerId>::template SecBit<usingBatch>;
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false, size_t width = adIdWidth>
 using PubAdId = typename pcf_frontend::MpcGame<
-    schedulerId>::template PubUnsignedInt<adIdWidth>;
-template <int schedulerId>
+    schedulerId>::template PubUnsignedInt<width, usingBatch>;
+template <int schedulerId, bool usingBatch = false, size_t width = adIdWidth>
 using SecAdId = typename pcf_frontend::MpcGame<
-    schedulerId>::template SecUnsignedInt<adIdWidth>;
+    schedulerId>::template SecUnsignedInt<width, usingBatch>;
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false>
 using PubOriginalAdId = typename pcf_frontend::MpcGame<
-    schedulerId>::template PubUnsignedInt<originalAdIdWidth>;
-template <int schedulerId>
+    schedulerId>::template PubUnsignedInt<originalAdIdWidth, usingBatch>;
+template <int schedulerId, bool usingBatch = false>
 using SecOriginalAdId = typename pcf_frontend::MpcGame<
-    schedulerId>::template SecUnsignedInt<originalAdIdWidth>;
+    schedulerId>::template SecUnsignedInt<originalAdIdWidth, usingBatch>;
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false>
 using PubConvValue = typename pcf_frontend::MpcGame<
-    schedulerId>::template PubUnsignedInt<convValueWidth>;
-template <int schedulerId>
+    schedulerId>::template PubUnsignedInt<convValueWidth, usingBatch>;
+template <int schedulerId, bool usingBatch = false>
 using SecConvValue = typename pcf_frontend::MpcGame<
-    schedulerId>::template SecUnsignedInt<convValueWidth>;
+    schedulerId>::template SecUnsignedInt<convValueWidth, usingBatch>;
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false>
 using PubSalesValue = typename pcf_frontend::MpcGame<
-    schedulerId>::template PubUnsignedInt<salesValueWidth>;
-template <int schedulerId>
+    schedulerId>::template PubUnsignedInt<salesValueWidth, usingBatch>;
+template <int schedulerId, bool usingBatch = false>
 using SecSalesValue = typename pcf_frontend::MpcGame<
-    schedulerId>::template SecUnsignedInt<salesValueWidth>;
+    schedulerId>::template SecUnsignedInt<salesValueWidth, usingBatch>;
+
+template <typename T, bool useVector>
+using ConditionalVector =
+    typename std::conditional<useVector, std::vector<T>, T>::type;
 
 } // namespace pcf2_aggregation
@@ -23,7 +23,7 @@ struct ConversionMetadata {
   }
 };
 
-template <int schedulerId>
+template <int schedulerId, bool usingBatch = false>
 struct PrivateMeasurementConversionMetadata {
   explicit PrivateMeasurementConversionMetadata(
       const ConversionMetadata& conversion) {
@@ -37,7 +37,29 @@ struct PrivateMeasurementConversionMetadata {
     }
   }
 
-  SecConvValue<schedulerId> convValue;
+  // Used for batch execution, where conversions holds the conversion at the
+  // same position for every id.
+  explicit PrivateMeasurementConversionMetadata(
+      const std::vector<ConversionMetadata>& conversions) {
+    std::vector<uint64_t> convValues;
+    convValues.reserve(conversions.size());
+    for (const auto& conversion : conversions) {
+      convValues.push_back(conversion.convValue);
+    }
+    if (conversions.empty() ||
+        conversions.at(0).inputEncryption ==
+            common::InputEncryption::Plaintext) {
+      convValue = SecConvValue<schedulerId, usingBatch>(
+          convValues, common::PARTNER);
+    } else {
+      typename SecConvValue<schedulerId, usingBatch>::ExtractedInt
+          extractedConvValues(convValues);
+      convValue = SecConvValue<schedulerId, usingBatch>(
+          std::move(extractedConvValues));
+    }
+  }
+
+  SecConvValue<schedulerId, usingBatch> convValue;
 };
 
 } // namespace pcf2_aggregation
@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <future>
 #include <memory>
 
@@ -43,13 +44,14 @@ inline std::vector<std::string> getIOInputFilenames(
   return inputFilePaths;
 }
 
-template <int PARTY, int index>
+template <int PARTY, int index, bool usingBatch>
 inline common::SchedulerStatistics startAggregationAppsForShardedFilesHelper(
     common::InputEncryption inputEncryption,
     common::Visibility outputVisibility,
     int startFileIndex,
     int remainingThreads,
     int numThreads,
+    int oramConcurrency,
     std::string serverIp,
     int port,
     std::string aggregationFormats,
@@ -80,8 +82,10 @@ inline common::SchedulerStatistics startAggregationAppsForShardedFilesHelper(
 
     // Each AggregationApp runs numFiles sequentially on a single thread
     // Publisher uses even schedulerId and partner uses odd schedulerId
-    auto app = std::make_unique<
-        pcf2_aggregation::AggregationApp<PARTY, 2 * index + PARTY>>(
+    auto app = std::make_unique<pcf2_aggregation::AggregationApp<
+        PARTY,
+        2 * index + PARTY,
+        usingBatch>>(
         inputEncryption,
         outputVisibility,
         std::move(communicationAgentFactory),
@@ -91,7 +95,8 @@ inline common::SchedulerStatistics startAggregationAppsForShardedFilesHelper(
         outputFilenames,
         startFileIndex,
         numFiles,
-        numThreads);
+        numThreads,
+        oramConcurrency);
 
     auto future = std::async([&app]() {
       app->run();
@@ -101,12 +106,16 @@ inline common::SchedulerStatistics startAggregationAppsForShardedFilesHelper(
     if constexpr (index < kMaxConcurrency) {
       if (remainingThreads > 1) {
         auto remainingStats =
-            startAggregationAppsForShardedFilesHelper<PARTY, index + 1>(
+            startAggregationAppsForShardedFilesHelper<
+                PARTY,
+                index + 1,
+                usingBatch>(
                 inputEncryption,
                 outputVisibility,
                 startFileIndex + numFiles,
                 remainingThreads - 1,
                 numThreads,
+                oramConcurrency,
                 serverIp,
                 port,
                 aggregationFormats,
@@ -122,7 +131,7 @@ inline common::SchedulerStatistics startAggregationAppsForShardedFilesHelper(
   return schedulerStatistics;
 }
 
-template <int PARTY>
+template <int PARTY, bool usingBatch>
 inline common::SchedulerStatistics startAggregationAppsForShardedFiles(
     common::InputEncryption inputEncryption,
     common::Visibility outputVisibility,
@@ -136,13 +145,17 @@ inline common::SchedulerStatistics startAggregationAppsForShardedFiles(
   // use only as many threads as the number of files
   auto numThreads =
       std::min((int)inputSecretShareFilenames.size(), (int)concurrency);
+  // spend the threads left over by the apps on parallel ORAM batches
+  auto oramConcurrency =
+      std::max(1, (int)concurrency / std::max(1, numThreads));
 
-  return startAggregationAppsForShardedFilesHelper<PARTY, 0>(
+  return startAggregationAppsForShardedFilesHelper<PARTY, 0, usingBatch>(
       inputEncryption,
       outputVisibility,
       0,
       numThreads,
       numThreads,
+      oramConcurrency,
       serverIp,
       port,
       aggregationFormats,
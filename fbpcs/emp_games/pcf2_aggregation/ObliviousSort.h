@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "folly/logging/xlog.h"
+
+#include "fbpcf/frontend/mpcGame.h"
+
+namespace pcf2_aggregation {
+
+/**
+ * Helpers to aggregate values by key without an ORAM. Records are given as
+ * XOR shares of their key and of their values, with values indexed by
+ * [value][record]. Each step works on a whole batch of records, and only
+ * rearranges extracted shares locally between steps.
+ */
+namespace oblivious_sort {
+
+template <int schedulerId, size_t width>
+using SecBatchUnsignedInt = typename fbpcf::frontend::MpcGame<
+    schedulerId>::template SecUnsignedInt<width, true>;
+
+template <int schedulerId, size_t width>
+using PubBatchUnsignedInt = typename fbpcf::frontend::MpcGame<
+    schedulerId>::template PubUnsignedInt<width, true>;
+
+/**
+ * Build a batch from the shares at the given indices.
+ */
+template <typename SecInt>
+SecInt gatherShares(
+    const std::vector<uint64_t>& shares,
+    const std::vector<size_t>& indices) {
+  std::vector<uint64_t> gatheredShares;
+  gatheredShares.reserve(indices.size());
+  for (auto index : indices) {
+    gatheredShares.push_back(shares.at(index));
+  }
+  typename SecInt::ExtractedInt extractedInt(gatheredShares);
+  return SecInt(std::move(extractedInt));
+}
+
+/**
+ * Write the shares of a batch back to the given indices.
+ */
+template <typename SecInt>
+void scatterShares(
+    const SecInt& value,
+    std::vector<uint64_t>& shares,
+    const std::vector<size_t>& indices) {
+  auto extractedShares = value.extractIntShare().getValue();
+  for (size_t i = 0; i < indices.size(); ++i) {
+    shares.at(indices.at(i)) = extractedShares.at(i);
+  }
+}
+
+/**
+ * Obliviously sort records by key, in ascending order, with a bitonic sorting
+ * network. All compare-and-swaps of a layer of the network run in one batch.
+ * The number of records must be a power of two.
+ */
+template <int schedulerId, size_t keyWidth, size_t valueWidth>
+void sortByKey(
+    std::vector<uint64_t>& keyShares,
+    std::vector<std::vector<uint64_t>>& valueShares) {
+  using SecKey = SecBatchUnsignedInt<schedulerId, keyWidth>;
+  using SecValue = SecBatchUnsignedInt<schedulerId, valueWidth>;
+
+  size_t size = keyShares.size();
+  CHECK_EQ(size & (size - 1), 0)
+      << "Number of records to sort must be a power of two.";
+  for (const auto& shares : valueShares) {
+    CHECK_EQ(shares.size(), size)
+        << "Every value must have one share per record.";
+  }
+
+  std::vector<size_t> lowIndices;
+  std::vector<size_t> highIndices;
+  for (size_t blockSize = 2; blockSize <= size; blockSize <<= 1) {
+    for (size_t distance = blockSize >> 1; distance > 0; distance >>= 1) {
+      lowIndices.clear();
+      highIndices.clear();
+      for (size_t i = 0; i < size; ++i) {
+        size_t j = i ^ distance;
+        if (j > i) {
+          // Blocks alternate between ascending and descending order, so that
+          // every two neighbouring blocks form a bitonic sequence.
+          bool ascending = (i & blockSize) == 0;
+          lowIndices.push_back(ascending ? i : j);
+          highIndices.push_back(ascending ? j : i);
+        }
+      }
+
+      auto lowKeys = gatherShares<SecKey>(keyShares, lowIndices);
+      auto highKeys = gatherShares<SecKey>(keyShares, highIndices);
+      auto swap = highKeys < lowKeys;
+      scatterShares(lowKeys.mux(swap, highKeys), keyShares, lowIndices);
+      scatterShares(highKeys.mux(swap, lowKeys), keyShares, highIndices);
+
+      for (auto& shares : valueShares) {
+        auto lowValues = gatherShares<SecValue>(shares, lowIndices);
+        auto highValues = gatherShares<SecValue>(shares, highIndices);
+        scatterShares(lowValues.mux(swap, highValues), shares, lowIndices);
+        scatterShares(highValues.mux(swap, lowValues), shares, highIndices);
+      }
+    }
+  }
+}
+
+/**
+ * Compute the running sums of the values within every run of consecutive
+ * records that have the same segment key. Afterwards, the last record of every
+ * run holds the sum of the run. Runs in log2(size) batched rounds.
+ */
+template <int schedulerId, size_t segmentWidth, size_t valueWidth>
+void segmentedSums(
+    const std::vector<uint64_t>& segmentShares,
+    std::vector<std::vector<uint64_t>>& valueShares) {
+  using SecSegment = SecBatchUnsignedInt<schedulerId, segmentWidth>;
+  using SecValue = SecBatchUnsignedInt<schedulerId, valueWidth>;
+  using PubValue = PubBatchUnsignedInt<schedulerId, valueWidth>;
+
+  size_t size = segmentShares.size();
+  std::vector<size_t> currentIndices;
+  std::vector<size_t> previousIndices;
+  for (size_t distance = 1; distance < size; distance <<= 1) {
+    currentIndices.clear();
+    previousIndices.clear();
+    for (size_t i = distance; i < size; ++i) {
+      currentIndices.push_back(i);
+      previousIndices.push_back(i - distance);
+    }
+
+    // Records are grouped by segment, so the two records are in the same run
+    // exactly when they have the same segment key.
+    auto currentSegments =
+        gatherShares<SecSegment>(segmentShares, currentIndices);
+    auto previousSegments =
+        gatherShares<SecSegment>(segmentShares, previousIndices);
+    auto sameSegment = currentSegments == previousSegments;
+    const PubValue zero(std::vector<uint64_t>(currentIndices.size(), 0));
+
+    for (auto& shares : valueShares) {
+      auto currentValues = gatherShares<SecValue>(shares, currentIndices);
+      auto previousValues = gatherShares<SecValue>(shares, previousIndices);
+      scatterShares(
+          currentValues + zero.mux(sameSegment, previousValues),
+          shares,
+          currentIndices);
+    }
+  }
+}
+
+} // namespace oblivious_sort
+
+} // namespace pcf2_aggregation
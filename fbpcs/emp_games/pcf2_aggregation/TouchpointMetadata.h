@@ -17,7 +17,7 @@ struct TouchpointMetadata {
   uint64_t ts;
   bool isClick;
   uint64_t campaignMetadata;
-  uint16_t adId;
+  uint32_t adId;
 
   /**
    * If both are clicks, or both are views, the earliest one comes first.
@@ -28,17 +28,33 @@ struct TouchpointMetadata {
   }
 };
 
-template <int schedulerId>
+template <
+    int schedulerId,
+    bool usingBatch = false,
+    size_t adIdBits = adIdWidth>
 struct PrivateMeasurementTouchpointMetadata {
   explicit PrivateMeasurementTouchpointMetadata(
       const TouchpointMetadata& touchpoint)
       : adId(touchpoint.adId, common::PUBLISHER) {}
 
+  // Used for batch execution, where touchpoints holds the touchpoint at the
+  // same position for every id.
   explicit PrivateMeasurementTouchpointMetadata(
-      const SecAdId<schedulerId>& secAdId)
+      const std::vector<TouchpointMetadata>& touchpoints) {
+    std::vector<uint64_t> adIds;
+    adIds.reserve(touchpoints.size());
+    for (const auto& touchpoint : touchpoints) {
+      adIds.push_back(touchpoint.adId);
+    }
+    adId =
+        SecAdId<schedulerId, usingBatch, adIdBits>(adIds, common::PUBLISHER);
+  }
+
+  explicit PrivateMeasurementTouchpointMetadata(
+      const SecAdId<schedulerId, usingBatch, adIdBits>& secAdId)
       : adId(secAdId) {}
 
-  SecAdId<schedulerId> adId;
+  SecAdId<schedulerId, usingBatch, adIdBits> adId;
 };
 
 } // namespace pcf2_aggregation
@@ -9,11 +9,15 @@
 
 #include "folly/Format.h"
 #include "folly/init/Init.h"
+#include "folly/json.h"
 #include "folly/logging/xlog.h"
 
 #include <fbpcf/aws/AwsSdk.h>
+#include <fbpcf/io/FileManagerUtil.h>
 #include <fbpcs/performance_tools/CostEstimation.h>
 
+#include "fbpcs/emp_games/common/PhaseTracker.h"
+
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationApp.h"
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationOptions.h"
 #include "fbpcs/emp_games/pcf2_aggregation/Constants.h"
@@ -27,6 +31,8 @@ int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   fbpcf::AwsSdk::aquire();
+  cost.startResourceSampling(
+      std::chrono::milliseconds{FLAGS_resource_sampling_interval_ms});
 
   FLAGS_party--; // subtract 1 because we use 0 and 1 for publisher and partner
                  // instead of 1 and 2
@@ -41,6 +47,10 @@ int main(int argc, char* argv[]) {
 
   common::SchedulerStatistics schedulerStatistics;
 
+  // use batched aggregation by default
+  const bool usingBatch = true;
+
+  cost.markPhase("run_game");
   try {
     XLOG(INFO) << "Start private aggregation...";
 
@@ -85,7 +95,8 @@ int main(int argc, char* argv[]) {
 
       schedulerStatistics =
           pcf2_aggregation::startAggregationAppsForShardedFiles<
-              common::PUBLISHER>(
+              common::PUBLISHER,
+              usingBatch>(
               inputEncryption,
               outputVisibility,
               inputSecretShareFilePaths,
@@ -100,7 +111,8 @@ int main(int argc, char* argv[]) {
           << "Starting private aggregation as Partner, will wait for Publisher...";
       schedulerStatistics =
           pcf2_aggregation::startAggregationAppsForShardedFiles<
-              common::PARTNER>(
+              common::PARTNER,
+              usingBatch>(
               inputEncryption,
               outputVisibility,
               inputSecretShareFilePaths,
@@ -122,6 +134,7 @@ int main(int argc, char* argv[]) {
     std::exit(1);
   }
 
+  cost.markPhase("finish");
   cost.end();
   XLOG(INFO, cost.getEstimatedCostString());
 
@@ -137,6 +150,14 @@ int main(int argc, char* argv[]) {
       schedulerStatistics.sentNetwork,
       schedulerStatistics.receivedNetwork);
 
+  if (!FLAGS_phase_profile_path.empty()) {
+    XLOGF(INFO, "Writing phase profile to {}", FLAGS_phase_profile_path);
+    fbpcf::io::write(
+        FLAGS_phase_profile_path,
+        folly::toPrettyJson(
+            common::getPhaseProfile(schedulerStatistics.phases)));
+  }
+
   if (FLAGS_log_cost) {
     auto run_name = (FLAGS_run_name != "") ? FLAGS_run_name : "temp_run_name";
     std::string party =
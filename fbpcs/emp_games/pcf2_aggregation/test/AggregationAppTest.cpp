@@ -27,6 +27,7 @@ namespace pcf2_aggregation {
 template <
     int PARTY,
     int schedulerId,
+    bool usingBatch,
     common::Visibility outputVisibility,
     common::InputEncryption inputEncryption>
 static void runGame(
@@ -48,7 +49,7 @@ static void runGame(
       fbpcf::engine::communication::SocketPartyCommunicationAgentFactory>(
       PARTY, partyInfos, useTls, tlsDir);
 
-  AggregationApp<PARTY, schedulerId>(
+  AggregationApp<PARTY, schedulerId, usingBatch>(
       inputEncryption,
       outputVisibility,
       std::move(communicationAgentFactory),
@@ -62,6 +63,7 @@ static void runGame(
 // helper function for executing MPC game and verifying corresponding output
 template <
     int id,
+    bool usingBatch,
     common::Visibility outputVisibility,
     common::InputEncryption inputEncryption>
 inline void testCorrectnessAggregationAppHelper(
@@ -82,7 +84,12 @@ inline void testCorrectnessAggregationAppHelper(
     bool useTls,
     std::string& tlsDir) {
   auto futureAlice = std::async(
-      runGame<common::PUBLISHER, 2 * id, outputVisibility, inputEncryption>,
+      runGame<
+          common::PUBLISHER,
+          2 * id,
+          usingBatch,
+          outputVisibility,
+          inputEncryption>,
       serverIpAlice,
       portAlice + 100 * id,
       aggregationFormat,
@@ -92,7 +99,12 @@ inline void testCorrectnessAggregationAppHelper(
       useTls,
       tlsDir);
   auto futureBob = std::async(
-      runGame<common::PARTNER, 2 * id + 1, outputVisibility, inputEncryption>,
+      runGame<
+          common::PARTNER,
+          2 * id + 1,
+          usingBatch,
+          outputVisibility,
+          inputEncryption>,
       serverIpBob,
       portBob + 100 * id,
       "",
@@ -123,6 +135,7 @@ inline void testCorrectnessAggregationAppHelper(
     if (remainingFiles > 1) {
       testCorrectnessAggregationAppHelper<
           id + 1,
+          usingBatch,
           outputVisibility,
           inputEncryption>(
           remainingFiles - 1,
@@ -145,8 +158,12 @@ inline void testCorrectnessAggregationAppHelper(
   }
 }
 
-class AggregationAppTest : public ::testing::TestWithParam<
-                               std::tuple<int, common::Visibility, bool>> {
+class AggregationAppTest
+    : public ::testing::TestWithParam<std::tuple<
+          int,
+          common::Visibility,
+          bool,
+          bool>> { // id, visibility, usingBatch, useTls
  protected:
   void SetUp() override {
     tlsDir_ = fbpcf::engine::communication::setUpTlsFiles();
@@ -197,10 +214,11 @@ class AggregationAppTest : public ::testing::TestWithParam<
     fbpcf::engine::communication::deleteTlsFiles(tlsDir_);
   }
 
-  template <int id, common::Visibility visibility>
+  template <int id, bool usingBatch, common::Visibility visibility>
   void testCorrectnessAggregationAppWrapper(bool useTls) {
     testCorrectnessAggregationAppHelper<
         id,
+        usingBatch,
         visibility,
         common::InputEncryption::Plaintext>(
         attributionRules_.size(),
@@ -239,19 +257,36 @@ class AggregationAppTest : public ::testing::TestWithParam<
 };
 
 TEST_P(AggregationAppTest, TestCorrectness) {
-  auto [id, visibility, useTls] = GetParam();
+  auto [id, visibility, usingBatch, useTls] = GetParam();
 
   switch (id) {
     case 0:
       switch (visibility) {
         case common::Visibility::Publisher:
-          testCorrectnessAggregationAppWrapper<
-              0,
-              common::Visibility::Publisher>(useTls);
+          if (usingBatch) {
+            testCorrectnessAggregationAppWrapper<
+                0,
+                true,
+                common::Visibility::Publisher>(useTls);
+          } else {
+            testCorrectnessAggregationAppWrapper<
+                0,
+                false,
+                common::Visibility::Publisher>(useTls);
+          }
           break;
         case common::Visibility::Xor:
-          testCorrectnessAggregationAppWrapper<0, common::Visibility::Xor>(
-              useTls);
+          if (usingBatch) {
+            testCorrectnessAggregationAppWrapper<
+                0,
+                true,
+                common::Visibility::Xor>(useTls);
+          } else {
+            testCorrectnessAggregationAppWrapper<
+                0,
+                false,
+                common::Visibility::Xor>(useTls);
+          }
           break;
       }
       break;
@@ -269,15 +304,17 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(
             common::Visibility::Publisher,
             common::Visibility::Xor),
+        ::testing::Bool(),
         ::testing::Bool()),
 
     [](const testing::TestParamInfo<AggregationAppTest::ParamType>& info) {
       auto id = std::to_string(std::get<0>(info.param));
       auto visibility = common::getVisibilityString(std::get<1>(info.param));
-      auto tls = std::get<2>(info.param) ? "True" : "False";
+      auto batch = std::get<2>(info.param) ? "True" : "False";
+      auto tls = std::get<3>(info.param) ? "True" : "False";
 
-      std::string name =
-          "ID_" + id + "_Visibility_" + visibility + "_TLS_" + tls;
+      std::string name = "ID_" + id + "_Visibility_" + visibility + "_Batch_" +
+          batch + "_TLS_" + tls;
       return name;
     });
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <future>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+#include "folly/Benchmark.h"
+#include "folly/init/Init.h"
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/pcf2_aggregation/AggregationGame.h"
+
+namespace pcf2_aggregation {
+
+const bool unsafe = true;
+const size_t kNumIds = 10000;
+
+// Every id has one touchpoint, on ad id (id % numAdIds) + 1, which is
+// attributed to its only conversion.
+template <int schedulerId, size_t adIdBits>
+void runMeasurementAggregation(
+    int myRole,
+    size_t numAdIds,
+    std::shared_ptr<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  AggregationGame<schedulerId, true> game(
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>(
+          myRole, *factory),
+      factory,
+      common::InputEncryption::Plaintext);
+
+  std::vector<uint64_t> validOriginalAdIds(numAdIds);
+  std::iota(validOriginalAdIds.begin(), validOriginalAdIds.end(), 1);
+
+  std::vector<std::vector<TouchpointMetadata>> touchpointMetadata;
+  std::vector<std::vector<ConversionMetadata>> conversionMetadata;
+  std::vector<std::vector<AttributionResult>> attributionResults;
+  for (size_t i = 0; i < kNumIds; ++i) {
+    uint32_t adId = i % numAdIds + 1;
+    touchpointMetadata.push_back(
+        {TouchpointMetadata{adId, 0, false, 0, adId}});
+    conversionMetadata.push_back(
+        {ConversionMetadata{0, 100, 0, common::InputEncryption::Plaintext}});
+    // attribution results are XOR shared
+    attributionResults.push_back(
+        {AttributionResult{myRole == common::PUBLISHER}});
+  }
+
+  PrivateAggregation<schedulerId, true, adIdBits> privateAggregation{
+      game.privatelyShareAttributionResults(attributionResults),
+      game.template privatelyShareMeasurementTouchpointMetadata<adIdBits>(
+          touchpointMetadata),
+      game.privatelyShareMeasurementConversionMetadata(conversionMetadata),
+      kNumIds};
+
+  MeasurementAggregator<schedulerId, true, adIdBits> aggregator(
+      validOriginalAdIds,
+      getAggregationStrategy(numAdIds),
+      common::Visibility::Publisher,
+      myRole,
+      1,
+      game.createWriteOnlyOramFactories(myRole, numAdIds));
+  aggregator.aggregateAttributions(privateAggregation);
+  folly::doNotOptimizeAway(aggregator.reveal());
+}
+
+template <size_t adIdBits>
+void benchmarkMeasurementAggregation(size_t numAdIds) {
+  auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      runMeasurementAggregation<common::PUBLISHER, adIdBits>,
+      common::PUBLISHER,
+      numAdIds,
+      std::move(factories[common::PUBLISHER]));
+  auto future1 = std::async(
+      runMeasurementAggregation<common::PARTNER, adIdBits>,
+      common::PARTNER,
+      numAdIds,
+      std::move(factories[common::PARTNER]));
+  future0.get();
+  future1.get();
+}
+
+// linear ORAM
+BENCHMARK(MeasurementAggregation_3Ads) {
+  benchmarkMeasurementAggregation<adIdWidth>(3);
+}
+
+// write-only ORAM
+BENCHMARK(MeasurementAggregation_1kAds) {
+  benchmarkMeasurementAggregation<adIdWidth>(1000);
+}
+
+BENCHMARK(MeasurementAggregation_64kAds) {
+  benchmarkMeasurementAggregation<adIdWidth>(64000);
+}
+
+// oblivious sort
+BENCHMARK(MeasurementAggregation_1MAds) {
+  benchmarkMeasurementAggregation<mediumAdIdWidth>(1000000);
+}
+
+} // namespace pcf2_aggregation
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv);
+  folly::runBenchmarks();
+  return 0;
+}
@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <string>
+#include <tuple>
+
+#include "fbpcf/engine/communication/InMemoryPartyCommunicationAgentFactory.h"
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/scheduler/LazySchedulerFactory.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcs/emp_games/common/TestUtil.h"
+
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
+#include "fbpcs/emp_games/common/test/CostBudget.h"
+#include "fbpcs/emp_games/pcf2_aggregation/AggregationGame.h"
+
+namespace pcf2_aggregation {
+
+const bool unsafe = true;
+
+/*
+ * Runs one party of the batched game on the insecure engine, which evaluates
+ * the same circuit as the secure one, and returns what its schedulers counted.
+ */
+template <int schedulerId>
+common::SchedulerStatistics measureAggregationCost(
+    int myId,
+    AggregationInputMetrics inputData,
+    std::shared_ptr<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  auto scheduler =
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>(
+          myId, *factory);
+  auto game = std::make_unique<AggregationGame<schedulerId, true>>(
+      std::move(scheduler),
+      std::move(factory),
+      common::InputEncryption::Plaintext,
+      1,
+      1,
+      nullptr,
+      std::nullopt,
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>);
+  game->computeAggregations(myId, inputData, common::Visibility::Publisher);
+  return game->getSchedulerStatistics();
+}
+
+// There are no 28d inputs. Aggregation does not depend on the rule, so the 28d
+// rules run on the output of the matching 1d rule.
+inline std::string inputRuleFor(const std::string& attributionRule) {
+  if (attributionRule == common::LAST_CLICK_28D) {
+    return common::LAST_CLICK_1D;
+  }
+  if (attributionRule == common::LAST_TOUCH_28D) {
+    return common::LAST_TOUCH_1D;
+  }
+  return attributionRule;
+}
+
+class AggregationCostTestFixture
+    : public ::testing::TestWithParam<std::tuple<std::string, std::string>> {
+};
+
+// Disabled until cost_budgets.json is seeded: build once, run this suite with
+// --gtest_also_run_disabled_tests and UPDATE_COST_BUDGETS=1, check in the
+// budgets and drop the DISABLED_ prefix
+TEST_P(AggregationCostTestFixture, DISABLED_TestCostWithinBudget) {
+  auto [attributionRule, aggregationFormat] = GetParam();
+  std::string baseDir_ =
+      private_measurement::test_util::getBaseDirFromPath(__FILE__);
+  auto inputRule = inputRuleFor(attributionRule);
+  std::string filePrefix = baseDir_ + "test_correctness/" + inputRule + ".";
+  std::string clearTextFilePrefix = baseDir_ +
+      "../../pcf2_attribution/test/test_correctness/" + inputRule + ".";
+
+  AggregationInputMetrics publisherInputData{
+      common::PUBLISHER,
+      common::InputEncryption::Plaintext,
+      filePrefix + "publisher.json",
+      clearTextFilePrefix + "publisher.csv",
+      aggregationFormat};
+  AggregationInputMetrics partnerInputData{
+      common::PARTNER,
+      common::InputEncryption::Plaintext,
+      filePrefix + "partner.json",
+      clearTextFilePrefix + "partner.csv",
+      ""};
+
+  auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+
+  auto future0 = std::async(
+      measureAggregationCost<0>,
+      0,
+      publisherInputData,
+      std::move(factories[0]));
+
+  auto future1 = std::async(
+      measureAggregationCost<1>,
+      1,
+      partnerInputData,
+      std::move(factories[1]));
+
+  auto publisherCost = future0.get();
+  future1.get();
+
+  // both parties evaluate the same circuit, so one of them is enough
+  common::expectWithinCostBudget(
+      baseDir_ + "cost_budgets.json",
+      attributionRule + "." + aggregationFormat,
+      publisherCost);
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AggregationCostTest,
+    AggregationCostTestFixture,
+    ::testing::Combine(
+        ::testing::Values(
+            common::LAST_CLICK_1D,
+            common::LAST_TOUCH_1D,
+            common::LAST_CLICK_28D,
+            common::LAST_TOUCH_28D,
+            common::LAST_CLICK_2_7D,
+            common::LAST_TOUCH_2_7D),
+        ::testing::Values(common::MEASUREMENT)),
+    [](const testing::TestParamInfo<AggregationCostTestFixture::ParamType>&
+           info) {
+      return std::get<0>(info.param) + "_" + std::get<1>(info.param);
+    });
+
+} // namespace pcf2_aggregation
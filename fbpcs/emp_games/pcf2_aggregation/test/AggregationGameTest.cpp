@@ -7,7 +7,9 @@
 
 #include <gtest/gtest.h>
 #include <memory>
+#include <optional>
 #include <set>
+#include <utility>
 
 #include "folly/test/JsonTestUtil.h"
 
@@ -19,6 +21,7 @@
 #include "fbpcs/emp_games/common/TestUtil.h"
 
 #include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/common/SchedulerStatistics.h"
 #include "fbpcs/emp_games/common/test/TestUtils.h"
 #include "fbpcs/emp_games/pcf2_aggregation/AggregationGame.h"
 #include "fbpcs/emp_games/pcf2_aggregation/test/AggregationTestUtils.h"
@@ -30,7 +33,7 @@ const bool unsafe = true;
 TEST(AggregationGameTest, TestShareAggregationFormats) {
   std::vector<std::string> aggregationFormatNames = {common::MEASUREMENT};
 
-  AggregationGame<common::PUBLISHER> game(
+  AggregationGame<common::PUBLISHER, false> game(
       std::make_unique<fbpcf::scheduler::PlaintextScheduler>(
           fbpcf::scheduler::WireKeeper::createWithVectorArena<unsafe>()),
       std::move(fbpcf::engine::communication::getInMemoryAgentFactory(1)[0]),
@@ -50,7 +53,7 @@ TEST(AggregationGameTest, TestPrivateMeasurementTouchpointMetadataPlaintext) {
           TouchpointMetadata{255, 5000, true, 20, 255},
           TouchpointMetadata{100, 20000, false, 0, 100}}};
 
-  AggregationGame<common::PUBLISHER> game(
+  AggregationGame<common::PUBLISHER, false> game(
       std::make_unique<fbpcf::scheduler::PlaintextScheduler>(
           fbpcf::scheduler::WireKeeper::createWithVectorArena<unsafe>()),
       std::move(fbpcf::engine::communication::getInMemoryAgentFactory(1)[0]),
@@ -88,7 +91,7 @@ TEST(AggregationGameTest, TestPrivateMeasurementConversionPlaintext) {
           ConversionMetadata{100, 0, 0, inputEncryption},
           ConversionMetadata{0, 1000, 20, inputEncryption}}};
 
-  AggregationGame<common::PUBLISHER> game(
+  AggregationGame<common::PUBLISHER, false> game(
       std::make_unique<fbpcf::scheduler::PlaintextScheduler>(
           fbpcf::scheduler::WireKeeper::createWithVectorArena<unsafe>()),
       std::move(fbpcf::engine::communication::getInMemoryAgentFactory(1)[0]),
@@ -117,6 +120,62 @@ TEST(AggregationGameTest, TestPrivateMeasurementConversionPlaintext) {
       1000);
 }
 
+TEST(AggregationGameTest, TestPrivateMeasurementMetadataPlaintextBatch) {
+  common::InputEncryption inputEncryption = common::InputEncryption::Plaintext;
+
+  // two ids, each with two touchpoints and two conversions
+  std::vector<std::vector<TouchpointMetadata>> touchpointMetadata{
+      std::vector<TouchpointMetadata>{
+          TouchpointMetadata{0, 8000, true, 0, 0},
+          TouchpointMetadata{255, 5000, true, 20, 255}},
+      std::vector<TouchpointMetadata>{
+          TouchpointMetadata{100, 20000, false, 0, 100},
+          TouchpointMetadata{7, 1000, true, 5, 7}}};
+  std::vector<std::vector<ConversionMetadata>> conversionMetadata{
+      std::vector<ConversionMetadata>{
+          ConversionMetadata{10000, 5000, 0, inputEncryption},
+          ConversionMetadata{100, 0, 0, inputEncryption}},
+      std::vector<ConversionMetadata>{
+          ConversionMetadata{0, 1000, 20, inputEncryption},
+          ConversionMetadata{50, 30, 0, inputEncryption}}};
+
+  AggregationGame<common::PUBLISHER, true> game(
+      std::make_unique<fbpcf::scheduler::PlaintextScheduler>(
+          fbpcf::scheduler::WireKeeper::createWithVectorArena<unsafe>()),
+      std::move(fbpcf::engine::communication::getInMemoryAgentFactory(1)[0]),
+      inputEncryption);
+
+  auto privateTouchpointMetadata =
+      game.privatelyShareMeasurementTouchpointMetadata(touchpointMetadata);
+  auto privateConversionMetadata =
+      game.privatelyShareMeasurementConversionMetadata(conversionMetadata);
+
+  // one batched value per touchpoint/conversion index, batched over ids
+  ASSERT_EQ(privateTouchpointMetadata.size(), 2);
+  ASSERT_EQ(privateConversionMetadata.size(), 2);
+
+  EXPECT_EQ(
+      privateTouchpointMetadata.at(0)
+          .adId.openToParty(common::PARTNER)
+          .getValue(),
+      std::vector<uint64_t>({0, 100}));
+  EXPECT_EQ(
+      privateTouchpointMetadata.at(1)
+          .adId.openToParty(common::PARTNER)
+          .getValue(),
+      std::vector<uint64_t>({255, 7}));
+  EXPECT_EQ(
+      privateConversionMetadata.at(0)
+          .convValue.openToParty(common::PUBLISHER)
+          .getValue(),
+      std::vector<uint64_t>({5000, 1000}));
+  EXPECT_EQ(
+      privateConversionMetadata.at(1)
+          .convValue.openToParty(common::PUBLISHER)
+          .getValue(),
+      std::vector<uint64_t>({0, 30}));
+}
+
 // Helper method to share attribution results and open to one party with
 // scheduler
 template <int schedulerId>
@@ -128,7 +187,7 @@ std::vector<std::vector<bool>> shareAttributionResultsWithScheduler(
     fbpcf::SchedulerCreator schedulerCreator) {
   // share attribution results
   auto scheduler = schedulerCreator(myId, *factory);
-  auto game = std::make_unique<AggregationGame<schedulerId>>(
+  auto game = std::make_unique<AggregationGame<schedulerId, false>>(
       std::move(scheduler),
       std::move(factory),
       common::InputEncryption::Plaintext);
@@ -217,7 +276,7 @@ std::vector<uint64_t> retrieveValidAdIdsWithSchedulerAndRealEngine(
         fbpcf::engine::communication::IPartyCommunicationAgentFactory> factory,
     fbpcf::SchedulerCreator schedulerCreator) {
   auto scheduler = schedulerCreator(myId, *factory);
-  auto game = std::make_unique<AggregationGame<schedulerId>>(
+  auto game = std::make_unique<AggregationGame<schedulerId, false>>(
       std::move(scheduler),
       std::move(factory),
       common::InputEncryption::Plaintext);
@@ -289,7 +348,31 @@ TEST(AggregationGameTest, TestRetrieveValidAdIdsLazyScheduler) {
       fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>);
 }
 
-template <int schedulerId>
+TEST(AggregationGameTest, TestReplaceAdIdWithCompressedAdId) {
+  std::vector<std::vector<TouchpointMetadata>> touchpointMetadata{
+      std::vector<TouchpointMetadata>{
+          TouchpointMetadata{0, 8000, true, 100, 0},
+          TouchpointMetadata{300, 5000, false, 20, 0}},
+      std::vector<TouchpointMetadata>{
+          TouchpointMetadata{7, 10000, true, 10, 0},
+          TouchpointMetadata{300, 20000, true, 50, 0}}};
+  std::vector<uint64_t> validOriginalAdIds{7, 300};
+
+  AggregationGame<common::PUBLISHER, false> game(
+      std::make_unique<fbpcf::scheduler::PlaintextScheduler>(
+          fbpcf::scheduler::WireKeeper::createWithVectorArena<unsafe>()),
+      std::move(fbpcf::engine::communication::getInMemoryAgentFactory(1)[0]),
+      common::InputEncryption::Plaintext);
+
+  game.replaceAdIdWithCompressedAdId(touchpointMetadata, validOriginalAdIds);
+
+  EXPECT_EQ(touchpointMetadata.at(0).at(0).adId, 0);
+  EXPECT_EQ(touchpointMetadata.at(0).at(1).adId, 2);
+  EXPECT_EQ(touchpointMetadata.at(1).at(0).adId, 1);
+  EXPECT_EQ(touchpointMetadata.at(1).at(1).adId, 2);
+}
+
+template <int schedulerId, bool usingBatch>
 AggregationOutputMetrics computeAggregationsWithScheduler(
     int myId,
     AggregationInputMetrics inputData,
@@ -297,18 +380,30 @@ AggregationOutputMetrics computeAggregationsWithScheduler(
     common::Visibility outputVisibility,
     std::shared_ptr<
         fbpcf::engine::communication::IPartyCommunicationAgentFactory> factory,
-    fbpcf::SchedulerCreator schedulerCreator) {
+    fbpcf::SchedulerCreator schedulerCreator,
+    int oramConcurrency,
+    std::optional<AggregationStrategy> strategy) {
   auto scheduler = schedulerCreator(myId, *factory);
-  auto game = std::make_unique<AggregationGame<schedulerId>>(
-      std::move(scheduler), std::move(factory), inputEncryption);
+  auto game = std::make_unique<AggregationGame<schedulerId, usingBatch>>(
+      std::move(scheduler),
+      std::move(factory),
+      inputEncryption,
+      1,
+      oramConcurrency,
+      nullptr,
+      strategy,
+      schedulerCreator);
   return game->computeAggregations(myId, inputData, outputVisibility);
 }
 
 // Test cases are from https://fb.quip.com/IUHDApxKEAli
+template <bool usingBatch>
 void testCorrectnessWithScheduler(
     common::InputEncryption inputEncryption,
     common::Visibility outputVisibility,
-    fbpcf::SchedulerCreator schedulerCreator) {
+    fbpcf::SchedulerCreator schedulerCreator,
+    int oramConcurrency = 1,
+    std::optional<AggregationStrategy> strategy = std::nullopt) {
   std::string baseDir_ =
       private_measurement::test_util::getBaseDirFromPath(__FILE__);
   // Attribution rules to test
@@ -358,22 +453,26 @@ void testCorrectnessWithScheduler(
       auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
 
       auto future0 = std::async(
-          computeAggregationsWithScheduler<0>,
+          computeAggregationsWithScheduler<0, usingBatch>,
           0,
           publisherInputData,
           inputEncryption,
           outputVisibility,
           std::move(factories[0]),
-          schedulerCreator);
+          schedulerCreator,
+          oramConcurrency,
+          strategy);
 
       auto future1 = std::async(
-          computeAggregationsWithScheduler<1>,
+          computeAggregationsWithScheduler<1, usingBatch>,
           1,
           partnerInputData,
           inputEncryption,
           outputVisibility,
           std::move(factories[1]),
-          schedulerCreator);
+          schedulerCreator,
+          oramConcurrency,
+          strategy);
 
       auto res0 = future0.get();
       auto res1 = future1.get();
@@ -394,15 +493,140 @@ void testCorrectnessWithScheduler(
 class AggregationGameTestFixture : public ::testing::TestWithParam<std::tuple<
                                        common::SchedulerType,
                                        common::Visibility,
-                                       common::InputEncryption>> {};
+                                       common::InputEncryption,
+                                       bool>> {};
 
 TEST_P(AggregationGameTestFixture, TestCorrectness) {
-  auto [schedulerType, visibility, inputEncryption] = GetParam();
+  auto [schedulerType, visibility, inputEncryption, usingBatch] = GetParam();
+
+  if (usingBatch) {
+    testCorrectnessWithScheduler<true>(
+        inputEncryption,
+        visibility,
+        fbpcf::getSchedulerCreator<unsafe>(schedulerType));
+  } else {
+    testCorrectnessWithScheduler<false>(
+        inputEncryption,
+        visibility,
+        fbpcf::getSchedulerCreator<unsafe>(schedulerType));
+  }
+}
 
-  testCorrectnessWithScheduler(
-      inputEncryption,
-      visibility,
-      fbpcf::getSchedulerCreator<unsafe>(schedulerType));
+TEST(AggregationGameTest, TestCorrectnessWithParallelOrams) {
+  for (auto visibility :
+       {common::Visibility::Publisher, common::Visibility::Xor}) {
+    testCorrectnessWithScheduler<false>(
+        common::InputEncryption::Plaintext,
+        visibility,
+        fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>,
+        2);
+    testCorrectnessWithScheduler<true>(
+        common::InputEncryption::Plaintext,
+        visibility,
+        fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>,
+        2);
+  }
+}
+
+// Returns the statistics of the game, and those of its own scheduler alone
+template <int schedulerId>
+std::pair<common::SchedulerStatistics, common::SchedulerStatistics>
+measureAggregationsWithParallelOrams(
+    int myId,
+    AggregationInputMetrics inputData,
+    std::shared_ptr<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  auto scheduler =
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>(
+          myId, *factory);
+  auto game = std::make_unique<AggregationGame<schedulerId, true>>(
+      std::move(scheduler),
+      std::move(factory),
+      common::InputEncryption::Plaintext,
+      1,
+      2,
+      nullptr,
+      std::nullopt,
+      fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>);
+  game->computeAggregations(myId, inputData, common::Visibility::Publisher);
+
+  auto gateStatistics =
+      fbpcf::scheduler::SchedulerKeeper<schedulerId>::getGateStatistics();
+  auto trafficStatistics =
+      fbpcf::scheduler::SchedulerKeeper<schedulerId>::getTrafficStatistics();
+  return {
+      game->getSchedulerStatistics(),
+      common::SchedulerStatistics{
+          gateStatistics.first,
+          gateStatistics.second,
+          trafficStatistics.first,
+          trafficStatistics.second}};
+}
+
+TEST(AggregationGameTest, TestSchedulerStatisticsIncludeParallelOrams) {
+  std::string baseDir_ =
+      private_measurement::test_util::getBaseDirFromPath(__FILE__);
+  std::string filePrefix =
+      baseDir_ + "test_correctness/" + common::LAST_CLICK_1D + ".";
+  std::string clearTextFilePrefix = baseDir_ +
+      "../../pcf2_attribution/test/test_correctness/" + common::LAST_CLICK_1D +
+      ".";
+  AggregationInputMetrics publisherInputData{
+      common::PUBLISHER,
+      common::InputEncryption::Plaintext,
+      filePrefix + "publisher.json",
+      clearTextFilePrefix + "publisher.csv",
+      common::MEASUREMENT};
+  AggregationInputMetrics partnerInputData{
+      common::PARTNER,
+      common::InputEncryption::Plaintext,
+      filePrefix + "partner.json",
+      clearTextFilePrefix + "partner.csv",
+      ""};
+
+  auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      measureAggregationsWithParallelOrams<0>,
+      0,
+      publisherInputData,
+      std::move(factories[0]));
+  auto future1 = std::async(
+      measureAggregationsWithParallelOrams<1>,
+      1,
+      partnerInputData,
+      std::move(factories[1]));
+  auto [total, ownScheduler] = future0.get();
+  future1.get();
+
+  // The second ORAM adds gates and traffic on a scheduler of its own
+  EXPECT_GT(total.nonFreeGates, ownScheduler.nonFreeGates);
+  EXPECT_GT(total.sentNetwork, ownScheduler.sentNetwork);
+}
+
+// The test ad ids only reach linear ORAM by default. Every strategy must give
+// the same output as it does.
+TEST(AggregationGameTest, TestCorrectnessWithEveryStrategy) {
+  for (auto strategy :
+       {AggregationStrategy::LinearOram,
+        AggregationStrategy::WriteOnlyOram,
+        AggregationStrategy::ObliviousSort}) {
+    for (auto visibility :
+         {common::Visibility::Publisher, common::Visibility::Xor}) {
+      testCorrectnessWithScheduler<false>(
+          common::InputEncryption::Plaintext,
+          visibility,
+          fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>,
+          1,
+          strategy);
+      testCorrectnessWithScheduler<true>(
+          common::InputEncryption::Plaintext,
+          visibility,
+          fbpcf::scheduler::createLazySchedulerWithInsecureEngine<unsafe>,
+          1,
+          strategy);
+    }
+  }
 }
 
 INSTANTIATE_TEST_SUITE_P(
@@ -419,15 +643,17 @@ INSTANTIATE_TEST_SUITE_P(
         ::testing::Values(
             common::InputEncryption::Plaintext,
             common::InputEncryption::PartnerXor,
-            common::InputEncryption::Xor)),
+            common::InputEncryption::Xor),
+        ::testing::Bool()),
     [](const testing::TestParamInfo<AggregationGameTestFixture::ParamType>&
            info) {
       auto schedulerType = std::get<0>(info.param);
       auto visibility = std::get<1>(info.param);
       auto inputEncryption = std::get<2>(info.param);
+      std::string batch = std::get<3>(info.param) ? "_Batch" : "";
 
       return getSchedulerName(schedulerType) +
           getInputEncryptionString(inputEncryption) + "_" +
-          getVisibilityString(visibility);
+          getVisibilityString(visibility) + batch;
     });
 } // namespace pcf2_aggregation
@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include <gtest/gtest.h>
+#include <future>
+#include <memory>
+#include <vector>
+
+#include "fbpcf/engine/communication/test/AgentFactoryCreationHelper.h"
+#include "fbpcf/scheduler/SchedulerHelper.h"
+
+#include "fbpcs/emp_games/common/Constants.h"
+#include "fbpcs/emp_games/pcf2_aggregation/Aggregator.h"
+#include "fbpcs/emp_games/pcf2_aggregation/ObliviousSort.h"
+
+namespace pcf2_aggregation {
+
+const bool unsafe = true;
+const size_t keyWidth = 8;
+const size_t valueWidth = 32;
+
+template <int schedulerId, size_t width>
+std::vector<uint64_t> openShares(const std::vector<uint64_t>& shares) {
+  typename oblivious_sort::SecBatchUnsignedInt<schedulerId, width>::ExtractedInt
+      extractedInt(shares);
+  return oblivious_sort::SecBatchUnsignedInt<schedulerId, width>(
+             std::move(extractedInt))
+      .openToParty(common::PUBLISHER)
+      .getValue();
+}
+
+// Publisher holds the records, and partner holds zero shares. Returns the
+// records opened to publisher, keys first.
+template <int schedulerId>
+std::vector<std::vector<uint64_t>> sortByKeyWithScheduler(
+    int myId,
+    std::vector<uint64_t> keys,
+    std::vector<uint64_t> values,
+    std::unique_ptr<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  fbpcf::scheduler::SchedulerKeeper<schedulerId>::setScheduler(
+      fbpcf::scheduler::createNetworkPlaintextScheduler<unsafe>(
+          myId, *factory));
+  if (myId != common::PUBLISHER) {
+    keys = std::vector<uint64_t>(keys.size(), 0);
+    values = std::vector<uint64_t>(values.size(), 0);
+  }
+
+  std::vector<std::vector<uint64_t>> valueShares{values};
+  oblivious_sort::sortByKey<schedulerId, keyWidth, valueWidth>(
+      keys, valueShares);
+  return {
+      openShares<schedulerId, keyWidth>(keys),
+      openShares<schedulerId, valueWidth>(valueShares.at(0))};
+}
+
+template <int schedulerId>
+std::vector<uint64_t> segmentedSumsWithScheduler(
+    int myId,
+    std::vector<uint64_t> segments,
+    std::vector<uint64_t> values,
+    std::unique_ptr<
+        fbpcf::engine::communication::IPartyCommunicationAgentFactory>
+        factory) {
+  fbpcf::scheduler::SchedulerKeeper<schedulerId>::setScheduler(
+      fbpcf::scheduler::createNetworkPlaintextScheduler<unsafe>(
+          myId, *factory));
+  if (myId != common::PUBLISHER) {
+    segments = std::vector<uint64_t>(segments.size(), 0);
+    values = std::vector<uint64_t>(values.size(), 0);
+  }
+
+  std::vector<std::vector<uint64_t>> valueShares{values};
+  oblivious_sort::segmentedSums<schedulerId, keyWidth, valueWidth>(
+      segments, valueShares);
+  return openShares<schedulerId, valueWidth>(valueShares.at(0));
+}
+
+TEST(ObliviousSortTest, TestSortByKey) {
+  std::vector<uint64_t> keys{5, 1, 7, 3, 4, 0, 6, 2};
+  std::vector<uint64_t> values{50, 10, 70, 30, 40, 0, 60, 20};
+
+  auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      sortByKeyWithScheduler<common::PUBLISHER>,
+      common::PUBLISHER,
+      keys,
+      values,
+      std::move(factories[common::PUBLISHER]));
+  auto future1 = std::async(
+      sortByKeyWithScheduler<common::PARTNER>,
+      common::PARTNER,
+      keys,
+      values,
+      std::move(factories[common::PARTNER]));
+  auto res = future0.get();
+  future1.get();
+
+  EXPECT_EQ(res.at(0), std::vector<uint64_t>({0, 1, 2, 3, 4, 5, 6, 7}));
+  EXPECT_EQ(
+      res.at(1), std::vector<uint64_t>({0, 10, 20, 30, 40, 50, 60, 70}));
+}
+
+TEST(ObliviousSortTest, TestSegmentedSums) {
+  std::vector<uint64_t> segments{1, 1, 2, 2, 2, 3, 4, 4};
+  std::vector<uint64_t> values{1, 2, 3, 4, 5, 6, 7, 8};
+
+  auto factories = fbpcf::engine::communication::getInMemoryAgentFactory(2);
+  auto future0 = std::async(
+      segmentedSumsWithScheduler<common::PUBLISHER>,
+      common::PUBLISHER,
+      segments,
+      values,
+      std::move(factories[common::PUBLISHER]));
+  auto future1 = std::async(
+      segmentedSumsWithScheduler<common::PARTNER>,
+      common::PARTNER,
+      segments,
+      values,
+      std::move(factories[common::PARTNER]));
+  auto res = future0.get();
+  future1.get();
+
+  EXPECT_EQ(res, std::vector<uint64_t>({1, 3, 3, 7, 12, 6, 7, 15}));
+}
+
+TEST(ObliviousSortTest, TestCompressedAdIdWidthAndStrategy) {
+  EXPECT_EQ(getCompressedAdIdWidth(1), adIdWidth);
+  EXPECT_EQ(getCompressedAdIdWidth(65535), adIdWidth);
+  EXPECT_EQ(getCompressedAdIdWidth(65536), mediumAdIdWidth);
+  EXPECT_EQ(getCompressedAdIdWidth(1 << 24), maxAdIdWidth);
+
+  EXPECT_EQ(getAggregationStrategy(3), AggregationStrategy::LinearOram);
+  EXPECT_EQ(getAggregationStrategy(1000), AggregationStrategy::WriteOnlyOram);
+  EXPECT_EQ(getAggregationStrategy(65535), AggregationStrategy::WriteOnlyOram);
+  EXPECT_EQ(getAggregationStrategy(65536), AggregationStrategy::ObliviousSort);
+}
+
+} // namespace pcf2_aggregation
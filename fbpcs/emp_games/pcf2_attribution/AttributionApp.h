@@ -7,10 +7,15 @@
 
 #pragma once
 
+#include <future>
+#include <memory>
+#include <optional>
+
 #include <fbpcf/io/FileManagerUtil.h>
 
 #include "fbpcf/engine/communication/IPartyCommunicationAgentFactory.h"
 #include "fbpcf/scheduler/SchedulerHelper.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
 #include "fbpcs/emp_games/common/SchedulerStatistics.h"
 #include "fbpcs/emp_games/pcf2_attribution/AttributionGame.h"
 
@@ -36,25 +41,61 @@ class AttributionApp {
         attributionRules_{attributionRules},
         inputFilenames_(inputFilenames),
         outputFilenames_(outputFilenames),
-        startFileIndex_(startFileIndex),
-        numFiles_(numFiles),
+        startFileIndex_(static_cast<size_t>(startFileIndex)),
+        numFiles_(static_cast<size_t>(numFiles)),
         schedulerStatistics_{0, 0, 0, 0} {}
 
   void run() {
     auto scheduler = fbpcf::scheduler::createLazySchedulerWithRealEngine(
         MY_ROLE, *communicationAgentFactory_);
 
+    std::unique_ptr<common::PhaseTracker> phaseTracker;
+    if (!FLAGS_phase_profile_path.empty()) {
+      phaseTracker = std::make_unique<common::PhaseTracker>(
+          getSchedulerCounters);
+    }
+
     AttributionGame<schedulerId, usingBatch, inputEncryption> game(
-        std::move(scheduler));
+        std::move(scheduler), phaseTracker.get());
 
     // Compute attributions sequentially on numFiles files, starting from
-    // startFileIndex
-    for (size_t i = startFileIndex_; i < startFileIndex_ + numFiles_; ++i) {
-      CHECK_LT(i, inputFilenames_.size())
-          << "File index exceeds number of files.";
-      auto inputData = getInputData(inputFilenames_.at(i));
+    // startFileIndex. The game itself has to run on this thread, but file I/O
+    // does not: the next input file is read and parsed in the background while
+    // the current one is being computed, and each output is written in the
+    // background while the next file is being computed. At most one prefetched
+    // input and one pending output are held in memory at any time.
+    size_t endFileIndex = startFileIndex_ + numFiles_;
+    std::future<AttributionInputMetrics<usingBatch, inputEncryption>>
+        nextInputData;
+    std::future<void> pendingOutput;
+    if (startFileIndex_ < endFileIndex) {
+      nextInputData = prefetchInputData(startFileIndex_);
+    }
+    for (size_t i = startFileIndex_; i < endFileIndex; ++i) {
+      std::optional<common::ScopedPhase> phase;
+      phase.emplace(phaseTracker.get(), "wait_for_input");
+      auto inputData = nextInputData.get();
+      phase.reset();
+      if (i + 1 < endFileIndex) {
+        nextInputData = prefetchInputData(i + 1);
+      }
+
       auto output = game.computeAttributions(MY_ROLE, inputData);
-      putOutputData(output, outputFilenames_.at(i));
+
+      // wait for the previous write before issuing the next one
+      phase.emplace(phaseTracker.get(), "wait_for_output");
+      if (pendingOutput.valid()) {
+        pendingOutput.get();
+      }
+      phase.reset();
+      pendingOutput = std::async(
+          std::launch::async, [this, i, output = std::move(output)]() {
+            putOutputData(output, outputFilenames_.at(i));
+          });
+    }
+    if (pendingOutput.valid()) {
+      common::ScopedPhase phase{phaseTracker.get(), "wait_for_output"};
+      pendingOutput.get();
     }
 
     auto gateStatistics =
@@ -77,6 +118,9 @@ class AttributionApp {
     schedulerStatistics_.freeGates = gateStatistics.second;
     schedulerStatistics_.sentNetwork = trafficStatistics.first;
     schedulerStatistics_.receivedNetwork = trafficStatistics.second;
+    if (phaseTracker) {
+      schedulerStatistics_.phases = phaseTracker->getPhases();
+    }
   }
 
   common::SchedulerStatistics getSchedulerStatistics() {
@@ -84,6 +128,18 @@ class AttributionApp {
   }
 
  protected:
+  static common::SchedulerStatistics getSchedulerCounters() {
+    auto gateStatistics =
+        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getGateStatistics();
+    auto trafficStatistics =
+        fbpcf::scheduler::SchedulerKeeper<schedulerId>::getTrafficStatistics();
+    return common::SchedulerStatistics{
+        gateStatistics.first,
+        gateStatistics.second,
+        trafficStatistics.first,
+        trafficStatistics.second};
+  }
+
   AttributionInputMetrics<usingBatch, inputEncryption> getInputData(
       std::string inputPath) {
     XLOG(INFO) << "MY_ROLE: " << MY_ROLE << ", schedulerId: " << schedulerId
@@ -93,6 +149,15 @@ class AttributionApp {
         MY_ROLE, attributionRules_, inputPath};
   }
 
+  std::future<AttributionInputMetrics<usingBatch, inputEncryption>>
+  prefetchInputData(size_t fileIndex) {
+    CHECK_LT(fileIndex, inputFilenames_.size())
+        << "File index exceeds number of files.";
+    return std::async(std::launch::async, [this, fileIndex]() {
+      return getInputData(inputFilenames_.at(fileIndex));
+    });
+  }
+
   void putOutputData(
       const AttributionOutputMetrics& attributions,
       std::string outputPath) {
@@ -105,8 +170,8 @@ class AttributionApp {
   std::string attributionRules_;
   std::vector<std::string> inputFilenames_;
   std::vector<std::string> outputFilenames_;
-  int startFileIndex_;
-  int numFiles_;
+  size_t startFileIndex_;
+  size_t numFiles_;
   common::SchedulerStatistics schedulerStatistics_;
 };
 
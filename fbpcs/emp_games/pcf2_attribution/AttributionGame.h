@@ -9,6 +9,7 @@
 
 #include "fbpcf/frontend/mpcGame.h"
 #include "fbpcs/emp_games/common/Debug.h"
+#include "fbpcs/emp_games/common/PhaseTracker.h"
 #include "fbpcs/emp_games/common/Util.h"
 #include "fbpcs/emp_games/pcf2_attribution/AttributionMetrics.h"
 #include "fbpcs/emp_games/pcf2_attribution/AttributionOptions.h"
@@ -26,9 +27,14 @@ template <
     common::InputEncryption inputEncryption>
 class AttributionGame : public fbpcf::frontend::MpcGame<schedulerId> {
  public:
+  /**
+   * Phases of the game are recorded in phaseTracker, unless it is null.
+   */
   explicit AttributionGame(
-      std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler)
-      : fbpcf::frontend::MpcGame<schedulerId>(std::move(scheduler)) {}
+      std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler,
+      common::PhaseTracker* phaseTracker = nullptr)
+      : fbpcf::frontend::MpcGame<schedulerId>(std::move(scheduler)),
+        phaseTracker_{phaseTracker} {}
 
   AttributionOutputMetrics computeAttributions(
       const int myRole,
@@ -89,6 +95,9 @@ class AttributionGame : public fbpcf::frontend::MpcGame<schedulerId> {
       const std::vector<std::vector<SecTimestamp<schedulerId, usingBatch>>>&
           thresholds,
       size_t batchSize);
+
+ private:
+  common::PhaseTracker* phaseTracker_;
 };
 
 } // namespace pcf2_attribution
@@ -9,6 +9,7 @@
 
 #include <algorithm>
 #include <exception>
+#include <optional>
 #include "fbpcs/emp_games/pcf2_attribution/AttributionGame.h"
 #include "fbpcs/emp_games/pcf2_attribution/Constants.h"
 
@@ -298,7 +299,11 @@ AttributionGame<schedulerId, usingBatch, inputEncryption>::computeAttributions(
   uint32_t numIds = ids.size();
   XLOGF(INFO, "Have {} ids", numIds);
 
+  // The current phase of the game. Starting a phase ends the previous one.
+  std::optional<common::ScopedPhase> phase;
+
   // Send over all of the data needed for this computation
+  phase.emplace(phaseTracker_, "share_inputs");
   XLOG(INFO, "Privately sharing touchpoints...");
   auto tpArrays = privatelyShareTouchpoints(inputData.getTouchpointArrays());
   XLOG(INFO, "Privately sharing conversions...");
@@ -312,18 +317,22 @@ AttributionGame<schedulerId, usingBatch, inputEncryption>::computeAttributions(
   AttributionOutputMetrics out;
 
   // Publisher shares attribution rules with partner
+  phase.emplace(phaseTracker_, "share_attribution_rules");
   auto attributionRules =
       shareAttributionRules(myRole, inputData.getAttributionRules());
+  phase.reset();
 
   for (const auto attributionRule : attributionRules) {
     XLOGF(INFO, "Computing attributions for rule {}", attributionRule.name);
 
     // Share touchpoint threshold information for computing attributions
+    phase.emplace(phaseTracker_, "share_thresholds");
     auto thresholdArrays = privatelyShareThresholds(
         inputData.getTouchpointArrays(), tpArrays, attributionRule, numIds);
     CHECK_EQ(thresholdArrays.size(), tpArrays.size())
         << "threshold arrays and touchpoint arrays are not the same length.";
 
+    phase.emplace(phaseTracker_, "attribution_circuit");
     std::vector<SecBitT<schedulerId, usingBatch>> attributions;
 
     if constexpr (usingBatch) {
@@ -349,8 +358,10 @@ AttributionGame<schedulerId, usingBatch, inputEncryption>::computeAttributions(
         INFO,
         "Retrieving attribution results for rule {}.",
         attributionRule.name);
+    phase.emplace(phaseTracker_, "reveal");
     attributionMetrics.formatToAttribution[attributionFormat] =
         attributionOutput.reveal();
+    phase.reset();
     out.ruleToMetrics[attributionRule.name] = attributionMetrics;
 
     XLOGF(
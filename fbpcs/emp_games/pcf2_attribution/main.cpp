@@ -10,11 +10,15 @@
 
 #include "folly/Format.h"
 #include "folly/init/Init.h"
+#include "folly/json.h"
 #include "folly/logging/xlog.h"
 
 #include <fbpcf/aws/AwsSdk.h>
+#include <fbpcf/io/FileManagerUtil.h>
 #include <fbpcs/performance_tools/CostEstimation.h>
 
+#include "fbpcs/emp_games/common/PhaseTracker.h"
+
 #include "fbpcs/emp_games/pcf2_attribution/AttributionApp.h"
 #include "fbpcs/emp_games/pcf2_attribution/AttributionOptions.h"
 #include "fbpcs/emp_games/pcf2_attribution/Constants.h"
@@ -28,6 +32,8 @@ int main(int argc, char* argv[]) {
   folly::init(&argc, &argv);
   gflags::ParseCommandLineFlags(&argc, &argv, true);
   fbpcf::AwsSdk::aquire();
+  cost.startResourceSampling(
+      std::chrono::milliseconds{FLAGS_resource_sampling_interval_ms});
 
   FLAGS_party--; // subtract 1 because we use 0 and 1 for publisher and partner
                  // instead of 1 and 2
@@ -43,6 +49,7 @@ int main(int argc, char* argv[]) {
   // use batched attribution by default
   const bool usingBatch = true;
 
+  cost.markPhase("run_game");
   try {
     auto [inputFilenames, outputFilenames] = pcf2_attribution::getIOFilenames(
         FLAGS_num_files,
@@ -149,6 +156,7 @@ int main(int argc, char* argv[]) {
     std::exit(1);
   }
 
+  cost.markPhase("finish");
   cost.end();
   XLOG(INFO, cost.getEstimatedCostString());
 
@@ -164,6 +172,14 @@ int main(int argc, char* argv[]) {
       schedulerStatistics.sentNetwork,
       schedulerStatistics.receivedNetwork);
 
+  if (!FLAGS_phase_profile_path.empty()) {
+    XLOGF(INFO, "Writing phase profile to {}", FLAGS_phase_profile_path);
+    fbpcf::io::write(
+        FLAGS_phase_profile_path,
+        folly::toPrettyJson(
+            common::getPhaseProfile(schedulerStatistics.phases)));
+  }
+
   if (FLAGS_log_cost) {
     auto run_name = (FLAGS_run_name != "") ? FLAGS_run_name : "temp_run_name";
     auto party = (FLAGS_party == common::PUBLISHER) ? "Publisher" : "Partner";
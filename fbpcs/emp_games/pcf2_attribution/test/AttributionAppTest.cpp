@@ -12,6 +12,7 @@
 #include <gtest/gtest.h>
 #include "folly/Format.h"
 #include "folly/Random.h"
+#include "folly/String.h"
 #include "folly/logging/xlog.h"
 
 #include "fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h"
@@ -53,6 +54,37 @@ static void runGame(
       .run();
 }
 
+template <int PARTY, int schedulerId, bool usingBatch>
+static void runGameOnMultipleFiles(
+    const std::string& serverIp,
+    const uint16_t port,
+    const std::string& attributionRules,
+    const std::vector<std::string>& inputPaths,
+    const std::vector<std::string>& outputPaths) {
+  std::map<
+      int,
+      fbpcf::engine::communication::SocketPartyCommunicationAgentFactory::
+          PartyInfo>
+      partyInfos({{0, {serverIp, port}}, {1, {serverIp, port}}});
+
+  auto communicationAgentFactory = std::make_unique<
+      fbpcf::engine::communication::SocketPartyCommunicationAgentFactory>(
+      PARTY, partyInfos, false, "");
+
+  AttributionApp<
+      PARTY,
+      schedulerId,
+      usingBatch,
+      common::InputEncryption::Plaintext>(
+      std::move(communicationAgentFactory),
+      attributionRules,
+      inputPaths,
+      outputPaths,
+      0,
+      inputPaths.size())
+      .run();
+}
+
 // helper function for executing MPC game and verifying corresponding output
 template <int id, bool usingBatch, common::InputEncryption inputEncryption>
 inline void testCorrectnessAttributionAppHelper(
@@ -232,4 +264,85 @@ INSTANTIATE_TEST_SUITE_P(
       return name;
     });
 
+// Run all test files through a single app, so that input prefetching and
+// asynchronous output writing are exercised across files.
+template <bool usingBatch>
+void testCorrectnessOnMultipleFiles() {
+  auto port = 5000 + folly::Random::rand32() % 1000;
+  std::string baseDir =
+      private_measurement::test_util::getBaseDirFromPath(__FILE__);
+  std::string tempDir = std::filesystem::temp_directory_path();
+  auto runId = folly::Random::secureRand64();
+
+  std::vector<std::string> attributionRules{
+      common::LAST_CLICK_1D,
+      common::LAST_TOUCH_1D,
+      common::LAST_CLICK_2_7D,
+      common::LAST_TOUCH_2_7D};
+  std::vector<std::string> inputFilenamesAlice;
+  std::vector<std::string> inputFilenamesBob;
+  std::vector<std::string> outputFilenamesAlice;
+  std::vector<std::string> outputFilenamesBob;
+  for (const auto& attributionRule : attributionRules) {
+    std::string filePrefix = baseDir + "test_correctness/" + attributionRule;
+    inputFilenamesAlice.push_back(filePrefix + ".publisher.csv");
+    inputFilenamesBob.push_back(filePrefix + ".partner.csv");
+    outputFilenamesAlice.push_back(folly::sformat(
+        "{}/output_path_alice.json_{}_{}", tempDir, runId, attributionRule));
+    outputFilenamesBob.push_back(folly::sformat(
+        "{}/output_path_bob.json_{}_{}", tempDir, runId, attributionRule));
+  }
+
+  auto futureAlice = std::async(
+      runGameOnMultipleFiles<common::PUBLISHER, 0, usingBatch>,
+      "",
+      port,
+      folly::join(",", attributionRules),
+      inputFilenamesAlice,
+      outputFilenamesAlice);
+  auto futureBob = std::async(
+      runGameOnMultipleFiles<common::PARTNER, 1, usingBatch>,
+      "127.0.0.1",
+      port,
+      "",
+      inputFilenamesBob,
+      outputFilenamesBob);
+
+  futureAlice.wait();
+  futureBob.wait();
+
+  for (size_t i = 0; i < attributionRules.size(); ++i) {
+    auto resAlice = AttributionOutputMetrics::fromJson(
+        fbpcf::io::read(outputFilenamesAlice.at(i)));
+    auto resBob = AttributionOutputMetrics::fromJson(
+        fbpcf::io::read(outputFilenamesBob.at(i)));
+
+    auto result = revealXORedResult(resAlice, resBob, attributionRules.at(i));
+    verifyOutput(
+        result,
+        baseDir + "test_correctness/" + attributionRules.at(i) + ".json");
+
+    std::filesystem::remove(outputFilenamesAlice.at(i));
+    std::filesystem::remove(outputFilenamesBob.at(i));
+  }
+}
+
+class AttributionAppMultipleFilesTest : public ::testing::TestWithParam<bool> {
+};
+
+TEST_P(AttributionAppMultipleFilesTest, TestCorrectnessOnMultipleFiles) {
+  if (GetParam()) {
+    testCorrectnessOnMultipleFiles<true>();
+  } else {
+    testCorrectnessOnMultipleFiles<false>();
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(
+    AttributionAppMultipleFilesTest,
+    AttributionAppMultipleFilesTest,
+    ::testing::Bool(),
+    [](const testing::TestParamInfo<AttributionAppMultipleFilesTest::ParamType>&
+           info) { return info.param ? "Batch_True" : "Batch_False"; });
+
 } // namespace pcf2_attribution
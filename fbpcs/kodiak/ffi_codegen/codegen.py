@@ -17,6 +17,9 @@ class TypeInfo:
     rust_name: str
     cpp_clear_type: str
     mpc_engine_type: str
+    # Batched types hold a whole column behind one handle. fbpcf takes and
+    # returns their values as a std::vector of this type.
+    batch_native_type: Optional[str] = None
 
 
 @dataclass
@@ -26,7 +29,6 @@ class OperatorInfo:
     ret: Optional[str] = None
 
 
-# TODO: Changing all these `false` to `true` makes it a batch game
 BOOLEAN_TYPE = TypeInfo(
     arg_name="mpc_bool",
     cpp_name="CppMPCBool",
@@ -66,9 +68,29 @@ ARITHMETIC_TYPES = [
     ),
 ]
 
+
+def to_batch_type(type_info: TypeInfo, batch_native_type: str) -> TypeInfo:
+    return TypeInfo(
+        arg_name=f"{type_info.arg_name}_batch",
+        cpp_name=f"{type_info.cpp_name}Batch",
+        rust_name=type_info.rust_name,
+        cpp_clear_type=type_info.cpp_clear_type,
+        mpc_engine_type=type_info.mpc_engine_type.replace("false>", "true>"),
+        batch_native_type=batch_native_type,
+    )
+
+
+BATCH_BOOLEAN_TYPE = to_batch_type(BOOLEAN_TYPE, "bool")
+
+# fbpcf keeps the values of every integer width in 64 bits
+BATCH_ARITHMETIC_TYPES = [
+    to_batch_type(type_info, "int64_t" if type_info.rust_name[0] == "i" else "uint64_t")
+    for type_info in ARITHMETIC_TYPES
+]
+
 BOOLEAN_OPS = [
     OperatorInfo(name="and", symbol="&"),
-    OperatorInfo(name="or", symbol="||"),
+    OperatorInfo(name="or", symbol="|"),
     OperatorInfo(name="xor", symbol="^"),
 ]
 
@@ -108,13 +130,15 @@ def get_h_pragma_and_includes() -> str:
         "#pragma once\n\n"
         "#include <map>\n"
         "#include <memory>\n"
-        "#include <string>\n\n"
+        "#include <string>\n"
+        "#include <vector>\n\n"
         "#include <fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h>\n"
         "#include <fbpcf/frontend/mpcGame.h>\n"
         "#include <fbpcf/mpc_std_lib/oram/IWriteOnlyOram.h>\n"
         "#include <fbpcf/mpc_std_lib/oram/LinearOramFactory.h>\n"
         "#include <fbpcf/scheduler/IScheduler.h>\n"
-        "#include <fbpcf/scheduler/SchedulerHelper.h>\n"
+        "#include <fbpcf/scheduler/SchedulerHelper.h>\n\n"
+        '#include "rust/cxx.h"\n'
     )
 
 
@@ -136,7 +160,6 @@ def get_kodiak_game_classes() -> str:
         "  explicit KodiakGameDetail(std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler)\n"
         "      : fbpcf::frontend::MpcGame<schedulerId>(std::move(scheduler)) {}\n"
         "};\n"
-        # TODO: Adding ', true' as a second template argument makes this a batch game
         "class KodiakGame : public KodiakGameDetail<0> {\n"
         " public:\n"
         "  explicit KodiakGame(std::unique_ptr<fbpcf::scheduler::IScheduler> scheduler)\n"
@@ -160,6 +183,19 @@ def make_new_func(type_info: TypeInfo) -> str:
     cpp_typename = type_info.cpp_name
     arg_name = type_info.arg_name
     clear_type = type_info.cpp_clear_type
+    if type_info.batch_native_type is not None:
+        native_type = type_info.batch_native_type
+        return (
+            # Signature and funcname
+            f"std::unique_ptr<{cpp_typename}> new_{arg_name}"
+            # parameters
+            f"(rust::Slice<const {clear_type}> a, int32_t partyId) {{\n"
+            # statements
+            f"  return std::make_unique<{cpp_typename}>("
+            f"std::vector<{native_type}>(a.begin(), a.end()), partyId);\n"
+            # end of func
+            "}"
+        )
     return (
         # Signature and funcname
         f"std::unique_ptr<{cpp_typename}> new_{arg_name}"
@@ -176,6 +212,24 @@ def make_reveal_func(type_info: TypeInfo) -> str:
     ret_type = type_info.cpp_clear_type
     arg_name = type_info.arg_name
     cpp_typename = type_info.cpp_name
+    if type_info.batch_native_type is not None:
+        return (
+            # Signature and funcname
+            f"rust::Vec<{ret_type}> reveal_{arg_name}"
+            # parameters
+            f"(const {cpp_typename}& a) {{\n"
+            # statements
+            # TODO: Open to *both* parties
+            f"  auto res = a.openToParty(0).getValue();\n"
+            f"  rust::Vec<{ret_type}> values;\n"
+            f"  values.reserve(res.size());\n"
+            f"  for (auto value : res) {{\n"
+            f"    values.push_back(static_cast<{ret_type}>(value));\n"
+            f"  }}\n"
+            f"  return values;\n"
+            # end of func
+            "}"
+        )
     return (
         # Signature and funcname
         f"{ret_type} reveal_{arg_name}"
@@ -190,14 +244,15 @@ def make_reveal_func(type_info: TypeInfo) -> str:
     )
 
 
-def make_mux_func(type_info: TypeInfo) -> str:
+def make_mux_func(type_info: TypeInfo, boolean_type: TypeInfo) -> str:
     cpp_type = type_info.cpp_name
     arg_name = type_info.arg_name
+    choice_type = boolean_type.cpp_name
     return (
         # Signature and funcname
         f"std::unique_ptr<{cpp_type}> {arg_name}_mux"
         # parameters
-        f"(const CppMPCBool& choiceBit, const {cpp_type}& trueCase, const {cpp_type}& falseCase) {{\n"
+        f"(const {choice_type}& choiceBit, const {cpp_type}& trueCase, const {cpp_type}& falseCase) {{\n"
         # statements
         f"  return std::make_unique<{cpp_type}>(trueCase.mux(choiceBit, falseCase));"
         # end of func
@@ -211,6 +266,9 @@ def make_binop_func(type_info: TypeInfo, op_info: OperatorInfo) -> str:
     param_typename = type_info.cpp_name
     if op_info.ret is not None:
         ret_typename = op_info.ret.cpp_name
+        # Batched operands give one result per row
+        if type_info.batch_native_type is not None:
+            ret_typename = f"{ret_typename}Batch"
     else:
         ret_typename = param_typename
 
@@ -243,53 +301,61 @@ def main() -> None:
         print("namespace kodiak_cpp {\n", file=f_h)
         for type_info in [BOOLEAN_TYPE] + ARITHMETIC_TYPES:
             print(get_using_declaration(type_info), file=f_h)
+        for type_info in [BATCH_BOOLEAN_TYPE] + BATCH_ARITHMETIC_TYPES:
+            print(get_using_declaration(type_info), file=f_h)
         print(get_kodiak_game_classes(), file=f_h)
 
         # First write the license, include header, and namespace declarations
         # This is the "set up" for the cpp file
         print(get_license_and_generated_header(), file=f_cpp)
         print('#include "fbpcs/kodiak/include/ffi.h"\n', file=f_cpp)
-        print("#include <memory>\n", file=f_cpp)
+        print("#include <memory>", file=f_cpp)
+        print("#include <vector>\n", file=f_cpp)
         print("using namespace kodiak_cpp;\n", file=f_cpp)
 
-        # Write all the functions for the boolean type
-        type_info = BOOLEAN_TYPE
-        print(f"Gen functions for {type_info.arg_name}")
-        new_f = make_new_func(type_info)
-        print(func_to_header_declaration(new_f), file=f_h)
-        print(new_f, file=f_cpp)
-        reveal_f = make_reveal_func(type_info)
-        print(func_to_header_declaration(reveal_f), file=f_h)
-        print(reveal_f, file=f_cpp)
-        for operator_info in BOOLEAN_OPS:
-            binop_f = make_binop_func(type_info, operator_info)
-            print(func_to_header_declaration(binop_f), file=f_h)
-            print(binop_f, file=f_cpp)
-
-        # Write all the functions for the arithmetic types
-        for type_info in ARITHMETIC_TYPES:
+        # Scalar types hold one value per handle, batched types a whole column
+        for boolean_type, arithmetic_types in [
+            (BOOLEAN_TYPE, ARITHMETIC_TYPES),
+            (BATCH_BOOLEAN_TYPE, BATCH_ARITHMETIC_TYPES),
+        ]:
+            # Write all the functions for the boolean type
+            type_info = boolean_type
             print(f"Gen functions for {type_info.arg_name}")
             new_f = make_new_func(type_info)
             print(func_to_header_declaration(new_f), file=f_h)
             print(new_f, file=f_cpp)
-
             reveal_f = make_reveal_func(type_info)
             print(func_to_header_declaration(reveal_f), file=f_h)
             print(reveal_f, file=f_cpp)
-
-            mux_f = make_mux_func(type_info)
-            print(func_to_header_declaration(mux_f), file=f_h)
-            print(mux_f, file=f_cpp)
-
-            for operator_info in ARITHMETIC_OPS:
-                binop_f = make_binop_func(type_info, operator_info)
-                print(func_to_header_declaration(binop_f), file=f_h)
-                print(binop_f, file=f_cpp)
-            for operator_info in COMPARISON_OPS:
+            for operator_info in BOOLEAN_OPS:
                 binop_f = make_binop_func(type_info, operator_info)
                 print(func_to_header_declaration(binop_f), file=f_h)
                 print(binop_f, file=f_cpp)
 
+            # Write all the functions for the arithmetic types
+            for type_info in arithmetic_types:
+                print(f"Gen functions for {type_info.arg_name}")
+                new_f = make_new_func(type_info)
+                print(func_to_header_declaration(new_f), file=f_h)
+                print(new_f, file=f_cpp)
+
+                reveal_f = make_reveal_func(type_info)
+                print(func_to_header_declaration(reveal_f), file=f_h)
+                print(reveal_f, file=f_cpp)
+
+                mux_f = make_mux_func(type_info, boolean_type)
+                print(func_to_header_declaration(mux_f), file=f_h)
+                print(mux_f, file=f_cpp)
+
+                for operator_info in ARITHMETIC_OPS:
+                    binop_f = make_binop_func(type_info, operator_info)
+                    print(func_to_header_declaration(binop_f), file=f_h)
+                    print(binop_f, file=f_cpp)
+                for operator_info in COMPARISON_OPS:
+                    binop_f = make_binop_func(type_info, operator_info)
+                    print(func_to_header_declaration(binop_f), file=f_h)
+                    print(binop_f, file=f_cpp)
+
         print("} // namespace kodiak_cpp", file=f_h)
 
     # Finally, run the auto-formatters on the code
@@ -12,6 +12,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include <fbpcf/engine/communication/SocketPartyCommunicationAgentFactory.h>
 #include <fbpcf/frontend/mpcGame.h>
@@ -20,6 +21,8 @@
 #include <fbpcf/scheduler/IScheduler.h>
 #include <fbpcf/scheduler/SchedulerHelper.h>
 
+#include "rust/cxx.h"
+
 namespace kodiak_cpp {
 
 using CppMPCBool = typename fbpcf::frontend::MpcGame<0>::template SecBit<false>;
@@ -31,6 +34,16 @@ using CppMPCUInt32 =
     typename fbpcf::frontend::MpcGame<0>::template SecUnsignedInt<32, false>;
 using CppMPCUInt64 =
     typename fbpcf::frontend::MpcGame<0>::template SecUnsignedInt<64, false>;
+using CppMPCBoolBatch =
+    typename fbpcf::frontend::MpcGame<0>::template SecBit<true>;
+using CppMPCInt32Batch =
+    typename fbpcf::frontend::MpcGame<0>::template SecSignedInt<32, true>;
+using CppMPCInt64Batch =
+    typename fbpcf::frontend::MpcGame<0>::template SecSignedInt<64, true>;
+using CppMPCUInt32Batch =
+    typename fbpcf::frontend::MpcGame<0>::template SecUnsignedInt<32, true>;
+using CppMPCUInt64Batch =
+    typename fbpcf::frontend::MpcGame<0>::template SecUnsignedInt<64, true>;
 constexpr int32_t PUBLISHER_ROLE = 0;
 constexpr int32_t PARTNER_ROLE = 1;
 
@@ -181,4 +194,133 @@ std::unique_ptr<CppMPCBool> mpc_uint64_lte(
 std::unique_ptr<CppMPCBool> mpc_uint64_gte(
     const CppMPCUInt64& a,
     const CppMPCUInt64& b);
+std::unique_ptr<CppMPCBoolBatch> new_mpc_bool_batch(
+    rust::Slice<const bool> a,
+    int32_t partyId);
+rust::Vec<bool> reveal_mpc_bool_batch(const CppMPCBoolBatch& a);
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_and(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_or(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_xor(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b);
+std::unique_ptr<CppMPCInt32Batch> new_mpc_int32_batch(
+    rust::Slice<const int32_t> a,
+    int32_t partyId);
+rust::Vec<int32_t> reveal_mpc_int32_batch(const CppMPCInt32Batch& a);
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCInt32Batch& trueCase,
+    const CppMPCInt32Batch& falseCase);
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_add(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_sub(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_eq(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_lt(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_gt(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_lte(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_gte(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b);
+std::unique_ptr<CppMPCInt64Batch> new_mpc_int64_batch(
+    rust::Slice<const int64_t> a,
+    int32_t partyId);
+rust::Vec<int64_t> reveal_mpc_int64_batch(const CppMPCInt64Batch& a);
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCInt64Batch& trueCase,
+    const CppMPCInt64Batch& falseCase);
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_add(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_sub(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_eq(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_lt(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_gt(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_lte(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_gte(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b);
+std::unique_ptr<CppMPCUInt32Batch> new_mpc_uint32_batch(
+    rust::Slice<const uint32_t> a,
+    int32_t partyId);
+rust::Vec<uint32_t> reveal_mpc_uint32_batch(const CppMPCUInt32Batch& a);
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCUInt32Batch& trueCase,
+    const CppMPCUInt32Batch& falseCase);
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_add(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_sub(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_eq(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_lt(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_gt(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_lte(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_gte(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b);
+std::unique_ptr<CppMPCUInt64Batch> new_mpc_uint64_batch(
+    rust::Slice<const uint64_t> a,
+    int32_t partyId);
+rust::Vec<uint64_t> reveal_mpc_uint64_batch(const CppMPCUInt64Batch& a);
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCUInt64Batch& trueCase,
+    const CppMPCUInt64Batch& falseCase);
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_add(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_sub(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_eq(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_lt(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_gt(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_lte(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_gte(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b);
 } // namespace kodiak_cpp
@@ -10,6 +10,7 @@
 #include "fbpcs/kodiak/include/ffi.h"
 
 #include <memory>
+#include <vector>
 
 using namespace kodiak_cpp;
 
@@ -227,3 +228,259 @@ std::unique_ptr<CppMPCBool> mpc_uint64_gte(
     const CppMPCUInt64& b) {
   return std::make_unique<CppMPCBool>(a >= b);
 }
+std::unique_ptr<CppMPCBoolBatch> new_mpc_bool_batch(
+    rust::Slice<const bool> a,
+    int32_t partyId) {
+  return std::make_unique<CppMPCBoolBatch>(
+      std::vector<bool>(a.begin(), a.end()), partyId);
+}
+rust::Vec<bool> reveal_mpc_bool_batch(const CppMPCBoolBatch& a) {
+  auto res = a.openToParty(0).getValue();
+  rust::Vec<bool> values;
+  values.reserve(res.size());
+  for (auto value : res) {
+    values.push_back(static_cast<bool>(value));
+  }
+  return values;
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_and(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a & b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_or(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a | b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_bool_batch_xor(
+    const CppMPCBoolBatch& a,
+    const CppMPCBoolBatch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a ^ b);
+}
+std::unique_ptr<CppMPCInt32Batch> new_mpc_int32_batch(
+    rust::Slice<const int32_t> a,
+    int32_t partyId) {
+  return std::make_unique<CppMPCInt32Batch>(
+      std::vector<int64_t>(a.begin(), a.end()), partyId);
+}
+rust::Vec<int32_t> reveal_mpc_int32_batch(const CppMPCInt32Batch& a) {
+  auto res = a.openToParty(0).getValue();
+  rust::Vec<int32_t> values;
+  values.reserve(res.size());
+  for (auto value : res) {
+    values.push_back(static_cast<int32_t>(value));
+  }
+  return values;
+}
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCInt32Batch& trueCase,
+    const CppMPCInt32Batch& falseCase) {
+  return std::make_unique<CppMPCInt32Batch>(trueCase.mux(choiceBit, falseCase));
+}
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_add(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCInt32Batch>(a + b);
+}
+std::unique_ptr<CppMPCInt32Batch> mpc_int32_batch_sub(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCInt32Batch>(a - b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_eq(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a == b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_lt(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a < b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_gt(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a > b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_lte(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a <= b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int32_batch_gte(
+    const CppMPCInt32Batch& a,
+    const CppMPCInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a >= b);
+}
+std::unique_ptr<CppMPCInt64Batch> new_mpc_int64_batch(
+    rust::Slice<const int64_t> a,
+    int32_t partyId) {
+  return std::make_unique<CppMPCInt64Batch>(
+      std::vector<int64_t>(a.begin(), a.end()), partyId);
+}
+rust::Vec<int64_t> reveal_mpc_int64_batch(const CppMPCInt64Batch& a) {
+  auto res = a.openToParty(0).getValue();
+  rust::Vec<int64_t> values;
+  values.reserve(res.size());
+  for (auto value : res) {
+    values.push_back(static_cast<int64_t>(value));
+  }
+  return values;
+}
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCInt64Batch& trueCase,
+    const CppMPCInt64Batch& falseCase) {
+  return std::make_unique<CppMPCInt64Batch>(trueCase.mux(choiceBit, falseCase));
+}
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_add(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCInt64Batch>(a + b);
+}
+std::unique_ptr<CppMPCInt64Batch> mpc_int64_batch_sub(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCInt64Batch>(a - b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_eq(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a == b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_lt(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a < b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_gt(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a > b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_lte(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a <= b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_int64_batch_gte(
+    const CppMPCInt64Batch& a,
+    const CppMPCInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a >= b);
+}
+std::unique_ptr<CppMPCUInt32Batch> new_mpc_uint32_batch(
+    rust::Slice<const uint32_t> a,
+    int32_t partyId) {
+  return std::make_unique<CppMPCUInt32Batch>(
+      std::vector<uint64_t>(a.begin(), a.end()), partyId);
+}
+rust::Vec<uint32_t> reveal_mpc_uint32_batch(const CppMPCUInt32Batch& a) {
+  auto res = a.openToParty(0).getValue();
+  rust::Vec<uint32_t> values;
+  values.reserve(res.size());
+  for (auto value : res) {
+    values.push_back(static_cast<uint32_t>(value));
+  }
+  return values;
+}
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCUInt32Batch& trueCase,
+    const CppMPCUInt32Batch& falseCase) {
+  return std::make_unique<CppMPCUInt32Batch>(
+      trueCase.mux(choiceBit, falseCase));
+}
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_add(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCUInt32Batch>(a + b);
+}
+std::unique_ptr<CppMPCUInt32Batch> mpc_uint32_batch_sub(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCUInt32Batch>(a - b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_eq(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a == b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_lt(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a < b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_gt(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a > b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_lte(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a <= b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint32_batch_gte(
+    const CppMPCUInt32Batch& a,
+    const CppMPCUInt32Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a >= b);
+}
+std::unique_ptr<CppMPCUInt64Batch> new_mpc_uint64_batch(
+    rust::Slice<const uint64_t> a,
+    int32_t partyId) {
+  return std::make_unique<CppMPCUInt64Batch>(
+      std::vector<uint64_t>(a.begin(), a.end()), partyId);
+}
+rust::Vec<uint64_t> reveal_mpc_uint64_batch(const CppMPCUInt64Batch& a) {
+  auto res = a.openToParty(0).getValue();
+  rust::Vec<uint64_t> values;
+  values.reserve(res.size());
+  for (auto value : res) {
+    values.push_back(static_cast<uint64_t>(value));
+  }
+  return values;
+}
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_mux(
+    const CppMPCBoolBatch& choiceBit,
+    const CppMPCUInt64Batch& trueCase,
+    const CppMPCUInt64Batch& falseCase) {
+  return std::make_unique<CppMPCUInt64Batch>(
+      trueCase.mux(choiceBit, falseCase));
+}
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_add(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCUInt64Batch>(a + b);
+}
+std::unique_ptr<CppMPCUInt64Batch> mpc_uint64_batch_sub(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCUInt64Batch>(a - b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_eq(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a == b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_lt(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a < b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_gt(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a > b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_lte(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a <= b);
+}
+std::unique_ptr<CppMPCBoolBatch> mpc_uint64_batch_gte(
+    const CppMPCUInt64Batch& a,
+    const CppMPCUInt64Batch& b) {
+  return std::make_unique<CppMPCBoolBatch>(a >= b);
+}
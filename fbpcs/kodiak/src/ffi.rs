@@ -21,6 +21,13 @@ mod ffi {
         type CppMPCUInt32;
         type CppMPCUInt64;
         type CppMPCBool;
+        // Batched versions of the types above, where one handle holds a
+        // whole column and each operation covers every row of it
+        type CppMPCInt32Batch;
+        type CppMPCInt64Batch;
+        type CppMPCUInt32Batch;
+        type CppMPCUInt64Batch;
+        type CppMPCBoolBatch;
 
         // Functions implemented in C++.
         // Create a new game
@@ -127,5 +134,173 @@ mod ffi {
         fn reveal_mpc_uint32(val: &CppMPCUInt32) -> u32;
         fn reveal_mpc_uint64(val: &CppMPCUInt64) -> u64;
         fn reveal_mpc_bool(val: &CppMPCBool) -> bool;
+
+        // Create new batched MPC types from a column of values
+        fn new_mpc_int32_batch(values: &[i32], partyId: i32) -> UniquePtr<CppMPCInt32Batch>;
+        fn new_mpc_int64_batch(values: &[i64], partyId: i32) -> UniquePtr<CppMPCInt64Batch>;
+        fn new_mpc_uint32_batch(values: &[u32], partyId: i32) -> UniquePtr<CppMPCUInt32Batch>;
+        fn new_mpc_uint64_batch(values: &[u64], partyId: i32) -> UniquePtr<CppMPCUInt64Batch>;
+        fn new_mpc_bool_batch(values: &[bool], partyId: i32) -> UniquePtr<CppMPCBoolBatch>;
+
+        // MPC Int32 batch functions
+        fn mpc_int32_batch_add(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCInt32Batch>;
+        fn mpc_int32_batch_sub(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCInt32Batch>;
+        fn mpc_int32_batch_lt(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int32_batch_gt(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int32_batch_lte(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int32_batch_gte(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int32_batch_eq(
+            lhs: &CppMPCInt32Batch,
+            rhs: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int32_batch_mux(
+            choice: &CppMPCBoolBatch,
+            true_case: &CppMPCInt32Batch,
+            false_case: &CppMPCInt32Batch,
+        ) -> UniquePtr<CppMPCInt32Batch>;
+
+        // MPC Int64 batch functions
+        fn mpc_int64_batch_add(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCInt64Batch>;
+        fn mpc_int64_batch_sub(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCInt64Batch>;
+        fn mpc_int64_batch_lt(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int64_batch_gt(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int64_batch_lte(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int64_batch_gte(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int64_batch_eq(
+            lhs: &CppMPCInt64Batch,
+            rhs: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_int64_batch_mux(
+            choice: &CppMPCBoolBatch,
+            true_case: &CppMPCInt64Batch,
+            false_case: &CppMPCInt64Batch,
+        ) -> UniquePtr<CppMPCInt64Batch>;
+
+        // MPC UInt32 batch functions
+        fn mpc_uint32_batch_add(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCUInt32Batch>;
+        fn mpc_uint32_batch_sub(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCUInt32Batch>;
+        fn mpc_uint32_batch_lt(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint32_batch_gt(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint32_batch_lte(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint32_batch_gte(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint32_batch_eq(
+            lhs: &CppMPCUInt32Batch,
+            rhs: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint32_batch_mux(
+            choice: &CppMPCBoolBatch,
+            true_case: &CppMPCUInt32Batch,
+            false_case: &CppMPCUInt32Batch,
+        ) -> UniquePtr<CppMPCUInt32Batch>;
+
+        // MPC UInt64 batch functions
+        fn mpc_uint64_batch_add(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCUInt64Batch>;
+        fn mpc_uint64_batch_sub(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCUInt64Batch>;
+        fn mpc_uint64_batch_lt(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint64_batch_gt(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint64_batch_lte(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint64_batch_gte(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint64_batch_eq(
+            lhs: &CppMPCUInt64Batch,
+            rhs: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_uint64_batch_mux(
+            choice: &CppMPCBoolBatch,
+            true_case: &CppMPCUInt64Batch,
+            false_case: &CppMPCUInt64Batch,
+        ) -> UniquePtr<CppMPCUInt64Batch>;
+
+        // MPC bool batch functions
+        fn mpc_bool_batch_and(
+            lhs: &CppMPCBoolBatch,
+            rhs: &CppMPCBoolBatch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_bool_batch_or(
+            lhs: &CppMPCBoolBatch,
+            rhs: &CppMPCBoolBatch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+        fn mpc_bool_batch_xor(
+            lhs: &CppMPCBoolBatch,
+            rhs: &CppMPCBoolBatch,
+        ) -> UniquePtr<CppMPCBoolBatch>;
+
+        // Batched reveal functions
+        fn reveal_mpc_int32_batch(val: &CppMPCInt32Batch) -> Vec<i32>;
+        fn reveal_mpc_int64_batch(val: &CppMPCInt64Batch) -> Vec<i64>;
+        fn reveal_mpc_uint32_batch(val: &CppMPCUInt32Batch) -> Vec<u32>;
+        fn reveal_mpc_uint64_batch(val: &CppMPCUInt64Batch) -> Vec<u64>;
+        fn reveal_mpc_bool_batch(val: &CppMPCBoolBatch) -> Vec<bool>;
     }
 }
@@ -19,6 +19,22 @@ pub enum MPCMetricDType {
     MPCUInt64(u64),
     MPCBool(bool),
     Vec(Vec<MPCMetricDType>),
+    // A whole column behind one value, so that an operation on it maps to
+    // one batched FFI call instead of one call per row
+    MPCInt32Batch(Vec<i32>),
+    MPCInt64Batch(Vec<i64>),
+    MPCUInt32Batch(Vec<u32>),
+    MPCUInt64Batch(Vec<u64>),
+    MPCBoolBatch(Vec<bool>),
+}
+
+/// Applies `op` row by row to two batches, which must be of the same size
+fn zip_batches<T: Copy, U>(lhs: &[T], rhs: &[T], op: impl Fn(T, T) -> U) -> Vec<U> {
+    assert_eq!(lhs.len(), rhs.len(), "Batches of different sizes");
+    lhs.iter()
+        .zip(rhs.iter())
+        .map(|(l, r)| op(*l, *r))
+        .collect()
 }
 
 macro_rules! impl_arithmetic_operator {
@@ -32,6 +48,42 @@ macro_rules! impl_arithmetic_operator {
                     (Self::MPCInt64(lhs), Self::MPCInt64(rhs)) => Self::MPCInt64(lhs $op rhs),
                     (Self::MPCUInt32(lhs), Self::MPCUInt32(rhs)) => Self::MPCUInt32(lhs $op rhs),
                     (Self::MPCUInt64(lhs), Self::MPCUInt64(rhs)) => Self::MPCUInt64(lhs $op rhs),
+                    (Self::MPCInt32Batch(lhs), Self::MPCInt32Batch(rhs)) => {
+                        Self::MPCInt32Batch(zip_batches(&lhs, &rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCInt32Batch(lhs), Self::MPCInt32(rhs)) => {
+                        Self::MPCInt32Batch(lhs.into_iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCInt32(lhs), Self::MPCInt32Batch(rhs)) => {
+                        Self::MPCInt32Batch(rhs.into_iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCInt64Batch(lhs), Self::MPCInt64Batch(rhs)) => {
+                        Self::MPCInt64Batch(zip_batches(&lhs, &rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCInt64Batch(lhs), Self::MPCInt64(rhs)) => {
+                        Self::MPCInt64Batch(lhs.into_iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCInt64(lhs), Self::MPCInt64Batch(rhs)) => {
+                        Self::MPCInt64Batch(rhs.into_iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCUInt32Batch(lhs), Self::MPCUInt32Batch(rhs)) => {
+                        Self::MPCUInt32Batch(zip_batches(&lhs, &rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCUInt32Batch(lhs), Self::MPCUInt32(rhs)) => {
+                        Self::MPCUInt32Batch(lhs.into_iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCUInt32(lhs), Self::MPCUInt32Batch(rhs)) => {
+                        Self::MPCUInt32Batch(rhs.into_iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCUInt64Batch(lhs), Self::MPCUInt64Batch(rhs)) => {
+                        Self::MPCUInt64Batch(zip_batches(&lhs, &rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCUInt64Batch(lhs), Self::MPCUInt64(rhs)) => {
+                        Self::MPCUInt64Batch(lhs.into_iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCUInt64(lhs), Self::MPCUInt64Batch(rhs)) => {
+                        Self::MPCUInt64Batch(rhs.into_iter().map(|r| lhs $op r).collect())
+                    }
                     (Self::Vec(lhs), Self::Vec(rhs)) => Self::Vec(
                         lhs.into_iter()
                             .zip(rhs.into_iter())
@@ -51,6 +103,9 @@ macro_rules! impl_arithmetic_operator {
                     (Self::MPCBool(_lhs), Self::MPCBool(_rhs)) => {
                         panic!("Operator not defined for MPC bool")
                     }
+                    (Self::MPCBoolBatch(_lhs), Self::MPCBoolBatch(_rhs)) => {
+                        panic!("Operator not defined for MPC bool")
+                    }
                     (_, _) => panic!("Differing MPCMetricDType variants not supported"),
                 }
             }
@@ -66,6 +121,42 @@ macro_rules! impl_comparision_method {
                     (Self::MPCInt64(lhs), Self::MPCInt64(rhs)) => Self::MPCBool(lhs $op rhs),
                     (Self::MPCUInt32(lhs), Self::MPCUInt32(rhs)) => Self::MPCBool(lhs $op rhs),
                     (Self::MPCUInt64(lhs), Self::MPCUInt64(rhs)) => Self::MPCBool(lhs $op rhs),
+                    (Self::MPCInt32Batch(lhs), Self::MPCInt32Batch(rhs)) => {
+                        Self::MPCBoolBatch(zip_batches(lhs, rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCInt32Batch(lhs), Self::MPCInt32(rhs)) => {
+                        Self::MPCBoolBatch(lhs.iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCInt32(lhs), Self::MPCInt32Batch(rhs)) => {
+                        Self::MPCBoolBatch(rhs.iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCInt64Batch(lhs), Self::MPCInt64Batch(rhs)) => {
+                        Self::MPCBoolBatch(zip_batches(lhs, rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCInt64Batch(lhs), Self::MPCInt64(rhs)) => {
+                        Self::MPCBoolBatch(lhs.iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCInt64(lhs), Self::MPCInt64Batch(rhs)) => {
+                        Self::MPCBoolBatch(rhs.iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCUInt32Batch(lhs), Self::MPCUInt32Batch(rhs)) => {
+                        Self::MPCBoolBatch(zip_batches(lhs, rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCUInt32Batch(lhs), Self::MPCUInt32(rhs)) => {
+                        Self::MPCBoolBatch(lhs.iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCUInt32(lhs), Self::MPCUInt32Batch(rhs)) => {
+                        Self::MPCBoolBatch(rhs.iter().map(|r| lhs $op r).collect())
+                    }
+                    (Self::MPCUInt64Batch(lhs), Self::MPCUInt64Batch(rhs)) => {
+                        Self::MPCBoolBatch(zip_batches(lhs, rhs, |l, r| l $op r))
+                    }
+                    (Self::MPCUInt64Batch(lhs), Self::MPCUInt64(rhs)) => {
+                        Self::MPCBoolBatch(lhs.iter().map(|l| l $op rhs).collect())
+                    }
+                    (Self::MPCUInt64(lhs), Self::MPCUInt64Batch(rhs)) => {
+                        Self::MPCBoolBatch(rhs.iter().map(|r| lhs $op r).collect())
+                    }
                     (Self::Vec(lhs), Self::Vec(rhs)) => Self::Vec(
                         lhs.iter()
                             .zip(rhs.iter())
@@ -85,6 +176,9 @@ macro_rules! impl_comparision_method {
                     (Self::MPCBool(_lhs), Self::MPCBool(_rhs)) => {
                         panic!("Operator not defined for MPC bool")
                     }
+                    (Self::MPCBoolBatch(_lhs), Self::MPCBoolBatch(_rhs)) => {
+                        panic!("Operator not defined for MPC bool")
+                    }
                     (_, _) => panic!("Differing MPCMetricDType variants not supported"),
                 }
             }
@@ -105,6 +199,34 @@ impl MPCMetricDType {
         T::try_from(self)
     }
 
+    /// Packs a column of scalars of one type into the matching batch type
+    pub fn batch(column: Vec<Self>) -> Self {
+        match column.first() {
+            Some(Self::MPCInt32(_)) => Self::MPCInt32Batch(Self::take_column(column)),
+            Some(Self::MPCInt64(_)) => Self::MPCInt64Batch(Self::take_column(column)),
+            Some(Self::MPCUInt32(_)) => Self::MPCUInt32Batch(Self::take_column(column)),
+            Some(Self::MPCUInt64(_)) => Self::MPCUInt64Batch(Self::take_column(column)),
+            Some(Self::MPCBool(_)) => Self::MPCBoolBatch(Self::take_column(column)),
+            Some(_) => panic!("Only columns of scalars can be batched"),
+            None => panic!("Cannot batch an empty column"),
+        }
+    }
+
+    fn take_column<T>(column: Vec<Self>) -> Vec<T>
+    where
+        T: std::convert::TryFrom<MPCMetricDType>,
+        <T as TryFrom<MPCMetricDType>>::Error: std::fmt::Debug,
+    {
+        column
+            .into_iter()
+            .map(|value| {
+                value
+                    .take_inner_val()
+                    .expect("Differing MPCMetricDType variants in one column")
+            })
+            .collect()
+    }
+
     impl_comparision_method!(lt, <);
     impl_comparision_method!(lte, <=);
     impl_comparision_method!(gt, >);
@@ -601,5 +723,95 @@ mod tests {
             MPCMetricDType::Vec(vec![MPCMetricDType::MPCBool(true)]).try_into(),
             Ok(vec![MPCMetricDType::MPCBool(true)])
         );
+        assert_eq!(
+            MPCMetricDType::MPCInt32Batch(vec![32]).try_into(),
+            Ok(vec![32i32])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCBoolBatch(vec![true]).try_into(),
+            Ok(vec![true])
+        );
+    }
+
+    #[test]
+    fn batch() {
+        assert_eq!(
+            MPCMetricDType::batch(vec![
+                MPCMetricDType::MPCInt32(1),
+                MPCMetricDType::MPCInt32(2)
+            ]),
+            MPCMetricDType::MPCInt32Batch(vec![1, 2])
+        );
+        assert_eq!(
+            MPCMetricDType::batch(vec![
+                MPCMetricDType::MPCUInt64(1),
+                MPCMetricDType::MPCUInt64(2)
+            ]),
+            MPCMetricDType::MPCUInt64Batch(vec![1, 2])
+        );
+        assert_eq!(
+            MPCMetricDType::batch(vec![
+                MPCMetricDType::MPCBool(true),
+                MPCMetricDType::MPCBool(false)
+            ]),
+            MPCMetricDType::MPCBoolBatch(vec![true, false])
+        );
+    }
+
+    #[test]
+    #[should_panic]
+    fn batch_mixed_column() {
+        MPCMetricDType::batch(vec![
+            MPCMetricDType::MPCInt32(1),
+            MPCMetricDType::MPCInt64(2),
+        ]);
+    }
+
+    #[test]
+    fn batch_arithmetic() {
+        assert_eq!(
+            MPCMetricDType::MPCInt32Batch(vec![1, 2]) + MPCMetricDType::MPCInt32Batch(vec![3, 4]),
+            MPCMetricDType::MPCInt32Batch(vec![4, 6])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCInt64Batch(vec![5, 6]) - MPCMetricDType::MPCInt64(2),
+            MPCMetricDType::MPCInt64Batch(vec![3, 4])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCUInt32(10) - MPCMetricDType::MPCUInt32Batch(vec![1, 2]),
+            MPCMetricDType::MPCUInt32Batch(vec![9, 8])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCUInt64Batch(vec![3, 4]) * MPCMetricDType::MPCUInt64Batch(vec![2, 2]),
+            MPCMetricDType::MPCUInt64Batch(vec![6, 8])
+        );
+    }
+
+    #[test]
+    #[should_panic]
+    fn batch_arithmetic_different_sizes() {
+        let _ = MPCMetricDType::MPCInt32Batch(vec![1, 2]) + MPCMetricDType::MPCInt32Batch(vec![3]);
+    }
+
+    #[test]
+    fn batch_comparison() {
+        assert_eq!(
+            MPCMetricDType::MPCInt32Batch(vec![1, 2])
+                .lt(&MPCMetricDType::MPCInt32Batch(vec![2, 1])),
+            MPCMetricDType::MPCBoolBatch(vec![true, false])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCInt64Batch(vec![1, 2]).gte(&MPCMetricDType::MPCInt64(2)),
+            MPCMetricDType::MPCBoolBatch(vec![false, true])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCUInt32(2).lte(&MPCMetricDType::MPCUInt32Batch(vec![2, 1])),
+            MPCMetricDType::MPCBoolBatch(vec![true, false])
+        );
+        assert_eq!(
+            MPCMetricDType::MPCUInt64Batch(vec![1, 3])
+                .gt(&MPCMetricDType::MPCUInt64Batch(vec![2, 2])),
+            MPCMetricDType::MPCBoolBatch(vec![false, true])
+        );
     }
 }
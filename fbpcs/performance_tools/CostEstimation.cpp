@@ -148,6 +148,10 @@ folly::dynamic CostEstimation::getEstimatedCostDynamic(
   result.insert("estimated_cost", estimatedCost_);
   result.insert("cloud_provider", CLOUD);
   result.insert("additional_info", folly::toJson(info));
+  if (resourceSampler_) {
+    result.insert(
+        "resource_timeline", folly::toJson(resourceSampler_->getTimeline()));
+  }
 
   return result;
 }
@@ -164,6 +168,10 @@ folly::dynamic CostEstimation::getEstimatedCostDynamic(std::string run_name) {
   result.insert("rx_bytes", networkRXBytes_);
   result.insert("tx_bytes", networkTXBytes_);
   result.insert("estimated_cost", estimatedCost_);
+  if (resourceSampler_) {
+    result.insert(
+        "resource_timeline", folly::toJson(resourceSampler_->getTimeline()));
+  }
   return result;
 }
 
@@ -178,6 +186,9 @@ void CostEstimation::start() {
 
 void CostEstimation::end() {
   end_time_ = std::chrono::system_clock::now();
+  if (resourceSampler_) {
+    resourceSampler_->stop();
+  }
   auto result = readNetworkSnapshot();
   if (!result.empty()) {
     networkRXBytes_ = result["rx"] - networkRXBytes_;
@@ -188,6 +199,25 @@ void CostEstimation::end() {
   calculateCost();
 }
 
+void CostEstimation::startResourceSampling(
+    std::chrono::milliseconds interval) {
+  if (interval.count() <= 0 || resourceSampler_) {
+    return;
+  }
+  resourceSampler_ = std::make_unique<ResourceSampler>(interval);
+  resourceSampler_->start();
+}
+
+void CostEstimation::markPhase(const std::string& name) {
+  if (resourceSampler_) {
+    resourceSampler_->markPhase(name);
+  }
+}
+
+folly::dynamic CostEstimation::getResourceTimeline() {
+  return resourceSampler_ ? resourceSampler_->getTimeline() : nullptr;
+}
+
 std::string CostEstimation::writeToS3(
     std::string party,
     std::string run_name,
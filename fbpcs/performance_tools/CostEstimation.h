@@ -7,7 +7,10 @@
 
 #pragma once
 
+#include <fbpcs/performance_tools/ResourceSampler.h>
 #include <folly/dynamic.h>
+#include <chrono>
+#include <memory>
 #include <string>
 
 namespace fbpcs::performance_tools {
@@ -39,6 +42,7 @@ class CostEstimation {
   long networkTXBytes_; // Network Transmit bytes
   std::chrono::time_point<std::chrono::system_clock> start_time_;
   std::chrono::time_point<std::chrono::system_clock> end_time_;
+  std::unique_ptr<ResourceSampler> resourceSampler_;
 
  public:
   explicit CostEstimation(const std::string& app);
@@ -49,7 +53,7 @@ class CostEstimation {
   long getNetworkBytes();
   void calculateCost();
 
-  std::unordered_map<std::string, long> readNetworkSnapshot();
+  static std::unordered_map<std::string, long> readNetworkSnapshot();
   std::string getEstimatedCostString();
   folly::dynamic getEstimatedCostDynamic(
       std::string run_name,
@@ -60,6 +64,17 @@ class CostEstimation {
   void start();
   void end();
 
+  /*
+   * Records a timeline of the process's resource usage every interval until
+   * end(), which is logged with the cost summary. Meant to be called once
+   * flags are parsed; a zero interval leaves sampling off.
+   */
+  void startResourceSampling(std::chrono::milliseconds interval);
+  // Marks the start of a named phase in the timeline, if sampling is on
+  void markPhase(const std::string& name);
+  // Null unless sampling was started
+  folly::dynamic getResourceTimeline();
+
   std::string writeToS3(
       std::string party,
       std::string run_name,
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#include "fbpcs/performance_tools/ResourceSampler.h"
+#include <fbpcs/performance_tools/CostEstimation.h>
+#include <folly/logging/xlog.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#include <fstream>
+#include <string>
+#include <utility>
+
+namespace fbpcs::performance_tools {
+
+namespace {
+
+int64_t toMs(const timeval& time) {
+  return static_cast<int64_t>(time.tv_sec) * 1000 + time.tv_usec / 1000;
+}
+
+// Reads the number after "<key>" in a "key: value" style file
+int64_t readProcValue(std::ifstream& file, const std::string& key) {
+  for (std::string line; getline(file, line);) {
+    if (line.rfind(key, 0) == 0) {
+      return std::stoll(line.substr(key.size()));
+    }
+  }
+  return 0;
+}
+
+} // namespace
+
+ResourceSampler::ResourceSampler(std::chrono::milliseconds interval)
+    : interval_{interval} {}
+
+ResourceSampler::~ResourceSampler() {
+  stop();
+}
+
+void ResourceSampler::start() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (running_) {
+    return;
+  }
+  running_ = true;
+  startTime_ = std::chrono::steady_clock::now();
+  thread_ = std::thread([this]() {
+    std::unique_lock<std::mutex> lock{mutex_};
+    while (running_) {
+      lock.unlock();
+      auto sample = readSample();
+      lock.lock();
+      sample.elapsedMs = getElapsedMs();
+      samples_.push_back(sample);
+      stopped_.wait_for(lock, interval_, [this]() { return !running_; });
+    }
+  });
+}
+
+void ResourceSampler::stop() {
+  {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (!running_) {
+      return;
+    }
+    running_ = false;
+  }
+  stopped_.notify_one();
+  thread_.join();
+  // the last sample closes the timeline at the time sampling stopped
+  takeSample();
+}
+
+void ResourceSampler::markPhase(const std::string& name) {
+  std::lock_guard<std::mutex> lock{mutex_};
+  if (!running_) {
+    XLOGF(WARN, "Phase {} is marked while not sampling, ignoring it", name);
+    return;
+  }
+  phases_.emplace_back(name, getElapsedMs());
+}
+
+folly::dynamic ResourceSampler::getTimeline() {
+  std::lock_guard<std::mutex> lock{mutex_};
+  folly::dynamic columns = folly::dynamic::object;
+  const std::vector<std::pair<std::string, int64_t ResourceSample::*>> fields{
+      {"elapsed_ms", &ResourceSample::elapsedMs},
+      {"user_cpu_ms", &ResourceSample::userCpuMs},
+      {"system_cpu_ms", &ResourceSample::systemCpuMs},
+      {"rss_bytes", &ResourceSample::rssBytes},
+      {"peak_rss_bytes", &ResourceSample::peakRssBytes},
+      {"io_read_bytes", &ResourceSample::ioReadBytes},
+      {"io_write_bytes", &ResourceSample::ioWriteBytes},
+      {"rx_bytes_dev", &ResourceSample::networkRXBytes},
+      {"tx_bytes_dev", &ResourceSample::networkTXBytes},
+      {"num_threads", &ResourceSample::numThreads}};
+  for (const auto& [name, field] : fields) {
+    folly::dynamic column = folly::dynamic::array;
+    for (const auto& sample : samples_) {
+      column.push_back(sample.*field);
+    }
+    columns.insert(name, std::move(column));
+  }
+
+  folly::dynamic phases = folly::dynamic::array;
+  for (const auto& [name, elapsedMs] : phases_) {
+    phases.push_back(
+        folly::dynamic::object("name", name)("elapsed_ms", elapsedMs));
+  }
+
+  folly::dynamic result = folly::dynamic::object;
+  result.insert("interval_ms", interval_.count());
+  result.insert("samples", std::move(columns));
+  result.insert("phases", std::move(phases));
+  return result;
+}
+
+ResourceSample ResourceSampler::readSample() {
+  ResourceSample sample;
+
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0) {
+    sample.userCpuMs = toMs(usage.ru_utime);
+    sample.systemCpuMs = toMs(usage.ru_stime);
+    // ru_maxrss is in kilobytes on Linux
+    sample.peakRssBytes = static_cast<int64_t>(usage.ru_maxrss) * 1024;
+  }
+
+  // the second field of statm is the resident set size in pages
+  std::ifstream statmFile{"/proc/self/statm"};
+  int64_t sizePages = 0;
+  int64_t residentPages = 0;
+  if (statmFile >> sizePages >> residentPages) {
+    sample.rssBytes = residentPages * sysconf(_SC_PAGESIZE);
+  }
+
+  // read_bytes and write_bytes count what actually hit the storage layer.
+  // They are read in the order the kernel writes them.
+  std::ifstream ioFile{PROC_SELF_IO_FILE};
+  sample.ioReadBytes = readProcValue(ioFile, "read_bytes:");
+  sample.ioWriteBytes = readProcValue(ioFile, "write_bytes:");
+
+  std::ifstream statusFile{PROC_SELF_STATUS_FILE};
+  sample.numThreads = readProcValue(statusFile, "Threads:");
+
+  auto network = CostEstimation::readNetworkSnapshot();
+  sample.networkRXBytes = network["rx"];
+  sample.networkTXBytes = network["tx"];
+  return sample;
+}
+
+void ResourceSampler::takeSample() {
+  auto sample = readSample();
+  std::lock_guard<std::mutex> lock{mutex_};
+  sample.elapsedMs = getElapsedMs();
+  samples_.push_back(sample);
+}
+
+int64_t ResourceSampler::getElapsedMs() const {
+  return std::chrono::duration_cast<std::chrono::milliseconds>(
+             std::chrono::steady_clock::now() - startTime_)
+      .count();
+}
+
+} // namespace fbpcs::performance_tools
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) Meta Platforms, Inc. and affiliates.
+ *
+ * This source code is licensed under the MIT license found in the
+ * LICENSE file in the root directory of this source tree.
+ */
+
+#pragma once
+
+#include <folly/dynamic.h>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fbpcs::performance_tools {
+
+const std::string PROC_SELF_IO_FILE = "/proc/self/io";
+const std::string PROC_SELF_STATUS_FILE = "/proc/self/status";
+
+/*
+ * Resource usage of this process at one point in time. Network bytes are read
+ * from NET_DEV_FILE, so they cover the whole container, like the cost summary.
+ */
+struct ResourceSample {
+  int64_t elapsedMs = 0; // since sampling started
+  int64_t userCpuMs = 0;
+  int64_t systemCpuMs = 0;
+  int64_t rssBytes = 0;
+  int64_t peakRssBytes = 0;
+  int64_t ioReadBytes = 0;
+  int64_t ioWriteBytes = 0;
+  int64_t networkRXBytes = 0;
+  int64_t networkTXBytes = 0;
+  int64_t numThreads = 0;
+};
+
+/*
+ * Samples the resource usage of this process on a background thread, at a
+ * fixed interval, so that memory spikes and idle network periods show up in
+ * the timeline instead of being averaged away. Named phase markers can be
+ * added from any thread to line the samples up with the game.
+ */
+class ResourceSampler {
+ public:
+  explicit ResourceSampler(std::chrono::milliseconds interval);
+  ~ResourceSampler();
+
+  ResourceSampler(const ResourceSampler&) = delete;
+  ResourceSampler& operator=(const ResourceSampler&) = delete;
+
+  void start();
+  // takes a last sample and joins the sampling thread
+  void stop();
+
+  void markPhase(const std::string& name);
+
+  /*
+   * The samples as a column per metric rather than an object per sample,
+   * which keeps the timeline small enough to log next to the cost summary.
+   */
+  folly::dynamic getTimeline();
+
+  static ResourceSample readSample();
+
+ private:
+  void takeSample();
+  int64_t getElapsedMs() const;
+
+  std::chrono::milliseconds interval_;
+  std::chrono::time_point<std::chrono::steady_clock> startTime_;
+  std::thread thread_;
+  std::mutex mutex_;
+  std::condition_variable stopped_;
+  bool running_ = false;
+  std::vector<ResourceSample> samples_;
+  std::vector<std::pair<std::string, int64_t>> phases_;
+};
+
+} // namespace fbpcs::performance_tools
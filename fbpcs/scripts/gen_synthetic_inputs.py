@@ -0,0 +1,415 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+"""
+CLI tool to generate matched publisher and partner inputs of any size for
+performance and scaling tests
+
+Every user is generated from its own seeded random generator, so the same
+options always give the same users, whatever the number of files, and rows are
+streamed to disk one user at a time. Memory only grows with the number of ad
+ids and the maximum events per user.
+
+Stages:
+    raw               Event level rows and id spines, as read by the sharder
+                      and the attribution id combiner
+    attribution       One row per user with event arrays, as read by
+                      pcf2_attribution and as the clear text input of
+                      pcf2_aggregation
+    aggregation       The attribution inputs, plus XOR shared attribution
+                      results as read by pcf2_aggregation
+    lift              Publisher and partner inputs of the lift calculator
+    shard_aggregator  XOR shared measurement metrics per shard, as read by the
+                      shard aggregator
+
+Usage:
+    gen_synthetic_inputs <stage> <output_dir> [options]
+
+Options:
+    -h --help                     Show this help
+    -n --num_users=<n>            Number of users, matched or not [default: 1000]
+    --num_files=<n>               Split users over this many files, suffixed _0, _1, ... [default: 1]
+    --seed=<s>                    Seed for every random choice [default: 0]
+    --match_rate=<m>              Probability of a user being in both datasets [default: 0.5]
+    --touchpoints=<d>             Distribution of touchpoints per user: zipf:<s>, uniform or fixed:<k> [default: zipf:1.5]
+    --max_touchpoints=<n>         Maximum touchpoints per user [default: 4]
+    --conversions=<d>             Distribution of conversions per user [default: zipf:1.5]
+    --max_conversions=<n>         Maximum conversions per user [default: 4]
+    --num_ad_ids=<n>              Number of distinct ad ids [default: 100]
+    --ad_ids=<d>                  Distribution of ad ids over users [default: zipf:1.0]
+    --click_rate=<c>              Probability of a touchpoint being a click [default: 0.5]
+    --min_ts=<t>                  Minimum event timestamp [default: 1600000000]
+    --max_ts=<t>                  Maximum event timestamp [default: 1600864000]
+    --attribution_rule=<r>        Rule name used in generated attribution results [default: last_touch_1d]
+    --log_every_n=<n>             Output progress every N users
+"""
+
+import bisect
+import hashlib
+import itertools
+import json
+import os
+import pathlib
+import random
+from typing import Any, Dict, IO, Iterator, List, NamedTuple, Tuple
+
+import docopt
+import schema
+
+STAGES = ["raw", "attribution", "aggregation", "lift", "shard_aggregator"]
+# Generated attribution results attribute a conversion to the last touchpoint
+# before it within this window, like a last touch rule
+ATTRIBUTION_WINDOW_SECONDS = 86400
+# Lift opportunities fall this long before the window, so that every
+# conversion can follow them
+LIFT_OPPORTUNITY_OFFSET_SECONDS = 3600
+
+
+class Touchpoint(NamedTuple):
+    timestamp: int
+    ad_id: int
+    is_click: int
+    campaign_metadata: int
+
+
+class Conversion(NamedTuple):
+    timestamp: int
+    value: int
+    metadata: int
+
+
+class User(NamedTuple):
+    user_num: int
+    in_publisher: bool
+    in_partner: bool
+    touchpoints: List[Touchpoint]
+    conversions: List[Conversion]
+
+
+class Distribution:
+    """
+    A distribution over 1..max_value, given as "zipf:<exponent>", "uniform" or
+    "fixed:<value>"
+    """
+
+    def __init__(self, spec: str, max_value: int) -> None:
+        kind, _, param = spec.partition(":")
+        if kind == "fixed":
+            self.values = [min(int(param), max_value)]
+            weights = [1.0]
+        elif kind == "uniform":
+            self.values = list(range(1, max_value + 1))
+            weights = [1.0] * max_value
+        elif kind == "zipf":
+            exponent = float(param)
+            self.values = list(range(1, max_value + 1))
+            weights = [1.0 / (k**exponent) for k in self.values]
+        else:
+            raise ValueError(f"Unknown distribution {spec}")
+        self.cum_weights = list(itertools.accumulate(weights))
+
+    def sample(self, rng: random.Random) -> int:
+        index = bisect.bisect_left(
+            self.cum_weights, rng.random() * self.cum_weights[-1]
+        )
+        return self.values[min(index, len(self.values) - 1)]
+
+
+def _get_raw_id(user_num: int) -> str:
+    return hashlib.md5(bytes(str(user_num), encoding="utf-8")).hexdigest()
+
+
+def _gen_user(
+    user_num: int, args: Dict[str, Any], dists: Dict[str, Distribution]
+) -> User:
+    rng = random.Random(f"{args['--seed']}:{user_num}")
+    if rng.random() < args["--match_rate"]:
+        in_publisher, in_partner = True, True
+    else:
+        in_publisher = rng.random() < 0.5
+        in_partner = not in_publisher
+
+    touchpoints = []
+    if in_publisher:
+        touchpoints = sorted(
+            Touchpoint(
+                timestamp=rng.randint(args["--min_ts"], args["--max_ts"]),
+                ad_id=dists["ad_ids"].sample(rng),
+                is_click=int(rng.random() < args["--click_rate"]),
+                campaign_metadata=rng.randint(0, 99),
+            )
+            for _ in range(dists["touchpoints"].sample(rng))
+        )
+    conversions = []
+    if in_partner:
+        conversions = sorted(
+            Conversion(
+                timestamp=rng.randint(args["--min_ts"], args["--max_ts"]),
+                value=rng.randint(1, 1000),
+                metadata=rng.randint(0, 3),
+            )
+            for _ in range(dists["conversions"].sample(rng))
+        )
+    return User(user_num, in_publisher, in_partner, touchpoints, conversions)
+
+
+def _get_attributed_touchpoint(
+    touchpoints: List[Touchpoint], conversion: Conversion
+) -> int:
+    """Index of the touchpoint the conversion is attributed to, or -1"""
+    attributed = -1
+    for i, tp in enumerate(touchpoints):
+        if (
+            tp.timestamp < conversion.timestamp
+            and conversion.timestamp - tp.timestamp <= ATTRIBUTION_WINDOW_SECONDS
+        ):
+            attributed = i
+    return attributed
+
+
+def _format_list(values: List[int]) -> str:
+    return "[" + ", ".join(str(v) for v in values) + "]"
+
+
+def _get_file_ranges(num_users: int, num_files: int) -> List[Tuple[int, int]]:
+    bounds = [num_users * i // num_files for i in range(num_files + 1)]
+    return list(zip(bounds[:-1], bounds[1:]))
+
+
+def _write_raw(users: Iterator[User], out_dir: pathlib.Path, suffix: str) -> None:
+    with open(out_dir / f"publisher.csv{suffix}", "w") as f_pub, open(
+        out_dir / f"partner.csv{suffix}", "w"
+    ) as f_part, open(
+        out_dir / f"publisher_spine.csv{suffix}", "w"
+    ) as f_pub_spine, open(
+        out_dir / f"partner_spine.csv{suffix}", "w"
+    ) as f_part_spine:
+        f_pub.write("id_,ad_id,timestamp,is_click,campaign_metadata\n")
+        f_part.write("id_,conversion_timestamp,conversion_value,conversion_metadata\n")
+        for user in users:
+            raw_id = _get_raw_id(user.user_num)
+            # both spines list every user, with an empty id where a party
+            # does not know them
+            f_pub_spine.write(
+                f"{user.user_num},{raw_id if user.in_publisher else ''}\n"
+            )
+            f_part_spine.write(f"{user.user_num},{raw_id if user.in_partner else ''}\n")
+            for tp in user.touchpoints:
+                f_pub.write(
+                    f"{raw_id},{tp.ad_id},{tp.timestamp},{tp.is_click},{tp.campaign_metadata}\n"
+                )
+            for conv in user.conversions:
+                f_part.write(
+                    f"{raw_id},{conv.timestamp},{conv.value},{conv.metadata}\n"
+                )
+
+
+def _write_attribution_row(f_pub: IO[str], f_part: IO[str], user: User) -> None:
+    tps = user.touchpoints
+    convs = user.conversions
+    f_pub.write(
+        f"{user.user_num},{_format_list([tp.ad_id for tp in tps])},"
+        f"{_format_list([tp.timestamp for tp in tps])},"
+        f"{_format_list([tp.is_click for tp in tps])},"
+        f"{_format_list([tp.campaign_metadata for tp in tps])}\n"
+    )
+    f_part.write(
+        f"{user.user_num},{_format_list([c.timestamp for c in convs])},"
+        f"{_format_list([c.value for c in convs])},"
+        f"{_format_list([c.metadata for c in convs])}\n"
+    )
+
+
+def _write_attribution(
+    users: Iterator[User],
+    out_dir: pathlib.Path,
+    suffix: str,
+    args: Dict[str, Any],
+    with_results: bool = False,
+) -> None:
+    with open(out_dir / f"publisher.csv{suffix}", "w") as f_pub, open(
+        out_dir / f"partner.csv{suffix}", "w"
+    ) as f_part:
+        f_pub.write("id_,ad_ids,timestamps,is_click,campaign_metadata\n")
+        f_part.write(
+            "id_,conversion_timestamps,conversion_values,conversion_metadata\n"
+        )
+        if not with_results:
+            for user in users:
+                _write_attribution_row(f_pub, f_part, user)
+            return
+
+        with open(
+            out_dir / f"publisher_attribution.json{suffix}", "w"
+        ) as f_pub_res, open(
+            out_dir / f"partner_attribution.json{suffix}", "w"
+        ) as f_part_res:
+            # written by hand, so that a file never has to be held in memory
+            header = f'{{"{args["--attribution_rule"]}": {{"default": {{'
+            f_pub_res.write(header)
+            f_part_res.write(header)
+            for row, user in enumerate(users):
+                _write_attribution_row(f_pub, f_part, user)
+                pub_shares, part_shares = _gen_attribution_shares(user, args)
+                separator = "" if row == 0 else ", "
+                f_pub_res.write(f'{separator}"{row}": {json.dumps(pub_shares)}')
+                f_part_res.write(f'{separator}"{row}": {json.dumps(part_shares)}')
+            f_pub_res.write("}}}\n")
+            f_part_res.write("}}}\n")
+
+
+def _gen_attribution_shares(
+    user: User, args: Dict[str, Any]
+) -> Tuple[List[Dict[str, bool]], List[Dict[str, bool]]]:
+    """
+    XOR shares of one is_attributed bit per padded (conversion, touchpoint)
+    pair, in the order pcf2_attribution writes them
+    """
+    rng = random.Random(f"{args['--seed']}:{user.user_num}:shares")
+    max_tps = args["--max_touchpoints"]
+    attributed = [False] * (args["--max_conversions"] * max_tps)
+    for c, conv in enumerate(user.conversions):
+        t = _get_attributed_touchpoint(user.touchpoints, conv)
+        if t >= 0:
+            attributed[c * max_tps + t] = True
+    pub_shares = []
+    part_shares = []
+    for bit in attributed:
+        mask = rng.random() < 0.5
+        pub_shares.append({"is_attributed": mask})
+        part_shares.append({"is_attributed": bit != mask})
+    return pub_shares, part_shares
+
+
+def _write_lift(
+    users: Iterator[User], out_dir: pathlib.Path, suffix: str, args: Dict[str, Any]
+) -> None:
+    max_convs = args["--max_conversions"]
+    with open(out_dir / f"publisher.csv{suffix}", "w") as f_pub, open(
+        out_dir / f"partner.csv{suffix}", "w"
+    ) as f_part:
+        f_pub.write(
+            "id_,opportunity,test_flag,opportunity_timestamp,num_impressions,num_clicks,total_spend\n"
+        )
+        f_part.write("id_,event_timestamps,values\n")
+        for user in users:
+            rng = random.Random(f"{args['--seed']}:{user.user_num}:lift")
+            tps = user.touchpoints
+            if tps:
+                num_clicks = sum(tp.is_click for tp in tps)
+                f_pub.write(
+                    f"{user.user_num},1,{int(rng.random() < 0.5)},"
+                    f"{args['--min_ts'] - LIFT_OPPORTUNITY_OFFSET_SECONDS},"
+                    f"{len(tps) - num_clicks},{num_clicks},"
+                    f"{rng.randint(1, 100) * len(tps)}\n"
+                )
+            else:
+                f_pub.write(f"{user.user_num},0,0,0,0,0,0\n")
+            # conversions are padded with leading zeros
+            convs = user.conversions
+            padding = [0] * (max_convs - len(convs))
+            f_part.write(
+                f"{user.user_num},{_format_list(padding + [c.timestamp for c in convs])},"
+                f"{_format_list(padding + [c.value for c in convs])}\n"
+            )
+
+
+def _write_shard_aggregator(
+    users: Iterator[User], out_dir: pathlib.Path, suffix: str, args: Dict[str, Any]
+) -> None:
+    # the sums are as large as the number of ad ids, not of users
+    convs = [0] * (args["--num_ad_ids"] + 1)
+    sales = [0] * (args["--num_ad_ids"] + 1)
+    first_user = None
+    for user in users:
+        first_user = user.user_num if first_user is None else first_user
+        for conv in user.conversions:
+            t = _get_attributed_touchpoint(user.touchpoints, conv)
+            if t >= 0:
+                ad_id = user.touchpoints[t].ad_id
+                convs[ad_id] += 1
+                sales[ad_id] += conv.value
+
+    rng = random.Random(f"{args['--seed']}:{first_user}:shard")
+    pub_metrics = {}
+    part_metrics = {}
+    for ad_id in range(len(convs)):
+        # the shard aggregator reads 64 bit integers, and XORs of values
+        # below 2^62 stay positive
+        conv_mask = rng.getrandbits(62)
+        sales_mask = rng.getrandbits(62)
+        pub_metrics[str(ad_id)] = {"convs": conv_mask, "sales": sales_mask}
+        part_metrics[str(ad_id)] = {
+            "convs": convs[ad_id] ^ conv_mask,
+            "sales": sales[ad_id] ^ sales_mask,
+        }
+    rule = args["--attribution_rule"]
+    with open(out_dir / f"publisher_attribution_out.json{suffix}", "w") as f:
+        json.dump({rule: {"measurement": pub_metrics}}, f)
+    with open(out_dir / f"partner_attribution_out.json{suffix}", "w") as f:
+        json.dump({rule: {"measurement": part_metrics}}, f)
+
+
+def gen_synthetic_inputs(args: Dict[str, Any]) -> None:
+    stage = args["<stage>"]
+    out_dir = args["<output_dir>"]
+    dists = {
+        "touchpoints": Distribution(args["--touchpoints"], args["--max_touchpoints"]),
+        "conversions": Distribution(args["--conversions"], args["--max_conversions"]),
+        "ad_ids": Distribution(args["--ad_ids"], args["--num_ad_ids"]),
+    }
+
+    def gen_users(begin: int, end: int) -> Iterator[User]:
+        for user_num in range(begin, end):
+            yield _gen_user(user_num, args, dists)
+            if args["--log_every_n"] and (user_num + 1) % args["--log_every_n"] == 0:
+                print(f"Generated {user_num + 1} users")
+
+    ranges = _get_file_ranges(args["--num_users"], args["--num_files"])
+    for i, (begin, end) in enumerate(ranges):
+        suffix = f"_{i}"
+        users = gen_users(begin, end)
+        if stage == "raw":
+            _write_raw(users, out_dir, suffix)
+        elif stage == "attribution":
+            _write_attribution(users, out_dir, suffix, args)
+        elif stage == "aggregation":
+            _write_attribution(users, out_dir, suffix, args, with_results=True)
+        elif stage == "lift":
+            _write_lift(users, out_dir, suffix, args)
+        else:
+            _write_shard_aggregator(users, out_dir, suffix, args)
+
+
+def main() -> None:
+    args_schema = schema.Schema(
+        {
+            "<stage>": schema.And(str, lambda s: s in STAGES),
+            "<output_dir>": schema.And(schema.Use(pathlib.Path), os.path.isdir),
+            "--num_users": schema.Use(int),
+            "--num_files": schema.And(schema.Use(int), lambda n: n > 0),
+            "--seed": schema.Use(int),
+            "--match_rate": schema.Use(float),
+            "--touchpoints": str,
+            "--max_touchpoints": schema.Use(int),
+            "--conversions": str,
+            "--max_conversions": schema.Use(int),
+            "--num_ad_ids": schema.Use(int),
+            "--ad_ids": str,
+            "--click_rate": schema.Use(float),
+            "--min_ts": schema.Use(int),
+            "--max_ts": schema.Use(int),
+            "--attribution_rule": str,
+            schema.Optional("--log_every_n"): schema.Or(None, schema.Use(int)),
+            "--help": bool,
+        }
+    )
+    args = args_schema.validate(docopt.docopt(__doc__))
+    gen_synthetic_inputs(args)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,141 @@
+#!/usr/bin/env python3
+# Copyright (c) Meta Platforms, Inc. and affiliates.
+#
+# This source code is licensed under the MIT license found in the
+# LICENSE file in the root directory of this source tree.
+
+import json
+import pathlib
+import random
+import tempfile
+import unittest
+
+from fbpcs.scripts import gen_synthetic_inputs
+
+
+def _get_args(stage: str, output_dir: str, **overrides) -> dict:
+    args = {
+        "<stage>": stage,
+        "<output_dir>": pathlib.Path(output_dir),
+        "--num_users": 200,
+        "--num_files": 1,
+        "--seed": 7,
+        "--match_rate": 0.5,
+        "--touchpoints": "zipf:1.5",
+        "--max_touchpoints": 4,
+        "--conversions": "zipf:1.5",
+        "--max_conversions": 4,
+        "--num_ad_ids": 10,
+        "--ad_ids": "zipf:1.0",
+        "--click_rate": 0.5,
+        "--min_ts": 1600000000,
+        "--max_ts": 1600086400,
+        "--attribution_rule": "last_touch_1d",
+        "--log_every_n": None,
+    }
+    args.update(overrides)
+    return args
+
+
+def _read_rows(path: pathlib.Path, has_header: bool = True) -> list:
+    with open(path) as f:
+        return f.read().splitlines()[1 if has_header else 0 :]
+
+
+class TestGenSyntheticInputs(unittest.TestCase):
+    def test_distribution(self) -> None:
+        rng = random.Random(0)
+        fixed = gen_synthetic_inputs.Distribution("fixed:3", 4)
+        self.assertEqual({3}, {fixed.sample(rng) for _ in range(100)})
+
+        # long tail: 1 is the most common value, but the maximum still shows up
+        zipf = gen_synthetic_inputs.Distribution("zipf:1.0", 10)
+        samples = [zipf.sample(rng) for _ in range(10000)]
+        self.assertEqual(1, max(set(samples), key=samples.count))
+        self.assertIn(10, samples)
+        self.assertTrue(all(1 <= s <= 10 for s in samples))
+
+        with self.assertRaises(ValueError):
+            gen_synthetic_inputs.Distribution("normal", 10)
+
+    def test_same_users_for_any_number_of_files(self) -> None:
+        with tempfile.TemporaryDirectory() as one, tempfile.TemporaryDirectory() as three:
+            gen_synthetic_inputs.gen_synthetic_inputs(_get_args("attribution", one))
+            gen_synthetic_inputs.gen_synthetic_inputs(
+                _get_args("attribution", three, **{"--num_files": 3})
+            )
+            for party in ["publisher", "partner"]:
+                rows = _read_rows(pathlib.Path(one) / f"{party}.csv_0")
+                sharded_rows = []
+                for i in range(3):
+                    sharded_rows += _read_rows(pathlib.Path(three) / f"{party}.csv_{i}")
+                self.assertEqual(200, len(rows))
+                self.assertEqual(rows, sharded_rows)
+
+    def test_match_rate(self) -> None:
+        with tempfile.TemporaryDirectory() as out_dir:
+            gen_synthetic_inputs.gen_synthetic_inputs(
+                _get_args("raw", out_dir, **{"--match_rate": 1.0})
+            )
+            for party in ["publisher", "partner"]:
+                spine = _read_rows(
+                    pathlib.Path(out_dir) / f"{party}_spine.csv_0", has_header=False
+                )
+                self.assertEqual(200, len(spine))
+                self.assertTrue(all(not row.endswith(",") for row in spine))
+
+            gen_synthetic_inputs.gen_synthetic_inputs(
+                _get_args("attribution", out_dir, **{"--match_rate": 0.0})
+            )
+            publisher = _read_rows(pathlib.Path(out_dir) / "publisher.csv_0")
+            partner = _read_rows(pathlib.Path(out_dir) / "partner.csv_0")
+            # without matches, every user has events on exactly one side
+            for pub_row, part_row in zip(publisher, partner):
+                self.assertNotEqual(
+                    pub_row.endswith("[],[],[],[]"), part_row.endswith("[],[],[]")
+                )
+
+    def test_attribution_shares(self) -> None:
+        with tempfile.TemporaryDirectory() as out_dir:
+            gen_synthetic_inputs.gen_synthetic_inputs(
+                _get_args("aggregation", out_dir, **{"--match_rate": 1.0})
+            )
+            with open(pathlib.Path(out_dir) / "publisher_attribution.json_0") as f:
+                publisher = json.load(f)["last_touch_1d"]["default"]
+            with open(pathlib.Path(out_dir) / "partner_attribution.json_0") as f:
+                partner = json.load(f)["last_touch_1d"]["default"]
+            self.assertEqual(200, len(publisher))
+
+            num_attributed = 0
+            for row in publisher:
+                self.assertEqual(16, len(publisher[row]))
+                revealed = [
+                    pub["is_attributed"] != part["is_attributed"]
+                    for pub, part in zip(publisher[row], partner[row])
+                ]
+                # a conversion is attributed to at most one touchpoint
+                for c in range(4):
+                    self.assertLessEqual(sum(revealed[c * 4 : c * 4 + 4]), 1)
+                num_attributed += sum(revealed)
+            self.assertLess(0, num_attributed)
+
+    def test_shard_aggregator_shares(self) -> None:
+        with tempfile.TemporaryDirectory() as out_dir:
+            gen_synthetic_inputs.gen_synthetic_inputs(
+                _get_args("shard_aggregator", out_dir, **{"--num_files": 2})
+            )
+            for i in range(2):
+                with open(
+                    pathlib.Path(out_dir) / f"publisher_attribution_out.json_{i}"
+                ) as f:
+                    publisher = json.load(f)["last_touch_1d"]["measurement"]
+                with open(
+                    pathlib.Path(out_dir) / f"partner_attribution_out.json_{i}"
+                ) as f:
+                    partner = json.load(f)["last_touch_1d"]["measurement"]
+                self.assertEqual(11, len(publisher))
+                for ad_id, metrics in publisher.items():
+                    convs = metrics["convs"] ^ partner[ad_id]["convs"]
+                    sales = metrics["sales"] ^ partner[ad_id]["sales"]
+                    self.assertLessEqual(convs, 200)
+                    self.assertLessEqual(convs, sales)